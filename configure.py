@@ -55,6 +55,10 @@ MODULES = [
         "archi/aggr/agg",
         "archi/aggr/ctx",
 
+        # execution tracing
+        "archi/trace/api",
+        "archi/trace/exe",
+
         # directed execution graphs
         "archi/exec/api",
         "archi/exec/exe",
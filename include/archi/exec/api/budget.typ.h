@@ -0,0 +1,57 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+/**
+ * @file
+ * @brief Types for budgeted directed execution graph execution.
+ */
+
+#pragma once
+#ifndef _ARCHI_EXEC_API_BUDGET_TYP_H_
+#define _ARCHI_EXEC_API_BUDGET_TYP_H_
+
+#include <stddef.h> // for size_t
+#include <stdint.h> // for uint64_t
+
+
+/**
+ * @brief Default number of operation calls and transitions between wall-clock checks.
+ */
+#define ARCHI_DEXGRAPH_BUDGET_DEFAULT_CHECK_PERIOD  64
+
+/**
+ * @brief DEG execution budget.
+ *
+ * Execution is interrupted between operations as soon as any of the limits is used up.
+ * Zero limit values mean no limit.
+ *
+ * The clock is read only once per check_period operation calls and node transitions,
+ * so the time limit can be exceeded by duration of that many operations.
+ * The time limit is also checked after node transitions, so that loops of nodes
+ * without operations are interrupted too.
+ */
+typedef struct archi_dexgraph_budget {
+    size_t max_operations; ///< Maximum number of operation calls.
+    uint64_t time_limit_ns; ///< Wall-clock time limit in nanoseconds, counted from the start of execution.
+    size_t check_period; ///< Number of operation calls and transitions between clock checks (0 means the default).
+
+    size_t num_operations; ///< [out] Number of operation calls done.
+} archi_dexgraph_budget_t;
+
+#endif // _ARCHI_EXEC_API_BUDGET_TYP_H_
@@ -0,0 +1,142 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Operations on dataflow graphs of operations.
+ */
+
+#pragma once
+#ifndef _ARCHI_EXEC_API_DATAFLOW_FUN_H_
+#define _ARCHI_EXEC_API_DATAFLOW_FUN_H_
+
+#include "archi/exec/api/dataflow.typ.h"
+#include "archi/exec/api/node.typ.h"
+#include "archi_base/error.typ.h"
+
+#include <stdbool.h>
+
+
+/**
+ * @brief Create a dataflow graph from a node sequence and a list of dependencies.
+ *
+ * Operations of the graph are operations of the node sequence,
+ * operation indices are sequence indices. Null operation functions are allowed
+ * and are done immediately when ready.
+ *
+ * Dependencies must refer to existing operations and must not form cycles.
+ *
+ * @warning The dataflow graph is a snapshot of the node sequence:
+ * operations modified after creation are not reflected in the graph.
+ * Operation data are referenced, not copied.
+ *
+ * @return Dataflow graph.
+ */
+archi_dexgraph_dataflow_t
+archi_dexgraph_dataflow_create(
+        const archi_dexgraph_node_t *node, ///< [in] Node which sequence provides operations.
+        const archi_dexgraph_dataflow_dependency_t dependency[], ///< [in] Array of dependencies.
+        size_t num_dependencies, ///< [in] Number of dependencies.
+        ARCHI_ERROR_PARAM_DECL ///< [out] Error.
+);
+
+/**
+ * @brief Destroy a dataflow graph.
+ */
+void
+archi_dexgraph_dataflow_destroy(
+        archi_dexgraph_dataflow_t dataflow ///< [in] Dataflow graph.
+);
+
+/**
+ * @brief Prepare a dataflow graph for an execution.
+ *
+ * Operations without dependencies are marked ready.
+ * A graph can be executed by one group of workers at a time.
+ */
+void
+archi_dexgraph_dataflow_begin(
+        archi_dexgraph_dataflow_t dataflow ///< [in] Dataflow graph.
+);
+
+/**
+ * @brief Execute ready operations of a dataflow graph until execution is finished.
+ *
+ * This function can be called concurrently from any number of threads
+ * between archi_dexgraph_dataflow_begin() and archi_dexgraph_dataflow_end().
+ * Every calling thread takes ready operations one by one and executes them.
+ * When an operation is done, dependent operations which have no more
+ * pending dependencies are marked ready. Threads that find no ready operations
+ * yield for a while, then sleep until an operation is marked ready.
+ *
+ * The function returns when all operations are done, or an operation has failed.
+ *
+ * @return True if the calling thread has executed the last operation
+ * or the failed operation, false otherwise.
+ */
+bool
+archi_dexgraph_dataflow_work(
+        archi_dexgraph_dataflow_t dataflow ///< [in] Dataflow graph.
+);
+
+/**
+ * @brief Finish an execution of a dataflow graph.
+ *
+ * Must be called after all workers have returned from archi_dexgraph_dataflow_work().
+ * Reports the error of the failed operation, if any.
+ */
+void
+archi_dexgraph_dataflow_end(
+        archi_dexgraph_dataflow_t dataflow, ///< [in] Dataflow graph.
+        ARCHI_ERROR_PARAM_DECL ///< [out] Error.
+);
+
+/**
+ * @brief Execute a dataflow graph on the calling thread.
+ *
+ * Operations are executed in a topological order.
+ */
+void
+archi_dexgraph_dataflow_execute(
+        archi_dexgraph_dataflow_t dataflow, ///< [in] Dataflow graph.
+        ARCHI_ERROR_PARAM_DECL ///< [out] Error.
+);
+
+/**
+ * @brief Get number of operations of a dataflow graph.
+ *
+ * @return Number of operations.
+ */
+size_t
+archi_dexgraph_dataflow_num_operations(
+        archi_dexgraph_dataflow_t dataflow ///< [in] Dataflow graph.
+);
+
+/**
+ * @brief Get number of dependencies of a dataflow graph.
+ *
+ * @return Number of dependencies.
+ */
+size_t
+archi_dexgraph_dataflow_num_dependencies(
+        archi_dexgraph_dataflow_t dataflow ///< [in] Dataflow graph.
+);
+
+#endif // _ARCHI_EXEC_API_DATAFLOW_FUN_H_
@@ -0,0 +1,54 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Types for dataflow graphs of operations.
+ */
+
+#pragma once
+#ifndef _ARCHI_EXEC_API_DATAFLOW_TYP_H_
+#define _ARCHI_EXEC_API_DATAFLOW_TYP_H_
+
+#include <stddef.h> // for size_t
+
+
+struct archi_dexgraph_dataflow;
+
+/**
+ * @brief Pointer to dataflow graph.
+ *
+ * A dataflow graph is a set of operations with declared dependencies between them.
+ * An operation is ready as soon as all operations it depends on are done,
+ * so independent operations can be executed concurrently by multiple threads.
+ */
+typedef struct archi_dexgraph_dataflow *archi_dexgraph_dataflow_t;
+
+/**
+ * @brief Dependency between operations of a dataflow graph.
+ *
+ * The operation cannot start until the dependency operation is done.
+ */
+typedef struct archi_dexgraph_dataflow_dependency {
+    size_t operation; ///< Index of the dependent operation.
+    size_t dependency; ///< Index of the operation it depends on.
+} archi_dexgraph_dataflow_dependency_t;
+
+#endif // _ARCHI_EXEC_API_DATAFLOW_TYP_H_
@@ -28,6 +28,8 @@
 #define _ARCHI_EXEC_API_GRAPH_FUN_H_
 
 #include "archi/exec/api/frame.typ.h"
+#include "archi/exec/api/profile.typ.h"
+#include "archi/exec/api/budget.typ.h"
 #include "archi_base/error.typ.h"
 
 
@@ -55,9 +57,10 @@ enum archi_dexgraph_exec_mode {
  * 5. update current node pointer and proceed to step 1 if the pointer is non-null, otherwise halt.
  *
  * Transitions to the next branch are done as follows:
- * 1. if transition function is not NULL, it is called with transition data to obtain branch index;
- * 2. otherwise, if transition data is not NULL, it is dereferenced to read branch index;
- * 3. in case both transition function and data are NULL, the default value of zero is used as branch index.
+ * 1. if transition kind is built-in, it is interpreted directly (see archi_dexgraph_transition_kind_t);
+ * 2. otherwise, if transition function is not NULL, it is called with transition data to obtain branch index;
+ * 3. otherwise, if transition data is not NULL, it is dereferenced to read branch index;
+ * 4. in case both transition function and data are NULL, the default value of zero is used as branch index.
  *
  * Output frame context is empty if execution halted without error.
  * Otherwise, it contains the current node pointer and sequence index of the function where error occured.
@@ -71,5 +74,48 @@ archi_dexgraph_execute(
         ARCHI_ERROR_PARAM_DECL ///< [out] Error.
 );
 
+/**
+ * @brief Execute a directed graph starting at the specified frame, collecting profile.
+ *
+ * Execution is identical to archi_dexgraph_execute(),
+ * but time of every operation and transition call is recorded to the profile.
+ * Profile entries that couldn't be allocated are not recorded.
+ *
+ * Profiling is available only if ARCHI_FEATURE_DEXGRAPH_PROFILE is defined,
+ * otherwise this function fails with ARCHI__ENOTIMPL.
+ * Plain archi_dexgraph_execute() is not affected by profiling in any case.
+ *
+ * @return Execution frame at the interruption point.
+ */
+archi_dexgraph_frame_t
+archi_dexgraph_execute_profiled(
+        archi_dexgraph_frame_t frame, ///< [in] Frame.
+        enum archi_dexgraph_exec_mode mode, ///< Execution mode.
+        archi_dexgraph_profile_t profile, ///< [in,out] Execution profile.
+        ARCHI_ERROR_PARAM_DECL ///< [out] Error.
+);
+
+/**
+ * @brief Execute a directed graph starting at the specified frame within a budget.
+ *
+ * Execution is identical to archi_dexgraph_execute(),
+ * but is also interrupted between operations once the budget is used up.
+ * Once the time limit is reached, execution is also interrupted after a node transition
+ * (at the beginning of the next node).
+ * The returned frame points to the next operation, so execution
+ * can be resumed exactly where it stopped by a subsequent call.
+ *
+ * Number of operation calls done is written to the budget structure.
+ *
+ * @return Execution frame at the interruption point.
+ */
+archi_dexgraph_frame_t
+archi_dexgraph_execute_budgeted(
+        archi_dexgraph_frame_t frame, ///< [in] Frame.
+        enum archi_dexgraph_exec_mode mode, ///< Execution mode.
+        archi_dexgraph_budget_t *budget, ///< [in,out] Execution budget.
+        ARCHI_ERROR_PARAM_DECL ///< [out] Error.
+);
+
 #endif // _ARCHI_EXEC_API_GRAPH_FUN_H_
 
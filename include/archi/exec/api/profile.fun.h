@@ -0,0 +1,99 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Directed execution graph profiling.
+ */
+
+#pragma once
+#ifndef _ARCHI_EXEC_API_PROFILE_FUN_H_
+#define _ARCHI_EXEC_API_PROFILE_FUN_H_
+
+#include "archi/exec/api/profile.typ.h"
+
+#include <stdbool.h>
+
+
+/**
+ * @brief Allocate an empty DEG execution profile.
+ *
+ * @note Profiles are not thread-safe, every executing thread needs its own profile.
+ *
+ * @return Newly allocated profile.
+ */
+archi_dexgraph_profile_t
+archi_dexgraph_profile_alloc(void);
+
+/**
+ * @brief Deallocate a DEG execution profile.
+ */
+void
+archi_dexgraph_profile_free(
+        archi_dexgraph_profile_t profile ///< [in] Profile.
+);
+
+/**
+ * @brief Remove all entries from a DEG execution profile.
+ */
+void
+archi_dexgraph_profile_reset(
+        archi_dexgraph_profile_t profile ///< [in] Profile.
+);
+
+/**
+ * @brief Record a call time into a DEG execution profile.
+ *
+ * A new entry is created if there is no entry for the node and index yet.
+ *
+ * @return True on success, false on memory allocation failure.
+ */
+bool
+archi_dexgraph_profile_record(
+        archi_dexgraph_profile_t profile, ///< [in] Profile.
+        const struct archi_dexgraph_node *node, ///< [in] Node.
+        size_t index, ///< [in] Operation function sequence index, or sequence length for transition.
+        uint64_t time_ns ///< [in] Call time in nanoseconds.
+);
+
+/**
+ * @brief Get number of entries in a DEG execution profile.
+ *
+ * @return Number of entries.
+ */
+size_t
+archi_dexgraph_profile_num_entries(
+        archi_dexgraph_profile_t profile ///< [in] Profile.
+);
+
+/**
+ * @brief Get DEG execution profile entries.
+ *
+ * Entries are stored in order of their first recording.
+ * The returned pointer is invalidated by subsequent recordings.
+ *
+ * @return Array of entries.
+ */
+const archi_dexgraph_profile_entry_t*
+archi_dexgraph_profile_entries(
+        archi_dexgraph_profile_t profile ///< [in] Profile.
+);
+
+#endif // _ARCHI_EXEC_API_PROFILE_FUN_H_
@@ -0,0 +1,58 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Types for directed execution graph profiling.
+ */
+
+#pragma once
+#ifndef _ARCHI_EXEC_API_PROFILE_TYP_H_
+#define _ARCHI_EXEC_API_PROFILE_TYP_H_
+
+#include <stddef.h> // for size_t
+#include <stdint.h> // for uint64_t
+
+
+struct archi_dexgraph_node;
+struct archi_dexgraph_profile;
+
+/**
+ * @brief Pointer to DEG execution profile.
+ */
+typedef struct archi_dexgraph_profile *archi_dexgraph_profile_t;
+
+/**
+ * @brief DEG execution profile entry.
+ *
+ * Index of an entry is a sequence index of the operation function,
+ * or node sequence length for the node transition.
+ */
+typedef struct archi_dexgraph_profile_entry {
+    const struct archi_dexgraph_node *node; ///< Node.
+    size_t index; ///< Operation function sequence index.
+
+    uint64_t num_calls; ///< Number of calls.
+    uint64_t total_ns; ///< Total time in nanoseconds.
+    uint64_t min_ns; ///< Minimum time of a call in nanoseconds.
+    uint64_t max_ns; ///< Maximum time of a call in nanoseconds.
+} archi_dexgraph_profile_entry_t;
+
+#endif // _ARCHI_EXEC_API_PROFILE_TYP_H_
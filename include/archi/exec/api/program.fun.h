@@ -0,0 +1,128 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Operations on compiled directed execution graph programs.
+ */
+
+#pragma once
+#ifndef _ARCHI_EXEC_API_PROGRAM_FUN_H_
+#define _ARCHI_EXEC_API_PROGRAM_FUN_H_
+
+#include "archi/exec/api/program.typ.h"
+#include "archi/exec/api/graph.fun.h"
+#include "archi/exec/api/node.typ.h"
+#include "archi_base/error.typ.h"
+
+
+/**
+ * @brief Compile a directed execution graph into a flat program.
+ *
+ * All nodes reachable from the entry node are laid out contiguously,
+ * the entry node being the first. Null operation functions are skipped.
+ * Null and out-of-range branches are resolved to ARCHI_DEXGRAPH_PROGRAM_END.
+ *
+ * @warning The program is a snapshot of the graph: operations, transitions,
+ * and branches modified after compilation are not reflected in the program.
+ * Operation and transition data are referenced, not copied.
+ *
+ * @return Compiled program.
+ */
+archi_dexgraph_program_t
+archi_dexgraph_program_compile(
+        const archi_dexgraph_node_t *entry, ///< [in] Entry node.
+        ARCHI_ERROR_PARAM_DECL ///< [out] Error.
+);
+
+/**
+ * @brief Destroy a compiled program.
+ */
+void
+archi_dexgraph_program_free(
+        archi_dexgraph_program_t program ///< [in] Program.
+);
+
+/**
+ * @brief Execute a compiled program starting at the specified position.
+ *
+ * The semantics are identical to archi_dexgraph_execute(),
+ * including the handling of transitions and execution modes.
+ *
+ * Output position is ARCHI_DEXGRAPH_PROGRAM_END if execution halted without error.
+ * Otherwise, it is the position of the instruction where error occured,
+ * or the position of the next instruction if execution was interrupted.
+ *
+ * @return Program position at the interruption point.
+ */
+archi_dexgraph_program_position_t
+archi_dexgraph_program_execute(
+        archi_dexgraph_program_t program, ///< [in] Program.
+        archi_dexgraph_program_position_t position, ///< [in] Initial position.
+        enum archi_dexgraph_exec_mode mode, ///< Execution mode.
+        ARCHI_ERROR_PARAM_DECL ///< [out] Error.
+);
+
+/**
+ * @brief Convert an execution frame to a program position.
+ *
+ * If the frame index points to a null operation function,
+ * the position of the next non-null operation (or node transition) is returned.
+ *
+ * @return Program position, or ARCHI_DEXGRAPH_PROGRAM_END if the node is not in the program.
+ */
+archi_dexgraph_program_position_t
+archi_dexgraph_program_position(
+        archi_dexgraph_program_t program, ///< [in] Program.
+        archi_dexgraph_frame_t frame ///< [in] Execution frame.
+);
+
+/**
+ * @brief Convert a program position to an execution frame.
+ *
+ * @return Execution frame, or empty frame if the position is out of program bounds.
+ */
+archi_dexgraph_frame_t
+archi_dexgraph_program_frame(
+        archi_dexgraph_program_t program, ///< [in] Program.
+        archi_dexgraph_program_position_t position ///< [in] Program position.
+);
+
+/**
+ * @brief Get number of instructions in a program.
+ *
+ * @return Number of instructions.
+ */
+size_t
+archi_dexgraph_program_length(
+        archi_dexgraph_program_t program ///< [in] Program.
+);
+
+/**
+ * @brief Get number of nodes a program was compiled from.
+ *
+ * @return Number of nodes.
+ */
+size_t
+archi_dexgraph_program_num_nodes(
+        archi_dexgraph_program_t program ///< [in] Program.
+);
+
+#endif // _ARCHI_EXEC_API_PROGRAM_FUN_H_
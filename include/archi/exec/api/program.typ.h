@@ -0,0 +1,55 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Types for compiled directed execution graph programs.
+ */
+
+#pragma once
+#ifndef _ARCHI_EXEC_API_PROGRAM_TYP_H_
+#define _ARCHI_EXEC_API_PROGRAM_TYP_H_
+
+#include <stddef.h> // for size_t
+
+
+struct archi_dexgraph_program;
+
+/**
+ * @brief Pointer to compiled directed execution graph program.
+ *
+ * A program is a flat array of instructions produced from a graph of nodes
+ * reachable from the entry node. Every node is laid out as its non-null
+ * operations followed by a single transition instruction,
+ * with branch targets pre-resolved to instruction positions.
+ */
+typedef struct archi_dexgraph_program *archi_dexgraph_program_t;
+
+/**
+ * @brief Position of an instruction in a program.
+ */
+typedef size_t archi_dexgraph_program_position_t;
+
+/**
+ * @brief Special program position value denoting halted execution.
+ */
+#define ARCHI_DEXGRAPH_PROGRAM_END  ((archi_dexgraph_program_position_t)-1)
+
+#endif // _ARCHI_EXEC_API_PROGRAM_TYP_H_
@@ -29,6 +29,9 @@
 
 #define ARCHI_POINTER_DATA_TAG__DEXGRAPH_NODE        0x30 ///< Data type tag for archi_dexgraph_node_t.
 #define ARCHI_POINTER_DATA_TAG__DEXGRAPH_NODE_ARRAY  0x31 ///< Data type tag for archi_dexgraph_node_array_t.
+#define ARCHI_POINTER_DATA_TAG__DEXGRAPH_PROGRAM     0x32 ///< Data type tag for archi_dexgraph_program_t.
+#define ARCHI_POINTER_DATA_TAG__DEXGRAPH_PROFILE     0x33 ///< Data type tag for archi_dexgraph_profile_t.
+#define ARCHI_POINTER_DATA_TAG__DEXGRAPH_DATAFLOW    0x34 ///< Data type tag for archi_dexgraph_dataflow_t.
 
 #define ARCHI_POINTER_FUNC_TAG__DEXGRAPH_OPERATION   0x30 ///< Function type tag for archi_dexgraph_operation_func_t.
 #define ARCHI_POINTER_FUNC_TAG__DEXGRAPH_TRANSITION  0x31 ///< Function type tag for archi_dexgraph_transition_func_t.
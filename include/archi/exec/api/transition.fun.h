@@ -0,0 +1,107 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Interpretation of built-in transition kinds.
+ */
+
+#pragma once
+#ifndef _ARCHI_EXEC_API_TRANSITION_FUN_H_
+#define _ARCHI_EXEC_API_TRANSITION_FUN_H_
+
+#include "archi/exec/api/transition.typ.h"
+
+#include <stdatomic.h> // for atomic_bool, atomic_load_explicit(), atomic_exchange_explicit()
+#include <stdbool.h>
+
+
+/**
+ * @brief Select a branch using a built-in transition kind.
+ *
+ * This function is inlined into DEG executors.
+ * Error is written only in case of failure, and left untouched otherwise.
+ *
+ * @return Index of the selected branch, or ARCHI_DEXGRAPH_HALT.
+ */
+static inline
+archi_dexgraph_branch_index_t
+archi_dexgraph_transition_builtin(
+        archi_dexgraph_transition_t transition, ///< [in] Transition of a built-in kind.
+        ARCHI_ERROR_PARAM_DECL ///< [out] Error.
+)
+{
+    if (transition.data == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "data of built-in transition (kind %i) is NULL",
+                (int)transition.kind);
+        return ARCHI_DEXGRAPH_HALT;
+    }
+
+    switch (transition.kind)
+    {
+        case ARCHI_DEXGRAPH_TRANSITION__LOOP:
+            {
+                archi_dexgraph_transition_loop_t *loop = transition.data;
+
+                if (loop->iteration + 1 < loop->num_iterations)
+                {
+                    // Do another iteration
+                    loop->iteration++;
+                    return 0;
+                }
+                else if (loop->num_iterations != 0)
+                {
+                    // Break the loop
+                    loop->iteration = 0;
+                    return 1;
+                }
+
+                ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "number of loop iterations cannot be zero");
+                return ARCHI_DEXGRAPH_HALT;
+            }
+
+        case ARCHI_DEXGRAPH_TRANSITION__SIGNAL_FLAG:
+            return atomic_load_explicit((atomic_bool*)transition.data, memory_order_relaxed) ? 1 : 0;
+
+        case ARCHI_DEXGRAPH_TRANSITION__SWITCH:
+            {
+                const archi_dexgraph_transition_switch_t *sw = transition.data;
+
+                if (sw->value == NULL)
+                {
+                    ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "switch value is NULL");
+                    return ARCHI_DEXGRAPH_HALT;
+                }
+
+                size_t value = *sw->value;
+                return (value < sw->table_size) ? sw->table[value] : sw->default_branch;
+            }
+
+        case ARCHI_DEXGRAPH_TRANSITION__ATOMIC_FLAG:
+            return atomic_exchange_explicit((atomic_bool*)transition.data, false, memory_order_acquire) ? 1 : 0;
+
+        default:
+            ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "unknown transition kind %i", (int)transition.kind);
+            return ARCHI_DEXGRAPH_HALT;
+    }
+}
+
+#endif // _ARCHI_EXEC_API_TRANSITION_FUN_H_
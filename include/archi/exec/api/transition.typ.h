@@ -56,13 +56,57 @@ typedef size_t archi_dexgraph_branch_index_t;
  */
 typedef ARCHI_DEXGRAPH_TRANSITION_FUNC((*archi_dexgraph_transition_func_t));
 
+/**
+ * @brief Kind of a transition.
+ *
+ * Built-in kinds are interpreted by executors directly, without calling a function.
+ * Transition function is ignored for built-in kinds, transition data must be non-null.
+ *
+ * Flag kinds select branch 1 if the flag is set, and branch 0 otherwise.
+ * Signal flags (archi_signal_flag_t) can be tested with the signal flag kind.
+ */
+typedef enum archi_dexgraph_transition_kind {
+    ARCHI_DEXGRAPH_TRANSITION__FUNCTION = 0, ///< Call transition function, or read branch index from data.
+    ARCHI_DEXGRAPH_TRANSITION__LOOP,         ///< Counted loop (archi_dexgraph_transition_loop_t).
+    ARCHI_DEXGRAPH_TRANSITION__SIGNAL_FLAG,  ///< Test a flag without clearing it (atomic_bool).
+    ARCHI_DEXGRAPH_TRANSITION__SWITCH,       ///< Integer switch via jump table (archi_dexgraph_transition_switch_t).
+    ARCHI_DEXGRAPH_TRANSITION__ATOMIC_FLAG,  ///< Test and clear a flag atomically (atomic_bool).
+} archi_dexgraph_transition_kind_t;
+
 /**
  * @brief Directed execution graph transition.
  */
 typedef struct archi_dexgraph_transition {
     archi_dexgraph_transition_func_t function; ///< Transition function.
     void *data; ///< Transition function data.
+    archi_dexgraph_transition_kind_t kind; ///< Transition kind.
 } archi_dexgraph_transition_t;
 
+/**
+ * @brief Transition data: counted loop.
+ *
+ * `iteration` is incremented on each iteration until it reaches `num_iterations`,
+ * selecting branch 0. Then, loop is broken selecting branch 1, and `iteration` is reset to zero.
+ */
+typedef struct archi_dexgraph_transition_loop {
+    size_t iteration; ///< Current iteration number.
+    size_t num_iterations; ///< Number of iterations to do.
+} archi_dexgraph_transition_loop_t;
+
+/**
+ * @brief Transition data: integer switch.
+ *
+ * Value is used as index in the table of branch indices.
+ * Default branch index is selected if the value is out of the table bounds.
+ */
+typedef struct archi_dexgraph_transition_switch {
+    const size_t *value; ///< Switch value.
+
+    const archi_dexgraph_branch_index_t *table; ///< Table of branch indices.
+    size_t table_size; ///< Number of entries in the table.
+
+    archi_dexgraph_branch_index_t default_branch; ///< Branch index for values out of table bounds.
+} archi_dexgraph_transition_switch_t;
+
 #endif // _ARCHI_EXEC_API_TRANSITION_TYP_H_
 
@@ -0,0 +1,56 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Context interface for dataflow graphs of operations.
+ */
+
+#pragma once
+#ifndef _ARCHI_EXEC_CTX_DATAFLOW_VAR_H_
+#define _ARCHI_EXEC_CTX_DATAFLOW_VAR_H_
+
+#include "archi/context/api/interface.typ.h"
+
+
+/**
+ * @brief Context interface: dataflow graph of operations.
+ *
+ * Operations are taken from the node sequence at initialization,
+ * so the node must be fully set up by then.
+ *
+ * Initialization parameters:
+ * - "node"         : (archi_dexgraph_node_t) node which sequence provides operations
+ * - "dependencies" : (archi_dexgraph_dataflow_dependency_t[]) array of dependencies between operations
+ *
+ * Getter slots:
+ * - "node"             : (archi_dexgraph_node_t) node which sequence provides operations
+ * - "num_operations"   : (size_t) number of operations
+ * - "num_dependencies" : (size_t) number of dependencies
+ *
+ * Calls:
+ * - "execute"  : execute the dataflow graph on the calling thread
+ *      returns: <nothing>
+ */
+extern
+const archi_context_interface_t
+archi_context_interface__dexgraph_dataflow;
+
+#endif // _ARCHI_EXEC_CTX_DATAFLOW_VAR_H_
@@ -38,6 +38,7 @@
  * - "sequence_length"  : (size_t) number of functions in the node sequence
  * - "transition_func"  : (archi_dexgraph_transition_func_t) transition function
  * - "transition_data"  : data of transition function
+ * - "transition_kind"  : (archi_dexgraph_transition_kind_t) transition kind
  * - "branches"         : (archi_dexgraph_node_array_t) array of branch nodes
  *
  * Getter slots:
@@ -47,6 +48,7 @@
  * - "sequence.data" [index]        : data of operation function #index
  * - "transition.function"          : (archi_dexgraph_transition_func_t) transition function
  * - "transition.data"              : data of transition function
+ * - "transition.kind"              : (archi_dexgraph_transition_kind_t) transition kind
  * - "branches"                     : (archi_dexgraph_node_array_t) array of branch nodes
  *
  * Calls:
@@ -54,12 +56,14 @@
  *      returns: <nothing>
  *      parameters:
  *      - "index"   : (archi_dexgraph_branch_index_t) initial operation function index
+ *      - "profile" : (archi_dexgraph_profile_t) execution profile to collect (optional)
  *
  * Setter slots:
  * - "sequence.function" [index]    : (archi_dexgraph_operation_func_t) operation function #index
  * - "sequence.data" [index]        : data of operation function #index
  * - "transition.function"          : (archi_dexgraph_transition_func_t) transition function
  * - "transition.data"              : data of transition function
+ * - "transition.kind"              : (archi_dexgraph_transition_kind_t) transition kind
  * - "branches"                     : (archi_dexgraph_node_array_t) array of branch nodes
  */
 extern
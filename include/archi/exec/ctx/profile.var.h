@@ -0,0 +1,50 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Context interface for DEG execution profiles.
+ */
+
+#pragma once
+#ifndef _ARCHI_EXEC_CTX_PROFILE_VAR_H_
+#define _ARCHI_EXEC_CTX_PROFILE_VAR_H_
+
+#include "archi/context/api/interface.typ.h"
+
+
+/**
+ * @brief Context interface: DEG execution profile.
+ *
+ * Initialization parameters:
+ *   <no parameters>
+ *
+ * Getter slots:
+ * - "num_entries"  : (size_t) number of profile entries
+ *
+ * Calls:
+ * - "reset" : remove all profile entries
+ *   <no parameters>
+ */
+extern
+const archi_context_interface_t
+archi_context_interface__dexgraph_profile;
+
+#endif // _ARCHI_EXEC_CTX_PROFILE_VAR_H_
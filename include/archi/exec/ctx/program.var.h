@@ -0,0 +1,57 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Context interface for compiled directed execution graph programs.
+ */
+
+#pragma once
+#ifndef _ARCHI_EXEC_CTX_PROGRAM_VAR_H_
+#define _ARCHI_EXEC_CTX_PROGRAM_VAR_H_
+
+#include "archi/context/api/interface.typ.h"
+
+
+/**
+ * @brief Context interface: compiled directed execution graph program.
+ *
+ * The graph is compiled at initialization, so all nodes reachable
+ * from the entry node must be fully set up by then.
+ *
+ * Initialization parameters:
+ * - "entry"    : (archi_dexgraph_node_t) entry node
+ *
+ * Getter slots:
+ * - "entry"        : (archi_dexgraph_node_t) entry node
+ * - "length"       : (size_t) number of program instructions
+ * - "num_nodes"    : (size_t) number of compiled nodes
+ *
+ * Calls:
+ * - "execute"  : execute the program
+ *      returns: <nothing>
+ *      parameters:
+ *      - "position"    : (archi_dexgraph_program_position_t) initial program position
+ */
+extern
+const archi_context_interface_t
+archi_context_interface__dexgraph_program;
+
+#endif // _ARCHI_EXEC_CTX_PROGRAM_VAR_H_
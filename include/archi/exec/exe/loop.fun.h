@@ -38,6 +38,9 @@
  * `iteration` is incremented on each iteration until it reaches `num_iterations`.
  * Then, loop is broken and `iteration` is reset to zero.
  *
+ * The built-in transition kind ARCHI_DEXGRAPH_TRANSITION__LOOP does the same
+ * without a function call.
+ *
  * @return 0 if a loop continues, 1 if a loop is broken.
  */
 ARCHI_DEXGRAPH_TRANSITION_FUNC(archi_dexgraph_transition__loop_times);
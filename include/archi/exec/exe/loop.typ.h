@@ -27,16 +27,15 @@
 #ifndef _ARCHI_EXEC_EXE_LOOP_TYP_H_
 #define _ARCHI_EXEC_EXE_LOOP_TYP_H_
 
-#include <stddef.h> // for size_t
+#include "archi/exec/api/transition.typ.h"
 
 
 /**
  * @brief Transition function data: loop N times.
+ *
+ * Data layout is shared with the built-in loop transition kind.
  */
-typedef struct archi_dexgraph_transition_data__loop_times {
-    size_t iteration; ///< Current iteration number.
-    size_t num_iterations; ///< Number of iterations to do.
-} archi_dexgraph_transition_data__loop_times_t;
+typedef archi_dexgraph_transition_loop_t archi_dexgraph_transition_data__loop_times_t;
 
 #endif // _ARCHI_EXEC_EXE_LOOP_TYP_H_
 
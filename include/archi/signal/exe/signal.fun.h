@@ -49,6 +49,9 @@ archi_dexgraph_transition_data__signal_detect_alloc(
  *
  * Function data type: archi_dexgraph_transition_data__signal_detect_t.
  *
+ * A single signal flag can be tested without a function call
+ * using the built-in transition kind ARCHI_DEXGRAPH_TRANSITION__SIGNAL_FLAG.
+ *
  * @return 0 if none of the signal flags is set, specified branch index otherwise.
  */
 ARCHI_DEXGRAPH_TRANSITION_FUNC(archi_dexgraph_transition__signal_detect);
@@ -37,6 +37,13 @@ extern
 const archi_aggr_type_t
 archi_aggr_type__thread_group_work;
 
+/**
+ * @brief Aggregate type description for archi_thread_group_tile_work_t.
+ */
+extern
+const archi_aggr_type_t
+archi_aggr_type__thread_group_tile_work;
+
 /**
  * @brief Aggregate type description for archi_thread_group_callback_t.
  */
@@ -58,5 +65,82 @@ extern
 const archi_aggr_type_t
 archi_aggr_type__dexgraph_op_data__thread_group_dispatch;
 
+/**
+ * @brief Aggregate type description for archi_thread_group_tiled_dispatch_params_t.
+ */
+extern
+const archi_aggr_type_t
+archi_aggr_type__thread_group_tiled_dispatch_params;
+
+/**
+ * @brief Aggregate type description for archi_dexgraph_op_data__thread_group_dispatch_tiled_t.
+ */
+extern
+const archi_aggr_type_t
+archi_aggr_type__dexgraph_op_data__thread_group_dispatch_tiled;
+
+/**
+ * @brief Aggregate type description for archi_thread_group_reduction_t.
+ */
+extern
+const archi_aggr_type_t
+archi_aggr_type__thread_group_reduction;
+
+/**
+ * @brief Aggregate type description for archi_dexgraph_op_data__thread_group_dispatch_reduce_t.
+ */
+extern
+const archi_aggr_type_t
+archi_aggr_type__dexgraph_op_data__thread_group_dispatch_reduce;
+
+/**
+ * @brief Aggregate type description for archi_thread_group_phase_work_t.
+ */
+extern
+const archi_aggr_type_t
+archi_aggr_type__thread_group_phase_work;
+
+/**
+ * @brief Aggregate type description for archi_dexgraph_op_data__thread_group_dispatch_phased_t.
+ */
+extern
+const archi_aggr_type_t
+archi_aggr_type__dexgraph_op_data__thread_group_dispatch_phased;
+
+/**
+ * @brief Aggregate type description for archi_dexgraph_op_data__thread_group_enqueue_t.
+ */
+extern
+const archi_aggr_type_t
+archi_aggr_type__dexgraph_op_data__thread_group_enqueue;
+
+/**
+ * @brief Aggregate type description for archi_dexgraph_op_data__thread_group_cancel_t.
+ */
+extern
+const archi_aggr_type_t
+archi_aggr_type__dexgraph_op_data__thread_group_cancel;
+
+/**
+ * @brief Aggregate type description for archi_dexgraph_op_data__thread_group_wait_ticket_t.
+ */
+extern
+const archi_aggr_type_t
+archi_aggr_type__dexgraph_op_data__thread_group_wait_ticket;
+
+/**
+ * @brief Aggregate type description for archi_dexgraph_op_data__thread_group_fork_join_t.
+ */
+extern
+const archi_aggr_type_t
+archi_aggr_type__dexgraph_op_data__thread_group_fork_join;
+
+/**
+ * @brief Aggregate type description for archi_dexgraph_op_data__thread_group_dataflow_t.
+ */
+extern
+const archi_aggr_type_t
+archi_aggr_type__dexgraph_op_data__thread_group_dataflow;
+
 #endif // _ARCHI_THREAD_AGG_THREAD_GROUP_VAR_H_
 
@@ -34,6 +34,8 @@
  * @brief Signature of a concurrent work completion callback.
  *
  * This function is called when all work items have been complete.
+ * If the work has been cancelled, the work size is the number of actually processed work items
+ * (which are not necessarily contiguous).
  */
 #define ARCHI_THREAD_GROUP_CALLBACK_FUNC(func_name)     void func_name( \
         void *data, /* [in] Callback data. */                           \
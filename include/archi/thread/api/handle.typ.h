@@ -32,6 +32,8 @@
 
 struct archi_thread_group;
 struct archi_thread_lfqueue;
+struct archi_thread_scheduler;
+struct archi_thread_pipeline;
 
 /**
  * @brief Pointer to thread group context.
@@ -43,5 +45,15 @@ typedef struct archi_thread_group *archi_thread_group_t;
  */
 typedef struct archi_thread_lfqueue *archi_thread_lfqueue_t;
 
+/**
+ * @brief Pointer to DEG frame scheduler.
+ */
+typedef struct archi_thread_scheduler *archi_thread_scheduler_t;
+
+/**
+ * @brief Pointer to pipeline of DEG stages.
+ */
+typedef struct archi_thread_pipeline *archi_thread_pipeline_t;
+
 #endif // _ARCHI_THREAD_API_HANDLE_TYP_H_
 
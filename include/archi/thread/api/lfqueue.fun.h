@@ -79,6 +79,44 @@ archi_thread_lfqueue_pop(
         ARCHI_ERROR_PARAM_DECL ///< [out] Error.
 );
 
+/**
+ * @brief Push multiple values to lock-free queue.
+ *
+ * Values are pushed in order, as a single contiguous run of queue slots
+ * reserved at once, so they are not interleaved with values of concurrent pushes.
+ * If the queue doesn't have enough free slots, only the first values are pushed.
+ *
+ * `values` may be NULL if `num_values` is zero.
+ *
+ * @return Number of pushed values (0 if queue was full).
+ */
+size_t
+archi_thread_lfqueue_push_n(
+        archi_thread_lfqueue_t queue, ///< [in] Queue to push values to.
+        const void *values, ///< [in] Array of pushed values.
+        size_t num_values, ///< [in] Number of values to push.
+        ARCHI_ERROR_PARAM_DECL ///< [out] Error.
+);
+
+/**
+ * @brief Pop multiple values from lock-free queue.
+ *
+ * Values are popped in order, as a single contiguous run of queue slots
+ * reserved at once.
+ * If the queue doesn't have enough values, only the available ones are popped.
+ *
+ * `values` may be NULL.
+ *
+ * @return Number of popped values (0 if queue was empty).
+ */
+size_t
+archi_thread_lfqueue_pop_n(
+        archi_thread_lfqueue_t queue, ///< [in] Queue to pop values from.
+        void *values, ///< [out] Memory to write popped values to.
+        size_t num_values, ///< [in] Maximum number of values to pop.
+        ARCHI_ERROR_PARAM_DECL ///< [out] Error.
+);
+
 /**
  * @brief Get queue capacity.
  *
@@ -0,0 +1,146 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Operations with pipelines of DEG stages.
+ */
+
+#pragma once
+#ifndef _ARCHI_THREAD_API_PIPELINE_FUN_H_
+#define _ARCHI_THREAD_API_PIPELINE_FUN_H_
+
+#include "archi/thread/api/handle.typ.h"
+#include "archi/thread/api/pipeline.typ.h"
+#include "archi_base/error.typ.h"
+
+#include <stdbool.h>
+
+
+/**
+ * @brief Create a pipeline of DEG stages.
+ *
+ * A pipeline runs every stage on its own dedicated thread, so that stages
+ * process consecutive work items simultaneously. Stages pass work items
+ * through lock-free queues: a stage waits while its output queue is full (backpressure),
+ * and while its input queue is empty. A waiting stage spins for the configured time,
+ * then sleeps until the queue is pushed or popped by another stage.
+ * Queues operated on outside of the pipeline are polled while sleeping.
+ *
+ * Stages are initially empty, they must be set before a pipeline is started.
+ * Threads wait until a pipeline is started.
+ *
+ * @return Pipeline.
+ */
+archi_thread_pipeline_t
+archi_thread_pipeline_create(
+        archi_thread_pipeline_start_params_t params, ///< [in] Pipeline creation parameters.
+        ARCHI_ERROR_PARAM_DECL ///< [out] Error.
+);
+
+/**
+ * @brief Stop, wait, join threads and destroy a pipeline.
+ */
+void
+archi_thread_pipeline_destroy(
+        archi_thread_pipeline_t pipeline ///< [in] Pipeline.
+);
+
+/**
+ * @brief Set a pipeline stage.
+ *
+ * Stages cannot be changed while a pipeline is running.
+ */
+void
+archi_thread_pipeline_set_stage(
+        archi_thread_pipeline_t pipeline, ///< [in] Pipeline.
+        size_t index, ///< [in] Stage index.
+        archi_thread_pipeline_stage_t stage, ///< [in] Stage.
+        ARCHI_ERROR_PARAM_DECL ///< [out] Error.
+);
+
+/**
+ * @brief Get a pipeline stage.
+ *
+ * @return Stage, or empty stage if the index is out of bounds.
+ */
+archi_thread_pipeline_stage_t
+archi_thread_pipeline_get_stage(
+        archi_thread_pipeline_t pipeline, ///< [in] Pipeline.
+        size_t index ///< [in] Stage index.
+);
+
+/**
+ * @brief Start a pipeline.
+ *
+ * Source stages produce work items until the pipeline is stopped.
+ * A stage with input queue finishes when its input queue is empty and all stages
+ * pushing to that queue have finished (or, if there are no such stages,
+ * when the pipeline is stopped). Thus, stopping a pipeline drains it.
+ *
+ * If a stage fails, all stages finish as soon as possible.
+ *
+ * @return True if the pipeline has been started, false if it is already running.
+ */
+bool
+archi_thread_pipeline_start(
+        archi_thread_pipeline_t pipeline, ///< [in] Pipeline.
+        ARCHI_ERROR_PARAM_DECL ///< [out] Error.
+);
+
+/**
+ * @brief Request a pipeline to stop.
+ *
+ * Source stages finish after the current iteration.
+ * Work item produced by a source stage in the iteration during which
+ * the stop request came is discarded, so a source stage subgraph can end the stream
+ * by stopping the pipeline itself.
+ *
+ * After the stop request, a stage that can't push a work item to a full queue
+ * popped outside of the pipeline discards the item instead of waiting for free space.
+ */
+void
+archi_thread_pipeline_stop(
+        archi_thread_pipeline_t pipeline ///< [in] Pipeline.
+);
+
+/**
+ * @brief Wait until all stages of a pipeline are finished.
+ *
+ * If the pipeline is not running, the function returns immediately.
+ * Reports the error of the first failed stage, if any.
+ */
+void
+archi_thread_pipeline_wait(
+        archi_thread_pipeline_t pipeline, ///< [in] Pipeline.
+        ARCHI_ERROR_PARAM_DECL ///< [out] Error.
+);
+
+/**
+ * @brief Get number of stages of a pipeline.
+ *
+ * @return Number of stages.
+ */
+size_t
+archi_thread_pipeline_num_stages(
+        archi_thread_pipeline_t pipeline ///< [in] Pipeline.
+);
+
+#endif // _ARCHI_THREAD_API_PIPELINE_FUN_H_
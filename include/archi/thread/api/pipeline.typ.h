@@ -0,0 +1,69 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Types for pipelines of DEG stages.
+ */
+
+#pragma once
+#ifndef _ARCHI_THREAD_API_PIPELINE_TYP_H_
+#define _ARCHI_THREAD_API_PIPELINE_TYP_H_
+
+#include "archi/thread/api/handle.typ.h"
+#include "archi/exec/api/node.typ.h"
+
+#include <stddef.h> // for size_t
+#include <stdint.h> // for uint64_t
+
+
+/**
+ * @brief Pipeline stage.
+ *
+ * Every iteration of a stage pops a work item from the input queue into the item buffer,
+ * executes the stage subgraph starting at the entry node, and pushes the work item
+ * from the item buffer to the output queue.
+ *
+ * The item buffer must be large enough for elements of both queues.
+ * Operations of the stage subgraph are expected to refer to the item buffer.
+ *
+ * A stage without input queue is a source stage, it produces a work item per iteration.
+ * A stage without output queue is a sink stage, it consumes work items.
+ * A stage without entry node passes work items through unchanged.
+ */
+typedef struct archi_thread_pipeline_stage {
+    const archi_dexgraph_node_t *entry; ///< Entry node of the stage subgraph.
+
+    archi_thread_lfqueue_t input; ///< Queue to pop work items from.
+    archi_thread_lfqueue_t output; ///< Queue to push work items to.
+
+    void *item; ///< Buffer for the current work item.
+} archi_thread_pipeline_stage_t;
+
+/**
+ * @brief Pipeline creation parameters.
+ */
+typedef struct archi_thread_pipeline_start_params {
+    size_t num_stages; ///< Number of stages (and threads) to create.
+
+    uint64_t spin_ns; ///< Time to spin before sleeping on a queue in nanoseconds (0 = sleep immediately).
+} archi_thread_pipeline_start_params_t;
+
+#endif // _ARCHI_THREAD_API_PIPELINE_TYP_H_
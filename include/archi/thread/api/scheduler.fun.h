@@ -0,0 +1,125 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Scheduling of directed execution graph frames.
+ */
+
+#pragma once
+#ifndef _ARCHI_THREAD_API_SCHEDULER_FUN_H_
+#define _ARCHI_THREAD_API_SCHEDULER_FUN_H_
+
+#include "archi/thread/api/handle.typ.h"
+#include "archi/thread/api/scheduler.typ.h"
+#include "archi/exec/api/frame.typ.h"
+#include "archi_base/error.typ.h"
+
+#include <stdbool.h>
+
+
+/**
+ * @brief Create a scheduler of DEG frames.
+ *
+ * A scheduler multiplexes many tasks (DEG execution frames) over a pool of worker threads.
+ * Every worker has its own work-stealing deque of tasks; tasks submitted
+ * from outside of the scheduler and yielded tasks are put into a shared injection queue.
+ * Idle workers take tasks from their own deque, then from the injection queue,
+ * then steal from other workers, and sleep if there is nothing to do.
+ *
+ * Tasks are executed cooperatively: a task runs until it halts, fails, or yields.
+ *
+ * @return Scheduler.
+ */
+archi_thread_scheduler_t
+archi_thread_scheduler_create(
+        archi_thread_scheduler_start_params_t params, ///< [in] Scheduler creation parameters.
+        ARCHI_ERROR_PARAM_DECL ///< [out] Error.
+);
+
+/**
+ * @brief Stop worker threads and destroy a scheduler.
+ *
+ * Tasks that are running finish their current execution slice,
+ * tasks that are not running are discarded.
+ */
+void
+archi_thread_scheduler_destroy(
+        archi_thread_scheduler_t scheduler ///< [in] Scheduler.
+);
+
+/**
+ * @brief Submit a task to a scheduler.
+ *
+ * If called from a worker thread of the same scheduler,
+ * the task is pushed to the deque of the calling worker.
+ *
+ * @return True if the task has been submitted, false if the maximum number of tasks is reached.
+ */
+bool
+archi_thread_scheduler_submit(
+        archi_thread_scheduler_t scheduler, ///< [in] Scheduler.
+        archi_dexgraph_frame_t frame, ///< [in] Initial execution frame of the task.
+        ARCHI_ERROR_PARAM_DECL ///< [out] Error.
+);
+
+/**
+ * @brief Request the current task to yield.
+ *
+ * The request takes effect at the next node transition of the task,
+ * after which the task is put to the end of the injection queue and resumed later.
+ * Calls outside of scheduler worker threads are ignored.
+ */
+void
+archi_thread_scheduler_yield(void);
+
+/**
+ * @brief Wait until all submitted tasks are finished.
+ *
+ * Reports the error of the first task failed since the previous wait, if any.
+ * Failed tasks are removed from the scheduler.
+ */
+void
+archi_thread_scheduler_wait(
+        archi_thread_scheduler_t scheduler, ///< [in] Scheduler.
+        ARCHI_ERROR_PARAM_DECL ///< [out] Error.
+);
+
+/**
+ * @brief Get number of worker threads of a scheduler.
+ *
+ * @return Number of worker threads.
+ */
+size_t
+archi_thread_scheduler_num_threads(
+        archi_thread_scheduler_t scheduler ///< [in] Scheduler.
+);
+
+/**
+ * @brief Get number of unfinished tasks of a scheduler.
+ *
+ * @return Number of unfinished tasks.
+ */
+size_t
+archi_thread_scheduler_num_tasks(
+        archi_thread_scheduler_t scheduler ///< [in] Scheduler.
+);
+
+#endif // _ARCHI_THREAD_API_SCHEDULER_FUN_H_
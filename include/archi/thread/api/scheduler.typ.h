@@ -0,0 +1,44 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Types for scheduling of directed execution graph frames.
+ */
+
+#pragma once
+#ifndef _ARCHI_THREAD_API_SCHEDULER_TYP_H_
+#define _ARCHI_THREAD_API_SCHEDULER_TYP_H_
+
+#include <stddef.h> // for size_t
+
+
+/**
+ * @brief Scheduler creation parameters.
+ *
+ * Maximum number of tasks is limited by lock-free queue capacity
+ * (half of the maximum supported capacity, see archi_thread_lfqueue_alloc_params_t).
+ */
+typedef struct archi_thread_scheduler_start_params {
+    size_t num_threads; ///< Number of worker threads to create.
+    size_t max_tasks; ///< Maximum number of simultaneously scheduled tasks.
+} archi_thread_scheduler_start_params_t;
+
+#endif // _ARCHI_THREAD_API_SCHEDULER_TYP_H_
@@ -29,9 +29,15 @@
 
 #define ARCHI_POINTER_DATA_TAG__THREAD_GROUP        0x40 ///< Data type tag for archi_thread_group_t.
 #define ARCHI_POINTER_DATA_TAG__THREAD_LFQUEUE      0x41 ///< Data type tag for archi_thread_lfqueue_t.
+#define ARCHI_POINTER_DATA_TAG__THREAD_SCHEDULER    0x42 ///< Data type tag for archi_thread_scheduler_t.
+#define ARCHI_POINTER_DATA_TAG__THREAD_PIPELINE     0x43 ///< Data type tag for archi_thread_pipeline_t.
 
 #define ARCHI_POINTER_FUNC_TAG__THREAD_WORK         0x40 ///< Function type tag for archi_thread_group_work_func_t.
 #define ARCHI_POINTER_FUNC_TAG__THREAD_CALLBACK     0x41 ///< Function type tag for archi_thread_group_callback_func_t.
+#define ARCHI_POINTER_FUNC_TAG__THREAD_TILE_WORK    0x42 ///< Function type tag for archi_thread_group_tile_work_func_t.
+#define ARCHI_POINTER_FUNC_TAG__THREAD_REDUCE       0x43 ///< Function type tag for archi_thread_group_reduce_func_t.
+#define ARCHI_POINTER_FUNC_TAG__THREAD_COMBINE      0x44 ///< Function type tag for archi_thread_group_combine_func_t.
+#define ARCHI_POINTER_FUNC_TAG__THREAD_PHASE_WORK   0x45 ///< Function type tag for archi_thread_group_phase_work_func_t.
 
 #endif // _ARCHI_THREAD_API_TAG_DEF_H_
 
@@ -64,12 +64,15 @@ archi_thread_group_destroy(
 /**
  * @brief Assign work to a thread group.
  *
- * If value of batch_size is zero, it is replaced with ((work.size - 1) / num_threads) + 1.
- * With this batch size pfunc is called no more than once per thread.
+ * If value of batch_size is zero, it is replaced depending on the scheduling policy.
+ * With the shared counter policy, it is replaced with ((work.size - 1) / num_threads) + 1,
+ * so that pfunc is called no more than once per thread.
  *
  * When all work items are done, the callback function is called from one of the threads
  * (the last one to finish).
  *
+ * Work is assigned only if the thread group is idle, i.e. all enqueued work tasks are completed.
+ *
  * @return True if work has been assigned, false otherwise.
  */
 bool
@@ -84,7 +87,133 @@ archi_thread_group_dispatch(
 );
 
 /**
- * @brief Wait until work task completion.
+ * @brief Assign work to a thread group and take part in processing it.
+ *
+ * The function works as archi_thread_group_dispatch(), but the calling thread
+ * also processes work items as one more thread of the group (with index equal to
+ * the number of threads), then waits for the remaining threads to finish.
+ * Batch sizes and per-thread ranges are computed for the number of threads plus one.
+ *
+ * The callback function may be called from the calling thread.
+ * The function returns after the work and the callback are finished.
+ *
+ * @return True if work has been assigned and done, false otherwise.
+ */
+bool
+archi_thread_group_dispatch_help(
+        archi_thread_group_t thread_group, ///< [in] Thread group.
+
+        archi_thread_group_work_t work, ///< [in] Concurrent work task.
+        archi_thread_group_callback_t callback, ///< [in] Concurrent work completion callback.
+
+        archi_thread_group_dispatch_params_t params, ///< [in] Dispatch parameters.
+        ARCHI_ERROR_PARAM_DECL ///< [out] Error.
+);
+
+/**
+ * @brief Enqueue work to a thread group.
+ *
+ * Enqueued work tasks are processed in order, and complete in order.
+ * A thread that has finished its share of a work task proceeds to the next one
+ * without waiting for other threads, unless the next task depends on an incomplete one.
+ * A task with a dependency is not started until the specified task is completed
+ * (including its callback).
+ *
+ * Batch size and callback are treated as by archi_thread_group_dispatch().
+ * If the thread group has no threads, work is done in the calling thread immediately.
+ *
+ * @return Ticket of the enqueued task (starting from 1),
+ * or 0 if the queue is full or the function failed.
+ */
+size_t
+archi_thread_group_enqueue(
+        archi_thread_group_t thread_group, ///< [in] Thread group.
+
+        archi_thread_group_work_t work, ///< [in] Concurrent work task.
+        archi_thread_group_callback_t callback, ///< [in] Concurrent work completion callback.
+
+        archi_thread_group_dispatch_params_t params, ///< [in] Dispatch parameters.
+        size_t after, ///< [in] Ticket of the task to complete before starting this one (0 = none).
+        ARCHI_ERROR_PARAM_DECL ///< [out] Error.
+);
+
+/**
+ * @brief Assign tiled work over a multi-dimensional domain to a thread group.
+ *
+ * The domain is split into tiles, and the work function is called for each tile
+ * with its coordinates and element range.
+ *
+ * The callback function receives the range of linearized tile indices [0; N),
+ * where N may exceed the number of tiles for Morton order due to padding.
+ *
+ * @return True if work has been assigned, false otherwise.
+ */
+bool
+archi_thread_group_dispatch_tiled(
+        archi_thread_group_t thread_group, ///< [in] Thread group.
+
+        archi_thread_group_tile_work_t work, ///< [in] Concurrent tile work task.
+        archi_thread_group_callback_t callback, ///< [in] Concurrent work completion callback.
+
+        archi_thread_group_tiled_dispatch_params_t params, ///< [in] Tiled dispatch parameters.
+        ARCHI_ERROR_PARAM_DECL ///< [out] Error.
+);
+
+/**
+ * @brief Assign a reduction to a thread group.
+ *
+ * Every participating thread has a separate accumulator padded to a cache line,
+ * which is initialized with the identity value before processing.
+ * The accumulation function is called for each work item with the accumulator of the calling thread.
+ * When all work items are done, the last thread combines the accumulators pairwise
+ * in a tree order, writes the result, and then calls the callback function.
+ *
+ * Batch size and scheduling policy are treated as by archi_thread_group_dispatch().
+ * If work size is zero, the identity value is written to the result location.
+ *
+ * @return True if work has been assigned, false otherwise.
+ */
+bool
+archi_thread_group_dispatch_reduce(
+        archi_thread_group_t thread_group, ///< [in] Thread group.
+
+        archi_thread_group_reduction_t reduction, ///< [in] Concurrent reduction task.
+        archi_thread_group_callback_t callback, ///< [in] Concurrent work completion callback.
+
+        archi_thread_group_dispatch_params_t params, ///< [in] Dispatch parameters.
+        ARCHI_ERROR_PARAM_DECL ///< [out] Error.
+);
+
+/**
+ * @brief Assign multi-phase work to a thread group.
+ *
+ * The work function is called for every work item in every phase.
+ * Threads wait on a spinning barrier between phases instead of going to sleep,
+ * so phases are cheaper than separate dispatches.
+ * Work items of a phase are distributed according to the scheduling policy anew.
+ *
+ * When all phases are done, the callback function is called from one of the threads.
+ * If the work task is cancelled, no further phases are started,
+ * and the callback receives the number of processed work items of the last phase.
+ *
+ * @warning Work functions must not wait for other threads of the group,
+ * as every participating thread must reach the barrier.
+ *
+ * @return True if work has been assigned, false otherwise.
+ */
+bool
+archi_thread_group_dispatch_phased(
+        archi_thread_group_t thread_group, ///< [in] Thread group.
+
+        archi_thread_group_phase_work_t work, ///< [in] Concurrent multi-phase work task.
+        archi_thread_group_callback_t callback, ///< [in] Concurrent work completion callback.
+
+        archi_thread_group_dispatch_params_t params, ///< [in] Dispatch parameters.
+        ARCHI_ERROR_PARAM_DECL ///< [out] Error.
+);
+
+/**
+ * @brief Wait until completion of all enqueued work tasks.
  *
  * If thread group is not busy, the function returns immediately.
  */
@@ -94,7 +223,7 @@ archi_thread_group_wait(
 );
 
 /**
- * @brief Wait until work task completion or timeout.
+ * @brief Wait until completion of all enqueued work tasks or timeout.
  *
  * If `time_point` is NULL, the wait time is unbounded as by using `archi_thread_group_wait()`.
  *
@@ -106,6 +235,159 @@ archi_thread_group_wait_until(
         const struct timespec *time_point  ///< [in] TIME_UTC based time point of timeout.
 );
 
+/**
+ * @brief Wait until completion of the work task with the specified ticket or timeout.
+ *
+ * If `time_point` is NULL, the wait time is unbounded.
+ *
+ * If the work task is already completed, the function returns immediately.
+ */
+void
+archi_thread_group_wait_ticket(
+        archi_thread_group_t thread_group, ///< [in] Thread group.
+        size_t ticket, ///< [in] Ticket of a work task.
+        const struct timespec *time_point  ///< [in] TIME_UTC based time point of timeout.
+);
+
+/**
+ * @brief Cancel an enqueued work task.
+ *
+ * Cancellation is cooperative: threads stop processing work items of a cancelled task
+ * between batches, so work items of already acquired batches are finished.
+ * The callback function is still called, and receives the number of actually processed
+ * work items as the work size.
+ *
+ * Ticket 0 cancels all enqueued work tasks that are not completed yet.
+ * Completed work tasks and tasks of thread groups with no threads are not affected.
+ */
+void
+archi_thread_group_cancel(
+        archi_thread_group_t thread_group, ///< [in] Thread group.
+        size_t ticket ///< [in] Ticket of a work task (0 = all incomplete tasks).
+);
+
+/**
+ * @brief Cancel the work task processed by the calling thread.
+ *
+ * The function is intended to be called from work functions,
+ * e.g. when the answer is found or an error has occurred.
+ * Cancellation is treated as by archi_thread_group_cancel().
+ *
+ * If the calling thread is not processing a work task, the function does nothing.
+ */
+void
+archi_thread_group_cancel_current_dispatch(void);
+
+/**
+ * @brief Check if the work task processed by the calling thread is cancelled.
+ *
+ * Work functions with long-running work items may use this to exit early.
+ *
+ * @return True if the work task is cancelled, false otherwise.
+ */
+bool
+archi_thread_group_current_dispatch_cancelled(void);
+
+/**
+ * @brief Allocate memory from the scratch arena of the calling thread.
+ *
+ * The function is intended to be called from work and callback functions.
+ * Scratch arena of a thread is reset before the thread starts processing a work task,
+ * so allocated memory stays valid until the thread finishes its share of the task.
+ *
+ * Alignment must be a power of two, zero alignment means 1.
+ *
+ * @return Pointer to allocated memory, or NULL if the calling thread has no scratch arena,
+ * the arena doesn't have enough free space, or the alignment is incorrect.
+ */
+void*
+archi_thread_group_scratch_alloc(
+        size_t num_bytes, ///< [in] Number of bytes to allocate.
+        size_t alignment  ///< [in] Alignment requirement.
+);
+
+/**
+ * @brief Get the current position of the scratch arena of the calling thread.
+ *
+ * @return Number of used bytes of the arena.
+ */
+size_t
+archi_thread_group_scratch_mark(void);
+
+/**
+ * @brief Release scratch arena memory allocated after the specified position.
+ */
+void
+archi_thread_group_scratch_rewind(
+        size_t mark ///< [in] Position obtained from archi_thread_group_scratch_mark().
+);
+
+/**
+ * @brief Get utilization statistics of a thread group.
+ *
+ * @return True if statistics are collected, false otherwise.
+ */
+bool
+archi_thread_group_stats(
+        archi_thread_group_t thread_group, ///< [in] Thread group.
+        archi_thread_group_stats_t *stats ///< [out] Statistics.
+);
+
+/**
+ * @brief Get utilization statistics of a thread of a group.
+ *
+ * Thread index equal to the number of threads denotes threads
+ * helping the group, see archi_thread_group_dispatch_help().
+ *
+ * @return True if statistics are collected and the thread index is valid, false otherwise.
+ */
+bool
+archi_thread_group_thread_stats(
+        archi_thread_group_t thread_group, ///< [in] Thread group.
+        size_t thread_idx, ///< [in] Index of a thread.
+        archi_thread_group_thread_stats_t *stats ///< [out] Statistics.
+);
+
+/**
+ * @brief Reset utilization statistics of a thread group and its threads.
+ *
+ * Counters updated concurrently may be reset incompletely.
+ */
+void
+archi_thread_group_stats_reset(
+        archi_thread_group_t thread_group ///< [in] Thread group.
+);
+
+/**
+ * @brief Get the completion notification descriptor of a thread group.
+ *
+ * The descriptor is created only if requested on thread group creation.
+ * It becomes readable when a work task completes (after its callback),
+ * and stays readable until archi_thread_group_notify_clear() is called,
+ * so it can be polled along with other descriptors (e.g. by epoll).
+ * The descriptor must not be read from or closed directly.
+ *
+ * @return Pollable descriptor, or -1 if it is not created.
+ */
+int
+archi_thread_group_notify_fd(
+        archi_thread_group_t thread_group ///< [in] Thread group.
+);
+
+/**
+ * @brief Make the completion notification descriptor of a thread group not readable.
+ *
+ * Completions that happen concurrently with the call may leave the descriptor readable,
+ * so spurious readiness is possible, but a completion is never missed:
+ * it is either counted in the returned value, or makes the descriptor readable again.
+ *
+ * @return Number of completed work tasks, which is the ticket of the last completed task.
+ */
+size_t
+archi_thread_group_notify_clear(
+        archi_thread_group_t thread_group ///< [in] Thread group.
+);
+
 /**
  * @brief Get number of threads in a group.
  *
@@ -27,16 +27,122 @@
 #ifndef _ARCHI_THREAD_API_THREAD_GROUP_TYP_H_
 #define _ARCHI_THREAD_API_THREAD_GROUP_TYP_H_
 
+#include "archi/memory/api/interface.typ.h"
+
 #include <stddef.h> // for size_t
+#include <stdint.h> // for uint64_t
+#include <stdbool.h>
 
 
+/**
+ * @brief Policy of pinning threads of a group to CPUs.
+ *
+ * Threads are pinned to CPUs of the CPU list (or all CPUs available to the process)
+ * belonging to the NUMA nodes of the node list (or all nodes).
+ * If there are more threads than CPUs, CPUs are reused in the same order.
+ */
+typedef enum archi_thread_group_affinity {
+    ARCHI_THREAD_GROUP_AFFINITY__NONE = 0, ///< Threads are not pinned.
+    ARCHI_THREAD_GROUP_AFFINITY__COMPACT,  ///< Fill CPUs of a NUMA node before moving to the next node.
+    ARCHI_THREAD_GROUP_AFFINITY__SCATTER,  ///< Distribute consecutive threads among NUMA nodes in turn.
+} archi_thread_group_affinity_t;
+
 /**
  * @brief Thread group creation parameters.
+ *
+ * Waiting threads (both slave threads waiting for work and threads waiting
+ * for work completion) spin for the specified time before going to sleep.
+ * Spinning reduces wakeup latency of small frequent dispatches at the cost of CPU time.
+ *
+ * Pinned threads don't migrate between CPUs, and memory they touch first
+ * is allocated on their NUMA node.
+ *
+ * Dispatch queue capacity is the maximum number of enqueued work tasks
+ * that are not completed yet.
+ *
+ * If scratch arena size is not zero, every thread (including a thread helping the group)
+ * gets its own cache line aligned scratch arena, see archi_thread_group_scratch_alloc().
+ * Arenas are allocated using the memory interface if it is provided, or on heap otherwise.
+ *
+ * Utilization statistics are collected only if requested,
+ * see archi_thread_group_stats() and archi_thread_group_thread_stats().
+ *
+ * Completion notification descriptor is created only if requested,
+ * see archi_thread_group_notify_fd().
  */
 typedef struct archi_thread_group_start_params {
     size_t num_threads; ///< Number of threads to create.
+    size_t queue_capacity; ///< Capacity of the dispatch queue (0 = 1).
+
+    uint64_t spin_ns; ///< Time to spin before sleeping in nanoseconds (0 = sleep immediately).
+
+    archi_thread_group_affinity_t affinity; ///< Policy of pinning threads to CPUs.
+
+    const size_t *cpu; ///< List of CPUs to pin threads to (NULL = all available CPUs).
+    size_t num_cpus;   ///< Number of CPUs in the list.
+
+    const size_t *numa_node; ///< List of NUMA nodes to take CPUs from (NULL = all nodes).
+    size_t num_numa_nodes;   ///< Number of NUMA nodes in the list.
+
+    size_t scratch_size; ///< Size of a per-thread scratch arena in bytes (0 = no arenas).
+    const archi_memory_interface_t *scratch_interface; ///< Memory interface for scratch arenas (NULL = heap).
+    void *scratch_alloc_data; ///< Interface-specific data for scratch arenas allocation.
+
+    bool stats; ///< Whether to collect utilization statistics.
+    bool notify; ///< Whether to create a completion notification descriptor.
 } archi_thread_group_start_params_t;
 
+/**
+ * @brief Policy of distributing work items among threads of a group.
+ */
+typedef enum archi_thread_group_schedule {
+    /**
+     * @brief Threads take batches from a shared counter.
+     *
+     * Zero batch size is replaced with ((size - 1) / num_threads) + 1.
+     */
+    ARCHI_THREAD_GROUP_SCHEDULE__SHARED = 0,
+
+    /**
+     * @brief Threads walk their own contiguous ranges and steal halves of others' ranges.
+     *
+     * The work item range is split into equal contiguous chunks, one per thread.
+     * A thread that runs out of work steals the upper half of the remaining range of another thread.
+     * There is no globally shared counter, and each thread processes adjacent indices.
+     *
+     * Zero batch size is replaced with ((size - 1) / (8 * num_threads)) + 1.
+     */
+    ARCHI_THREAD_GROUP_SCHEDULE__STEAL,
+
+    /**
+     * @brief Threads take shrinking chunks from a shared counter.
+     *
+     * A chunk is 1/num_threads of the remaining work items, but no less than the batch size.
+     * Large chunks at the beginning keep the counter cool, small chunks at the end balance the load.
+     *
+     * Zero batch size is replaced with 1.
+     */
+    ARCHI_THREAD_GROUP_SCHEDULE__GUIDED,
+
+    /**
+     * @brief Threads take batches from a shared counter, batch size is tuned automatically.
+     *
+     * Time of processing a work item is measured during every dispatch and remembered
+     * per work function. Batch size for the next dispatch of the same function is chosen
+     * so that a batch takes a few tens of microseconds, but no more than the default
+     * batch size of the shared counter policy.
+     *
+     * The measured cost also determines how many threads are woken:
+     * small work is done in the dispatching thread with index equal to the number of threads
+     * (if the group is idle), medium work is done by a subset of threads,
+     * and only large work wakes all threads.
+     * Work of an unmeasured function and work dispatched with help is done by all threads.
+     *
+     * Batch size serves as the lower bound.
+     */
+    ARCHI_THREAD_GROUP_SCHEDULE__ADAPTIVE,
+} archi_thread_group_schedule_t;
+
 /**
  * @brief Thread group work dispatch parameters.
  */
@@ -45,7 +151,85 @@ typedef struct archi_thread_group_dispatch_params {
     size_t size;   ///< Number of work items to be processed.
 
     size_t batch_size; ///< Number of work items done by a thread at once.
+
+    archi_thread_group_schedule_t schedule; ///< Policy of distributing work items among threads.
 } archi_thread_group_dispatch_params_t;
 
+/**
+ * @brief Order of traversing tiles of a multi-dimensional work domain.
+ */
+typedef enum archi_thread_group_tile_order {
+    /**
+     * @brief Tiles are traversed along x first, then y, then z.
+     */
+    ARCHI_THREAD_GROUP_TILE_ORDER__ROW_MAJOR = 0,
+
+    /**
+     * @brief Tiles are traversed in Morton (Z-) order.
+     *
+     * Consecutive tiles are close to each other in all dimensions,
+     * which improves cache reuse of neighbouring data.
+     * The tile grid is padded to powers of two along each dimension,
+     * work items falling out of the grid are skipped.
+     */
+    ARCHI_THREAD_GROUP_TILE_ORDER__MORTON,
+} archi_thread_group_tile_order_t;
+
+/**
+ * @brief Thread group tiled work dispatch parameters.
+ *
+ * Dimensions are ordered as (x, y, z).
+ * Unused dimensions must have size 1 (e.g. 2D domains have z size 1).
+ * Zero domain size along any dimension means an empty domain, so there is no work to do.
+ * Zero tile size along a dimension means the whole domain size.
+ *
+ * Every tile is a work item. Tiles are linearized in the specified order,
+ * then distributed among threads according to the batch size and the scheduling policy.
+ */
+typedef struct archi_thread_group_tiled_dispatch_params {
+    archi_thread_group_tile_order_t order; ///< Order of traversing tiles.
+
+    size_t size[3];      ///< Domain size in elements.
+    size_t tile_size[3]; ///< Tile size in elements.
+
+    size_t batch_size; ///< Number of tiles done by a thread at once.
+    archi_thread_group_schedule_t schedule; ///< Policy of distributing tiles among threads.
+} archi_thread_group_tiled_dispatch_params_t;
+
+/**
+ * @brief Utilization statistics of a thread of a group.
+ *
+ * Wake latency is measured for work tasks that were enqueued while the thread
+ * was waiting for them, and is the time from enqueueing of a task to the thread waking up.
+ *
+ * All times are in nanoseconds.
+ */
+typedef struct archi_thread_group_thread_stats {
+    uint64_t num_work_items; ///< Number of processed work items.
+    uint64_t num_batches;    ///< Number of acquired batches of work items.
+
+    uint64_t busy_ns; ///< Time spent processing work items.
+    uint64_t wait_ns; ///< Time spent waiting for work tasks.
+
+    uint64_t num_wakeups;         ///< Number of work tasks the thread was waiting for.
+    uint64_t wake_latency_ns;     ///< Total wake latency.
+    uint64_t max_wake_latency_ns; ///< Maximum wake latency.
+} archi_thread_group_thread_stats_t;
+
+/**
+ * @brief Utilization statistics of a thread group.
+ *
+ * Tail time of a work task is the time between the first and the last thread
+ * finishing their shares of work items.
+ *
+ * All times are in nanoseconds.
+ */
+typedef struct archi_thread_group_stats {
+    uint64_t num_dispatches; ///< Number of completed work tasks.
+
+    uint64_t tail_ns;     ///< Total tail time.
+    uint64_t max_tail_ns; ///< Maximum tail time.
+} archi_thread_group_stats_t;
+
 #endif // _ARCHI_THREAD_API_THREAD_GROUP_TYP_H_
 
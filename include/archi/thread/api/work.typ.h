@@ -53,5 +53,128 @@ typedef struct archi_thread_group_work {
     void *data; ///< Work data.
 } archi_thread_group_work_t;
 
+/*****************************************************************************/
+
+/**
+ * @brief Tile of a multi-dimensional work domain.
+ *
+ * Dimensions are ordered as (x, y, z).
+ */
+typedef struct archi_thread_group_tile {
+    size_t coord[3]; ///< Tile coordinates (in tiles).
+
+    size_t begin[3]; ///< First element of the tile.
+    size_t end[3];   ///< End of the tile (clamped to the domain size).
+} archi_thread_group_tile_t;
+
+/**
+ * @brief Signature of a concurrent tile work function.
+ *
+ * This function is called for each tile concurrently.
+ */
+#define ARCHI_THREAD_GROUP_TILE_WORK_FUNC(func_name)    void func_name(     \
+        void *data, /* [in] Work data. */                                   \
+        archi_thread_group_tile_t tile, /* [in] Current tile. */            \
+        size_t thread_idx) /* [in] Index of the calling thread. */
+
+/**
+ * @brief Concurrent tile work function.
+ */
+typedef ARCHI_THREAD_GROUP_TILE_WORK_FUNC((*archi_thread_group_tile_work_func_t));
+
+/**
+ * @brief Concurrent tile work task.
+ */
+typedef struct archi_thread_group_tile_work {
+    archi_thread_group_tile_work_func_t function; ///< Tile work function.
+    void *data; ///< Work data.
+} archi_thread_group_tile_work_t;
+
+/*****************************************************************************/
+
+/**
+ * @brief Signature of a concurrent reduction accumulation function.
+ *
+ * This function is called for each work item concurrently,
+ * and accumulates the item into the accumulator of the calling thread.
+ */
+#define ARCHI_THREAD_GROUP_REDUCE_FUNC(func_name)   void func_name(         \
+        void *data, /* [in] Reduction data. */                              \
+        void *accumulator, /* [in,out] Accumulator of the calling thread. */\
+        size_t work_item_idx, /* [in] Index of the current work item. */    \
+        size_t thread_idx) /* [in] Index of the calling thread. */
+
+/**
+ * @brief Concurrent reduction accumulation function.
+ */
+typedef ARCHI_THREAD_GROUP_REDUCE_FUNC((*archi_thread_group_reduce_func_t));
+
+/**
+ * @brief Signature of a reduction combination function.
+ *
+ * This function combines a value into an accumulator.
+ * The operation is expected to be associative.
+ */
+#define ARCHI_THREAD_GROUP_COMBINE_FUNC(func_name)  void func_name(         \
+        void *data, /* [in] Reduction data. */                              \
+        void *accumulator, /* [in,out] Accumulator. */                      \
+        const void *value) /* [in] Value to combine into the accumulator. */
+
+/**
+ * @brief Reduction combination function.
+ */
+typedef ARCHI_THREAD_GROUP_COMBINE_FUNC((*archi_thread_group_combine_func_t));
+
+/**
+ * @brief Concurrent reduction task.
+ *
+ * Every thread accumulates work items into its own accumulator,
+ * which is initialized with the identity value.
+ * Accumulators are combined when all work items are done,
+ * and the result is written to the result location.
+ */
+typedef struct archi_thread_group_reduction {
+    archi_thread_group_reduce_func_t accumulate; ///< Accumulation function.
+    archi_thread_group_combine_func_t combine;   ///< Combination function.
+    void *data; ///< Reduction data.
+
+    const void *identity; ///< Identity value.
+    size_t value_size; ///< Size of a value in bytes.
+
+    void *result; ///< Location of the result.
+} archi_thread_group_reduction_t;
+
+/*****************************************************************************/
+
+/**
+ * @brief Signature of a concurrent multi-phase work function.
+ *
+ * This function is called for each work item concurrently, once in every phase.
+ * All work items of a phase are done before work items of the next phase are started.
+ */
+#define ARCHI_THREAD_GROUP_PHASE_WORK_FUNC(func_name)   void func_name(     \
+        void *data, /* [in] Work data. */                                   \
+        size_t phase, /* [in] Index of the current phase. */                \
+        size_t work_item_idx, /* [in] Index of the current work item. */    \
+        size_t thread_idx) /* [in] Index of the calling thread. */
+
+/**
+ * @brief Concurrent multi-phase work function.
+ */
+typedef ARCHI_THREAD_GROUP_PHASE_WORK_FUNC((*archi_thread_group_phase_work_func_t));
+
+/**
+ * @brief Concurrent multi-phase work task.
+ *
+ * Phases are done in order over the same range of work items,
+ * with threads synchronizing on a barrier between phases.
+ */
+typedef struct archi_thread_group_phase_work {
+    archi_thread_group_phase_work_func_t function; ///< Multi-phase work function.
+    void *data; ///< Work data.
+
+    size_t num_phases; ///< Number of phases.
+} archi_thread_group_phase_work_t;
+
 #endif // _ARCHI_THREAD_API_WORK_TYP_H_
 
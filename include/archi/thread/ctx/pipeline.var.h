@@ -0,0 +1,64 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Context interface for pipelines of DEG stages.
+ */
+
+#pragma once
+#ifndef _ARCHI_THREAD_CTX_PIPELINE_VAR_H_
+#define _ARCHI_THREAD_CTX_PIPELINE_VAR_H_
+
+#include "archi/context/api/interface.typ.h"
+
+
+/**
+ * @brief Context interface: pipeline of DEG stages.
+ *
+ * Initialization parameters:
+ * - "params"       : (archi_thread_pipeline_start_params_t) pipeline creation parameters structure
+ * - "num_stages"   : (size_t) number of stages
+ * - "spin_ns"      : (uint64_t) time to spin before sleeping on a queue in nanoseconds
+ *
+ * Getter slots:
+ * - "num_stages"       : (size_t) number of stages
+ * - "stage.entry" [i]  : (archi_dexgraph_node_t) entry node of stage subgraph
+ * - "stage.input" [i]  : (archi_thread_lfqueue_t) input queue of stage
+ * - "stage.output" [i] : (archi_thread_lfqueue_t) output queue of stage
+ * - "stage.item" [i]   : (void) work item buffer of stage
+ *
+ * Setter slots:
+ * - "stage.entry" [i]  : (archi_dexgraph_node_t) entry node of stage subgraph
+ * - "stage.input" [i]  : (archi_thread_lfqueue_t) input queue of stage
+ * - "stage.output" [i] : (archi_thread_lfqueue_t) output queue of stage
+ * - "stage.item" [i]   : (void) work item buffer of stage
+ *
+ * Calls:
+ * - "start"        : start the pipeline
+ * - "stop"         : request the pipeline to stop
+ * - "wait"         : wait until all stages are finished
+ */
+extern
+const archi_context_interface_t
+archi_context_interface__thread_pipeline;
+
+#endif // _ARCHI_THREAD_CTX_PIPELINE_VAR_H_
+
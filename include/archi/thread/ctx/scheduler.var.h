@@ -0,0 +1,55 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+/**
+ * @file
+ * @brief Context interface for scheduler contexts.
+ */
+
+#pragma once
+#ifndef _ARCHI_THREAD_CTX_SCHEDULER_VAR_H_
+#define _ARCHI_THREAD_CTX_SCHEDULER_VAR_H_
+
+#include "archi/context/api/interface.typ.h"
+
+
+/**
+ * @brief Context interface: scheduler of DEG frames.
+ *
+ * Initialization parameters:
+ * - "params"       : (archi_thread_scheduler_start_params_t) scheduler creation parameters structure
+ * - "num_threads"  : (size_t) number of worker threads
+ * - "max_tasks"    : (size_t) maximum number of simultaneously scheduled tasks
+ *
+ * Getter slots:
+ * - "num_threads"  : (size_t) number of worker threads
+ * - "num_tasks"    : (size_t) number of unfinished tasks
+ *
+ * Calls:
+ * - "submit"       : submit a task
+ *      parameters:
+ *      - "node"        : (archi_dexgraph_node_t) initial node of the task
+ *      - "index"       : (size_t) initial operation function sequence index
+ * - "wait"         : wait until all tasks are finished
+ */
+extern
+const archi_context_interface_t
+archi_context_interface__thread_scheduler;
+
+#endif // _ARCHI_THREAD_CTX_SCHEDULER_VAR_H_
@@ -34,11 +34,30 @@
  * @brief Context interface: thread group.
  *
  * Initialization parameters:
- * - "params"       : (archi_thread_group_start_params_t) thread group creation parameters structure
- * - "num_threads"  : (size_t) number of threads in group
+ * - "params"               : (archi_thread_group_start_params_t) thread group creation parameters structure
+ * - "num_threads"          : (size_t) number of threads in group
+ * - "queue_capacity"       : (size_t) capacity of the dispatch queue
+ * - "spin_ns"              : (uint64_t) time to spin before sleeping in nanoseconds
+ * - "affinity"             : (archi_thread_group_affinity_t) policy of pinning threads to CPUs
+ * - "cpus"                 : (size_t[]) list of CPUs to pin threads to
+ * - "numa_nodes"           : (size_t[]) list of NUMA nodes to take CPUs from
+ * - "scratch_size"         : (size_t) size of a per-thread scratch arena in bytes
+ * - "scratch_interface"    : (archi_memory_interface_t) memory interface for scratch arenas
+ * - "scratch_alloc_data"   : interface-specific data for scratch arenas allocation
+ * - "stats"                : (char) whether to collect utilization statistics
+ * - "notify"               : (char) whether to create a completion notification descriptor
  *
  * Getter slots:
- * - "num_threads"  : (size_t) number of threads in group
+ * - "num_threads"          : (size_t) number of threads in group
+ * - "stats"                : (archi_thread_group_stats_t) utilization statistics of the group
+ * - "thread_stats" [index] : (archi_thread_group_thread_stats_t) utilization statistics of thread #index
+ * - "notify_fd"            : (int) pollable completion notification descriptor
+ *
+ * Calls:
+ * - "reset_stats" : reset utilization statistics
+ *   <no parameters>
+ * - "clear_notify" : make the completion notification descriptor not readable
+ *   <no parameters>
  */
 extern
 const archi_context_interface_t
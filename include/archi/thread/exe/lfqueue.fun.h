@@ -0,0 +1,54 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief DEG operation functions for lock-free queue operations.
+ */
+
+#pragma once
+#ifndef _ARCHI_THREAD_EXE_LFQUEUE_FUN_H_
+#define _ARCHI_THREAD_EXE_LFQUEUE_FUN_H_
+
+#include "archi/exec/api/operation.typ.h"
+
+
+/**
+ * @brief Operation function: push multiple values to a lock-free queue.
+ *
+ * Doesn't wait for free slots: if the queue doesn't have enough of them,
+ * only the first values are pushed.
+ *
+ * Function data type: archi_dexgraph_op_data__thread_lfqueue_push_n_t.
+ */
+ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__thread_lfqueue_push_n);
+
+/**
+ * @brief Operation function: pop multiple values from a lock-free queue.
+ *
+ * Doesn't wait for values: if the queue doesn't have enough of them,
+ * only the available values are popped.
+ *
+ * Function data type: archi_dexgraph_op_data__thread_lfqueue_pop_n_t.
+ */
+ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__thread_lfqueue_pop_n);
+
+#endif // _ARCHI_THREAD_EXE_LFQUEUE_FUN_H_
+
@@ -0,0 +1,60 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Data for DEG operation functions for lock-free queue operations.
+ */
+
+#pragma once
+#ifndef _ARCHI_THREAD_EXE_LFQUEUE_TYP_H_
+#define _ARCHI_THREAD_EXE_LFQUEUE_TYP_H_
+
+#include "archi/thread/api/handle.typ.h"
+
+#include <stddef.h> // for size_t
+
+
+/**
+ * @brief Operation function data: push multiple values to a lock-free queue.
+ */
+typedef struct archi_dexgraph_op_data__thread_lfqueue_push_n {
+    archi_thread_lfqueue_t queue; ///< Lock-free queue handle.
+
+    const void *values; ///< Array of pushed values.
+    size_t num_values; ///< Number of values to push.
+
+    size_t *num_pushed; ///< Location to store the number of pushed values in (optional).
+} archi_dexgraph_op_data__thread_lfqueue_push_n_t;
+
+/**
+ * @brief Operation function data: pop multiple values from a lock-free queue.
+ */
+typedef struct archi_dexgraph_op_data__thread_lfqueue_pop_n {
+    archi_thread_lfqueue_t queue; ///< Lock-free queue handle.
+
+    void *values; ///< Memory to write popped values to (optional).
+    size_t num_values; ///< Maximum number of values to pop.
+
+    size_t *num_popped; ///< Location to store the number of popped values in (optional).
+} archi_dexgraph_op_data__thread_lfqueue_pop_n_t;
+
+#endif // _ARCHI_THREAD_EXE_LFQUEUE_TYP_H_
+
@@ -0,0 +1,59 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief DEG operation functions for pipeline operations.
+ */
+
+#pragma once
+#ifndef _ARCHI_THREAD_EXE_PIPELINE_FUN_H_
+#define _ARCHI_THREAD_EXE_PIPELINE_FUN_H_
+
+#include "archi/exec/api/operation.typ.h"
+
+
+/**
+ * @brief Operation function: start a pipeline.
+ *
+ * If the pipeline is already running, waits for it to finish first.
+ *
+ * Function data type: archi_thread_pipeline_t.
+ */
+ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__thread_pipeline_start);
+
+/**
+ * @brief Operation function: request a pipeline to stop.
+ *
+ * Function data type: archi_thread_pipeline_t.
+ */
+ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__thread_pipeline_stop);
+
+/**
+ * @brief Operation function: wait for a pipeline to finish.
+ *
+ * @warning Must not be called from a stage of the same pipeline.
+ *
+ * Function data type: archi_thread_pipeline_t.
+ */
+ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__thread_pipeline_wait);
+
+#endif // _ARCHI_THREAD_EXE_PIPELINE_FUN_H_
+
@@ -0,0 +1,60 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+/**
+ * @file
+ * @brief DEG operation functions for scheduler operations.
+ */
+
+#pragma once
+#ifndef _ARCHI_THREAD_EXE_SCHEDULER_FUN_H_
+#define _ARCHI_THREAD_EXE_SCHEDULER_FUN_H_
+
+#include "archi/exec/api/operation.typ.h"
+
+
+/**
+ * @brief Operation function: submit a task to a scheduler.
+ *
+ * Fails if the maximum number of scheduler tasks is reached.
+ *
+ * Function data type: archi_dexgraph_op_data__thread_scheduler_submit_t.
+ */
+ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__thread_scheduler_submit);
+
+/**
+ * @brief Operation function: wait scheduler to finish all tasks.
+ *
+ * @warning Must not be called from a task of the same scheduler.
+ *
+ * Function data type: archi_thread_scheduler_t.
+ */
+ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__thread_scheduler_wait);
+
+/**
+ * @brief Operation function: request the current scheduler task to yield.
+ *
+ * The task is suspended at the next node transition and resumed later.
+ * Does nothing if not called from a scheduler task.
+ *
+ * Function data type: none.
+ */
+ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__thread_scheduler_yield);
+
+#endif // _ARCHI_THREAD_EXE_SCHEDULER_FUN_H_
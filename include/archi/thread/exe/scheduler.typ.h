@@ -0,0 +1,45 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+/**
+ * @file
+ * @brief Data for DEG operation functions for scheduler operations.
+ */
+
+#pragma once
+#ifndef _ARCHI_THREAD_EXE_SCHEDULER_TYP_H_
+#define _ARCHI_THREAD_EXE_SCHEDULER_TYP_H_
+
+#include "archi/thread/api/handle.typ.h"
+#include "archi/exec/api/node.typ.h"
+
+#include <stddef.h> // for size_t
+
+
+/**
+ * @brief Operation function data: submit a task to a scheduler.
+ */
+typedef struct archi_dexgraph_op_data__thread_scheduler_submit {
+    archi_thread_scheduler_t scheduler; ///< Scheduler handle.
+
+    const archi_dexgraph_node_t *node; ///< Initial node of the task.
+    size_t index; ///< Initial operation function sequence index.
+} archi_dexgraph_op_data__thread_scheduler_submit_t;
+
+#endif // _ARCHI_THREAD_EXE_SCHEDULER_TYP_H_
@@ -37,6 +37,45 @@
  */
 ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__thread_group_dispatch);
 
+/**
+ * @brief Operation function: dispatch work task to a thread group and take part in processing it.
+ *
+ * The operation returns after the work task is completed.
+ *
+ * Function data type: archi_dexgraph_op_data__thread_group_dispatch_t.
+ */
+ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__thread_group_dispatch_help);
+
+/**
+ * @brief Operation function: dispatch tiled work task to a thread group.
+ *
+ * Function data type: archi_dexgraph_op_data__thread_group_dispatch_tiled_t.
+ */
+ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__thread_group_dispatch_tiled);
+
+/**
+ * @brief Operation function: dispatch reduction to a thread group.
+ *
+ * Function data type: archi_dexgraph_op_data__thread_group_dispatch_reduce_t.
+ */
+ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__thread_group_dispatch_reduce);
+
+/**
+ * @brief Operation function: dispatch multi-phase work task to a thread group.
+ *
+ * Function data type: archi_dexgraph_op_data__thread_group_dispatch_phased_t.
+ */
+ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__thread_group_dispatch_phased);
+
+/**
+ * @brief Operation function: enqueue work task to a thread group.
+ *
+ * If the dispatch queue is full, the operation waits until all enqueued tasks are completed.
+ *
+ * Function data type: archi_dexgraph_op_data__thread_group_enqueue_t.
+ */
+ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__thread_group_enqueue);
+
 /**
  * @brief Operation function: wait thread group to finish work.
  *
@@ -44,5 +83,56 @@ ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__thread_group_dispatch);
  */
 ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__thread_group_wait);
 
+/**
+ * @brief Operation function: cancel work tasks of a thread group.
+ *
+ * If the ticket is not provided, all incomplete work tasks are cancelled.
+ *
+ * Function data type: archi_dexgraph_op_data__thread_group_cancel_t.
+ */
+ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__thread_group_cancel);
+
+/**
+ * @brief Operation function: wait thread group to finish an enqueued work task.
+ *
+ * Function data type: archi_dexgraph_op_data__thread_group_wait_ticket_t.
+ */
+ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__thread_group_wait_ticket);
+
+/**
+ * @brief Operation function: execute DEG branches concurrently and join.
+ *
+ * Each branch is executed as a separate work item, starting at the first operation
+ * of its entry node and proceeding without interruptions until halted or failed.
+ * Null branches are skipped. The operation returns after all branches are finished.
+ * Branches are enqueued after work tasks already enqueued to the thread group,
+ * but work tasks enqueued later are not waited for.
+ *
+ * If branch error array is provided, it receives errors of all branches.
+ * The operation fails with the error of the failed branch with the lowest index
+ * if the array is provided, or the first failed branch otherwise.
+ *
+ * @warning Branches must not dispatch work to the same thread group,
+ * as it is busy until the operation finishes.
+ *
+ * Function data type: archi_dexgraph_op_data__thread_group_fork_join_t.
+ */
+ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__thread_group_fork_join);
+
+/**
+ * @brief Operation function: execute a dataflow graph concurrently.
+ *
+ * Every thread of the group executes ready operations of the dataflow graph
+ * until all operations are done or an operation fails.
+ * The operation returns after the dataflow graph execution is finished,
+ * and fails with the error of the failed operation.
+ *
+ * @warning Operations of the dataflow graph must not dispatch work to the same thread group,
+ * as it is busy until the operation finishes.
+ *
+ * Function data type: archi_dexgraph_op_data__thread_group_dataflow_t.
+ */
+ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__thread_group_dataflow);
+
 #endif // _ARCHI_THREAD_EXE_THREAD_GROUP_FUN_H_
 
@@ -31,6 +31,9 @@
 #include "archi/thread/api/work.typ.h"
 #include "archi/thread/api/callback.typ.h"
 #include "archi/thread/api/thread_group.typ.h"
+#include "archi/exec/api/node.typ.h"
+#include "archi/exec/api/dataflow.typ.h"
+#include "archi_base/error.typ.h"
 
 
 /**
@@ -44,5 +47,87 @@ typedef struct archi_dexgraph_op_data__thread_group_dispatch {
     archi_thread_group_dispatch_params_t param; ///< Dispatch parameters.
 } archi_dexgraph_op_data__thread_group_dispatch_t;
 
+/**
+ * @brief Operation function data: dispatch tiled work task to a thread group.
+ */
+typedef struct archi_dexgraph_op_data__thread_group_dispatch_tiled {
+    archi_thread_group_t thread_group; ///< Thread group handle.
+
+    archi_thread_group_tile_work_t work; ///< Concurrent tile work task.
+    archi_thread_group_callback_t callback; ///< Concurrent work completion callback.
+    archi_thread_group_tiled_dispatch_params_t param; ///< Tiled dispatch parameters.
+} archi_dexgraph_op_data__thread_group_dispatch_tiled_t;
+
+/**
+ * @brief Operation function data: dispatch reduction to a thread group.
+ */
+typedef struct archi_dexgraph_op_data__thread_group_dispatch_reduce {
+    archi_thread_group_t thread_group; ///< Thread group handle.
+
+    archi_thread_group_reduction_t reduction; ///< Concurrent reduction task.
+    archi_thread_group_callback_t callback; ///< Concurrent work completion callback.
+    archi_thread_group_dispatch_params_t param; ///< Dispatch parameters.
+} archi_dexgraph_op_data__thread_group_dispatch_reduce_t;
+
+/**
+ * @brief Operation function data: dispatch multi-phase work task to a thread group.
+ */
+typedef struct archi_dexgraph_op_data__thread_group_dispatch_phased {
+    archi_thread_group_t thread_group; ///< Thread group handle.
+
+    archi_thread_group_phase_work_t work; ///< Concurrent multi-phase work task.
+    archi_thread_group_callback_t callback; ///< Concurrent work completion callback.
+    archi_thread_group_dispatch_params_t param; ///< Dispatch parameters.
+} archi_dexgraph_op_data__thread_group_dispatch_phased_t;
+
+/**
+ * @brief Operation function data: enqueue work task to a thread group.
+ */
+typedef struct archi_dexgraph_op_data__thread_group_enqueue {
+    archi_thread_group_t thread_group; ///< Thread group handle.
+
+    archi_thread_group_work_t work; ///< Concurrent work task.
+    archi_thread_group_callback_t callback; ///< Concurrent work completion callback.
+    archi_thread_group_dispatch_params_t param; ///< Dispatch parameters.
+
+    const size_t *after; ///< Ticket of the task to complete before starting this one (optional).
+    size_t *ticket; ///< Location to store the ticket of the enqueued task in (optional).
+} archi_dexgraph_op_data__thread_group_enqueue_t;
+
+/**
+ * @brief Operation function data: cancel work tasks of a thread group.
+ */
+typedef struct archi_dexgraph_op_data__thread_group_cancel {
+    archi_thread_group_t thread_group; ///< Thread group handle.
+    const size_t *ticket; ///< Ticket of the task to cancel (optional, NULL = all incomplete tasks).
+} archi_dexgraph_op_data__thread_group_cancel_t;
+
+/**
+ * @brief Operation function data: wait thread group to finish an enqueued work task.
+ */
+typedef struct archi_dexgraph_op_data__thread_group_wait_ticket {
+    archi_thread_group_t thread_group; ///< Thread group handle.
+    const size_t *ticket; ///< Ticket of the task.
+} archi_dexgraph_op_data__thread_group_wait_ticket_t;
+
+/**
+ * @brief Operation function data: execute DEG branches concurrently and join.
+ */
+typedef struct archi_dexgraph_op_data__thread_group_fork_join {
+    archi_thread_group_t thread_group; ///< Thread group handle.
+
+    const archi_dexgraph_node_array_t *branches; ///< Entry nodes of concurrent branches.
+    archi_error_t *branch_error; ///< Array of per-branch errors (optional).
+} archi_dexgraph_op_data__thread_group_fork_join_t;
+
+/**
+ * @brief Operation function data: execute a dataflow graph concurrently.
+ */
+typedef struct archi_dexgraph_op_data__thread_group_dataflow {
+    archi_thread_group_t thread_group; ///< Thread group handle.
+
+    archi_dexgraph_dataflow_t dataflow; ///< Dataflow graph.
+} archi_dexgraph_op_data__thread_group_dataflow_t;
+
 #endif // _ARCHI_THREAD_EXE_THREAD_GROUP_TYP_H_
 
@@ -0,0 +1,51 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Macros for tracing hooks.
+ */
+
+#pragma once
+#ifndef _ARCHI_TRACE_API_TRACE_DEF_H_
+#define _ARCHI_TRACE_API_TRACE_DEF_H_
+
+#ifdef ARCHI_FEATURE_TRACE
+
+#  include "archi/trace/api/trace.fun.h"
+#  include "archi/trace/api/trace.var.h"
+
+/**
+ * @brief Record a trace event if tracing is active.
+ *
+ * Expands to nothing if ARCHI_FEATURE_TRACE is not defined.
+ */
+#  define ARCHI_TRACE_EVENT(type, name, object, arg) do {                   \
+    if (atomic_load_explicit(&archi_trace_active, memory_order_relaxed))    \
+        archi_trace_record((type), (name), (object), (arg));                \
+} while (0)
+
+#else
+
+#  define ARCHI_TRACE_EVENT(type, name, object, arg) do {} while (0)
+
+#endif
+
+#endif // _ARCHI_TRACE_API_TRACE_DEF_H_
@@ -0,0 +1,96 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Execution tracing.
+ */
+
+#pragma once
+#ifndef _ARCHI_TRACE_API_TRACE_FUN_H_
+#define _ARCHI_TRACE_API_TRACE_FUN_H_
+
+#include "archi/trace/api/trace.typ.h"
+#include "archi_base/error.typ.h"
+
+#include <stdbool.h>
+
+
+/**
+ * @brief Start recording trace events.
+ *
+ * Every thread records events into its own ring buffer,
+ * which is allocated on the first event of the thread.
+ * When a buffer is full, the oldest events are overwritten.
+ * Buffers allocated before keep their capacity.
+ *
+ * Tracing is available only if ARCHI_FEATURE_TRACE is defined,
+ * otherwise this function fails with ARCHI__ENOTIMPL.
+ *
+ * @return True on success, false on failure.
+ */
+bool
+archi_trace_start(
+        archi_trace_start_params_t params, ///< [in] Tracing parameters.
+        ARCHI_ERROR_PARAM_DECL ///< [out] Error.
+);
+
+/**
+ * @brief Stop recording trace events.
+ *
+ * Recorded events are kept until flushed.
+ */
+void
+archi_trace_stop(void);
+
+/**
+ * @brief Record a trace event into the buffer of the calling thread.
+ *
+ * This function is lock-free, except for the first call in a thread.
+ * It is normally called through ARCHI_TRACE_EVENT().
+ *
+ * The event name is copied, so it needs to stay valid only during the call.
+ */
+void
+archi_trace_record(
+        archi_trace_event_type_t type, ///< [in] Event type.
+        const char *name, ///< [in] Event name.
+        const void *object, ///< [in] Traced object.
+        uint32_t arg ///< [in] Event argument.
+);
+
+/**
+ * @brief Write recorded trace events to a file and discard them.
+ *
+ * The output is in Chrome trace event JSON format,
+ * which can be viewed in Perfetto UI or chrome://tracing.
+ *
+ * Flushing is safe while events are being recorded, but events
+ * overwritten during flushing are dropped.
+ *
+ * @return True on success, false on failure.
+ */
+bool
+archi_trace_flush(
+        const char *pathname, ///< [in] Output file path.
+        ARCHI_ERROR_PARAM_DECL ///< [out] Error.
+);
+
+#endif // _ARCHI_TRACE_API_TRACE_FUN_H_
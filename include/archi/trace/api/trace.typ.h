@@ -0,0 +1,85 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Types for execution tracing.
+ */
+
+#pragma once
+#ifndef _ARCHI_TRACE_API_TRACE_TYP_H_
+#define _ARCHI_TRACE_API_TRACE_TYP_H_
+
+#include <stddef.h> // for size_t
+#include <stdint.h> // for uint64_t, uint32_t
+
+
+/**
+ * @brief Type of a trace event.
+ */
+typedef enum archi_trace_event_type {
+    ARCHI_TRACE__NODE_ENTER = 1,    ///< DEG node execution began (arg: initial sequence index).
+    ARCHI_TRACE__NODE_LEAVE,        ///< DEG node execution ended (arg: sequence index).
+    ARCHI_TRACE__OPERATION_BEGIN,   ///< DEG operation call began (arg: sequence index).
+    ARCHI_TRACE__OPERATION_END,     ///< DEG operation call ended (arg: sequence index).
+
+    ARCHI_TRACE__DISPATCH,          ///< Work was dispatched to a thread group (arg: number of work items).
+    ARCHI_TRACE__WORK_BEGIN,        ///< Thread started processing work items (arg: thread index).
+    ARCHI_TRACE__WORK_END,          ///< Thread finished processing work items (arg: thread index).
+    ARCHI_TRACE__COMPLETE,          ///< Dispatched work was completed (arg: thread index).
+
+    ARCHI_TRACE__LFQUEUE_PUSH_FULL, ///< Lock-free queue push failed as the queue is full.
+    ARCHI_TRACE__LFQUEUE_POP_EMPTY, ///< Lock-free queue pop failed as the queue is empty.
+} archi_trace_event_type_t;
+
+/**
+ * @brief Maximum size of a trace event name including the terminating null character.
+ *
+ * Longer names are truncated when an event is recorded.
+ */
+#define ARCHI_TRACE_EVENT_NAME_SIZE     40 // makes sizeof(archi_trace_event_t) == 64
+
+/**
+ * @brief Trace event.
+ */
+typedef struct archi_trace_event {
+    uint64_t time_ns; ///< Timestamp in nanoseconds.
+    char name[ARCHI_TRACE_EVENT_NAME_SIZE]; ///< Event name (copy of a prefix).
+    const void *object; ///< Traced object.
+    uint32_t type; ///< Event type (archi_trace_event_type_t).
+    uint32_t arg; ///< Event argument.
+} archi_trace_event_t;
+
+/**
+ * @brief Tracing start parameters.
+ *
+ * Capacity of per-thread event buffers must be a power of two.
+ * Zero capacity denotes the default value.
+ */
+typedef struct archi_trace_start_params {
+    size_t capacity; ///< Capacity of per-thread event buffers.
+} archi_trace_start_params_t;
+
+/**
+ * @brief Default capacity of per-thread event buffers.
+ */
+#define ARCHI_TRACE_DEFAULT_CAPACITY    (1 << 16) // 65536
+
+#endif // _ARCHI_TRACE_API_TRACE_TYP_H_
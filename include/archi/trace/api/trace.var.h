@@ -0,0 +1,41 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Global state of execution tracing.
+ */
+
+#pragma once
+#ifndef _ARCHI_TRACE_API_TRACE_VAR_H_
+#define _ARCHI_TRACE_API_TRACE_VAR_H_
+
+#include <stdatomic.h> // for atomic_bool
+
+
+/**
+ * @brief Whether trace events are being recorded.
+ *
+ * @warning Use archi_trace_start() and archi_trace_stop() to change the value.
+ */
+extern
+atomic_bool archi_trace_active;
+
+#endif // _ARCHI_TRACE_API_TRACE_VAR_H_
@@ -0,0 +1,58 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief DEG operation functions for execution tracing.
+ */
+
+#pragma once
+#ifndef _ARCHI_TRACE_EXE_TRACE_FUN_H_
+#define _ARCHI_TRACE_EXE_TRACE_FUN_H_
+
+#include "archi/exec/api/operation.typ.h"
+
+
+/**
+ * @brief Operation function: start recording trace events.
+ *
+ * Default parameters are used if function data is NULL.
+ *
+ * Function data type: archi_trace_start_params_t.
+ */
+ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__trace_start);
+
+/**
+ * @brief Operation function: stop recording trace events.
+ *
+ * Function data type: <none>.
+ */
+ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__trace_stop);
+
+/**
+ * @brief Operation function: write recorded trace events to a file.
+ *
+ * The output is in Chrome trace event JSON format.
+ *
+ * Function data type: char[] (output file path).
+ */
+ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__trace_flush);
+
+#endif // _ARCHI_TRACE_EXE_TRACE_FUN_H_
@@ -0,0 +1,499 @@
+ #############################################################################
+ # Copyright (C) 2023-2026 by Ivan Podmazov                                  #
+ #                                                                           #
+ # This file is part of Archipelago.                                         #
+ #                                                                           #
+ #   Archipelago is free software: you can redistribute it and/or modify it  #
+ #   under the terms of the GNU Lesser General Public License as published   #
+ #   by the Free Software Foundation, either version 3 of the License, or    #
+ #   (at your option) any later version.                                     #
+ #                                                                           #
+ #   Archipelago is distributed in the hope that it will be useful,          #
+ #   but WITHOUT ANY WARRANTY; without even the implied warranty of          #
+ #   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           #
+ #   GNU Lesser General Public License for more details.                     #
+ #                                                                           #
+ #   You should have received a copy of the GNU Lesser General Public        #
+ #   License along with Archipelago. If not, see                             #
+ #   <http://www.gnu.org/licenses/>.                                         #
+ #############################################################################
+
+# @file
+# @brief Ahead-of-time compilation of directed execution graphs.
+#
+# A graph described through a context registry (node and node array contexts,
+# their initialization parameters and slot assignments) is translated into C code
+# of a single operation function. Operation functions are called directly in sequence,
+# transitions are translated to `switch`/`goto` statements.
+# The generated code is compiled into a shared library, which can be loaded
+# as a library context, and the generated operation function used instead of
+# the interpreted graph.
+#
+# Node data (operation and transition data) is not known until run time,
+# so the generated operation function accepts an array of pointers to the graph nodes
+# as its data, and reads operation and transition data from the nodes.
+
+from collections import namedtuple
+import subprocess
+
+import archi.ctypes as typ
+from .object import Object, PrimitiveData
+from .context import (
+        DexgraphNodeContext,
+        DexgraphNodeArrayContext,
+        DexgraphOperationFuncSymbol,
+        LibraryContext,
+        )
+from .registry import Registry
+
+##############################################################################
+# Graph description extraction
+##############################################################################
+
+# Reference to a function symbol obtained from a library context.
+SymbolRef = namedtuple('SymbolRef', ('name',))
+
+# Reference to a whole context.
+ContextRef = namedtuple('ContextRef', ('key',))
+
+# Reference to a value that cannot be determined ahead of time.
+UnknownRef = namedtuple('UnknownRef', ('description',))
+
+# Description of a graph node.
+DexgraphNodeDescription = namedtuple('DexgraphNodeDescription',
+                                     ('key', 'name', 'sequence', 'transition_func',
+                                      'transition_data', 'transition_kind', 'branches'))
+
+# Node initialization parameters to node slots mapping.
+_NODE_INIT_PARAM_SLOTS = {'transition_func': 'transition.function',
+                          'transition_data': 'transition.data',
+                          'transition_kind': 'transition.kind',
+                          'branches': 'branches'}
+
+
+def _string(obj, /):
+    """Get a string from a nullable string object.
+    """
+    return obj.string if obj is not None else ''
+
+
+def _indices(obj, /):
+    """Get a tuple of indices from a nullable slot indices object.
+    """
+    return tuple(obj.c_object) if obj is not None else ()
+
+
+def _kvlist(kvlist, /):
+    """Iterate over a nullable key-value list object.
+    """
+    while kvlist is not None:
+        yield kvlist['key'].string, kvlist['value']
+        kvlist = kvlist['next']
+
+
+class DexgraphDescription:
+    """Description of directed execution graphs extracted from a list of registry operations.
+
+    Registry operations are replayed symbolically: only context creation parameters
+    and slot assignments are tracked, nothing is executed.
+    """
+    def __init__(self, registry, /, operations=None):
+        """Extract graph description from registry operations.
+
+        The operation list of the registry is used by default.
+        """
+        if not isinstance(registry, Registry):
+            raise TypeError
+
+        if operations is None:
+            operations = registry.operations.list
+
+        self._node_keys = set(registry.contexts(cls=DexgraphNodeContext))
+        self._array_keys = set(registry.contexts(cls=DexgraphNodeArrayContext))
+
+        self._aliases = {}
+        self._plists = {}
+        self._pointers = set()
+        self._init = {}
+        self._slots = {}
+
+        for op, data in operations:
+            self._replay(op, data)
+
+    def _key(self, key, /):
+        """Resolve context key aliases.
+        """
+        while key in self._aliases:
+            key = self._aliases[key]
+        return key
+
+    def _plist_params(self, key, /):
+        """Obtain the effective parameters of a parameter list context.
+        """
+        if not key:
+            return {}
+
+        key = self._key(key)
+
+        try:
+            base_key, params = self._plists[key]
+        except KeyError:
+            raise ValueError(f"Parameter list context '{key}' is unknown")
+
+        result = self._plist_params(base_key)
+        result.update(params)
+        result.update({name: value for (name, indices), value in self._slots[key].items()
+                       if not indices})
+        return result
+
+    def _source(self, key, name, indices, /):
+        """Resolve a source slot reference.
+        """
+        key = self._key(key)
+
+        if not name and not indices:
+            return ContextRef(key)
+
+        try:
+            return self._slots[key][(name, indices)]
+        except KeyError:
+            return UnknownRef(f"'{key}'.{name}{list(indices) if indices else ''}")
+
+    def _deref(self, value, /):
+        """Dereference pointer contexts.
+        """
+        while isinstance(value, ContextRef) and value.key in self._pointers:
+            value = self._slots[value.key].get(('pointee', ()))
+        return value
+
+    def _replay(self, op, data, /):
+        """Replay a registry operation.
+        """
+        if op == 'alias':
+            self._aliases[data['key'].string] = self._key(data['original_key'].string)
+            return
+
+        key = data['key'].string
+        self._aliases.pop(key, None)
+
+        if op == 'delete':
+            pass
+
+        elif op in ('create_as', 'create_from'):
+            params = self._plist_params(_string(data['init_params_context_key']))
+            params.update(_kvlist(data['init_params_list']))
+
+            self._init[key] = params
+            self._slots[key] = {(_NODE_INIT_PARAM_SLOTS[name], ()): value
+                                for name, value in params.items()
+                                if key in self._node_keys and name in _NODE_INIT_PARAM_SLOTS}
+
+        elif op == 'create_plist':
+            self._plists[key] = (_string(data['params_context_key']),
+                                 dict(_kvlist(data['params_list'])))
+            self._slots[key] = {}
+
+        elif op == 'create_ptr':
+            self._pointers.add(key)
+            self._slots[key] = {('pointee', ()): data['pointee']}
+
+        elif op == 'create_dptr_array':
+            self._slots[key] = {}
+
+        elif op == 'invoke':
+            pass
+
+        else:
+            slot = (_string(data['slot_name']), _indices(data['slot_indices']))
+
+            if op == 'unassign':
+                value = None
+            elif op == 'assign':
+                value = data['value']
+            elif op in ('assign_slot', 'assign_slot_weak'):
+                value = self._source(data['source_key'].string,
+                                     _string(data['source_slot_name']),
+                                     _indices(data['source_slot_indices']))
+            elif op in ('assign_call', 'assign_call_weak'):
+                name = _string(data['source_slot_name'])
+                if name.startswith('function.') and not _indices(data['source_slot_indices']):
+                    value = SymbolRef(name[len('function.'):])
+                else:
+                    value = UnknownRef(f"call '{data['source_key'].string}'.{name}")
+            else:
+                raise ValueError(f"Registry operation '{op}' is not supported")
+
+            self._slots.setdefault(key, {})[slot] = value
+
+    def _value(self, key, name, indices=(), /):
+        """Obtain the current value of a node slot.
+        """
+        return self._deref(self._slots[key].get((name, indices)))
+
+    @staticmethod
+    def _integer(value, what, /):
+        """Obtain an integer from a primitive data object.
+        """
+        if value is None:
+            return 0
+        elif not isinstance(value, PrimitiveData):
+            raise ValueError(f"{what} is not known ahead of time")
+
+        return value.c_object.value
+
+    def node(self, key, /):
+        """Obtain description of the node with the specified key.
+        """
+        key = self._key(key)
+
+        if key not in self._node_keys or key not in self._init:
+            raise KeyError(f"Node context '{key}' is unknown")
+
+        name = self._init[key].get('name')
+        name = name.string if name is not None else key
+
+        sequence = []
+        for index in range(self._integer(self._init[key].get('sequence_length'),
+                                         f"Length of node '{key}'")):
+            function = self._value(key, 'sequence.function', (index,))
+            if function is not None and not isinstance(function, SymbolRef):
+                raise ValueError(f"Operation function #{index} of node '{key}' "
+                                 "is not a library symbol")
+            sequence.append(function.name if function is not None else None)
+
+        function = self._value(key, 'transition.function')
+        if function is not None and not isinstance(function, SymbolRef):
+            raise ValueError(f"Transition function of node '{key}' is not a library symbol")
+
+        kind = self._integer(self._value(key, 'transition.kind'),
+                             f"Transition kind of node '{key}'")
+
+        branches = self._value(key, 'branches')
+        if branches is None:
+            branches = ()
+        elif isinstance(branches, ContextRef) and branches.key in self._array_keys:
+            branches = self._branches(branches.key)
+        else:
+            raise ValueError(f"Branches of node '{key}' are not a node array context")
+
+        return DexgraphNodeDescription(
+                key=key,
+                name=name,
+                sequence=tuple(sequence),
+                transition_func=function.name if function is not None else None,
+                transition_data=self._value(key, 'transition.data') is not None,
+                transition_kind=kind,
+                branches=branches)
+
+    def _branches(self, key, /):
+        """Obtain keys of nodes in a node array.
+        """
+        num_nodes = self._integer(self._init.get(key, {}).get('num_nodes'),
+                                  f"Length of node array '{key}'")
+
+        branches = []
+        for index in range(num_nodes):
+            node = self._value(key, 'node', (index,))
+            if node is not None and not (isinstance(node, ContextRef)
+                                         and node.key in self._node_keys):
+                raise ValueError(f"Node #{index} of array '{key}' is not a node context")
+            branches.append(node.key if node is not None else None)
+
+        return tuple(branches)
+
+    def reachable(self, entry, /):
+        """Obtain the list of nodes reachable from the entry node, in breadth-first order.
+        """
+        nodes = [self.node(entry)]
+        index = {nodes[0].key: 0}
+
+        position = 0
+        while position < len(nodes):
+            for branch in nodes[position].branches:
+                if branch is not None and branch not in index:
+                    index[branch] = len(nodes)
+                    nodes.append(self.node(branch))
+            position += 1
+
+        return nodes
+
+##############################################################################
+# C code generation
+##############################################################################
+
+# Names of built-in transition kinds.
+_TRANSITION_KINDS = {getattr(typ, name): name for name in dir(typ)
+                     if name.startswith('ARCHI_DEXGRAPH_TRANSITION__')}
+
+
+class DexgraphAotCompiler:
+    """Ahead-of-time compiler of a directed execution graph.
+
+    The generated operation function is named `archi_dexgraph_op__aot_<name>`.
+    Its data is a pointer array of graph nodes in the order of the `nodes` property
+    (see new_node_array()).
+    """
+    def __init__(self, registry, entry, /, name, operations=None):
+        """Extract the graph reachable from the entry node.
+        """
+        if not isinstance(registry, Registry):
+            raise TypeError
+        elif not isinstance(entry, (str, DexgraphNodeContext)):
+            raise TypeError
+        elif not isinstance(name, str):
+            raise TypeError
+        elif not name.isidentifier():
+            raise ValueError(f"'{name}' is not a valid C identifier")
+
+        if isinstance(entry, DexgraphNodeContext):
+            entry = DexgraphNodeContext.key_of(entry)
+
+        self._name = name
+        self._nodes = DexgraphDescription(registry, operations=operations).reachable(entry)
+
+    @property
+    def name(self, /):
+        """Get the generated operation function name (without prefix).
+        """
+        return self._name
+
+    @property
+    def nodes(self, /):
+        """Get the list of descriptions of graph nodes.
+        """
+        return self._nodes
+
+    def source(self, /):
+        """Generate C code.
+        """
+        index = {node.key: position for position, node in enumerate(self.nodes)}
+
+        operations = sorted({function for node in self.nodes
+                             for function in node.sequence if function is not None})
+        transitions = sorted({node.transition_func for node in self.nodes
+                              if node.transition_func is not None
+                              and node.transition_kind == typ.ARCHI_DEXGRAPH_TRANSITION__FUNCTION})
+
+        lines = ['// Generated by archi.aot: do not edit.',
+                 '',
+                 '#include "archi/exec/api/node.typ.h"',
+                 '#include "archi/exec/api/transition.fun.h"',
+                 '']
+
+        lines += [f'ARCHI_DEXGRAPH_OPERATION_FUNC({function});' for function in operations]
+        lines += [f'ARCHI_DEXGRAPH_TRANSITION_FUNC({function});' for function in transitions]
+
+        lines += ['',
+                  f'ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__aot_{self.name});',
+                  '',
+                  f'ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__aot_{self.name})',
+                  '{',
+                  '    const archi_dexgraph_node_t *const *node = data;',
+                  '    archi_dexgraph_branch_index_t branch_index;',
+                  '',
+                  '    archi_error_t error;',
+                  '    ARCHI_ERROR_VAR_RESET(&error);',
+                  '']
+
+        labeled = {branch for node in self.nodes for branch in node.branches}
+
+        for position, node in enumerate(self.nodes):
+            name = node.name.replace('*/', '* /').replace('\n', ' ')
+            lines.append(f'node_{position}: /* {name} */' if node.key in labeled
+                         else f'    /* {name} */')
+
+            for op_index, function in enumerate(node.sequence):
+                if function is None:
+                    continue
+
+                lines += ['    ARCHI_ERROR_VAR_UNSET(&error);',
+                          f'    {function}(node[{position}]->sequence[{op_index}].data, &error);',
+                          '    if (error.code != 0)',
+                          '        goto leave;']
+
+            lines += self._transition(node, position)
+
+            targets = [index[branch] if branch is not None else None for branch in node.branches]
+
+            if not node.transition_data and node.transition_func is None and \
+                    node.transition_kind == typ.ARCHI_DEXGRAPH_TRANSITION__FUNCTION:
+                # branch index is always 0
+                lines += [f'    goto {self._label(targets[0] if targets else None)};', '']
+                continue
+
+            lines += ['    switch (branch_index)',
+                      '    {']
+            lines += [f'        case {branch}: goto {self._label(target)};'
+                      for branch, target in enumerate(targets) if target is not None]
+            lines += ['        default: goto leave;',
+                      '    }',
+                      '']
+
+        lines += ['leave:',
+                  '    ARCHI_ERROR_ASSIGN(error);',
+                  '}',
+                  '']
+
+        return '\n'.join(lines)
+
+    @staticmethod
+    def _label(target, /):
+        """Get a label of a branch target.
+        """
+        return f'node_{target}' if target is not None else 'leave'
+
+    @staticmethod
+    def _transition(node, position, /):
+        """Generate code of a node transition.
+        """
+        data = f'node[{position}]->transition.data'
+
+        if node.transition_kind != typ.ARCHI_DEXGRAPH_TRANSITION__FUNCTION:
+            return [f'    branch_index = archi_dexgraph_transition_builtin(',
+                    f'            (archi_dexgraph_transition_t){{.data = {data}, '
+                    f'.kind = {_TRANSITION_KINDS[node.transition_kind]}}}, &error);',
+                    '    if (error.code != 0)',
+                    '        goto leave;']
+        elif node.transition_func is not None:
+            return ['    ARCHI_ERROR_VAR_UNSET(&error);',
+                    f'    branch_index = {node.transition_func}({data}, &error);',
+                    '    if (error.code != 0)',
+                    '        goto leave;']
+        elif node.transition_data:
+            return [f'    branch_index = ({data} != NULL) ? '
+                    f'*(archi_dexgraph_branch_index_t*){data} : 0;']
+        else:
+            return []
+
+    def write_source(self, pathname, /):
+        """Write generated C code to a file.
+        """
+        with open(pathname, 'w') as file:
+            file.write(self.source())
+
+    @staticmethod
+    def compile_library(source, output, /, include_dirs=(), cc='cc', cflags=('-O2',)):
+        """Compile generated C code into a shared library.
+        """
+        command = [cc, '-std=c17', '-fPIC', '-shared', *cflags]
+        command += [f'-I{include_dir}' for include_dir in include_dirs]
+        command += ['-o', output, source]
+
+        subprocess.run(command, check=True)
+
+    def operation(self, library, /):
+        """Obtain the generated operation function slot from a library context.
+        """
+        if not isinstance(library, LibraryContext):
+            raise TypeError
+
+        return DexgraphOperationFuncSymbol.slot(f'aot_{self.name}', library)
+
+    def new_node_array(self, registry, key, /):
+        """Create the pointer array of graph nodes (operation function data).
+        """
+        if not isinstance(registry, Registry):
+            raise TypeError
+
+        return registry.new_context(key, [registry[node.key] for node in self.nodes])
+
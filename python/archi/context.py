@@ -1106,6 +1106,8 @@ _TYPE_INT = (TypeAttr.from_type(c.c_int),
 _TYPE_LONGLONG = (TypeAttr.from_type(c.c_longlong),
                   lambda value: PrimitiveData(c.c_longlong(value)))
 _TYPE_SIZE = (TypeAttr.from_type(c.c_size_t), _make_size_t)
+_TYPE_UINT64 = (TypeAttr.from_type(c.c_uint64),
+                lambda value: PrimitiveData(c.c_uint64(value)))
 _TYPE_ATTR = (TypeAttr.from_type(TypeAttr),
               lambda value: PrimitiveData(TypeAttr(value)))
 _TYPE_DATA_PTR = TypeAttr.from_type(c.c_void_p)
@@ -1306,11 +1308,14 @@ class DexgraphNodeContext(ContextWhitelist):
                   'sequence_length': _TYPE_SIZE,
                   'transition_func': TypeAttr.function(typ.ARCHI_POINTER_FUNC_TAG__DEXGRAPH_TRANSITION),
                   'transition_data': _TYPE_DATA,
+                  'transition_kind': (TypeAttr.from_type(typ.archi_dexgraph_transition_kind_t),
+                                      lambda value: PrimitiveData(typ.archi_dexgraph_transition_kind_t(value))),
                   'branches': TypeAttr.complex_data(typ.ARCHI_POINTER_DATA_TAG__DEXGRAPH_NODE_ARRAY)}
 
     class ExecuteCallParameters(ParametersWhitelist):
         PARAMS = {'index': (TypeAttr.from_type(typ.archi_dexgraph_branch_index_t),
-                            lambda value: PrimitiveData(typ.archi_dexgraph_branch_index_t(value)))}
+                            lambda value: PrimitiveData(typ.archi_dexgraph_branch_index_t(value))),
+                  'profile': TypeAttr.complex_data(typ.ARCHI_POINTER_DATA_TAG__DEXGRAPH_PROFILE)}
 
     GETTER_SLOTS = {'name': _TYPE_STRING,
                     'sequence.length': _TYPE_SIZE,
@@ -1318,6 +1323,7 @@ class DexgraphNodeContext(ContextWhitelist):
                     'sequence.data': {1: _TYPE_DATA},
                     'transition.function': TypeAttr.function(typ.ARCHI_POINTER_FUNC_TAG__DEXGRAPH_TRANSITION),
                     'transition.data': _TYPE_DATA,
+                    'transition.kind': TypeAttr.from_type(typ.archi_dexgraph_transition_kind_t),
                     'branches': TypeAttr.complex_data(typ.ARCHI_POINTER_DATA_TAG__DEXGRAPH_NODE_ARRAY)}
 
     CALL_SLOTS = {'execute': (None, ExecuteCallParameters)}
@@ -1326,6 +1332,8 @@ class DexgraphNodeContext(ContextWhitelist):
                     'sequence.data': {1: _TYPE_DATA},
                     'transition.function': TypeAttr.function(typ.ARCHI_POINTER_FUNC_TAG__DEXGRAPH_TRANSITION),
                     'transition.data': _TYPE_DATA,
+                    'transition.kind': (TypeAttr.from_type(typ.archi_dexgraph_transition_kind_t),
+                                        lambda value: PrimitiveData(typ.archi_dexgraph_transition_kind_t(value))),
                     'branches': TypeAttr.complex_data(typ.ARCHI_POINTER_DATA_TAG__DEXGRAPH_NODE_ARRAY)}
 
 
@@ -1344,6 +1352,70 @@ class DexgraphNodeArrayContext(ContextWhitelist):
 
     SETTER_SLOTS = {'node': {1: TypeAttr.complex_data(typ.ARCHI_POINTER_DATA_TAG__DEXGRAPH_NODE)}}
 
+
+class DexgraphProgramContext(ContextWhitelist):
+    """Compiled directed execution graph program.
+    """
+    C_NAME = 'dexgraph_program'
+
+    CONTEXT_TYPE = TypeAttr.complex_data(typ.ARCHI_POINTER_DATA_TAG__DEXGRAPH_PROGRAM)
+
+    class InitParameters(ParametersWhitelist):
+        PARAMS = {'entry': TypeAttr.complex_data(typ.ARCHI_POINTER_DATA_TAG__DEXGRAPH_NODE)}
+
+    class ExecuteCallParameters(ParametersWhitelist):
+        PARAMS = {'position': (TypeAttr.from_type(typ.archi_dexgraph_program_position_t),
+                               lambda value: PrimitiveData(typ.archi_dexgraph_program_position_t(value)))}
+
+    GETTER_SLOTS = {'entry': TypeAttr.complex_data(typ.ARCHI_POINTER_DATA_TAG__DEXGRAPH_NODE),
+                    'length': _TYPE_SIZE,
+                    'num_nodes': _TYPE_SIZE}
+
+    CALL_SLOTS = {'execute': (None, ExecuteCallParameters)}
+
+
+class DexgraphDataflowContext(ContextWhitelist):
+    """Dataflow graph of operations.
+    """
+    C_NAME = 'dexgraph_dataflow'
+
+    CONTEXT_TYPE = TypeAttr.complex_data(typ.ARCHI_POINTER_DATA_TAG__DEXGRAPH_DATAFLOW)
+
+    class InitParameters(ParametersWhitelist):
+        PARAMS = {'node': TypeAttr.complex_data(typ.ARCHI_POINTER_DATA_TAG__DEXGRAPH_NODE),
+                  'dependencies': (TypeAttr.from_type(typ.archi_dexgraph_dataflow_dependency_t),
+                                   lambda value: PrimitiveData(
+                                       (typ.archi_dexgraph_dataflow_dependency_t * len(value))(
+                                           *(typ.archi_dexgraph_dataflow_dependency_t(*dep)
+                                             for dep in value))))}
+
+    class ExecuteCallParameters(ParametersWhitelist):
+        PARAMS = {}
+
+    GETTER_SLOTS = {'node': TypeAttr.complex_data(typ.ARCHI_POINTER_DATA_TAG__DEXGRAPH_NODE),
+                    'num_operations': _TYPE_SIZE,
+                    'num_dependencies': _TYPE_SIZE}
+
+    CALL_SLOTS = {'execute': (None, ExecuteCallParameters)}
+
+
+class DexgraphProfileContext(ContextWhitelist):
+    """Directed execution graph execution profile.
+    """
+    C_NAME = 'dexgraph_profile'
+
+    CONTEXT_TYPE = TypeAttr.complex_data(typ.ARCHI_POINTER_DATA_TAG__DEXGRAPH_PROFILE)
+
+    class InitParameters(ParametersWhitelist):
+        PARAMS = {}
+
+    class ResetCallParameters(ParametersWhitelist):
+        PARAMS = {}
+
+    GETTER_SLOTS = {'num_entries': _TYPE_SIZE}
+
+    CALL_SLOTS = {'reset': (None, ResetCallParameters)}
+
 ### archi/thread ###
 
 class ThreadGroupContext(ContextWhitelist):
@@ -1356,9 +1428,34 @@ class ThreadGroupContext(ContextWhitelist):
     class InitParameters(ParametersWhitelist):
         PARAMS = {'params': (TypeAttr.from_type(typ.archi_thread_group_start_params_t),
                              lambda value: PrimitiveData(value)),
-                  'num_threads': _TYPE_SIZE}
+                  'num_threads': _TYPE_SIZE,
+                  'queue_capacity': _TYPE_SIZE,
+                  'spin_ns': _TYPE_UINT64,
+                  'affinity': (TypeAttr.from_type(typ.archi_thread_group_affinity_t),
+                               lambda value: PrimitiveData(typ.archi_thread_group_affinity_t(value))),
+                  'cpus': (TypeAttr.from_type(c.c_size_t),
+                           lambda value: PrimitiveData((c.c_size_t * len(value))(*value))),
+                  'numa_nodes': (TypeAttr.from_type(c.c_size_t),
+                                 lambda value: PrimitiveData((c.c_size_t * len(value))(*value))),
+                  'scratch_size': _TYPE_SIZE,
+                  'scratch_interface': TypeAttr.complex_data(typ.ARCHI_POINTER_DATA_TAG__MEMORY_INTERFACE),
+                  'scratch_alloc_data': _TYPE_DATA,
+                  'stats': _TYPE_BOOL,
+                  'notify': _TYPE_BOOL}
+
+    class ResetStatsCallParameters(ParametersWhitelist):
+        PARAMS = {}
+
+    class ClearNotifyCallParameters(ParametersWhitelist):
+        PARAMS = {}
 
-    GETTER_SLOTS = {'num_threads': _TYPE_SIZE}
+    GETTER_SLOTS = {'num_threads': _TYPE_SIZE,
+                    'stats': TypeAttr.from_type(typ.archi_thread_group_stats_t),
+                    'thread_stats': {1: TypeAttr.from_type(typ.archi_thread_group_thread_stats_t)},
+                    'notify_fd': _TYPE_INT}
+
+    CALL_SLOTS = {'reset_stats': (None, ResetStatsCallParameters),
+                  'clear_notify': (None, ClearNotifyCallParameters)}
 
 
 class LockFreeQueueContext(ContextWhitelist):
@@ -1377,6 +1474,71 @@ class LockFreeQueueContext(ContextWhitelist):
     GETTER_SLOTS = {'capacity': _TYPE_SIZE,
                     'elt_size': _TYPE_SIZE}
 
+
+class ThreadSchedulerContext(ContextWhitelist):
+    """Scheduler of directed execution graph frames.
+    """
+    C_NAME = 'thread_scheduler'
+
+    CONTEXT_TYPE = TypeAttr.complex_data(typ.ARCHI_POINTER_DATA_TAG__THREAD_SCHEDULER)
+
+    class InitParameters(ParametersWhitelist):
+        PARAMS = {'params': (TypeAttr.from_type(typ.archi_thread_scheduler_start_params_t),
+                             lambda value: PrimitiveData(value)),
+                  'num_threads': _TYPE_SIZE,
+                  'max_tasks': _TYPE_SIZE}
+
+    class SubmitCallParameters(ParametersWhitelist):
+        PARAMS = {'node': TypeAttr.complex_data(typ.ARCHI_POINTER_DATA_TAG__DEXGRAPH_NODE),
+                  'index': _TYPE_SIZE}
+
+    class WaitCallParameters(ParametersWhitelist):
+        PARAMS = {}
+
+    GETTER_SLOTS = {'num_threads': _TYPE_SIZE,
+                    'num_tasks': _TYPE_SIZE}
+
+    CALL_SLOTS = {'submit': (None, SubmitCallParameters),
+                  'wait': (None, WaitCallParameters)}
+
+
+class ThreadPipelineContext(ContextWhitelist):
+    """Pipeline of directed execution graph stages connected by lock-free queues.
+    """
+    C_NAME = 'thread_pipeline'
+
+    CONTEXT_TYPE = TypeAttr.complex_data(typ.ARCHI_POINTER_DATA_TAG__THREAD_PIPELINE)
+
+    class InitParameters(ParametersWhitelist):
+        PARAMS = {'params': (TypeAttr.from_type(typ.archi_thread_pipeline_start_params_t),
+                             lambda value: PrimitiveData(value)),
+                  'num_stages': _TYPE_SIZE,
+                  'spin_ns': _TYPE_UINT64}
+
+    class StartCallParameters(ParametersWhitelist):
+        PARAMS = {}
+
+    class StopCallParameters(ParametersWhitelist):
+        PARAMS = {}
+
+    class WaitCallParameters(ParametersWhitelist):
+        PARAMS = {}
+
+    GETTER_SLOTS = {'num_stages': _TYPE_SIZE,
+                    'stage.entry': {1: TypeAttr.complex_data(typ.ARCHI_POINTER_DATA_TAG__DEXGRAPH_NODE)},
+                    'stage.input': {1: TypeAttr.complex_data(typ.ARCHI_POINTER_DATA_TAG__THREAD_LFQUEUE)},
+                    'stage.output': {1: TypeAttr.complex_data(typ.ARCHI_POINTER_DATA_TAG__THREAD_LFQUEUE)},
+                    'stage.item': {1: _TYPE_DATA}}
+
+    SETTER_SLOTS = {'stage.entry': {1: TypeAttr.complex_data(typ.ARCHI_POINTER_DATA_TAG__DEXGRAPH_NODE)},
+                    'stage.input': {1: TypeAttr.complex_data(typ.ARCHI_POINTER_DATA_TAG__THREAD_LFQUEUE)},
+                    'stage.output': {1: TypeAttr.complex_data(typ.ARCHI_POINTER_DATA_TAG__THREAD_LFQUEUE)},
+                    'stage.item': {1: _TYPE_DATA}}
+
+    CALL_SLOTS = {'start': (None, StartCallParameters),
+                  'stop': (None, StopCallParameters),
+                  'wait': (None, WaitCallParameters)}
+
 ### archi/signal ###
 
 class SignalHandlerDataHashmapContext(ContextBase):
@@ -497,11 +497,41 @@ class archi_aggr_type_t(c.Structure):
 
 ARCHI_POINTER_DATA_TAG__DEXGRAPH_NODE = 0x30
 ARCHI_POINTER_DATA_TAG__DEXGRAPH_NODE_ARRAY = 0x31
+ARCHI_POINTER_DATA_TAG__DEXGRAPH_PROGRAM = 0x32
+ARCHI_POINTER_DATA_TAG__DEXGRAPH_PROFILE = 0x33
+ARCHI_POINTER_DATA_TAG__DEXGRAPH_DATAFLOW = 0x34
 ARCHI_POINTER_FUNC_TAG__DEXGRAPH_OPERATION = 0x30
 ARCHI_POINTER_FUNC_TAG__DEXGRAPH_TRANSITION = 0x31
 
 
 archi_dexgraph_branch_index_t = c.c_size_t
+archi_dexgraph_program_position_t = c.c_size_t
+archi_dexgraph_transition_kind_t = c.c_int
+
+ARCHI_DEXGRAPH_TRANSITION__FUNCTION = 0
+ARCHI_DEXGRAPH_TRANSITION__LOOP = 1
+ARCHI_DEXGRAPH_TRANSITION__SIGNAL_FLAG = 2
+ARCHI_DEXGRAPH_TRANSITION__SWITCH = 3
+ARCHI_DEXGRAPH_TRANSITION__ATOMIC_FLAG = 4
+
+
+class archi_dexgraph_dataflow_dependency_t(c.Structure):
+    """Dependency between operations of a dataflow graph.
+    """
+    _fields_ = [('operation', c.c_size_t),
+                ('dependency', c.c_size_t)]
+
+##############################################################################
+# Execution tracing
+##############################################################################
+
+class archi_trace_start_params_t(c.Structure):
+    """Tracing start parameters.
+    """
+    _fields_ = [('capacity', c.c_size_t)]
+
+    def __init__(self, /, capacity=0):
+        self.capacity = capacity
 
 ##############################################################################
 # Concurrent processing
@@ -509,17 +539,88 @@ archi_dexgraph_branch_index_t = c.c_size_t
 
 ARCHI_POINTER_DATA_TAG__THREAD_GROUP = 0x40
 ARCHI_POINTER_DATA_TAG__THREAD_LFQUEUE = 0x41
+ARCHI_POINTER_DATA_TAG__THREAD_SCHEDULER = 0x42
+ARCHI_POINTER_DATA_TAG__THREAD_PIPELINE = 0x43
 ARCHI_POINTER_FUNC_TAG__THREAD_WORK = 0x40
 ARCHI_POINTER_FUNC_TAG__THREAD_CALLBACK = 0x41
+ARCHI_POINTER_FUNC_TAG__THREAD_TILE_WORK = 0x42
+ARCHI_POINTER_FUNC_TAG__THREAD_REDUCE = 0x43
+ARCHI_POINTER_FUNC_TAG__THREAD_COMBINE = 0x44
+ARCHI_POINTER_FUNC_TAG__THREAD_PHASE_WORK = 0x45
+
+
+archi_thread_group_affinity_t = c.c_int
+
+ARCHI_THREAD_GROUP_AFFINITY__NONE = 0
+ARCHI_THREAD_GROUP_AFFINITY__COMPACT = 1
+ARCHI_THREAD_GROUP_AFFINITY__SCATTER = 2
+
+archi_thread_group_schedule_t = c.c_int
+
+ARCHI_THREAD_GROUP_SCHEDULE__SHARED = 0
+ARCHI_THREAD_GROUP_SCHEDULE__STEAL = 1
+ARCHI_THREAD_GROUP_SCHEDULE__GUIDED = 2
+ARCHI_THREAD_GROUP_SCHEDULE__ADAPTIVE = 3
+
+archi_thread_group_tile_order_t = c.c_int
+
+ARCHI_THREAD_GROUP_TILE_ORDER__ROW_MAJOR = 0
+ARCHI_THREAD_GROUP_TILE_ORDER__MORTON = 1
 
 
 class archi_thread_group_start_params_t(c.Structure):
     """Thread group creation parameters.
     """
-    _fields_ = [('num_threads', c.c_size_t)]
+    _fields_ = [('num_threads', c.c_size_t),
+                ('queue_capacity', c.c_size_t),
+                ('spin_ns', c.c_uint64),
+                ('affinity', archi_thread_group_affinity_t),
+                ('cpu', c.POINTER(c.c_size_t)),
+                ('num_cpus', c.c_size_t),
+                ('numa_node', c.POINTER(c.c_size_t)),
+                ('num_numa_nodes', c.c_size_t),
+                ('scratch_size', c.c_size_t),
+                ('scratch_interface', c.c_void_p),
+                ('scratch_alloc_data', c.c_void_p),
+                ('stats', c.c_bool),
+                ('notify', c.c_bool)]
+
+    def __init__(self, /, num_threads, queue_capacity=0, spin_ns=0,
+                 affinity=ARCHI_THREAD_GROUP_AFFINITY__NONE, scratch_size=0, stats=False, notify=False):
+        if queue_capacity < 0:
+            raise ValueError
+        elif spin_ns < 0:
+            raise ValueError
+        elif scratch_size < 0:
+            raise ValueError
 
-    def __init__(self, /, num_threads):
         self.num_threads = num_threads
+        self.queue_capacity = queue_capacity
+        self.spin_ns = spin_ns
+        self.affinity = affinity
+        self.scratch_size = scratch_size
+        self.stats = stats
+        self.notify = notify
+
+
+class archi_thread_group_thread_stats_t(c.Structure):
+    """Utilization statistics of a thread of a group.
+    """
+    _fields_ = [('num_work_items', c.c_uint64),
+                ('num_batches', c.c_uint64),
+                ('busy_ns', c.c_uint64),
+                ('wait_ns', c.c_uint64),
+                ('num_wakeups', c.c_uint64),
+                ('wake_latency_ns', c.c_uint64),
+                ('max_wake_latency_ns', c.c_uint64)]
+
+
+class archi_thread_group_stats_t(c.Structure):
+    """Utilization statistics of a thread group.
+    """
+    _fields_ = [('num_dispatches', c.c_uint64),
+                ('tail_ns', c.c_uint64),
+                ('max_tail_ns', c.c_uint64)]
 
 
 class archi_thread_lfqueue_alloc_params_t(c.Structure):
@@ -537,6 +638,38 @@ class archi_thread_lfqueue_alloc_params_t(c.Structure):
         self.capacity = capacity
         self.elt_size = elt_size
 
+
+class archi_thread_scheduler_start_params_t(c.Structure):
+    """Scheduler creation parameters.
+    """
+    _fields_ = [('num_threads', c.c_size_t),
+                ('max_tasks', c.c_size_t)]
+
+    def __init__(self, /, num_threads, max_tasks):
+        if num_threads <= 0:
+            raise ValueError
+        elif max_tasks <= 0:
+            raise ValueError
+
+        self.num_threads = num_threads
+        self.max_tasks = max_tasks
+
+
+class archi_thread_pipeline_start_params_t(c.Structure):
+    """Pipeline creation parameters.
+    """
+    _fields_ = [('num_stages', c.c_size_t),
+                ('spin_ns', c.c_uint64)]
+
+    def __init__(self, /, num_stages, spin_ns=0):
+        if num_stages < 0:
+            raise ValueError
+        elif spin_ns < 0:
+            raise ValueError
+
+        self.num_stages = num_stages
+        self.spin_ns = spin_ns
+
 ##############################################################################
 # Signal management
 ##############################################################################
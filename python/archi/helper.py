@@ -67,7 +67,8 @@ def new_aggregate_object(registry, key, /, interface=None, metadata=None, fam_le
 def new_thread_group_dispatch_func_data(registry, key, /, thread_group=None,
                                         work_func=None, work_data=None,
                                         callback_func=None, callback_data=None,
-                                        work_offset=None, work_size=None, batch_size=None):
+                                        work_offset=None, work_size=None, batch_size=None,
+                                        schedule=None, data_type='thread_group_dispatch'):
     """Create thread group dispatching function data.
     """
     if not isinstance(registry, Registry):
@@ -123,8 +124,387 @@ def new_thread_group_dispatch_func_data(registry, key, /, thread_group=None,
             TypeAttr.of(batch_size), TypeAttr.from_type(c.c_size_t)):
         raise TypeError
 
+    if isinstance(schedule, int):
+        schedule = PrimitiveData(typ.archi_thread_group_schedule_t(schedule))
+    elif schedule is not None and not TypeAttr.compatible(
+            TypeAttr.of(schedule), TypeAttr.from_type(typ.archi_thread_group_schedule_t)):
+        raise TypeError
+
+    dispatch_data = new_aggregate_object(registry, key, metadata=AggregateTypeSymbol.slot(
+        DexgraphOperationDataSymbol.full_name(data_type), registry.BUILTIN.executable))
+
+    if thread_group is not None:
+        registry(dispatch_data.member.thread_group << thread_group)
+    if work_func is not None:
+        registry(dispatch_data.member.work.function << work_func)
+    if work_data is not None:
+        registry(dispatch_data.member.work.data << work_data)
+    if callback_func is not None:
+        registry(dispatch_data.member.callback.function << callback_func)
+    if callback_data is not None:
+        registry(dispatch_data.member.callback.data << callback_data)
+    if work_offset is not None:
+        registry(dispatch_data.member.param.offset << work_offset)
+    if work_size is not None:
+        registry(dispatch_data.member.param.size << work_size)
+    if batch_size is not None:
+        registry(dispatch_data.member.param.batch_size << batch_size)
+    if schedule is not None:
+        registry(dispatch_data.member.param.schedule << schedule)
+
+    return dispatch_data
+
+
+def new_thread_group_enqueue_func_data(registry, key, /, thread_group=None,
+                                       work_func=None, work_data=None,
+                                       callback_func=None, callback_data=None,
+                                       work_offset=None, work_size=None, batch_size=None,
+                                       schedule=None, after=None, ticket=None):
+    """Create thread group enqueueing function data.
+
+    Dependency and ticket are size_t data objects, so that one operation
+    could store the ticket another one depends on.
+    """
+    if not isinstance(registry, Registry):
+        raise TypeError
+
+    if after is not None and not TypeAttr.compatible(
+            TypeAttr.of(after), TypeAttr.from_type(c.c_size_t)):
+        raise TypeError
+
+    if ticket is not None and not TypeAttr.compatible(
+            TypeAttr.of(ticket), TypeAttr.from_type(c.c_size_t, writable=True)):
+        raise TypeError
+
+    dispatch_data = new_thread_group_dispatch_func_data(registry, key, thread_group=thread_group,
+                                                        work_func=work_func, work_data=work_data,
+                                                        callback_func=callback_func,
+                                                        callback_data=callback_data,
+                                                        work_offset=work_offset, work_size=work_size,
+                                                        batch_size=batch_size, schedule=schedule,
+                                                        data_type='thread_group_enqueue')
+
+    if after is not None:
+        registry(dispatch_data.member.after << after)
+    if ticket is not None:
+        registry(dispatch_data.member.ticket << ticket)
+
+    return dispatch_data
+
+
+def new_thread_group_cancel_func_data(registry, key, /, thread_group=None, ticket=None):
+    """Create thread group cancellation function data.
+
+    If ticket is not set, all incomplete work tasks are cancelled.
+    """
+    if not isinstance(registry, Registry):
+        raise TypeError
+
+    if thread_group is not None and not TypeAttr.compatible(
+            TypeAttr.of(thread_group),
+            TypeAttr.complex_data(typ.ARCHI_POINTER_DATA_TAG__THREAD_GROUP)):
+        raise TypeError
+
+    if ticket is not None and not TypeAttr.compatible(
+            TypeAttr.of(ticket), TypeAttr.from_type(c.c_size_t)):
+        raise TypeError
+
+    cancel_data = new_aggregate_object(registry, key, metadata=AggregateTypeSymbol.slot(
+        DexgraphOperationDataSymbol.full_name('thread_group_cancel'), registry.BUILTIN.executable))
+
+    if thread_group is not None:
+        registry(cancel_data.member.thread_group << thread_group)
+    if ticket is not None:
+        registry(cancel_data.member.ticket << ticket)
+
+    return cancel_data
+
+
+def new_thread_group_wait_ticket_func_data(registry, key, /, thread_group=None, ticket=None):
+    """Create thread group ticket waiting function data.
+    """
+    if not isinstance(registry, Registry):
+        raise TypeError
+
+    if thread_group is not None and not TypeAttr.compatible(
+            TypeAttr.of(thread_group),
+            TypeAttr.complex_data(typ.ARCHI_POINTER_DATA_TAG__THREAD_GROUP)):
+        raise TypeError
+
+    if ticket is not None and not TypeAttr.compatible(
+            TypeAttr.of(ticket), TypeAttr.from_type(c.c_size_t)):
+        raise TypeError
+
+    wait_data = new_aggregate_object(registry, key, metadata=AggregateTypeSymbol.slot(
+        DexgraphOperationDataSymbol.full_name('thread_group_wait_ticket'), registry.BUILTIN.executable))
+
+    if thread_group is not None:
+        registry(wait_data.member.thread_group << thread_group)
+    if ticket is not None:
+        registry(wait_data.member.ticket << ticket)
+
+    return wait_data
+
+
+def new_thread_group_dispatch_tiled_func_data(registry, key, /, thread_group=None,
+                                              work_func=None, work_data=None,
+                                              callback_func=None, callback_data=None,
+                                              size=None, tile_size=None, order=None,
+                                              batch_size=None, schedule=None):
+    """Create thread group tiled dispatching function data.
+
+    Domain and tile sizes are sequences of up to 3 elements (x, y, z).
+    Missing trailing dimensions of the domain size are set to 1.
+    """
+    if not isinstance(registry, Registry):
+        raise TypeError
+
+    if thread_group is not None and not TypeAttr.compatible(
+            TypeAttr.of(thread_group),
+            TypeAttr.complex_data(typ.ARCHI_POINTER_DATA_TAG__THREAD_GROUP)):
+        raise TypeError
+
+    if work_func is not None and not TypeAttr.compatible(
+            TypeAttr.of(work_func),
+            TypeAttr.function(typ.ARCHI_POINTER_FUNC_TAG__THREAD_TILE_WORK)):
+        raise TypeError
+
+    if work_data is not None and not TypeAttr.compatible(
+            TypeAttr.of(work_data), TypeAttr.complex_data()):
+        raise TypeError
+
+    if callback_func is not None and not TypeAttr.compatible(
+            TypeAttr.of(callback_func),
+            TypeAttr.function(typ.ARCHI_POINTER_FUNC_TAG__THREAD_CALLBACK)):
+        raise TypeError
+
+    if callback_data is not None and not TypeAttr.compatible(
+            TypeAttr.of(callback_data), TypeAttr.complex_data()):
+        raise TypeError
+
+    def dimensions(value):
+        if value is None:
+            return []
+        elif not isinstance(value, (list, tuple)):
+            raise TypeError
+        elif len(value) > 3:
+            raise ValueError
+
+        result = []
+        for elt in value:
+            if isinstance(elt, int):
+                if elt < 0:
+                    raise ValueError
+
+                elt = PrimitiveData(c.c_size_t(elt))
+            elif not TypeAttr.compatible(TypeAttr.of(elt), TypeAttr.from_type(c.c_size_t)):
+                raise TypeError
+
+            result.append(elt)
+
+        return result
+
+    size = dimensions(size)
+    tile_size = dimensions(tile_size)
+
+    if size:
+        size += [PrimitiveData(c.c_size_t(1)) for _ in range(3 - len(size))]
+
+    if isinstance(order, int):
+        order = PrimitiveData(typ.archi_thread_group_tile_order_t(order))
+    elif order is not None and not TypeAttr.compatible(
+            TypeAttr.of(order), TypeAttr.from_type(typ.archi_thread_group_tile_order_t)):
+        raise TypeError
+
+    if isinstance(batch_size, int):
+        if batch_size < 0:
+            raise ValueError
+
+        batch_size = PrimitiveData(c.c_size_t(batch_size))
+    elif batch_size is not None and not TypeAttr.compatible(
+            TypeAttr.of(batch_size), TypeAttr.from_type(c.c_size_t)):
+        raise TypeError
+
+    if isinstance(schedule, int):
+        schedule = PrimitiveData(typ.archi_thread_group_schedule_t(schedule))
+    elif schedule is not None and not TypeAttr.compatible(
+            TypeAttr.of(schedule), TypeAttr.from_type(typ.archi_thread_group_schedule_t)):
+        raise TypeError
+
+    dispatch_data = new_aggregate_object(registry, key, metadata=AggregateTypeSymbol.slot(
+        DexgraphOperationDataSymbol.full_name('thread_group_dispatch_tiled'), registry.BUILTIN.executable))
+
+    if thread_group is not None:
+        registry(dispatch_data.member.thread_group << thread_group)
+    if work_func is not None:
+        registry(dispatch_data.member.work.function << work_func)
+    if work_data is not None:
+        registry(dispatch_data.member.work.data << work_data)
+    if callback_func is not None:
+        registry(dispatch_data.member.callback.function << callback_func)
+    if callback_data is not None:
+        registry(dispatch_data.member.callback.data << callback_data)
+    for index, elt in enumerate(size):
+        registry(dispatch_data.member.param.size[0, index] << elt)
+    for index, elt in enumerate(tile_size):
+        registry(dispatch_data.member.param.tile_size[0, index] << elt)
+    if order is not None:
+        registry(dispatch_data.member.param.order << order)
+    if batch_size is not None:
+        registry(dispatch_data.member.param.batch_size << batch_size)
+    if schedule is not None:
+        registry(dispatch_data.member.param.schedule << schedule)
+
+    return dispatch_data
+
+
+def new_thread_group_dispatch_reduce_func_data(registry, key, /, thread_group=None,
+                                               accumulate_func=None, combine_func=None, reduction_data=None,
+                                               identity=None, value_size=None, result=None,
+                                               callback_func=None, callback_data=None,
+                                               work_offset=None, work_size=None, batch_size=None,
+                                               schedule=None):
+    """Create thread group reduction dispatching function data.
+    """
+    if not isinstance(registry, Registry):
+        raise TypeError
+
+    if thread_group is not None and not TypeAttr.compatible(
+            TypeAttr.of(thread_group),
+            TypeAttr.complex_data(typ.ARCHI_POINTER_DATA_TAG__THREAD_GROUP)):
+        raise TypeError
+
+    if accumulate_func is not None and not TypeAttr.compatible(
+            TypeAttr.of(accumulate_func),
+            TypeAttr.function(typ.ARCHI_POINTER_FUNC_TAG__THREAD_REDUCE)):
+        raise TypeError
+
+    if combine_func is not None and not TypeAttr.compatible(
+            TypeAttr.of(combine_func),
+            TypeAttr.function(typ.ARCHI_POINTER_FUNC_TAG__THREAD_COMBINE)):
+        raise TypeError
+
+    for data in (reduction_data, identity, result, callback_data):
+        if data is not None and not TypeAttr.compatible(
+                TypeAttr.of(data), TypeAttr.complex_data()):
+            raise TypeError
+
+    if callback_func is not None and not TypeAttr.compatible(
+            TypeAttr.of(callback_func),
+            TypeAttr.function(typ.ARCHI_POINTER_FUNC_TAG__THREAD_CALLBACK)):
+        raise TypeError
+
+    def size_value(value):
+        if isinstance(value, int):
+            if value < 0:
+                raise ValueError
+
+            value = PrimitiveData(c.c_size_t(value))
+        elif value is not None and not TypeAttr.compatible(
+                TypeAttr.of(value), TypeAttr.from_type(c.c_size_t)):
+            raise TypeError
+
+        return value
+
+    value_size = size_value(value_size)
+    work_offset = size_value(work_offset)
+    work_size = size_value(work_size)
+    batch_size = size_value(batch_size)
+
+    if isinstance(schedule, int):
+        schedule = PrimitiveData(typ.archi_thread_group_schedule_t(schedule))
+    elif schedule is not None and not TypeAttr.compatible(
+            TypeAttr.of(schedule), TypeAttr.from_type(typ.archi_thread_group_schedule_t)):
+        raise TypeError
+
+    dispatch_data = new_aggregate_object(registry, key, metadata=AggregateTypeSymbol.slot(
+        DexgraphOperationDataSymbol.full_name('thread_group_dispatch_reduce'), registry.BUILTIN.executable))
+
+    if thread_group is not None:
+        registry(dispatch_data.member.thread_group << thread_group)
+    if accumulate_func is not None:
+        registry(dispatch_data.member.reduction.accumulate << accumulate_func)
+    if combine_func is not None:
+        registry(dispatch_data.member.reduction.combine << combine_func)
+    if reduction_data is not None:
+        registry(dispatch_data.member.reduction.data << reduction_data)
+    if identity is not None:
+        registry(dispatch_data.member.reduction.identity << identity)
+    if value_size is not None:
+        registry(dispatch_data.member.reduction.value_size << value_size)
+    if result is not None:
+        registry(dispatch_data.member.reduction.result << result)
+    if callback_func is not None:
+        registry(dispatch_data.member.callback.function << callback_func)
+    if callback_data is not None:
+        registry(dispatch_data.member.callback.data << callback_data)
+    if work_offset is not None:
+        registry(dispatch_data.member.param.offset << work_offset)
+    if work_size is not None:
+        registry(dispatch_data.member.param.size << work_size)
+    if batch_size is not None:
+        registry(dispatch_data.member.param.batch_size << batch_size)
+    if schedule is not None:
+        registry(dispatch_data.member.param.schedule << schedule)
+
+    return dispatch_data
+
+
+def new_thread_group_dispatch_phased_func_data(registry, key, /, thread_group=None,
+                                               work_func=None, work_data=None, num_phases=None,
+                                               callback_func=None, callback_data=None,
+                                               work_offset=None, work_size=None, batch_size=None,
+                                               schedule=None):
+    """Create thread group multi-phase work dispatching function data.
+    """
+    if not isinstance(registry, Registry):
+        raise TypeError
+
+    if thread_group is not None and not TypeAttr.compatible(
+            TypeAttr.of(thread_group),
+            TypeAttr.complex_data(typ.ARCHI_POINTER_DATA_TAG__THREAD_GROUP)):
+        raise TypeError
+
+    if work_func is not None and not TypeAttr.compatible(
+            TypeAttr.of(work_func),
+            TypeAttr.function(typ.ARCHI_POINTER_FUNC_TAG__THREAD_PHASE_WORK)):
+        raise TypeError
+
+    for data in (work_data, callback_data):
+        if data is not None and not TypeAttr.compatible(
+                TypeAttr.of(data), TypeAttr.complex_data()):
+            raise TypeError
+
+    if callback_func is not None and not TypeAttr.compatible(
+            TypeAttr.of(callback_func),
+            TypeAttr.function(typ.ARCHI_POINTER_FUNC_TAG__THREAD_CALLBACK)):
+        raise TypeError
+
+    def size_value(value):
+        if isinstance(value, int):
+            if value < 0:
+                raise ValueError
+
+            value = PrimitiveData(c.c_size_t(value))
+        elif value is not None and not TypeAttr.compatible(
+                TypeAttr.of(value), TypeAttr.from_type(c.c_size_t)):
+            raise TypeError
+
+        return value
+
+    num_phases = size_value(num_phases)
+    work_offset = size_value(work_offset)
+    work_size = size_value(work_size)
+    batch_size = size_value(batch_size)
+
+    if isinstance(schedule, int):
+        schedule = PrimitiveData(typ.archi_thread_group_schedule_t(schedule))
+    elif schedule is not None and not TypeAttr.compatible(
+            TypeAttr.of(schedule), TypeAttr.from_type(typ.archi_thread_group_schedule_t)):
+        raise TypeError
+
     dispatch_data = new_aggregate_object(registry, key, metadata=AggregateTypeSymbol.slot(
-        DexgraphOperationDataSymbol.full_name('thread_group_dispatch'), registry.BUILTIN.executable))
+        DexgraphOperationDataSymbol.full_name('thread_group_dispatch_phased'), registry.BUILTIN.executable))
 
     if thread_group is not None:
         registry(dispatch_data.member.thread_group << thread_group)
@@ -132,6 +512,8 @@ def new_thread_group_dispatch_func_data(registry, key, /, thread_group=None,
         registry(dispatch_data.member.work.function << work_func)
     if work_data is not None:
         registry(dispatch_data.member.work.data << work_data)
+    if num_phases is not None:
+        registry(dispatch_data.member.work.num_phases << num_phases)
     if callback_func is not None:
         registry(dispatch_data.member.callback.function << callback_func)
     if callback_data is not None:
@@ -142,9 +524,177 @@ def new_thread_group_dispatch_func_data(registry, key, /, thread_group=None,
         registry(dispatch_data.member.param.size << work_size)
     if batch_size is not None:
         registry(dispatch_data.member.param.batch_size << batch_size)
+    if schedule is not None:
+        registry(dispatch_data.member.param.schedule << schedule)
 
     return dispatch_data
 
+
+def new_thread_group_fork_join_func_data(registry, key, /, thread_group=None,
+                                         branches=None, branch_error=None):
+    """Create thread group fork-join function data.
+    """
+    if not isinstance(registry, Registry):
+        raise TypeError
+
+    if thread_group is not None and not TypeAttr.compatible(
+            TypeAttr.of(thread_group),
+            TypeAttr.complex_data(typ.ARCHI_POINTER_DATA_TAG__THREAD_GROUP)):
+        raise TypeError
+
+    if branches is not None and not TypeAttr.compatible(
+            TypeAttr.of(branches),
+            TypeAttr.complex_data(typ.ARCHI_POINTER_DATA_TAG__DEXGRAPH_NODE_ARRAY)):
+        raise TypeError
+
+    if branch_error is not None and not TypeAttr.compatible(
+            TypeAttr.of(branch_error), TypeAttr.complex_data()):
+        raise TypeError
+
+    fork_join_data = new_aggregate_object(registry, key, metadata=AggregateTypeSymbol.slot(
+        DexgraphOperationDataSymbol.full_name('thread_group_fork_join'), registry.BUILTIN.executable))
+
+    if thread_group is not None:
+        registry(fork_join_data.member.thread_group << thread_group)
+    if branches is not None:
+        registry(fork_join_data.member.branches << branches)
+    if branch_error is not None:
+        registry(fork_join_data.member.branch_error << branch_error)
+
+    return fork_join_data
+
+
+def new_thread_group_dataflow_func_data(registry, key, /, thread_group=None, dataflow=None):
+    """Create thread group dataflow graph execution function data.
+    """
+    if not isinstance(registry, Registry):
+        raise TypeError
+
+    if thread_group is not None and not TypeAttr.compatible(
+            TypeAttr.of(thread_group),
+            TypeAttr.complex_data(typ.ARCHI_POINTER_DATA_TAG__THREAD_GROUP)):
+        raise TypeError
+
+    if dataflow is not None and not TypeAttr.compatible(
+            TypeAttr.of(dataflow),
+            TypeAttr.complex_data(typ.ARCHI_POINTER_DATA_TAG__DEXGRAPH_DATAFLOW)):
+        raise TypeError
+
+    dataflow_data = new_aggregate_object(registry, key, metadata=AggregateTypeSymbol.slot(
+        DexgraphOperationDataSymbol.full_name('thread_group_dataflow'), registry.BUILTIN.executable))
+
+    if thread_group is not None:
+        registry(dataflow_data.member.thread_group << thread_group)
+    if dataflow is not None:
+        registry(dataflow_data.member.dataflow << dataflow)
+
+    return dataflow_data
+
+
+def new_thread_scheduler_submit_func_data(registry, key, /, scheduler=None,
+                                          node=None, index=None):
+    """Create scheduler task submission function data.
+    """
+    if not isinstance(registry, Registry):
+        raise TypeError
+
+    if scheduler is not None and not TypeAttr.compatible(
+            TypeAttr.of(scheduler),
+            TypeAttr.complex_data(typ.ARCHI_POINTER_DATA_TAG__THREAD_SCHEDULER)):
+        raise TypeError
+
+    if node is not None and not TypeAttr.compatible(
+            TypeAttr.of(node),
+            TypeAttr.complex_data(typ.ARCHI_POINTER_DATA_TAG__DEXGRAPH_NODE)):
+        raise TypeError
+
+    if isinstance(index, int):
+        if index < 0:
+            raise ValueError
+
+        index = PrimitiveData(c.c_size_t(index))
+    elif index is not None and not TypeAttr.compatible(
+            TypeAttr.of(index), TypeAttr.from_type(c.c_size_t)):
+        raise TypeError
+
+    submit_data = new_aggregate_object(registry, key, metadata=AggregateTypeSymbol.slot(
+        DexgraphOperationDataSymbol.full_name('thread_scheduler_submit'), registry.BUILTIN.executable))
+
+    if scheduler is not None:
+        registry(submit_data.member.scheduler << scheduler)
+    if node is not None:
+        registry(submit_data.member.node << node)
+    if index is not None:
+        registry(submit_data.member.index << index)
+
+    return submit_data
+
+
+def _new_thread_lfqueue_transfer_func_data(registry, key, /, queue, values, num_values,
+                                           num_done, data_type, num_done_name):
+    if not isinstance(registry, Registry):
+        raise TypeError
+
+    if queue is not None and not TypeAttr.compatible(
+            TypeAttr.of(queue),
+            TypeAttr.complex_data(typ.ARCHI_POINTER_DATA_TAG__THREAD_LFQUEUE)):
+        raise TypeError
+
+    if values is not None and not TypeAttr.compatible(
+            TypeAttr.of(values), TypeAttr.complex_data()):
+        raise TypeError
+
+    if isinstance(num_values, int):
+        if num_values < 0:
+            raise ValueError
+
+        num_values = PrimitiveData(c.c_size_t(num_values))
+    elif num_values is not None and not TypeAttr.compatible(
+            TypeAttr.of(num_values), TypeAttr.from_type(c.c_size_t)):
+        raise TypeError
+
+    if num_done is not None and not TypeAttr.compatible(
+            TypeAttr.of(num_done), TypeAttr.from_type(c.c_size_t, writable=True)):
+        raise TypeError
+
+    transfer_data = new_aggregate_object(registry, key, metadata=AggregateTypeSymbol.slot(
+        DexgraphOperationDataSymbol.full_name(data_type), registry.BUILTIN.executable))
+
+    if queue is not None:
+        registry(transfer_data.member.queue << queue)
+    if values is not None:
+        registry(transfer_data.member.values << values)
+    if num_values is not None:
+        registry(transfer_data.member.num_values << num_values)
+    if num_done is not None:
+        registry(getattr(transfer_data.member, num_done_name) << num_done)
+
+    return transfer_data
+
+
+def new_thread_lfqueue_push_n_func_data(registry, key, /, queue=None, values=None,
+                                        num_values=None, num_pushed=None):
+    """Create lock-free queue multiple values pushing function data.
+
+    Number of pushed values is stored to a size_t data object, if provided.
+    """
+    return _new_thread_lfqueue_transfer_func_data(registry, key, queue=queue, values=values,
+                                                  num_values=num_values, num_done=num_pushed,
+                                                  data_type='thread_lfqueue_push_n',
+                                                  num_done_name='num_pushed')
+
+
+def new_thread_lfqueue_pop_n_func_data(registry, key, /, queue=None, values=None,
+                                       num_values=None, num_popped=None):
+    """Create lock-free queue multiple values popping function data.
+
+    Number of popped values is stored to a size_t data object, if provided.
+    """
+    return _new_thread_lfqueue_transfer_func_data(registry, key, queue=queue, values=values,
+                                                  num_values=num_values, num_done=num_popped,
+                                                  data_type='thread_lfqueue_pop_n',
+                                                  num_done_name='num_popped')
+
 ### archi/memory ###
 
 def heap_memory_interface(executable, /):
@@ -0,0 +1,163 @@
+ #############################################################################
+ # Copyright (C) 2023-2026 by Ivan Podmazov                                  #
+ #                                                                           #
+ # This file is part of Archipelago.                                         #
+ #                                                                           #
+ #   Archipelago is free software: you can redistribute it and/or modify it  #
+ #   under the terms of the GNU Lesser General Public License as published   #
+ #   by the Free Software Foundation, either version 3 of the License, or    #
+ #   (at your option) any later version.                                     #
+ #                                                                           #
+ #   Archipelago is distributed in the hope that it will be useful,          #
+ #   but WITHOUT ANY WARRANTY; without even the implied warranty of          #
+ #   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           #
+ #   GNU Lesser General Public License for more details.                     #
+ #                                                                           #
+ #   You should have received a copy of the GNU Lesser General Public        #
+ #   License along with Archipelago. If not, see                             #
+ #   <http://www.gnu.org/licenses/>.                                         #
+ #############################################################################
+
+# @file
+# @brief Tests of ahead-of-time compilation of directed execution graphs.
+#
+# Run from the python/ directory: python -m unittest discover tests
+
+import os
+import shutil
+import tempfile
+import unittest
+
+import archi.ctypes as typ
+import archi.context as ctx
+from archi.aot import DexgraphAotCompiler
+from archi.context import Context, DexgraphOperationFuncSymbol, DexgraphTransitionFuncSymbol
+from archi.object import PrimitiveData
+from archi.registry import Registry
+
+# Directory of C headers
+INCLUDE_DIR = os.path.join(os.path.dirname(__file__), '..', '..', 'include')
+
+
+def new_graph():
+    """Create a small graph using all kinds of transitions.
+
+    entry ---> loop --(LOOP)--> loop / signal
+    signal --(SIGNAL_FLAG)--> switch / atomic
+    switch --(SWITCH)--> choose / atomic / <none> / finish
+    atomic --(ATOMIC_FLAG)--> choose / finish
+    choose --(FUNCTION, function)--> finish / <none>
+    finish --(FUNCTION, data)--> <none> / entry
+    """
+    registry = Registry(require=[Registry.BUILTIN.executable])
+    executable = registry.BUILTIN.executable
+
+    I_NODE = ctx.DexgraphNodeContext.interface_in(executable)
+    I_NODE_ARRAY = ctx.DexgraphNodeArrayContext.interface_in(executable)
+
+    branches = {
+        'entry': ('loop',),
+        'loop': ('loop', 'signal'),
+        'signal': ('switch', 'atomic'),
+        'switch': ('choose', 'atomic', None, 'finish'),
+        'atomic': ('choose', 'finish'),
+        'choose': ('finish', None),
+        'finish': (None, 'entry'),
+    }
+
+    params = {
+        'entry': dict(sequence_length=1),
+        'loop': dict(sequence_length=2, transition_kind=typ.ARCHI_DEXGRAPH_TRANSITION__LOOP),
+        'signal': dict(sequence_length=0, transition_kind=typ.ARCHI_DEXGRAPH_TRANSITION__SIGNAL_FLAG),
+        'switch': dict(sequence_length=1, transition_kind=typ.ARCHI_DEXGRAPH_TRANSITION__SWITCH),
+        'atomic': dict(sequence_length=1, transition_kind=typ.ARCHI_DEXGRAPH_TRANSITION__ATOMIC_FLAG),
+        'choose': dict(sequence_length=3, transition_func=DexgraphTransitionFuncSymbol.slot(
+            'test_choose', executable)),
+        'finish': dict(sequence_length=1, transition_data=PrimitiveData(
+            typ.archi_dexgraph_branch_index_t(0))),
+    }
+
+    arrays = {key: registry.new_context(f'{key}.branches', I_NODE_ARRAY(num_nodes=len(targets)))
+              for key, targets in branches.items()}
+
+    nodes = {key: registry.new_context(key, I_NODE(name=key, branches=arrays[key], **params[key]))
+             for key in branches}
+
+    for key, targets in branches.items():
+        for index, target in enumerate(targets):
+            if target is not None:
+                registry(arrays[key].node[index] << Context.Slot.weak_ref(nodes[target]))
+
+    first = DexgraphOperationFuncSymbol.slot('test_first', executable)
+    second = DexgraphOperationFuncSymbol.slot('test_second', executable)
+
+    registry(nodes['entry'].sequence.function[0] << first)
+    registry(nodes['loop'].sequence.function[0] << first)
+    registry(nodes['loop'].sequence.function[1] << second)
+    registry(nodes['switch'].sequence.function[0] << second)
+    registry(nodes['atomic'].sequence.function[0] << first)
+    registry(nodes['choose'].sequence.function[0] << first)
+    registry(nodes['choose'].sequence.function[2] << second) # operation #1 is null
+    registry(nodes['finish'].sequence.function[0] << second)
+
+    return registry
+
+
+class DexgraphAotCompilerTest(unittest.TestCase):
+    def test_nodes(self):
+        registry = new_graph()
+
+        aot = DexgraphAotCompiler(registry, 'entry', name='test')
+        self.assertEqual([node.key for node in aot.nodes],
+                         ['entry', 'loop', 'signal', 'switch', 'atomic', 'choose', 'finish'])
+
+        node = {node.key: node for node in aot.nodes}
+        self.assertEqual(node['loop'].transition_kind, typ.ARCHI_DEXGRAPH_TRANSITION__LOOP)
+        self.assertEqual(node['choose'].sequence, ('archi_dexgraph_op__test_first', None,
+                                                   'archi_dexgraph_op__test_second'))
+        self.assertEqual(node['choose'].transition_func, 'archi_dexgraph_transition__test_choose')
+        self.assertTrue(node['finish'].transition_data)
+        self.assertEqual(node['switch'].branches, ('choose', 'atomic', None, 'finish'))
+
+        # Nodes unreachable from the entry node are omitted
+        aot = DexgraphAotCompiler(registry, 'choose', name='test')
+        self.assertEqual([node.key for node in aot.nodes],
+                         ['choose', 'finish', 'entry', 'loop', 'signal', 'switch', 'atomic'])
+
+        aot = DexgraphAotCompiler(registry, 'signal', name='test')
+        self.assertEqual(aot.nodes[0].key, 'signal')
+
+    def test_source(self):
+        source = DexgraphAotCompiler(new_graph(), 'entry', name='test').source()
+
+        self.assertIn('ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__aot_test)\n{', source)
+        self.assertIn('ARCHI_DEXGRAPH_TRANSITION_FUNC(archi_dexgraph_transition__test_choose);', source)
+
+        for kind in ('LOOP', 'SIGNAL_FLAG', 'SWITCH', 'ATOMIC_FLAG'):
+            self.assertIn(f'.kind = ARCHI_DEXGRAPH_TRANSITION__{kind}}}', source)
+
+        self.assertIn('branch_index = archi_dexgraph_transition__test_choose(node[5]->transition.data, &error);',
+                      source)
+        self.assertIn('*(archi_dexgraph_branch_index_t*)node[6]->transition.data', source)
+
+        # Null operations are skipped
+        self.assertNotIn('sequence[1]', source.split('node_5:')[1].split('node_6:')[0])
+
+    @unittest.skipIf(shutil.which('cc') is None, "C compiler is not available")
+    def test_compile(self):
+        registry = new_graph()
+
+        with tempfile.TemporaryDirectory() as directory:
+            for entry in ('entry', 'choose', 'signal'):
+                aot = DexgraphAotCompiler(registry, entry, name=f'test_{entry}')
+
+                source = os.path.join(directory, f'{entry}.c')
+                aot.write_source(source)
+
+                aot.compile_library(source, os.path.join(directory, f'lib{entry}.so'),
+                                    include_dirs=(INCLUDE_DIR,),
+                                    cflags=('-O2', '-Wall', '-Wextra', '-Wpedantic', '-Werror'))
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,57 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+/**
+ * @file
+ * @brief Aggregate type descriptions for data of built-in transitions.
+ */
+
+#include "archi/exec/agg/transition.var.h"
+#include "archi/exec/api/transition.typ.h"
+
+
+static
+const archi_aggr_member_type__value_t
+VTYPE_size = ARCHI_AGGR_MEMBER_TYPE__VALUE(size_t, 0);
+
+static
+const archi_aggr_member_type__pointer_t
+PTYPE_size = ARCHI_AGGR_MEMBER_TYPE__POINTER_TO_PDATA(const size_t*, size_t, 1);
+
+static
+const archi_aggr_member_type__pointer_t
+PTYPE_size_array = ARCHI_AGGR_MEMBER_TYPE__POINTER_TO_PDATA(const archi_dexgraph_branch_index_t*,
+        archi_dexgraph_branch_index_t, 0);
+
+/*****************************************************************************/
+
+static
+const archi_aggr_member_t
+MEMBERS_dexgraph_transition_data__switch[] = {
+    ARCHI_AGGR_MEMBER__POINTER(archi_dexgraph_transition_switch_t, value, 1, PTYPE_size),
+    ARCHI_AGGR_MEMBER__POINTER(archi_dexgraph_transition_switch_t, table, 1, PTYPE_size_array),
+    ARCHI_AGGR_MEMBER__VALUE(archi_dexgraph_transition_switch_t, table_size, 1, VTYPE_size),
+    ARCHI_AGGR_MEMBER__VALUE(archi_dexgraph_transition_switch_t, default_branch, 1, VTYPE_size),
+};
+
+const archi_aggr_type_t
+archi_aggr_type__dexgraph_transition_data__switch = ARCHI_AGGR_TYPE(
+        archi_dexgraph_transition_switch_t, 0,
+        MEMBERS_dexgraph_transition_data__switch);
+
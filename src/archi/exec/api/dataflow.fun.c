@@ -0,0 +1,469 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Operations on dataflow graphs of operations.
+ */
+
+#include "archi/exec/api/dataflow.fun.h"
+
+#include <stdlib.h> // for malloc(), free()
+#include <stdint.h> // for SIZE_MAX
+#include <stdatomic.h>
+#include <threads.h> // for thrd_yield(), mtx_*, cnd_*
+
+
+/**
+ * @brief Special value of ready queue entries which are not yet written.
+ */
+#define ARCHI_DEXGRAPH_DATAFLOW_NO_OPERATION  SIZE_MAX
+
+/**
+ * @brief Number of yields of an idle worker before it goes to sleep.
+ */
+#define ARCHI_DEXGRAPH_DATAFLOW_SPIN_ROUNDS   16
+
+struct archi_dexgraph_dataflow {
+    archi_dexgraph_operation_t *operation; ///< Array of operations.
+    size_t num_operations; ///< Number of operations.
+    size_t num_dependencies; ///< Number of dependencies.
+
+    size_t *num_pending_init; ///< Numbers of dependencies of operations.
+    size_t *successor_start; ///< Positions of the first successors of operations (plus the end position).
+    size_t *successor; ///< Indices of dependent operations.
+
+    // Execution state
+    atomic_size_t *num_pending; ///< Numbers of pending dependencies of operations.
+    atomic_size_t *ready; ///< Queue of ready operations.
+    atomic_size_t ready_head; ///< Position of the next ready operation to take.
+    atomic_size_t ready_tail; ///< Position of the next ready operation to put.
+    atomic_size_t num_remaining; ///< Number of operations not done yet.
+
+    atomic_bool stop; ///< Whether the execution is stopped due to failure.
+    atomic_flag failed; ///< Whether the error has been recorded.
+    archi_error_t error; ///< Error of the failed operation.
+
+    // Sleeping of idle workers
+    atomic_size_t num_events; ///< Number of operations made ready, plus finish and stop events.
+    atomic_size_t num_sleeping; ///< Number of workers sleeping on the condition variable.
+
+    bool sync_initialized; ///< Whether the mutex and the condition variable are initialized.
+    mtx_t mtx;
+    cnd_t cnd;
+};
+
+archi_dexgraph_dataflow_t
+archi_dexgraph_dataflow_create(
+        const archi_dexgraph_node_t *node,
+        const archi_dexgraph_dataflow_dependency_t dependency[],
+        size_t num_dependencies,
+        ARCHI_ERROR_PARAM_DECL)
+{
+    if (node == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "node is NULL");
+        return NULL;
+    }
+    else if ((dependency == NULL) && (num_dependencies != 0))
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "array of dependencies is NULL");
+        return NULL;
+    }
+
+    size_t num_operations = node->sequence_length;
+
+    // Validate the dependencies
+    for (size_t i = 0; i < num_dependencies; i++)
+    {
+        if ((dependency[i].operation >= num_operations) || (dependency[i].dependency >= num_operations))
+        {
+            ARCHI_ERROR_SET(ARCHI__EINDEX, "dependency #%zu refers to an operation out of bounds (%zu -> %zu, %zu operations)",
+                    i, dependency[i].operation, dependency[i].dependency, num_operations);
+            return NULL;
+        }
+        else if (dependency[i].operation == dependency[i].dependency)
+        {
+            ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "operation #%zu depends on itself", dependency[i].operation);
+            return NULL;
+        }
+    }
+
+    // Allocate the dataflow graph
+    archi_dexgraph_dataflow_t dataflow = malloc(sizeof(*dataflow));
+    if (dataflow == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__EMEMORY, "couldn't allocate dataflow graph");
+        return NULL;
+    }
+
+    *dataflow = (struct archi_dexgraph_dataflow){
+        .num_operations = num_operations,
+        .num_dependencies = num_dependencies,
+    };
+
+    dataflow->operation = malloc(sizeof(*dataflow->operation) * (num_operations + 1));
+    dataflow->num_pending_init = malloc(sizeof(*dataflow->num_pending_init) * (num_operations + 1));
+    dataflow->successor_start = malloc(sizeof(*dataflow->successor_start) * (num_operations + 1));
+    dataflow->successor = malloc(sizeof(*dataflow->successor) * (num_dependencies + 1));
+    dataflow->num_pending = malloc(sizeof(*dataflow->num_pending) * (num_operations + 1));
+    dataflow->ready = malloc(sizeof(*dataflow->ready) * (num_operations + 1));
+
+    if ((dataflow->operation == NULL) || (dataflow->num_pending_init == NULL) ||
+            (dataflow->successor_start == NULL) || (dataflow->successor == NULL) ||
+            (dataflow->num_pending == NULL) || (dataflow->ready == NULL))
+    {
+        ARCHI_ERROR_SET(ARCHI__EMEMORY, "couldn't allocate dataflow graph arrays");
+        goto failure;
+    }
+
+    // Initialize the synchronization primitives for idle workers
+    if (mtx_init(&dataflow->mtx, mtx_plain) != thrd_success)
+    {
+        ARCHI_ERROR_SET(ARCHI__ESYSTEM, "couldn't initialize mutex");
+        goto failure;
+    }
+
+    if (cnd_init(&dataflow->cnd) != thrd_success)
+    {
+        ARCHI_ERROR_SET(ARCHI__ESYSTEM, "couldn't initialize condition variable");
+        mtx_destroy(&dataflow->mtx);
+        goto failure;
+    }
+
+    dataflow->sync_initialized = true;
+
+    atomic_init(&dataflow->num_events, 0);
+    atomic_init(&dataflow->num_sleeping, 0);
+
+    // Copy the operations
+    for (size_t i = 0; i < num_operations; i++)
+    {
+        dataflow->operation[i] = node->sequence[i];
+        dataflow->num_pending_init[i] = 0;
+        dataflow->successor_start[i] = 0;
+    }
+
+    dataflow->successor_start[num_operations] = 0;
+
+    // Build arrays of successors
+    for (size_t i = 0; i < num_dependencies; i++)
+    {
+        dataflow->num_pending_init[dependency[i].operation]++;
+        dataflow->successor_start[dependency[i].dependency + 1]++;
+    }
+
+    for (size_t i = 0; i < num_operations; i++)
+        dataflow->successor_start[i + 1] += dataflow->successor_start[i];
+
+    {
+        size_t *temp = malloc(sizeof(*temp) * 2 * (num_operations + 1));
+        if (temp == NULL)
+        {
+            ARCHI_ERROR_SET(ARCHI__EMEMORY, "couldn't allocate temporary arrays");
+            goto failure;
+        }
+
+        size_t *queue = temp;
+        size_t *pending = temp + (num_operations + 1);
+
+        for (size_t i = 0; i < num_operations; i++)
+            pending[i] = dataflow->successor_start[i]; // insertion positions
+
+        for (size_t i = 0; i < num_dependencies; i++)
+            dataflow->successor[pending[dependency[i].dependency]++] = dependency[i].operation;
+
+        // Check that dependencies do not form cycles (Kahn's algorithm)
+        size_t queue_length = 0;
+
+        for (size_t i = 0; i < num_operations; i++)
+        {
+            pending[i] = dataflow->num_pending_init[i];
+            if (pending[i] == 0)
+                queue[queue_length++] = i;
+        }
+
+        for (size_t i = 0; i < queue_length; i++)
+        {
+            for (size_t j = dataflow->successor_start[queue[i]]; j < dataflow->successor_start[queue[i] + 1]; j++)
+                if (--pending[dataflow->successor[j]] == 0)
+                    queue[queue_length++] = dataflow->successor[j];
+        }
+
+        free(temp);
+
+        if (queue_length != num_operations)
+        {
+            ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "dependencies form a cycle (%zu operations can never become ready)",
+                    num_operations - queue_length);
+            goto failure;
+        }
+    }
+
+    ARCHI_ERROR_RESET();
+    return dataflow;
+
+failure:
+    archi_dexgraph_dataflow_destroy(dataflow);
+    return NULL;
+}
+
+void
+archi_dexgraph_dataflow_destroy(
+        archi_dexgraph_dataflow_t dataflow)
+{
+    if (dataflow == NULL)
+        return;
+
+    if (dataflow->sync_initialized)
+    {
+        cnd_destroy(&dataflow->cnd);
+        mtx_destroy(&dataflow->mtx);
+    }
+
+    free(dataflow->operation);
+    free(dataflow->num_pending_init);
+    free(dataflow->successor_start);
+    free(dataflow->successor);
+    free(dataflow->num_pending);
+    free(dataflow->ready);
+    free(dataflow);
+}
+
+static
+void
+archi_dexgraph_dataflow_notify(
+        archi_dexgraph_dataflow_t dataflow)
+{
+    atomic_fetch_add_explicit(&dataflow->num_events, 1, memory_order_seq_cst);
+
+    // Spinning workers see the counter by themselves, sleeping ones need to be woken
+    if (atomic_load_explicit(&dataflow->num_sleeping, memory_order_seq_cst) != 0)
+    {
+        // Sleepers check the counter under the mutex, so they're either waiting or will see it
+        mtx_lock(&dataflow->mtx);
+        cnd_broadcast(&dataflow->cnd);
+        mtx_unlock(&dataflow->mtx);
+    }
+}
+
+static
+void
+archi_dexgraph_dataflow_idle(
+        archi_dexgraph_dataflow_t dataflow,
+        size_t num_events, // value of the event counter before the ready queue was found empty
+        unsigned *num_rounds) // number of idle rounds since the last operation
+{
+    // Back off with yields first, as dependencies are often done quickly
+    if (*num_rounds < ARCHI_DEXGRAPH_DATAFLOW_SPIN_ROUNDS)
+    {
+        (*num_rounds)++;
+        thrd_yield();
+        return;
+    }
+
+    // Fall back to sleeping on the condition variable
+    mtx_lock(&dataflow->mtx);
+
+    // The counter must be visible before the events are checked, see archi_dexgraph_dataflow_notify()
+    atomic_fetch_add_explicit(&dataflow->num_sleeping, 1, memory_order_seq_cst);
+
+    while (atomic_load_explicit(&dataflow->num_events, memory_order_seq_cst) == num_events)
+        cnd_wait(&dataflow->cnd, &dataflow->mtx);
+
+    atomic_fetch_sub_explicit(&dataflow->num_sleeping, 1, memory_order_relaxed);
+
+    mtx_unlock(&dataflow->mtx);
+}
+
+static
+void
+archi_dexgraph_dataflow_push_ready(
+        archi_dexgraph_dataflow_t dataflow,
+        size_t index)
+{
+    size_t position = atomic_fetch_add_explicit(&dataflow->ready_tail, 1, memory_order_relaxed);
+    atomic_store_explicit(&dataflow->ready[position], index, memory_order_release);
+
+    archi_dexgraph_dataflow_notify(dataflow);
+}
+
+void
+archi_dexgraph_dataflow_begin(
+        archi_dexgraph_dataflow_t dataflow)
+{
+    if (dataflow == NULL)
+        return;
+
+    for (size_t i = 0; i < dataflow->num_operations; i++)
+    {
+        atomic_init(&dataflow->num_pending[i], dataflow->num_pending_init[i]);
+        atomic_init(&dataflow->ready[i], ARCHI_DEXGRAPH_DATAFLOW_NO_OPERATION);
+    }
+
+    atomic_init(&dataflow->ready_head, 0);
+    atomic_init(&dataflow->ready_tail, 0);
+    atomic_init(&dataflow->num_remaining, dataflow->num_operations);
+
+    atomic_init(&dataflow->stop, false);
+    atomic_flag_clear_explicit(&dataflow->failed, memory_order_relaxed);
+    ARCHI_ERROR_VAR_RESET(&dataflow->error);
+
+    for (size_t i = 0; i < dataflow->num_operations; i++)
+        if (dataflow->num_pending_init[i] == 0)
+            archi_dexgraph_dataflow_push_ready(dataflow, i);
+
+    // Publish the initial state to workers
+    atomic_thread_fence(memory_order_release);
+}
+
+bool
+archi_dexgraph_dataflow_work(
+        archi_dexgraph_dataflow_t dataflow)
+{
+    if (dataflow == NULL)
+        return false;
+
+    archi_error_t error;
+    unsigned num_idle_rounds = 0;
+
+    for (;;)
+    {
+        // Read the event counter before checking the state, so that no event is missed when sleeping
+        size_t num_events = atomic_load_explicit(&dataflow->num_events, memory_order_seq_cst);
+
+        if ((atomic_load_explicit(&dataflow->num_remaining, memory_order_acquire) == 0) ||
+                atomic_load_explicit(&dataflow->stop, memory_order_relaxed))
+            return false;
+
+        // Take a ready operation
+        size_t head = atomic_load_explicit(&dataflow->ready_head, memory_order_relaxed);
+
+        if (head == atomic_load_explicit(&dataflow->ready_tail, memory_order_acquire))
+        {
+            // Nothing is ready: other workers are busy with dependencies
+            archi_dexgraph_dataflow_idle(dataflow, num_events, &num_idle_rounds);
+            continue;
+        }
+
+        if (!atomic_compare_exchange_weak_explicit(&dataflow->ready_head, &head, head + 1,
+                    memory_order_relaxed, memory_order_relaxed))
+            continue;
+
+        num_idle_rounds = 0;
+
+        size_t index;
+        while ((index = atomic_load_explicit(&dataflow->ready[head], memory_order_acquire)) ==
+                ARCHI_DEXGRAPH_DATAFLOW_NO_OPERATION)
+            thrd_yield(); // the entry is being written by a thread that may have been preempted
+
+        // Execute the operation
+        archi_dexgraph_operation_t operation = dataflow->operation[index];
+
+        if (operation.function != NULL)
+        {
+            ARCHI_ERROR_VAR_UNSET(&error);
+            /*****************************************/
+            operation.function(operation.data, &error);
+            /*****************************************/
+
+            if (error.code != 0)
+            {
+                if (!atomic_flag_test_and_set_explicit(&dataflow->failed, memory_order_relaxed))
+                    dataflow->error = error;
+
+                atomic_store_explicit(&dataflow->stop, true, memory_order_relaxed);
+
+                // Wake idle workers so that they return
+                archi_dexgraph_dataflow_notify(dataflow);
+                return true;
+            }
+        }
+
+        // Mark dependent operations ready
+        for (size_t i = dataflow->successor_start[index]; i < dataflow->successor_start[index + 1]; i++)
+        {
+            size_t successor = dataflow->successor[i];
+
+            if (atomic_fetch_sub_explicit(&dataflow->num_pending[successor], 1, memory_order_acq_rel) == 1)
+                archi_dexgraph_dataflow_push_ready(dataflow, successor);
+        }
+
+        if (atomic_fetch_sub_explicit(&dataflow->num_remaining, 1, memory_order_acq_rel) == 1)
+        {
+            // Wake idle workers so that they return
+            archi_dexgraph_dataflow_notify(dataflow);
+            return true;
+        }
+    }
+}
+
+void
+archi_dexgraph_dataflow_end(
+        archi_dexgraph_dataflow_t dataflow,
+        ARCHI_ERROR_PARAM_DECL)
+{
+    if (dataflow == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "dataflow graph is NULL");
+        return;
+    }
+
+    atomic_thread_fence(memory_order_acquire);
+
+    if (dataflow->error.code != 0)
+    {
+        ARCHI_ERROR_ASSIGN(dataflow->error);
+        return;
+    }
+
+    ARCHI_ERROR_RESET();
+}
+
+void
+archi_dexgraph_dataflow_execute(
+        archi_dexgraph_dataflow_t dataflow,
+        ARCHI_ERROR_PARAM_DECL)
+{
+    if (dataflow == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "dataflow graph is NULL");
+        return;
+    }
+
+    archi_dexgraph_dataflow_begin(dataflow);
+    archi_dexgraph_dataflow_work(dataflow);
+    archi_dexgraph_dataflow_end(dataflow, ARCHI_ERROR_PARAM);
+}
+
+size_t
+archi_dexgraph_dataflow_num_operations(
+        archi_dexgraph_dataflow_t dataflow)
+{
+    return (dataflow != NULL) ? dataflow->num_operations : 0;
+}
+
+size_t
+archi_dexgraph_dataflow_num_dependencies(
+        archi_dexgraph_dataflow_t dataflow)
+{
+    return (dataflow != NULL) ? dataflow->num_dependencies : 0;
+}
+
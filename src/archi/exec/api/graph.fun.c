@@ -25,14 +25,96 @@
 
 #include "archi/exec/api/graph.fun.h"
 #include "archi/exec/api/node.typ.h"
+#include "archi/exec/api/transition.fun.h"
+#include "archi/trace/api/trace.def.h"
 
+#ifdef ARCHI_FEATURE_DEXGRAPH_PROFILE
+#  include "archi/exec/api/profile.fun.h"
+#endif
 
+#include <stdbool.h>
+#include <time.h> // for struct timespec, timespec_get()
+
+
+static inline
+uint64_t
+archi_dexgraph_time_ns(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+#ifdef ARCHI_FEATURE_DEXGRAPH_PROFILE
+
+#  define PROFILE_BEGIN()   \
+    uint64_t profile_start = (profile != NULL) ? archi_dexgraph_time_ns() : 0
+
+#  define PROFILE_END(node, index)  do {                                        \
+    if (profile != NULL)                                                        \
+        archi_dexgraph_profile_record(profile, (node), (index),                 \
+                archi_dexgraph_time_ns() - profile_start);                      \
+} while (0)
+
+#else
+
+#  define PROFILE_BEGIN()
+#  define PROFILE_END(node, index)
+
+#endif
+
+/**
+ * @brief State of budgeted execution.
+ */
+struct archi_dexgraph_budget_state {
+    size_t num_operations; // number of operation calls done
+    size_t max_operations; // maximum number of operation calls, or SIZE_MAX
+
+    uint64_t deadline_ns; // wall-clock deadline, or 0
+    size_t check_period; // number of operation calls and transitions between clock checks
+    size_t check_countdown; // number of operation calls and transitions until the next clock check
+};
+
+static inline
+bool
+archi_dexgraph_budget_deadline_passed(
+        struct archi_dexgraph_budget_state *budget)
+{
+    if ((budget->deadline_ns != 0) && (--budget->check_countdown == 0))
+    {
+        budget->check_countdown = budget->check_period;
+        return archi_dexgraph_time_ns() >= budget->deadline_ns;
+    }
+
+    return false;
+}
+
+static inline
+bool
+archi_dexgraph_budget_spent(
+        struct archi_dexgraph_budget_state *budget)
+{
+    budget->num_operations++;
+
+    if (budget->num_operations >= budget->max_operations)
+        return true;
+
+    return archi_dexgraph_budget_deadline_passed(budget);
+}
+
+static inline
 archi_dexgraph_frame_t
-archi_dexgraph_execute(
+archi_dexgraph_execute_internal(
         archi_dexgraph_frame_t frame,
         enum archi_dexgraph_exec_mode mode,
+        archi_dexgraph_profile_t profile,
+        struct archi_dexgraph_budget_state *budget,
         ARCHI_ERROR_PARAM_DECL)
 {
+#ifndef ARCHI_FEATURE_DEXGRAPH_PROFILE
+    (void) profile;
+#endif
+
     if ((mode < ARCHI_DEXGRAPH__NO_INTERRUPT) || (mode > ARCHI_DEXGRAPH__INTERRUPT_OPERATION))
     {
         ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "unknown DEG execution mode %i", mode);
@@ -44,6 +126,8 @@ archi_dexgraph_execute(
 
     while (frame.node != NULL)
     {
+        ARCHI_TRACE_EVENT(ARCHI_TRACE__NODE_ENTER, frame.node->name, frame.node, frame.index);
+
         // Execute the sequence of operation functions
         for (; frame.index < frame.node->sequence_length; frame.index++)
         {
@@ -52,15 +136,24 @@ archi_dexgraph_execute(
             if (operation.function != NULL)
             {
                 ARCHI_ERROR_VAR_UNSET(&error);
+                ARCHI_TRACE_EVENT(ARCHI_TRACE__OPERATION_BEGIN, frame.node->name, frame.node, frame.index);
+                PROFILE_BEGIN();
                 /*****************************************/
                 operation.function(operation.data, &error);
                 /*****************************************/
+                PROFILE_END(frame.node, frame.index);
+                ARCHI_TRACE_EVENT(ARCHI_TRACE__OPERATION_END, frame.node->name, frame.node, frame.index);
 
                 if (error.code != 0)
+                {
+                    ARCHI_TRACE_EVENT(ARCHI_TRACE__NODE_LEAVE, frame.node->name, frame.node, frame.index);
                     goto interrupt;
-                else if (mode >= ARCHI_DEXGRAPH__INTERRUPT_OPERATION)
+                }
+                else if ((mode >= ARCHI_DEXGRAPH__INTERRUPT_OPERATION) ||
+                        ((budget != NULL) && archi_dexgraph_budget_spent(budget)))
                 {
                     frame.index++;
+                    ARCHI_TRACE_EVENT(ARCHI_TRACE__NODE_LEAVE, frame.node->name, frame.node, frame.index);
                     goto interrupt;
                 }
             }
@@ -70,8 +163,19 @@ archi_dexgraph_execute(
         archi_dexgraph_branch_index_t branch_index;
         {
             archi_dexgraph_transition_t transition = frame.node->transition;
+            PROFILE_BEGIN();
 
-            if (transition.function != NULL)
+            if (transition.kind != ARCHI_DEXGRAPH_TRANSITION__FUNCTION)
+            {
+                branch_index = archi_dexgraph_transition_builtin(transition, &error);
+
+                if (error.code != 0)
+                {
+                    ARCHI_TRACE_EVENT(ARCHI_TRACE__NODE_LEAVE, frame.node->name, frame.node, frame.index);
+                    goto interrupt;
+                }
+            }
+            else if (transition.function != NULL)
             {
                 ARCHI_ERROR_VAR_UNSET(&error);
                 /**********************************************************/
@@ -79,14 +183,21 @@ archi_dexgraph_execute(
                 /**********************************************************/
 
                 if (error.code != 0)
+                {
+                    ARCHI_TRACE_EVENT(ARCHI_TRACE__NODE_LEAVE, frame.node->name, frame.node, frame.index);
                     goto interrupt;
+                }
             }
             else if (transition.data != NULL)
                 branch_index = *(archi_dexgraph_branch_index_t*)transition.data;
             else
                 branch_index = 0;
+
+            PROFILE_END(frame.node, frame.node->sequence_length);
         }
 
+        ARCHI_TRACE_EVENT(ARCHI_TRACE__NODE_LEAVE, frame.node->name, frame.node, frame.index);
+
         // Proceed to the selected branch
         const archi_dexgraph_node_array_t *branch = frame.node->branch;
 
@@ -97,7 +208,10 @@ archi_dexgraph_execute(
 
         frame.index = 0;
 
-        if (mode >= ARCHI_DEXGRAPH__INTERRUPT_TRANSITION)
+        // Transitions count towards clock checks too, so that loops of nodes
+        // without operations don't run past the deadline
+        if ((mode >= ARCHI_DEXGRAPH__INTERRUPT_TRANSITION) ||
+                ((budget != NULL) && archi_dexgraph_budget_deadline_passed(budget)))
             goto interrupt;
     }
 interrupt:
@@ -106,3 +220,66 @@ interrupt:
     return frame;
 }
 
+archi_dexgraph_frame_t
+archi_dexgraph_execute(
+        archi_dexgraph_frame_t frame,
+        enum archi_dexgraph_exec_mode mode,
+        ARCHI_ERROR_PARAM_DECL)
+{
+    return archi_dexgraph_execute_internal(frame, mode, NULL, NULL, ARCHI_ERROR_PARAM);
+}
+
+archi_dexgraph_frame_t
+archi_dexgraph_execute_profiled(
+        archi_dexgraph_frame_t frame,
+        enum archi_dexgraph_exec_mode mode,
+        archi_dexgraph_profile_t profile,
+        ARCHI_ERROR_PARAM_DECL)
+{
+#ifdef ARCHI_FEATURE_DEXGRAPH_PROFILE
+    if (profile == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "DEG execution profile is NULL");
+        return frame;
+    }
+
+    return archi_dexgraph_execute_internal(frame, mode, profile, NULL, ARCHI_ERROR_PARAM);
+#else
+    (void) mode;
+    (void) profile;
+
+    ARCHI_ERROR_SET(ARCHI__ENOTIMPL, "DEG execution profiling is disabled at build time");
+    return frame;
+#endif
+}
+
+archi_dexgraph_frame_t
+archi_dexgraph_execute_budgeted(
+        archi_dexgraph_frame_t frame,
+        enum archi_dexgraph_exec_mode mode,
+        archi_dexgraph_budget_t *budget,
+        ARCHI_ERROR_PARAM_DECL)
+{
+    if (budget == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "DEG execution budget is NULL");
+        return frame;
+    }
+
+    size_t check_period = (budget->check_period != 0) ? budget->check_period :
+        ARCHI_DEXGRAPH_BUDGET_DEFAULT_CHECK_PERIOD;
+
+    struct archi_dexgraph_budget_state state = {
+        .max_operations = (budget->max_operations != 0) ? budget->max_operations : SIZE_MAX,
+        .deadline_ns = (budget->time_limit_ns != 0) ?
+            archi_dexgraph_time_ns() + budget->time_limit_ns : 0,
+        .check_period = check_period,
+        .check_countdown = check_period,
+    };
+
+    frame = archi_dexgraph_execute_internal(frame, mode, NULL, &state, ARCHI_ERROR_PARAM);
+
+    budget->num_operations = state.num_operations;
+    return frame;
+}
+
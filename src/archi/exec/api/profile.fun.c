@@ -0,0 +1,204 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Directed execution graph profiling.
+ */
+
+#include "archi/exec/api/profile.fun.h"
+
+#include <stdlib.h> // for malloc(), realloc(), free()
+#include <stdint.h> // for uintptr_t, UINT64_MAX
+
+
+struct archi_dexgraph_profile {
+    archi_dexgraph_profile_entry_t *entry; ///< Array of entries.
+    size_t num_entries; ///< Number of entries.
+
+    size_t *slot; ///< Hash table of entry indices (SIZE_MAX for empty slots).
+    size_t num_slots; ///< Number of hash table slots (power of two).
+};
+
+#define ARCHI_DEXGRAPH_PROFILE_EMPTY_SLOT   ((size_t)-1)
+
+static
+size_t
+archi_dexgraph_profile_hash(
+        const struct archi_dexgraph_node *node,
+        size_t index)
+{
+    size_t hash = (size_t)((uintptr_t)node >> 4);
+    hash ^= index + 0x9E3779B9u + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+static
+bool
+archi_dexgraph_profile_grow(
+        archi_dexgraph_profile_t profile)
+{
+    size_t num_slots = (profile->num_slots != 0) ? profile->num_slots * 2 : 64;
+
+    archi_dexgraph_profile_entry_t *entry = realloc(profile->entry,
+            sizeof(*entry) * (num_slots / 2));
+    if (entry == NULL)
+        return false;
+
+    profile->entry = entry;
+
+    size_t *slot = malloc(sizeof(*slot) * num_slots);
+    if (slot == NULL)
+        return false;
+
+    for (size_t i = 0; i < num_slots; i++)
+        slot[i] = ARCHI_DEXGRAPH_PROFILE_EMPTY_SLOT;
+
+    // Rehash existing entries
+    for (size_t i = 0; i < profile->num_entries; i++)
+    {
+        size_t j = archi_dexgraph_profile_hash(entry[i].node, entry[i].index) & (num_slots - 1);
+
+        while (slot[j] != ARCHI_DEXGRAPH_PROFILE_EMPTY_SLOT)
+            j = (j + 1) & (num_slots - 1);
+
+        slot[j] = i;
+    }
+
+    free(profile->slot);
+
+    profile->slot = slot;
+    profile->num_slots = num_slots;
+
+    return true;
+}
+
+archi_dexgraph_profile_t
+archi_dexgraph_profile_alloc(void)
+{
+    archi_dexgraph_profile_t profile = malloc(sizeof(*profile));
+    if (profile == NULL)
+        return NULL;
+
+    *profile = (struct archi_dexgraph_profile){0};
+
+    return profile;
+}
+
+void
+archi_dexgraph_profile_free(
+        archi_dexgraph_profile_t profile)
+{
+    if (profile == NULL)
+        return;
+
+    free(profile->entry);
+    free(profile->slot);
+    free(profile);
+}
+
+void
+archi_dexgraph_profile_reset(
+        archi_dexgraph_profile_t profile)
+{
+    if (profile == NULL)
+        return;
+
+    for (size_t i = 0; i < profile->num_slots; i++)
+        profile->slot[i] = ARCHI_DEXGRAPH_PROFILE_EMPTY_SLOT;
+
+    profile->num_entries = 0;
+}
+
+bool
+archi_dexgraph_profile_record(
+        archi_dexgraph_profile_t profile,
+        const struct archi_dexgraph_node *node,
+        size_t index,
+        uint64_t time_ns)
+{
+    if (profile == NULL)
+        return false;
+
+    // Keep the load factor at most 1/2
+    if (profile->num_entries >= profile->num_slots / 2)
+    {
+        if (!archi_dexgraph_profile_grow(profile))
+            return false;
+    }
+
+    size_t mask = profile->num_slots - 1;
+    size_t j = archi_dexgraph_profile_hash(node, index) & mask;
+
+    for (;;)
+    {
+        size_t entry_index = profile->slot[j];
+
+        if (entry_index == ARCHI_DEXGRAPH_PROFILE_EMPTY_SLOT)
+        {
+            entry_index = profile->num_entries++;
+            profile->slot[j] = entry_index;
+
+            profile->entry[entry_index] = (archi_dexgraph_profile_entry_t){
+                .node = node,
+                .index = index,
+                .min_ns = UINT64_MAX,
+            };
+        }
+
+        archi_dexgraph_profile_entry_t *entry = &profile->entry[entry_index];
+
+        if ((entry->node == node) && (entry->index == index))
+        {
+            entry->num_calls++;
+            entry->total_ns += time_ns;
+
+            if (time_ns < entry->min_ns)
+                entry->min_ns = time_ns;
+            if (time_ns > entry->max_ns)
+                entry->max_ns = time_ns;
+
+            return true;
+        }
+
+        j = (j + 1) & mask;
+    }
+}
+
+size_t
+archi_dexgraph_profile_num_entries(
+        archi_dexgraph_profile_t profile)
+{
+    if (profile == NULL)
+        return 0;
+
+    return profile->num_entries;
+}
+
+const archi_dexgraph_profile_entry_t*
+archi_dexgraph_profile_entries(
+        archi_dexgraph_profile_t profile)
+{
+    if (profile == NULL)
+        return NULL;
+
+    return profile->entry;
+}
+
@@ -0,0 +1,408 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Operations on compiled directed execution graph programs.
+ */
+
+#include "archi/exec/api/program.fun.h"
+#include "archi/exec/api/transition.fun.h"
+
+#include <stdlib.h> // for malloc(), realloc(), free()
+#include <stdbool.h>
+
+
+/**
+ * @brief Program instruction.
+ *
+ * Operation instructions have null branch pointer,
+ * transition instructions always have non-null one.
+ */
+struct archi_dexgraph_program_instruction {
+    union {
+        archi_dexgraph_operation_func_t operation; ///< Operation function.
+        archi_dexgraph_transition_func_t transition; ///< Transition function.
+    } function;
+    void *data; ///< Function data.
+
+    const archi_dexgraph_program_position_t *branch; ///< Resolved branch positions.
+    size_t num_branches; ///< Number of branches.
+
+    archi_dexgraph_transition_kind_t kind; ///< Transition kind.
+};
+
+struct archi_dexgraph_program {
+    struct archi_dexgraph_program_instruction *instruction; ///< Array of instructions.
+    size_t length; ///< Number of instructions.
+
+    archi_dexgraph_program_position_t *branch_table; ///< Storage for resolved branch positions.
+
+    archi_dexgraph_frame_t *origin; ///< Execution frames corresponding to instructions.
+
+    const archi_dexgraph_node_t **node; ///< Array of compiled nodes.
+    archi_dexgraph_program_position_t *node_start; ///< Positions of the first instruction of nodes.
+    size_t num_nodes; ///< Number of compiled nodes.
+};
+
+static
+size_t
+archi_dexgraph_program_node_index(
+        const archi_dexgraph_node_t **node,
+        size_t num_nodes,
+        const archi_dexgraph_node_t *target)
+{
+    // Graphs are small and compiled once, so linear search suffices
+    for (size_t i = 0; i < num_nodes; i++)
+        if (node[i] == target)
+            return i;
+
+    return num_nodes;
+}
+
+archi_dexgraph_program_t
+archi_dexgraph_program_compile(
+        const archi_dexgraph_node_t *entry,
+        ARCHI_ERROR_PARAM_DECL)
+{
+    if (entry == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "entry node is NULL");
+        return NULL;
+    }
+
+    archi_dexgraph_program_t program = malloc(sizeof(*program));
+    if (program == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__EMEMORY, "couldn't allocate DEG program");
+        return NULL;
+    }
+
+    *program = (struct archi_dexgraph_program){0};
+
+    // Collect all reachable nodes in breadth-first order
+    size_t capacity = 8;
+    size_t num_branch_entries = 0;
+
+    program->node = malloc(sizeof(*program->node) * capacity);
+    if (program->node == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__EMEMORY, "couldn't allocate array of DEG nodes");
+        goto failure;
+    }
+
+    program->node[0] = entry;
+    program->num_nodes = 1;
+
+    for (size_t i = 0; i < program->num_nodes; i++)
+    {
+        const archi_dexgraph_node_t *current = program->node[i];
+
+        for (size_t j = 0; j < current->sequence_length; j++)
+            if (current->sequence[j].function != NULL)
+                program->length++;
+
+        program->length++; // transition
+
+        if (current->branch == NULL)
+            continue;
+
+        num_branch_entries += current->branch->num_nodes;
+
+        for (size_t j = 0; j < current->branch->num_nodes; j++)
+        {
+            const archi_dexgraph_node_t *target = current->branch->node[j];
+
+            if ((target == NULL) || (archi_dexgraph_program_node_index(
+                            program->node, program->num_nodes, target) < program->num_nodes))
+                continue;
+
+            if (program->num_nodes == capacity)
+            {
+                capacity *= 2;
+
+                const archi_dexgraph_node_t **node = realloc(program->node,
+                        sizeof(*program->node) * capacity);
+                if (node == NULL)
+                {
+                    ARCHI_ERROR_SET(ARCHI__EMEMORY, "couldn't reallocate array of DEG nodes (capacity = %zu)",
+                            capacity);
+                    goto failure;
+                }
+
+                program->node = node;
+            }
+
+            program->node[program->num_nodes++] = target;
+        }
+    }
+
+    // Allocate arrays
+    program->instruction = malloc(sizeof(*program->instruction) * program->length);
+    program->origin = malloc(sizeof(*program->origin) * program->length);
+    program->node_start = malloc(sizeof(*program->node_start) * program->num_nodes);
+    program->branch_table = malloc(sizeof(*program->branch_table) * (num_branch_entries + 1));
+
+    if ((program->instruction == NULL) || (program->origin == NULL) ||
+            (program->node_start == NULL) || (program->branch_table == NULL))
+    {
+        ARCHI_ERROR_SET(ARCHI__EMEMORY, "couldn't allocate DEG program arrays (length = %zu, nodes = %zu)",
+                program->length, program->num_nodes);
+        goto failure;
+    }
+
+    // Compute node positions
+    {
+        archi_dexgraph_program_position_t position = 0;
+
+        for (size_t i = 0; i < program->num_nodes; i++)
+        {
+            const archi_dexgraph_node_t *current = program->node[i];
+
+            program->node_start[i] = position;
+
+            for (size_t j = 0; j < current->sequence_length; j++)
+                if (current->sequence[j].function != NULL)
+                    position++;
+
+            position++; // transition
+        }
+    }
+
+    // Emit instructions
+    {
+        archi_dexgraph_program_position_t position = 0;
+        size_t branch_offset = 0;
+
+        for (size_t i = 0; i < program->num_nodes; i++)
+        {
+            const archi_dexgraph_node_t *current = program->node[i];
+
+            for (size_t j = 0; j < current->sequence_length; j++)
+            {
+                archi_dexgraph_operation_t operation = current->sequence[j];
+                if (operation.function == NULL)
+                    continue;
+
+                program->instruction[position] = (struct archi_dexgraph_program_instruction){
+                    .function.operation = operation.function,
+                    .data = operation.data,
+                };
+                program->origin[position] = (archi_dexgraph_frame_t){.node = current, .index = j};
+
+                position++;
+            }
+
+            const archi_dexgraph_program_position_t *branch = &program->branch_table[branch_offset];
+            size_t num_branches = 0;
+
+            if (current->branch != NULL)
+            {
+                num_branches = current->branch->num_nodes;
+
+                for (size_t j = 0; j < num_branches; j++)
+                {
+                    const archi_dexgraph_node_t *target = current->branch->node[j];
+
+                    program->branch_table[branch_offset++] = (target != NULL) ?
+                        program->node_start[archi_dexgraph_program_node_index(
+                                program->node, program->num_nodes, target)] :
+                        ARCHI_DEXGRAPH_PROGRAM_END;
+                }
+            }
+
+            program->instruction[position] = (struct archi_dexgraph_program_instruction){
+                .function.transition = current->transition.function,
+                .data = current->transition.data,
+                .branch = branch,
+                .num_branches = num_branches,
+                .kind = current->transition.kind,
+            };
+            program->origin[position] = (archi_dexgraph_frame_t){
+                .node = current, .index = current->sequence_length};
+
+            position++;
+        }
+    }
+
+    ARCHI_ERROR_RESET();
+    return program;
+
+failure:
+    archi_dexgraph_program_free(program);
+    return NULL;
+}
+
+void
+archi_dexgraph_program_free(
+        archi_dexgraph_program_t program)
+{
+    if (program == NULL)
+        return;
+
+    free(program->instruction);
+    free(program->branch_table);
+    free(program->origin);
+    free(program->node);
+    free(program->node_start);
+    free(program);
+}
+
+archi_dexgraph_program_position_t
+archi_dexgraph_program_execute(
+        archi_dexgraph_program_t program,
+        archi_dexgraph_program_position_t position,
+        enum archi_dexgraph_exec_mode mode,
+        ARCHI_ERROR_PARAM_DECL)
+{
+    if (program == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "DEG program is NULL");
+        return position;
+    }
+    else if ((mode < ARCHI_DEXGRAPH__NO_INTERRUPT) || (mode > ARCHI_DEXGRAPH__INTERRUPT_OPERATION))
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "unknown DEG execution mode %i", mode);
+        return position;
+    }
+
+    const struct archi_dexgraph_program_instruction *instruction = program->instruction;
+    const size_t length = program->length;
+
+    archi_error_t error;
+    ARCHI_ERROR_VAR_RESET(&error);
+
+    // ARCHI_DEXGRAPH_PROGRAM_END is never less than program length
+    while (position < length)
+    {
+        const struct archi_dexgraph_program_instruction *current = &instruction[position];
+
+        if (current->branch == NULL)
+        {
+            // Only the error code is reset here, the rest is filled on failure
+            error.code = ARCHI__EUNSPECIFIED;
+            /*****************************************************/
+            current->function.operation(current->data, &error);
+            /*****************************************************/
+
+            if (error.code != 0)
+                goto failure;
+
+            position++;
+
+            if (mode >= ARCHI_DEXGRAPH__INTERRUPT_OPERATION)
+                goto interrupt;
+        }
+        else
+        {
+            archi_dexgraph_branch_index_t branch_index;
+
+            if (current->kind != ARCHI_DEXGRAPH_TRANSITION__FUNCTION)
+            {
+                branch_index = archi_dexgraph_transition_builtin((archi_dexgraph_transition_t){
+                        .data = current->data, .kind = current->kind}, &error);
+
+                if (error.code != 0)
+                    goto failure;
+            }
+            else if (current->function.transition != NULL)
+            {
+                error.code = ARCHI__EUNSPECIFIED;
+                /**************************************************************************/
+                branch_index = current->function.transition(current->data, &error);
+                /**************************************************************************/
+
+                if (error.code != 0)
+                    goto failure;
+            }
+            else if (current->data != NULL)
+                branch_index = *(archi_dexgraph_branch_index_t*)current->data;
+            else
+                branch_index = 0;
+
+            if (branch_index < current->num_branches)
+                position = current->branch[branch_index];
+            else // non-existent branch or ARCHI_DEXGRAPH_HALT
+                position = ARCHI_DEXGRAPH_PROGRAM_END;
+
+            if (mode >= ARCHI_DEXGRAPH__INTERRUPT_TRANSITION)
+                goto interrupt;
+        }
+    }
+
+    position = ARCHI_DEXGRAPH_PROGRAM_END;
+    goto interrupt;
+
+failure:
+    if (error.code == ARCHI__EUNSPECIFIED)
+        ARCHI_ERROR_VAR_UNSET(&error);
+
+interrupt:
+    ARCHI_ERROR_ASSIGN(error);
+    return position;
+}
+
+archi_dexgraph_program_position_t
+archi_dexgraph_program_position(
+        archi_dexgraph_program_t program,
+        archi_dexgraph_frame_t frame)
+{
+    if ((program == NULL) || (frame.node == NULL))
+        return ARCHI_DEXGRAPH_PROGRAM_END;
+
+    size_t node_index = archi_dexgraph_program_node_index(
+            program->node, program->num_nodes, frame.node);
+    if (node_index == program->num_nodes)
+        return ARCHI_DEXGRAPH_PROGRAM_END;
+
+    archi_dexgraph_program_position_t position = program->node_start[node_index];
+
+    while ((program->instruction[position].branch == NULL) &&
+            (program->origin[position].index < frame.index))
+        position++;
+
+    return position;
+}
+
+archi_dexgraph_frame_t
+archi_dexgraph_program_frame(
+        archi_dexgraph_program_t program,
+        archi_dexgraph_program_position_t position)
+{
+    if ((program == NULL) || (position >= program->length))
+        return (archi_dexgraph_frame_t){0};
+
+    return program->origin[position];
+}
+
+size_t
+archi_dexgraph_program_length(
+        archi_dexgraph_program_t program)
+{
+    return (program != NULL) ? program->length : 0;
+}
+
+size_t
+archi_dexgraph_program_num_nodes(
+        archi_dexgraph_program_t program)
+{
+    return (program != NULL) ? program->num_nodes : 0;
+}
+
@@ -0,0 +1,210 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Context interface for dataflow graphs of operations.
+ */
+
+#include "archi/exec/ctx/dataflow.var.h"
+#include "archi/exec/api/dataflow.fun.h"
+#include "archi/exec/api/tag.def.h"
+#include "archi/context/api/interface.def.h"
+#include "archi_base/pointer.fun.h"
+#include "archi_base/pointer.def.h"
+#include "archi_base/util/plist.fun.h"
+#include "archi_base/util/check.fun.h"
+#include "archi_base/util/string.fun.h"
+
+#include <stdlib.h> // for malloc(), free()
+
+
+struct archi_context_data__dexgraph_dataflow {
+    archi_rcpointer_t dataflow;
+
+    // References
+    archi_rcpointer_t ref_node;
+};
+
+static
+ARCHI_CONTEXT_INIT_FUNC(archi_context_init__dexgraph_dataflow)
+{
+    // Parse parameters
+    archi_rcpointer_t node = {0};
+    archi_rcpointer_t dependencies = {0};
+    {
+        archi_plist_param_t parsed[] = {
+            {.name = "node",
+                .check = {archi_value_check__attr, (archi_pointer_attr_t[]){archi_pointer_attr__cdata(ARCHI_POINTER_DATA_TAG__DEXGRAPH_NODE)}},
+                .assign = {archi_plist_assign__rcpointer, &node, sizeof(node), NULL}},
+            {.name = "dependencies",
+                .check = {archi_value_check__attr, (archi_pointer_attr_t[]){ARCHI_POINTER_ATTR__PDATA(1, archi_dexgraph_dataflow_dependency_t)}},
+                .assign = {archi_plist_assign__rcpointer, &dependencies, sizeof(dependencies), NULL}},
+            {0},
+        };
+
+        if (!archi_plist_parse(&params->n, true, parsed, false, ARCHI_ERROR_PARAM))
+            return NULL;
+    }
+
+    if (node.ptr == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "node is not specified");
+        return NULL;
+    }
+
+    size_t num_dependencies = 0;
+    if (dependencies.ptr != NULL)
+        archi_pointer_attr_unpk__pdata(dependencies.attr, &num_dependencies, NULL, NULL, NULL);
+
+    // Construct the context
+    struct archi_context_data__dexgraph_dataflow *context_data = malloc(sizeof(*context_data));
+    if (context_data == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__EMEMORY, "couldn't allocate context data");
+        return NULL;
+    }
+
+    *context_data = (struct archi_context_data__dexgraph_dataflow){
+        .dataflow = {
+            .ptr = archi_dexgraph_dataflow_create(node.cptr, dependencies.cptr, num_dependencies, ARCHI_ERROR_PARAM),
+            .attr = ARCHI_POINTER_TYPE__DATA_WRITABLE |
+                archi_pointer_attr__cdata(ARCHI_POINTER_DATA_TAG__DEXGRAPH_DATAFLOW),
+        },
+    };
+
+    if (context_data->dataflow.ptr == NULL)
+        goto failure;
+
+    // Initialize references
+    context_data->ref_node = archi_rcpointer_own(node, ARCHI_ERROR_PARAM);
+    if (!context_data->ref_node.attr)
+        goto failure;
+
+    ARCHI_ERROR_RESET();
+    return (archi_rcpointer_t*)context_data;
+
+failure:
+    archi_dexgraph_dataflow_destroy(context_data->dataflow.ptr);
+    free(context_data);
+
+    return NULL;
+}
+
+static
+ARCHI_CONTEXT_FINAL_FUNC(archi_context_final__dexgraph_dataflow)
+{
+    struct archi_context_data__dexgraph_dataflow *context_data =
+        (struct archi_context_data__dexgraph_dataflow*)context;
+
+    archi_rcpointer_disown(context_data->ref_node);
+
+    archi_dexgraph_dataflow_destroy(context_data->dataflow.ptr);
+    free(context_data);
+}
+
+static
+ARCHI_CONTEXT_EVAL_FUNC(archi_context_eval__dexgraph_dataflow)
+{
+    struct archi_context_data__dexgraph_dataflow *context_data =
+        (struct archi_context_data__dexgraph_dataflow*)context;
+
+    archi_dexgraph_dataflow_t dataflow = context_data->dataflow.ptr;
+
+    if (!call)
+    {
+        if (ARCHI_STRING_COMPARE("node", ==, slot.name))
+        {
+            if (slot.num_indices != 0)
+            {
+                ARCHI_ERROR_SET(ARCHI__EINDEX, "number of slot indices isn't 0");
+                return;
+            }
+
+            ARCHI_CONTEXT_YIELD(context_data->ref_node);
+        }
+        else if (ARCHI_STRING_COMPARE("num_operations", ==, slot.name))
+        {
+            if (slot.num_indices != 0)
+            {
+                ARCHI_ERROR_SET(ARCHI__EINDEX, "number of slot indices isn't 0");
+                return;
+            }
+
+            size_t num_operations = archi_dexgraph_dataflow_num_operations(dataflow);
+
+            archi_rcpointer_t value = {
+                .ptr = &num_operations,
+                .attr = ARCHI_POINTER_TYPE__DATA_ON_STACK |
+                    ARCHI_POINTER_ATTR__PDATA(1, size_t),
+            };
+
+            ARCHI_CONTEXT_YIELD(value);
+        }
+        else if (ARCHI_STRING_COMPARE("num_dependencies", ==, slot.name))
+        {
+            if (slot.num_indices != 0)
+            {
+                ARCHI_ERROR_SET(ARCHI__EINDEX, "number of slot indices isn't 0");
+                return;
+            }
+
+            size_t num_dependencies = archi_dexgraph_dataflow_num_dependencies(dataflow);
+
+            archi_rcpointer_t value = {
+                .ptr = &num_dependencies,
+                .attr = ARCHI_POINTER_TYPE__DATA_ON_STACK |
+                    ARCHI_POINTER_ATTR__PDATA(1, size_t),
+            };
+
+            ARCHI_CONTEXT_YIELD(value);
+        }
+        else
+            ARCHI_ERROR_SET(ARCHI__EKEY, "unknown slot '%s' encountered", slot.name);
+    }
+    else
+    {
+        if (ARCHI_STRING_COMPARE("execute", ==, slot.name))
+        {
+            if (slot.num_indices != 0)
+            {
+                ARCHI_ERROR_SET(ARCHI__EINDEX, "number of slot indices isn't 0");
+                return;
+            }
+            else if (params != NULL)
+            {
+                ARCHI_ERROR_SET(ARCHI__EKEY, "no parameters are accepted");
+                return;
+            }
+
+            archi_dexgraph_dataflow_execute(dataflow, ARCHI_ERROR_PARAM);
+        }
+        else
+            ARCHI_ERROR_SET(ARCHI__EKEY, "unknown slot '%s' encountered", slot.name);
+    }
+}
+
+const archi_context_interface_t
+archi_context_interface__dexgraph_dataflow = {
+    .init_fn = archi_context_init__dexgraph_dataflow,
+    .final_fn = archi_context_final__dexgraph_dataflow,
+    .eval_fn = archi_context_eval__dexgraph_dataflow,
+};
+
@@ -56,6 +56,7 @@ ARCHI_CONTEXT_INIT_FUNC(archi_context_init__dexgraph_node)
     const char *name = NULL;
     size_t sequence_length = 0;
     archi_rcpointer_t transition_func = {0}, transition_data = {0}, branch_array = {0};
+    archi_dexgraph_transition_kind_t transition_kind = ARCHI_DEXGRAPH_TRANSITION__FUNCTION;
     {
         archi_plist_param_t parsed[] = {
             {.name = "name",
@@ -70,6 +71,9 @@ ARCHI_CONTEXT_INIT_FUNC(archi_context_init__dexgraph_node)
             {.name = "transition_data",
                 .check = {archi_value_check__attr, (archi_pointer_attr_t[]){archi_pointer_attr__cdata(0)}},
                 .assign = {archi_plist_assign__rcpointer, &transition_data, sizeof(transition_data), NULL}},
+            {.name = "transition_kind",
+                .check = {archi_value_check__attr, (archi_pointer_attr_t[]){ARCHI_POINTER_ATTR__PDATA(1, archi_dexgraph_transition_kind_t)}},
+                .assign = {archi_plist_assign__value, &transition_kind, sizeof(transition_kind), NULL}},
             {.name = "branches",
                 .check = {archi_value_check__attr, (archi_pointer_attr_t[]){archi_pointer_attr__cdata(ARCHI_POINTER_DATA_TAG__DEXGRAPH_NODE_ARRAY)}},
                 .assign = {archi_plist_assign__rcpointer, &branch_array, sizeof(branch_array), NULL}},
@@ -146,6 +150,7 @@ ARCHI_CONTEXT_INIT_FUNC(archi_context_init__dexgraph_node)
 
     node->transition.function = (archi_dexgraph_transition_func_t)context_data->ref_transition_func.fptr;
     node->transition.data = context_data->ref_transition_data.ptr;
+    node->transition.kind = transition_kind;
     node->branch = context_data->ref_branch_array.cptr;
 
     ARCHI_ERROR_RESET();
@@ -290,6 +295,24 @@ ARCHI_CONTEXT_EVAL_FUNC(archi_context_eval__dexgraph_node)
 
             ARCHI_CONTEXT_YIELD(context_data->ref_transition_data);
         }
+        else if (ARCHI_STRING_COMPARE("transition.kind", ==, slot.name))
+        {
+            if (slot.num_indices != 0)
+            {
+                ARCHI_ERROR_SET(ARCHI__EINDEX, "number of slot indices isn't 0");
+                return;
+            }
+
+            archi_dexgraph_transition_kind_t kind = node->transition.kind;
+
+            archi_rcpointer_t value = {
+                .ptr = &kind,
+                .attr = ARCHI_POINTER_TYPE__DATA_ON_STACK |
+                    ARCHI_POINTER_ATTR__PDATA(1, archi_dexgraph_transition_kind_t),
+            };
+
+            ARCHI_CONTEXT_YIELD(value);
+        }
         else if (ARCHI_STRING_COMPARE("branches", ==, slot.name))
         {
             if (slot.num_indices != 0)
@@ -315,11 +338,15 @@ ARCHI_CONTEXT_EVAL_FUNC(archi_context_eval__dexgraph_node)
 
             // Parse parameters
             size_t index = 0;
+            archi_dexgraph_profile_t profile = NULL;
             {
                 archi_plist_param_t parsed[] = {
                     {.name = "index",
                         .check = {archi_value_check__attr, (archi_pointer_attr_t[]){ARCHI_POINTER_ATTR__PDATA(1, archi_dexgraph_branch_index_t)}},
                         .assign = {archi_plist_assign__value, &index, sizeof(index), NULL}},
+                    {.name = "profile",
+                        .check = {archi_value_check__attr, (archi_pointer_attr_t[]){archi_pointer_attr__cdata(ARCHI_POINTER_DATA_TAG__DEXGRAPH_PROFILE)}},
+                        .assign = {archi_plist_assign__dptr, &profile, sizeof(profile), NULL}},
                     {0},
                 };
 
@@ -333,7 +360,10 @@ ARCHI_CONTEXT_EVAL_FUNC(archi_context_eval__dexgraph_node)
                 .index = index,
             };
 
-            archi_dexgraph_execute(frame, ARCHI_DEXGRAPH__NO_INTERRUPT, ARCHI_ERROR_PARAM);
+            if (profile == NULL)
+                archi_dexgraph_execute(frame, ARCHI_DEXGRAPH__NO_INTERRUPT, ARCHI_ERROR_PARAM);
+            else
+                archi_dexgraph_execute_profiled(frame, ARCHI_DEXGRAPH__NO_INTERRUPT, profile, ARCHI_ERROR_PARAM);
         }
         else
             ARCHI_ERROR_SET(ARCHI__EKEY, "unknown slot '%s' encountered", slot.name);
@@ -464,6 +494,24 @@ ARCHI_CONTEXT_SET_FUNC(archi_context_set__dexgraph_node)
 
         ARCHI_ERROR_RESET();
     }
+    else if (ARCHI_STRING_COMPARE("transition.kind", ==, slot.name))
+    {
+        if (slot.num_indices != 0)
+        {
+            ARCHI_ERROR_SET(ARCHI__EINDEX, "number of slot indices isn't 0");
+            return;
+        }
+        else if (!archi_pointer_attr_compatible(value.attr,
+                    ARCHI_POINTER_ATTR__PDATA(1, archi_dexgraph_transition_kind_t)))
+        {
+            ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "assigned value is not a DEG transition kind");
+            return;
+        }
+
+        node->transition.kind = *(archi_dexgraph_transition_kind_t*)value.ptr;
+
+        ARCHI_ERROR_RESET();
+    }
     else if (ARCHI_STRING_COMPARE("branches", ==, slot.name))
     {
         if (slot.num_indices != 0)
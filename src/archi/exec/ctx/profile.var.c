@@ -0,0 +1,136 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Context interface for DEG execution profiles.
+ */
+
+#include "archi/exec/ctx/profile.var.h"
+#include "archi/exec/api/profile.fun.h"
+#include "archi/exec/api/tag.def.h"
+#include "archi/context/api/interface.def.h"
+#include "archi_base/pointer.fun.h"
+#include "archi_base/pointer.def.h"
+#include "archi_base/util/string.fun.h"
+
+#include <stdlib.h> // for malloc(), free()
+
+
+static
+ARCHI_CONTEXT_INIT_FUNC(archi_context_init__dexgraph_profile)
+{
+    if (params != NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__EKEY, "no parameters are accepted");
+        return NULL;
+    }
+
+    // Construct the context
+    archi_rcpointer_t *context_data = malloc(sizeof(*context_data));
+    if (context_data == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__EMEMORY, "couldn't allocate context data");
+        return NULL;
+    }
+
+    archi_dexgraph_profile_t profile = archi_dexgraph_profile_alloc();
+    if (profile == NULL)
+    {
+        free(context_data);
+
+        ARCHI_ERROR_SET(ARCHI__EMEMORY, "couldn't allocate DEG execution profile");
+        return NULL;
+    }
+
+    *context_data = (archi_rcpointer_t){
+        .ptr = profile,
+        .attr = ARCHI_POINTER_TYPE__DATA_WRITABLE |
+            archi_pointer_attr__cdata(ARCHI_POINTER_DATA_TAG__DEXGRAPH_PROFILE),
+    };
+
+    ARCHI_ERROR_RESET();
+    return context_data;
+}
+
+static
+ARCHI_CONTEXT_FINAL_FUNC(archi_context_final__dexgraph_profile)
+{
+    archi_dexgraph_profile_free(context->ptr);
+    free(context);
+}
+
+static
+ARCHI_CONTEXT_EVAL_FUNC(archi_context_eval__dexgraph_profile)
+{
+    if (!call)
+    {
+        if (ARCHI_STRING_COMPARE("num_entries", ==, slot.name))
+        {
+            if (slot.num_indices != 0)
+            {
+                ARCHI_ERROR_SET(ARCHI__EINDEX, "number of slot indices isn't 0");
+                return;
+            }
+
+            size_t num_entries = archi_dexgraph_profile_num_entries(context->ptr);
+
+            archi_rcpointer_t value = {
+                .ptr = &num_entries,
+                .attr = ARCHI_POINTER_TYPE__DATA_ON_STACK |
+                    ARCHI_POINTER_ATTR__PDATA(1, size_t),
+            };
+
+            ARCHI_CONTEXT_YIELD(value);
+        }
+        else
+            ARCHI_ERROR_SET(ARCHI__EKEY, "unknown slot '%s' encountered", slot.name);
+    }
+    else
+    {
+        if (ARCHI_STRING_COMPARE("reset", ==, slot.name))
+        {
+            if (slot.num_indices != 0)
+            {
+                ARCHI_ERROR_SET(ARCHI__EINDEX, "number of slot indices isn't 0");
+                return;
+            }
+            else if (params != NULL)
+            {
+                ARCHI_ERROR_SET(ARCHI__EKEY, "no parameters are accepted");
+                return;
+            }
+
+            archi_dexgraph_profile_reset(context->ptr);
+
+            ARCHI_ERROR_RESET();
+        }
+        else
+            ARCHI_ERROR_SET(ARCHI__EKEY, "unknown slot '%s' encountered", slot.name);
+    }
+}
+
+const archi_context_interface_t
+archi_context_interface__dexgraph_profile = {
+    .init_fn = archi_context_init__dexgraph_profile,
+    .final_fn = archi_context_final__dexgraph_profile,
+    .eval_fn = archi_context_eval__dexgraph_profile,
+};
+
@@ -0,0 +1,212 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Context interface for compiled directed execution graph programs.
+ */
+
+#include "archi/exec/ctx/program.var.h"
+#include "archi/exec/api/program.fun.h"
+#include "archi/exec/api/tag.def.h"
+#include "archi/context/api/interface.def.h"
+#include "archi_base/pointer.fun.h"
+#include "archi_base/pointer.def.h"
+#include "archi_base/util/plist.fun.h"
+#include "archi_base/util/check.fun.h"
+#include "archi_base/util/string.fun.h"
+
+#include <stdlib.h> // for malloc(), free()
+
+
+struct archi_context_data__dexgraph_program {
+    archi_rcpointer_t program;
+
+    // References
+    archi_rcpointer_t ref_entry;
+};
+
+static
+ARCHI_CONTEXT_INIT_FUNC(archi_context_init__dexgraph_program)
+{
+    // Parse parameters
+    archi_rcpointer_t entry = {0};
+    {
+        archi_plist_param_t parsed[] = {
+            {.name = "entry",
+                .check = {archi_value_check__attr, (archi_pointer_attr_t[]){archi_pointer_attr__cdata(ARCHI_POINTER_DATA_TAG__DEXGRAPH_NODE)}},
+                .assign = {archi_plist_assign__rcpointer, &entry, sizeof(entry), NULL}},
+            {0},
+        };
+
+        if (!archi_plist_parse(&params->n, true, parsed, false, ARCHI_ERROR_PARAM))
+            return NULL;
+    }
+
+    if (entry.ptr == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "entry node is not specified");
+        return NULL;
+    }
+
+    // Construct the context
+    struct archi_context_data__dexgraph_program *context_data = malloc(sizeof(*context_data));
+    if (context_data == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__EMEMORY, "couldn't allocate context data");
+        return NULL;
+    }
+
+    *context_data = (struct archi_context_data__dexgraph_program){
+        .program = {
+            .ptr = archi_dexgraph_program_compile(entry.cptr, ARCHI_ERROR_PARAM),
+            .attr = ARCHI_POINTER_TYPE__DATA_WRITABLE |
+                archi_pointer_attr__cdata(ARCHI_POINTER_DATA_TAG__DEXGRAPH_PROGRAM),
+        },
+    };
+
+    if (context_data->program.ptr == NULL)
+        goto failure;
+
+    // Initialize references
+    context_data->ref_entry = archi_rcpointer_own(entry, ARCHI_ERROR_PARAM);
+    if (!context_data->ref_entry.attr)
+        goto failure;
+
+    ARCHI_ERROR_RESET();
+    return (archi_rcpointer_t*)context_data;
+
+failure:
+    archi_dexgraph_program_free(context_data->program.ptr);
+    free(context_data);
+
+    return NULL;
+}
+
+static
+ARCHI_CONTEXT_FINAL_FUNC(archi_context_final__dexgraph_program)
+{
+    struct archi_context_data__dexgraph_program *context_data =
+        (struct archi_context_data__dexgraph_program*)context;
+
+    archi_rcpointer_disown(context_data->ref_entry);
+
+    archi_dexgraph_program_free(context_data->program.ptr);
+    free(context_data);
+}
+
+static
+ARCHI_CONTEXT_EVAL_FUNC(archi_context_eval__dexgraph_program)
+{
+    struct archi_context_data__dexgraph_program *context_data =
+        (struct archi_context_data__dexgraph_program*)context;
+
+    archi_dexgraph_program_t program = context_data->program.ptr;
+
+    if (!call)
+    {
+        if (ARCHI_STRING_COMPARE("entry", ==, slot.name))
+        {
+            if (slot.num_indices != 0)
+            {
+                ARCHI_ERROR_SET(ARCHI__EINDEX, "number of slot indices isn't 0");
+                return;
+            }
+
+            ARCHI_CONTEXT_YIELD(context_data->ref_entry);
+        }
+        else if (ARCHI_STRING_COMPARE("length", ==, slot.name))
+        {
+            if (slot.num_indices != 0)
+            {
+                ARCHI_ERROR_SET(ARCHI__EINDEX, "number of slot indices isn't 0");
+                return;
+            }
+
+            size_t length = archi_dexgraph_program_length(program);
+
+            archi_rcpointer_t value = {
+                .ptr = &length,
+                .attr = ARCHI_POINTER_TYPE__DATA_ON_STACK |
+                    ARCHI_POINTER_ATTR__PDATA(1, size_t),
+            };
+
+            ARCHI_CONTEXT_YIELD(value);
+        }
+        else if (ARCHI_STRING_COMPARE("num_nodes", ==, slot.name))
+        {
+            if (slot.num_indices != 0)
+            {
+                ARCHI_ERROR_SET(ARCHI__EINDEX, "number of slot indices isn't 0");
+                return;
+            }
+
+            size_t num_nodes = archi_dexgraph_program_num_nodes(program);
+
+            archi_rcpointer_t value = {
+                .ptr = &num_nodes,
+                .attr = ARCHI_POINTER_TYPE__DATA_ON_STACK |
+                    ARCHI_POINTER_ATTR__PDATA(1, size_t),
+            };
+
+            ARCHI_CONTEXT_YIELD(value);
+        }
+        else
+            ARCHI_ERROR_SET(ARCHI__EKEY, "unknown slot '%s' encountered", slot.name);
+    }
+    else
+    {
+        if (ARCHI_STRING_COMPARE("execute", ==, slot.name))
+        {
+            if (slot.num_indices != 0)
+            {
+                ARCHI_ERROR_SET(ARCHI__EINDEX, "number of slot indices isn't 0");
+                return;
+            }
+
+            // Parse parameters
+            archi_dexgraph_program_position_t position = 0;
+            {
+                archi_plist_param_t parsed[] = {
+                    {.name = "position",
+                        .check = {archi_value_check__attr, (archi_pointer_attr_t[]){ARCHI_POINTER_ATTR__PDATA(1, archi_dexgraph_program_position_t)}},
+                        .assign = {archi_plist_assign__value, &position, sizeof(position), NULL}},
+                    {0},
+                };
+
+                if (!archi_plist_parse(&params->n, true, parsed, false, ARCHI_ERROR_PARAM))
+                    return;
+            }
+
+            // Execute the program
+            archi_dexgraph_program_execute(program, position, ARCHI_DEXGRAPH__NO_INTERRUPT, ARCHI_ERROR_PARAM);
+        }
+        else
+            ARCHI_ERROR_SET(ARCHI__EKEY, "unknown slot '%s' encountered", slot.name);
+    }
+}
+
+const archi_context_interface_t
+archi_context_interface__dexgraph_program = {
+    .init_fn = archi_context_init__dexgraph_program,
+    .final_fn = archi_context_final__dexgraph_program,
+    .eval_fn = archi_context_eval__dexgraph_program,
+};
+
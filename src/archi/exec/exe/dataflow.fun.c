@@ -0,0 +1,40 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Operation functions for dataflow graphs of operations.
+ */
+
+#include "archi/exec/exe/dataflow.fun.h"
+#include "archi/exec/api/dataflow.fun.h"
+
+
+ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__dataflow_execute)
+{
+    if (data == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "dataflow graph is NULL");
+        return;
+    }
+
+    archi_dexgraph_dataflow_execute(data, ARCHI_ERROR_PARAM);
+}
+
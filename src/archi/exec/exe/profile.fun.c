@@ -0,0 +1,119 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Operation functions for DEG execution profiles.
+ */
+
+#include "archi/exec/exe/profile.fun.h"
+#include "archi/exec/api/profile.fun.h"
+#include "archi/exec/api/node.typ.h"
+
+#include <stdio.h> // for printf()
+#include <stdlib.h> // for malloc(), free(), qsort()
+
+
+ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__profile_reset)
+{
+    if (data == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "DEG execution profile is NULL");
+        return;
+    }
+
+    archi_dexgraph_profile_reset(data);
+
+    ARCHI_ERROR_RESET();
+}
+
+static
+int
+archi_dexgraph_profile_entry_compare(
+        const void *a,
+        const void *b)
+{
+    const archi_dexgraph_profile_entry_t *entry_a = *(const archi_dexgraph_profile_entry_t**)a;
+    const archi_dexgraph_profile_entry_t *entry_b = *(const archi_dexgraph_profile_entry_t**)b;
+
+    return (entry_a->total_ns < entry_b->total_ns) - (entry_a->total_ns > entry_b->total_ns);
+}
+
+ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__profile_report)
+{
+    if (data == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "DEG execution profile is NULL");
+        return;
+    }
+
+    size_t num_entries = archi_dexgraph_profile_num_entries(data);
+    const archi_dexgraph_profile_entry_t *entries = archi_dexgraph_profile_entries(data);
+
+    const archi_dexgraph_profile_entry_t **sorted = malloc(sizeof(*sorted) * (num_entries + 1));
+    if (sorted == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__EMEMORY, "couldn't allocate array of sorted profile entries (length = %zu)",
+                num_entries);
+        return;
+    }
+
+    uint64_t total_ns = 0;
+    for (size_t i = 0; i < num_entries; i++)
+    {
+        sorted[i] = &entries[i];
+        total_ns += entries[i].total_ns;
+    }
+
+    qsort(sorted, num_entries, sizeof(*sorted), archi_dexgraph_profile_entry_compare);
+
+    printf("\n------ DEG PROFILE REPORT ------\n");
+    printf("%-24s %8s %10s %12s %7s %10s %10s %10s\n",
+            "Node", "Index", "Calls", "Total ms", "Share", "Avg us", "Min us", "Max us");
+
+    for (size_t i = 0; i < num_entries; i++)
+    {
+        const archi_dexgraph_profile_entry_t *entry = sorted[i];
+
+        const char *name = (entry->node->name != NULL) ? entry->node->name : "<unnamed>";
+
+        char index[24];
+        if (entry->index < entry->node->sequence_length)
+            snprintf(index, sizeof(index), "%zu", entry->index);
+        else
+            snprintf(index, sizeof(index), "->");
+
+        printf("%-24s %8s %10llu %12.3f %6.1f%% %10.3f %10.3f %10.3f\n",
+                name, index, (unsigned long long)entry->num_calls,
+                entry->total_ns * 1e-6,
+                (total_ns != 0) ? entry->total_ns * 100.0 / total_ns : 0.0,
+                entry->total_ns * 1e-3 / entry->num_calls,
+                entry->min_ns * 1e-3, entry->max_ns * 1e-3);
+    }
+
+    printf("Total        : %.3f ms in %zu entries ('->' marks transitions)\n",
+            total_ns * 1e-6, num_entries);
+    printf("--- END OF DEG PROFILE REPORT ---\n");
+
+    free(sorted);
+
+    ARCHI_ERROR_RESET();
+}
+
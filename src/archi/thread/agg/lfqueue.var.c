@@ -0,0 +1,79 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Aggregate type descriptions for data of operation functions for lock-free queue operations.
+ */
+
+#include "archi/thread/agg/lfqueue.var.h"
+#include "archi/thread/exe/lfqueue.typ.h"
+#include "archi/thread/api/tag.def.h"
+
+
+static
+const archi_aggr_member_type__value_t
+VTYPE_size = ARCHI_AGGR_MEMBER_TYPE__VALUE(size_t, 0);
+
+static
+const archi_aggr_member_type__pointer_t
+PTYPE_data = ARCHI_AGGR_MEMBER_TYPE__POINTER_TO_CDATA(void*, 0);
+
+static
+const archi_aggr_member_type__pointer_t
+PTYPE_thread_lfqueue = ARCHI_AGGR_MEMBER_TYPE__POINTER_TO_CDATA(archi_thread_lfqueue_t,
+        ARCHI_POINTER_DATA_TAG__THREAD_LFQUEUE);
+
+static
+const archi_aggr_member_type__pointer_t
+PTYPE_count = ARCHI_AGGR_MEMBER_TYPE__POINTER_TO_PDATA(size_t*, size_t, 1);
+
+/*****************************************************************************/
+
+static
+const archi_aggr_member_t
+MEMBERS_dexgraph_op_data__thread_lfqueue_push_n[] = {
+    ARCHI_AGGR_MEMBER__POINTER(archi_dexgraph_op_data__thread_lfqueue_push_n_t, queue, 1, PTYPE_thread_lfqueue),
+    ARCHI_AGGR_MEMBER__POINTER(archi_dexgraph_op_data__thread_lfqueue_push_n_t, values, 1, PTYPE_data),
+    ARCHI_AGGR_MEMBER__VALUE(archi_dexgraph_op_data__thread_lfqueue_push_n_t, num_values, 1, VTYPE_size),
+    ARCHI_AGGR_MEMBER__POINTER(archi_dexgraph_op_data__thread_lfqueue_push_n_t, num_pushed, 1, PTYPE_count),
+};
+
+const archi_aggr_type_t
+archi_aggr_type__dexgraph_op_data__thread_lfqueue_push_n = ARCHI_AGGR_TYPE(
+        archi_dexgraph_op_data__thread_lfqueue_push_n_t, 0,
+        MEMBERS_dexgraph_op_data__thread_lfqueue_push_n);
+
+/*****************************************************************************/
+
+static
+const archi_aggr_member_t
+MEMBERS_dexgraph_op_data__thread_lfqueue_pop_n[] = {
+    ARCHI_AGGR_MEMBER__POINTER(archi_dexgraph_op_data__thread_lfqueue_pop_n_t, queue, 1, PTYPE_thread_lfqueue),
+    ARCHI_AGGR_MEMBER__POINTER(archi_dexgraph_op_data__thread_lfqueue_pop_n_t, values, 1, PTYPE_data),
+    ARCHI_AGGR_MEMBER__VALUE(archi_dexgraph_op_data__thread_lfqueue_pop_n_t, num_values, 1, VTYPE_size),
+    ARCHI_AGGR_MEMBER__POINTER(archi_dexgraph_op_data__thread_lfqueue_pop_n_t, num_popped, 1, PTYPE_count),
+};
+
+const archi_aggr_type_t
+archi_aggr_type__dexgraph_op_data__thread_lfqueue_pop_n = ARCHI_AGGR_TYPE(
+        archi_dexgraph_op_data__thread_lfqueue_pop_n_t, 0,
+        MEMBERS_dexgraph_op_data__thread_lfqueue_pop_n);
+
@@ -0,0 +1,59 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+/**
+ * @file
+ * @brief Aggregate type descriptions for data of operation functions for scheduler operations.
+ */
+
+#include "archi/thread/agg/scheduler.var.h"
+#include "archi/thread/exe/scheduler.typ.h"
+#include "archi/thread/api/tag.def.h"
+#include "archi/exec/api/tag.def.h"
+
+
+static
+const archi_aggr_member_type__value_t
+VTYPE_size = ARCHI_AGGR_MEMBER_TYPE__VALUE(size_t, 0);
+
+static
+const archi_aggr_member_type__pointer_t
+PTYPE_thread_scheduler = ARCHI_AGGR_MEMBER_TYPE__POINTER_TO_CDATA(archi_thread_scheduler_t,
+        ARCHI_POINTER_DATA_TAG__THREAD_SCHEDULER);
+
+static
+const archi_aggr_member_type__pointer_t
+PTYPE_dexgraph_node = ARCHI_AGGR_MEMBER_TYPE__POINTER_TO_CDATA(const archi_dexgraph_node_t*,
+        ARCHI_POINTER_DATA_TAG__DEXGRAPH_NODE);
+
+/*****************************************************************************/
+
+static
+const archi_aggr_member_t
+MEMBERS_dexgraph_op_data__thread_scheduler_submit[] = {
+    ARCHI_AGGR_MEMBER__POINTER(archi_dexgraph_op_data__thread_scheduler_submit_t, scheduler, 1, PTYPE_thread_scheduler),
+    ARCHI_AGGR_MEMBER__POINTER(archi_dexgraph_op_data__thread_scheduler_submit_t, node, 1, PTYPE_dexgraph_node),
+    ARCHI_AGGR_MEMBER__VALUE(archi_dexgraph_op_data__thread_scheduler_submit_t, index, 1, VTYPE_size),
+};
+
+const archi_aggr_type_t
+archi_aggr_type__dexgraph_op_data__thread_scheduler_submit = ARCHI_AGGR_TYPE(
+        archi_dexgraph_op_data__thread_scheduler_submit_t, 0,
+        MEMBERS_dexgraph_op_data__thread_scheduler_submit);
+
@@ -26,12 +26,21 @@
 #include "archi/thread/agg/thread_group.var.h"
 #include "archi/thread/exe/thread_group.typ.h"
 #include "archi/thread/api/tag.def.h"
+#include "archi/exec/api/tag.def.h"
 
 
 static
 const archi_aggr_member_type__value_t
 VTYPE_size = ARCHI_AGGR_MEMBER_TYPE__VALUE(size_t, 0);
 
+static
+const archi_aggr_member_type__value_t
+VTYPE_schedule = ARCHI_AGGR_MEMBER_TYPE__VALUE(archi_thread_group_schedule_t, 0);
+
+static
+const archi_aggr_member_type__value_t
+VTYPE_tile_order = ARCHI_AGGR_MEMBER_TYPE__VALUE(archi_thread_group_tile_order_t, 0);
+
 static
 const archi_aggr_member_type__pointer_t
 PTYPE_data = ARCHI_AGGR_MEMBER_TYPE__POINTER_TO_CDATA(void*, 0);
@@ -41,6 +50,26 @@ const archi_aggr_member_type__pointer_t
 PTYPE_thread_group_work_func = ARCHI_AGGR_MEMBER_TYPE__POINTER_TO_FUNC(archi_thread_group_work_func_t,
         ARCHI_POINTER_FUNC_TAG__THREAD_WORK);
 
+static
+const archi_aggr_member_type__pointer_t
+PTYPE_thread_group_tile_work_func = ARCHI_AGGR_MEMBER_TYPE__POINTER_TO_FUNC(archi_thread_group_tile_work_func_t,
+        ARCHI_POINTER_FUNC_TAG__THREAD_TILE_WORK);
+
+static
+const archi_aggr_member_type__pointer_t
+PTYPE_thread_group_reduce_func = ARCHI_AGGR_MEMBER_TYPE__POINTER_TO_FUNC(archi_thread_group_reduce_func_t,
+        ARCHI_POINTER_FUNC_TAG__THREAD_REDUCE);
+
+static
+const archi_aggr_member_type__pointer_t
+PTYPE_thread_group_combine_func = ARCHI_AGGR_MEMBER_TYPE__POINTER_TO_FUNC(archi_thread_group_combine_func_t,
+        ARCHI_POINTER_FUNC_TAG__THREAD_COMBINE);
+
+static
+const archi_aggr_member_type__pointer_t
+PTYPE_thread_group_phase_work_func = ARCHI_AGGR_MEMBER_TYPE__POINTER_TO_FUNC(archi_thread_group_phase_work_func_t,
+        ARCHI_POINTER_FUNC_TAG__THREAD_PHASE_WORK);
+
 static
 const archi_aggr_member_type__pointer_t
 PTYPE_thread_group_callback_func = ARCHI_AGGR_MEMBER_TYPE__POINTER_TO_FUNC(archi_thread_group_callback_func_t,
@@ -51,6 +80,24 @@ const archi_aggr_member_type__pointer_t
 PTYPE_thread_group = ARCHI_AGGR_MEMBER_TYPE__POINTER_TO_CDATA(archi_thread_group_t,
         ARCHI_POINTER_DATA_TAG__THREAD_GROUP);
 
+static
+const archi_aggr_member_type__pointer_t
+PTYPE_dexgraph_node_array = ARCHI_AGGR_MEMBER_TYPE__POINTER_TO_CDATA(const archi_dexgraph_node_array_t*,
+        ARCHI_POINTER_DATA_TAG__DEXGRAPH_NODE_ARRAY);
+
+static
+const archi_aggr_member_type__pointer_t
+PTYPE_dexgraph_dataflow = ARCHI_AGGR_MEMBER_TYPE__POINTER_TO_CDATA(archi_dexgraph_dataflow_t,
+        ARCHI_POINTER_DATA_TAG__DEXGRAPH_DATAFLOW);
+
+static
+const archi_aggr_member_type__pointer_t
+PTYPE_ticket = ARCHI_AGGR_MEMBER_TYPE__POINTER_TO_PDATA(size_t*, size_t, 1);
+
+static
+const archi_aggr_member_type__pointer_t
+PTYPE_error = ARCHI_AGGR_MEMBER_TYPE__POINTER_TO_CDATA(archi_error_t*, 0);
+
 /*****************************************************************************/
 
 static
@@ -67,6 +114,20 @@ archi_aggr_type__thread_group_work = ARCHI_AGGR_TYPE(
 
 /*****************************************************************************/
 
+static
+const archi_aggr_member_t
+MEMBERS_thread_group_tile_work[] = {
+    ARCHI_AGGR_MEMBER__POINTER(archi_thread_group_tile_work_t, function, 1, PTYPE_thread_group_tile_work_func),
+    ARCHI_AGGR_MEMBER__POINTER(archi_thread_group_tile_work_t, data, 1, PTYPE_data),
+};
+
+const archi_aggr_type_t
+archi_aggr_type__thread_group_tile_work = ARCHI_AGGR_TYPE(
+        archi_thread_group_tile_work_t, 0,
+        MEMBERS_thread_group_tile_work);
+
+/*****************************************************************************/
+
 static
 const archi_aggr_member_t
 MEMBERS_thread_group_callback[] = {
@@ -87,6 +148,7 @@ MEMBERS_thread_group_dispatch_params[] = {
     ARCHI_AGGR_MEMBER__VALUE(archi_thread_group_dispatch_params_t, offset, 1, VTYPE_size),
     ARCHI_AGGR_MEMBER__VALUE(archi_thread_group_dispatch_params_t, size, 1, VTYPE_size),
     ARCHI_AGGR_MEMBER__VALUE(archi_thread_group_dispatch_params_t, batch_size, 1, VTYPE_size),
+    ARCHI_AGGR_MEMBER__VALUE(archi_thread_group_dispatch_params_t, schedule, 1, VTYPE_schedule),
 };
 
 const archi_aggr_type_t
@@ -113,3 +175,188 @@ archi_aggr_type__dexgraph_op_data__thread_group_dispatch = ARCHI_AGGR_TYPE(
         archi_dexgraph_op_data__thread_group_dispatch_t, 0,
         MEMBERS_dexgraph_op_data__thread_group_dispatch);
 
+/*****************************************************************************/
+
+static
+const archi_aggr_member_t
+MEMBERS_thread_group_tiled_dispatch_params[] = {
+    ARCHI_AGGR_MEMBER__VALUE(archi_thread_group_tiled_dispatch_params_t, order, 1, VTYPE_tile_order),
+    ARCHI_AGGR_MEMBER__VALUE(archi_thread_group_tiled_dispatch_params_t, size, 3, VTYPE_size),
+    ARCHI_AGGR_MEMBER__VALUE(archi_thread_group_tiled_dispatch_params_t, tile_size, 3, VTYPE_size),
+    ARCHI_AGGR_MEMBER__VALUE(archi_thread_group_tiled_dispatch_params_t, batch_size, 1, VTYPE_size),
+    ARCHI_AGGR_MEMBER__VALUE(archi_thread_group_tiled_dispatch_params_t, schedule, 1, VTYPE_schedule),
+};
+
+const archi_aggr_type_t
+archi_aggr_type__thread_group_tiled_dispatch_params = ARCHI_AGGR_TYPE(
+        archi_thread_group_tiled_dispatch_params_t, 0,
+        MEMBERS_thread_group_tiled_dispatch_params);
+
+/*****************************************************************************/
+
+static
+const archi_aggr_member_t
+MEMBERS_dexgraph_op_data__thread_group_dispatch_tiled[] = {
+    ARCHI_AGGR_MEMBER__POINTER(archi_dexgraph_op_data__thread_group_dispatch_tiled_t, thread_group, 1, PTYPE_thread_group),
+    ARCHI_AGGR_MEMBER__AGGREGATE(archi_dexgraph_op_data__thread_group_dispatch_tiled_t, work, 1,
+            archi_aggr_type__thread_group_tile_work.top_level),
+    ARCHI_AGGR_MEMBER__AGGREGATE(archi_dexgraph_op_data__thread_group_dispatch_tiled_t, callback, 1,
+            archi_aggr_type__thread_group_callback.top_level),
+    ARCHI_AGGR_MEMBER__AGGREGATE(archi_dexgraph_op_data__thread_group_dispatch_tiled_t, param, 1,
+            archi_aggr_type__thread_group_tiled_dispatch_params.top_level),
+};
+
+const archi_aggr_type_t
+archi_aggr_type__dexgraph_op_data__thread_group_dispatch_tiled = ARCHI_AGGR_TYPE(
+        archi_dexgraph_op_data__thread_group_dispatch_tiled_t, 0,
+        MEMBERS_dexgraph_op_data__thread_group_dispatch_tiled);
+
+/*****************************************************************************/
+
+static
+const archi_aggr_member_t
+MEMBERS_thread_group_reduction[] = {
+    ARCHI_AGGR_MEMBER__POINTER(archi_thread_group_reduction_t, accumulate, 1, PTYPE_thread_group_reduce_func),
+    ARCHI_AGGR_MEMBER__POINTER(archi_thread_group_reduction_t, combine, 1, PTYPE_thread_group_combine_func),
+    ARCHI_AGGR_MEMBER__POINTER(archi_thread_group_reduction_t, data, 1, PTYPE_data),
+    ARCHI_AGGR_MEMBER__POINTER(archi_thread_group_reduction_t, identity, 1, PTYPE_data),
+    ARCHI_AGGR_MEMBER__VALUE(archi_thread_group_reduction_t, value_size, 1, VTYPE_size),
+    ARCHI_AGGR_MEMBER__POINTER(archi_thread_group_reduction_t, result, 1, PTYPE_data),
+};
+
+const archi_aggr_type_t
+archi_aggr_type__thread_group_reduction = ARCHI_AGGR_TYPE(
+        archi_thread_group_reduction_t, 0,
+        MEMBERS_thread_group_reduction);
+
+/*****************************************************************************/
+
+static
+const archi_aggr_member_t
+MEMBERS_dexgraph_op_data__thread_group_dispatch_reduce[] = {
+    ARCHI_AGGR_MEMBER__POINTER(archi_dexgraph_op_data__thread_group_dispatch_reduce_t, thread_group, 1, PTYPE_thread_group),
+    ARCHI_AGGR_MEMBER__AGGREGATE(archi_dexgraph_op_data__thread_group_dispatch_reduce_t, reduction, 1,
+            archi_aggr_type__thread_group_reduction.top_level),
+    ARCHI_AGGR_MEMBER__AGGREGATE(archi_dexgraph_op_data__thread_group_dispatch_reduce_t, callback, 1,
+            archi_aggr_type__thread_group_callback.top_level),
+    ARCHI_AGGR_MEMBER__AGGREGATE(archi_dexgraph_op_data__thread_group_dispatch_reduce_t, param, 1,
+            archi_aggr_type__thread_group_dispatch_params.top_level),
+};
+
+const archi_aggr_type_t
+archi_aggr_type__dexgraph_op_data__thread_group_dispatch_reduce = ARCHI_AGGR_TYPE(
+        archi_dexgraph_op_data__thread_group_dispatch_reduce_t, 0,
+        MEMBERS_dexgraph_op_data__thread_group_dispatch_reduce);
+
+/*****************************************************************************/
+
+static
+const archi_aggr_member_t
+MEMBERS_thread_group_phase_work[] = {
+    ARCHI_AGGR_MEMBER__POINTER(archi_thread_group_phase_work_t, function, 1, PTYPE_thread_group_phase_work_func),
+    ARCHI_AGGR_MEMBER__POINTER(archi_thread_group_phase_work_t, data, 1, PTYPE_data),
+    ARCHI_AGGR_MEMBER__VALUE(archi_thread_group_phase_work_t, num_phases, 1, VTYPE_size),
+};
+
+const archi_aggr_type_t
+archi_aggr_type__thread_group_phase_work = ARCHI_AGGR_TYPE(
+        archi_thread_group_phase_work_t, 0,
+        MEMBERS_thread_group_phase_work);
+
+/*****************************************************************************/
+
+static
+const archi_aggr_member_t
+MEMBERS_dexgraph_op_data__thread_group_dispatch_phased[] = {
+    ARCHI_AGGR_MEMBER__POINTER(archi_dexgraph_op_data__thread_group_dispatch_phased_t, thread_group, 1, PTYPE_thread_group),
+    ARCHI_AGGR_MEMBER__AGGREGATE(archi_dexgraph_op_data__thread_group_dispatch_phased_t, work, 1,
+            archi_aggr_type__thread_group_phase_work.top_level),
+    ARCHI_AGGR_MEMBER__AGGREGATE(archi_dexgraph_op_data__thread_group_dispatch_phased_t, callback, 1,
+            archi_aggr_type__thread_group_callback.top_level),
+    ARCHI_AGGR_MEMBER__AGGREGATE(archi_dexgraph_op_data__thread_group_dispatch_phased_t, param, 1,
+            archi_aggr_type__thread_group_dispatch_params.top_level),
+};
+
+const archi_aggr_type_t
+archi_aggr_type__dexgraph_op_data__thread_group_dispatch_phased = ARCHI_AGGR_TYPE(
+        archi_dexgraph_op_data__thread_group_dispatch_phased_t, 0,
+        MEMBERS_dexgraph_op_data__thread_group_dispatch_phased);
+
+/*****************************************************************************/
+
+static
+const archi_aggr_member_t
+MEMBERS_dexgraph_op_data__thread_group_enqueue[] = {
+    ARCHI_AGGR_MEMBER__POINTER(archi_dexgraph_op_data__thread_group_enqueue_t, thread_group, 1, PTYPE_thread_group),
+    ARCHI_AGGR_MEMBER__AGGREGATE(archi_dexgraph_op_data__thread_group_enqueue_t, work, 1,
+            archi_aggr_type__thread_group_work.top_level),
+    ARCHI_AGGR_MEMBER__AGGREGATE(archi_dexgraph_op_data__thread_group_enqueue_t, callback, 1,
+            archi_aggr_type__thread_group_callback.top_level),
+    ARCHI_AGGR_MEMBER__AGGREGATE(archi_dexgraph_op_data__thread_group_enqueue_t, param, 1,
+            archi_aggr_type__thread_group_dispatch_params.top_level),
+    ARCHI_AGGR_MEMBER__POINTER(archi_dexgraph_op_data__thread_group_enqueue_t, after, 1, PTYPE_ticket),
+    ARCHI_AGGR_MEMBER__POINTER(archi_dexgraph_op_data__thread_group_enqueue_t, ticket, 1, PTYPE_ticket),
+};
+
+const archi_aggr_type_t
+archi_aggr_type__dexgraph_op_data__thread_group_enqueue = ARCHI_AGGR_TYPE(
+        archi_dexgraph_op_data__thread_group_enqueue_t, 0,
+        MEMBERS_dexgraph_op_data__thread_group_enqueue);
+
+/*****************************************************************************/
+
+static
+const archi_aggr_member_t
+MEMBERS_dexgraph_op_data__thread_group_cancel[] = {
+    ARCHI_AGGR_MEMBER__POINTER(archi_dexgraph_op_data__thread_group_cancel_t, thread_group, 1, PTYPE_thread_group),
+    ARCHI_AGGR_MEMBER__POINTER(archi_dexgraph_op_data__thread_group_cancel_t, ticket, 1, PTYPE_ticket),
+};
+
+const archi_aggr_type_t
+archi_aggr_type__dexgraph_op_data__thread_group_cancel = ARCHI_AGGR_TYPE(
+        archi_dexgraph_op_data__thread_group_cancel_t, 0,
+        MEMBERS_dexgraph_op_data__thread_group_cancel);
+
+/*****************************************************************************/
+
+static
+const archi_aggr_member_t
+MEMBERS_dexgraph_op_data__thread_group_wait_ticket[] = {
+    ARCHI_AGGR_MEMBER__POINTER(archi_dexgraph_op_data__thread_group_wait_ticket_t, thread_group, 1, PTYPE_thread_group),
+    ARCHI_AGGR_MEMBER__POINTER(archi_dexgraph_op_data__thread_group_wait_ticket_t, ticket, 1, PTYPE_ticket),
+};
+
+const archi_aggr_type_t
+archi_aggr_type__dexgraph_op_data__thread_group_wait_ticket = ARCHI_AGGR_TYPE(
+        archi_dexgraph_op_data__thread_group_wait_ticket_t, 0,
+        MEMBERS_dexgraph_op_data__thread_group_wait_ticket);
+
+/*****************************************************************************/
+
+static
+const archi_aggr_member_t
+MEMBERS_dexgraph_op_data__thread_group_fork_join[] = {
+    ARCHI_AGGR_MEMBER__POINTER(archi_dexgraph_op_data__thread_group_fork_join_t, thread_group, 1, PTYPE_thread_group),
+    ARCHI_AGGR_MEMBER__POINTER(archi_dexgraph_op_data__thread_group_fork_join_t, branches, 1, PTYPE_dexgraph_node_array),
+    ARCHI_AGGR_MEMBER__POINTER(archi_dexgraph_op_data__thread_group_fork_join_t, branch_error, 1, PTYPE_error),
+};
+
+const archi_aggr_type_t
+archi_aggr_type__dexgraph_op_data__thread_group_fork_join = ARCHI_AGGR_TYPE(
+        archi_dexgraph_op_data__thread_group_fork_join_t, 0,
+        MEMBERS_dexgraph_op_data__thread_group_fork_join);
+
+/*****************************************************************************/
+
+static
+const archi_aggr_member_t
+MEMBERS_dexgraph_op_data__thread_group_dataflow[] = {
+    ARCHI_AGGR_MEMBER__POINTER(archi_dexgraph_op_data__thread_group_dataflow_t, thread_group, 1, PTYPE_thread_group),
+    ARCHI_AGGR_MEMBER__POINTER(archi_dexgraph_op_data__thread_group_dataflow_t, dataflow, 1, PTYPE_dexgraph_dataflow),
+};
+
+const archi_aggr_type_t
+archi_aggr_type__dexgraph_op_data__thread_group_dataflow = ARCHI_AGGR_TYPE(
+        archi_dexgraph_op_data__thread_group_dataflow_t, 0,
+        MEMBERS_dexgraph_op_data__thread_group_dataflow);
+
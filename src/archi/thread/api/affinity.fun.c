@@ -0,0 +1,316 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Pinning threads of groups to CPUs.
+ */
+
+#define _GNU_SOURCE // for sched_getaffinity(), sched_setaffinity(), CPU_* macros
+
+#include "affinity.fun.h"
+
+#include <stdlib.h> // for malloc(), calloc(), free()
+#include <stdio.h> // for fopen(), fscanf(), fgetc(), fclose(), snprintf()
+
+#ifdef __linux__
+#  include <sched.h> // for cpu_set_t, sched_getaffinity(), sched_setaffinity()
+#endif
+
+
+#ifdef __linux__
+
+/**
+ * @brief Maximum number of NUMA nodes.
+ */
+#define ARCHI_THREAD_AFFINITY_MAX_NODES 1024
+
+struct archi_thread_affinity_workspace {
+    bool cpu_selected[CPU_SETSIZE];
+    size_t cpu_node[CPU_SETSIZE];
+
+    bool node_online[ARCHI_THREAD_AFFINITY_MAX_NODES];
+    bool node_selected[ARCHI_THREAD_AFFINITY_MAX_NODES];
+
+    bool list[CPU_SETSIZE > ARCHI_THREAD_AFFINITY_MAX_NODES ?
+        CPU_SETSIZE : ARCHI_THREAD_AFFINITY_MAX_NODES];
+};
+
+/**
+ * @brief Read a list in the sysfs format (like "0-3,8,10-11").
+ */
+static
+bool
+archi_thread_affinity_read_list(
+        const char *path,
+        bool *list,
+        size_t list_size)
+{
+    FILE *file = fopen(path, "r");
+    if (file == NULL)
+        return false;
+
+    for (size_t i = 0; i < list_size; i++)
+        list[i] = false;
+
+    unsigned long first, last;
+    while (fscanf(file, "%lu", &first) == 1)
+    {
+        last = first;
+
+        int chr = fgetc(file);
+        if (chr == '-')
+        {
+            if (fscanf(file, "%lu", &last) != 1)
+                break;
+
+            chr = fgetc(file);
+        }
+
+        for (unsigned long i = first; (i <= last) && (i < list_size); i++)
+            list[i] = true;
+
+        if (chr != ',')
+            break;
+    }
+
+    fclose(file);
+    return true;
+}
+
+size_t*
+archi_thread_affinity_plan(
+        archi_thread_group_start_params_t params,
+        ARCHI_ERROR_PARAM_DECL)
+{
+    if ((params.affinity == ARCHI_THREAD_GROUP_AFFINITY__NONE) || (params.num_threads == 0))
+    {
+        ARCHI_ERROR_RESET();
+        return NULL;
+    }
+    else if ((params.affinity != ARCHI_THREAD_GROUP_AFFINITY__COMPACT) &&
+            (params.affinity != ARCHI_THREAD_GROUP_AFFINITY__SCATTER))
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "unknown thread affinity policy (%i)", (int)params.affinity);
+        return NULL;
+    }
+    else if ((params.cpu == NULL) && (params.num_cpus != 0))
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "CPU list is NULL while its length is not zero");
+        return NULL;
+    }
+    else if ((params.numa_node == NULL) && (params.num_numa_nodes != 0))
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "NUMA node list is NULL while its length is not zero");
+        return NULL;
+    }
+
+    cpu_set_t allowed;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+    {
+        ARCHI_ERROR_SET(ARCHI__ESYSTEM, "couldn't get CPU affinity of the process");
+        return NULL;
+    }
+
+    struct archi_thread_affinity_workspace *ws = calloc(1, sizeof(*ws));
+    if (ws == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__EMEMORY, "couldn't allocate thread affinity workspace");
+        return NULL;
+    }
+
+    size_t *order = NULL, *plan = NULL;
+
+    // Determine NUMA nodes of CPUs
+    size_t num_nodes = 1;
+    if (archi_thread_affinity_read_list("/sys/devices/system/node/online",
+                ws->node_online, ARCHI_THREAD_AFFINITY_MAX_NODES))
+    {
+        for (size_t node = 0; node < ARCHI_THREAD_AFFINITY_MAX_NODES; node++)
+        {
+            if (!ws->node_online[node])
+                continue;
+
+            num_nodes = node + 1;
+
+            char path[64];
+            snprintf(path, sizeof(path), "/sys/devices/system/node/node%zu/cpulist", node);
+
+            if (!archi_thread_affinity_read_list(path, ws->list, CPU_SETSIZE))
+                continue;
+
+            for (size_t cpu = 0; cpu < CPU_SETSIZE; cpu++)
+                if (ws->list[cpu])
+                    ws->cpu_node[cpu] = node;
+        }
+    }
+    else // no NUMA information: all CPUs belong to node 0
+        ws->node_online[0] = true;
+
+    // Select CPUs
+    if (params.cpu != NULL)
+    {
+        for (size_t i = 0; i < params.num_cpus; i++)
+        {
+            size_t cpu = params.cpu[i];
+            if ((cpu >= CPU_SETSIZE) || !CPU_ISSET(cpu, &allowed))
+            {
+                ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "CPU %zu is not available to the process", cpu);
+                goto finish;
+            }
+
+            ws->cpu_selected[cpu] = true;
+        }
+    }
+    else
+    {
+        for (size_t cpu = 0; cpu < CPU_SETSIZE; cpu++)
+            ws->cpu_selected[cpu] = CPU_ISSET(cpu, &allowed);
+    }
+
+    // Select NUMA nodes
+    if (params.numa_node != NULL)
+    {
+        for (size_t i = 0; i < params.num_numa_nodes; i++)
+        {
+            size_t node = params.numa_node[i];
+            if ((node >= ARCHI_THREAD_AFFINITY_MAX_NODES) || !ws->node_online[node])
+            {
+                ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "NUMA node %zu is not available", node);
+                goto finish;
+            }
+
+            ws->node_selected[node] = true;
+        }
+
+        for (size_t cpu = 0; cpu < CPU_SETSIZE; cpu++)
+            if (!ws->node_selected[ws->cpu_node[cpu]])
+                ws->cpu_selected[cpu] = false;
+    }
+
+    size_t num_cpus = 0;
+    for (size_t cpu = 0; cpu < CPU_SETSIZE; cpu++)
+        if (ws->cpu_selected[cpu])
+            num_cpus++;
+
+    if (num_cpus == 0)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "no CPUs are available for pinning threads");
+        goto finish;
+    }
+
+    // Order CPUs by NUMA nodes
+    order = malloc(sizeof(*order) * num_cpus);
+    plan = malloc(sizeof(*plan) * params.num_threads);
+
+    if ((order == NULL) || (plan == NULL))
+    {
+        ARCHI_ERROR_SET(ARCHI__EMEMORY, "couldn't allocate array of thread CPU indices");
+
+        free(plan);
+        plan = NULL;
+        goto finish;
+    }
+
+    if (params.affinity == ARCHI_THREAD_GROUP_AFFINITY__COMPACT)
+    {
+        size_t idx = 0;
+
+        for (size_t node = 0; node < num_nodes; node++)
+            for (size_t cpu = 0; cpu < CPU_SETSIZE; cpu++)
+                if (ws->cpu_selected[cpu] && (ws->cpu_node[cpu] == node))
+                    order[idx++] = cpu;
+    }
+    else // scatter: take the next CPU of every node in turn
+    {
+        size_t idx = 0;
+
+        while (idx < num_cpus)
+        {
+            for (size_t node = 0; node < num_nodes; node++)
+            {
+                for (size_t cpu = 0; cpu < CPU_SETSIZE; cpu++)
+                {
+                    if (ws->cpu_selected[cpu] && (ws->cpu_node[cpu] == node))
+                    {
+                        ws->cpu_selected[cpu] = false;
+                        order[idx++] = cpu;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    for (size_t i = 0; i < params.num_threads; i++)
+        plan[i] = order[i % num_cpus];
+
+    ARCHI_ERROR_RESET();
+
+finish:
+    free(order);
+    free(ws);
+
+    return plan;
+}
+
+bool
+archi_thread_affinity_pin(
+        size_t cpu)
+{
+    if (cpu >= CPU_SETSIZE)
+        return false;
+
+    cpu_set_t pinned;
+
+    CPU_ZERO(&pinned);
+    CPU_SET(cpu, &pinned);
+
+    return sched_setaffinity(0, sizeof(pinned), &pinned) == 0;
+}
+
+#else // not __linux__
+
+size_t*
+archi_thread_affinity_plan(
+        archi_thread_group_start_params_t params,
+        ARCHI_ERROR_PARAM_DECL)
+{
+    if ((params.affinity == ARCHI_THREAD_GROUP_AFFINITY__NONE) || (params.num_threads == 0))
+    {
+        ARCHI_ERROR_RESET();
+        return NULL;
+    }
+
+    ARCHI_ERROR_SET(ARCHI__ENOTIMPL, "pinning threads to CPUs is not supported on this platform");
+    return NULL;
+}
+
+bool
+archi_thread_affinity_pin(
+        size_t cpu)
+{
+    (void) cpu;
+
+    return false;
+}
+
+#endif
+
@@ -0,0 +1,61 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Pinning threads of groups to CPUs.
+ */
+
+#pragma once
+#ifndef _SRC_ARCHI_THREAD_API_AFFINITY_FUN_H_
+#define _SRC_ARCHI_THREAD_API_AFFINITY_FUN_H_
+
+#include "archi/thread/api/thread_group.typ.h"
+#include "archi_base/error.typ.h"
+
+#include <stdbool.h>
+
+
+/**
+ * @brief Compute CPUs to pin threads of a group to.
+ *
+ * @return Array of CPU indices (one per thread), or NULL if threads are not pinned or on error.
+ */
+size_t*
+archi_thread_affinity_plan(
+        archi_thread_group_start_params_t params, ///< [in] Thread group creation parameters.
+        ARCHI_ERROR_PARAM_DECL ///< [out] Error.
+);
+
+/**
+ * @brief Pin the calling thread to a CPU.
+ *
+ * Threads of a group call this on their start,
+ * before touching any memory, so that it is placed on their NUMA node.
+ *
+ * @return True on success, false on failure.
+ */
+bool
+archi_thread_affinity_pin(
+        size_t cpu ///< [in] CPU to pin the calling thread to.
+);
+
+#endif // _SRC_ARCHI_THREAD_API_AFFINITY_FUN_H_
+
@@ -24,6 +24,7 @@
  */
 
 #include "archi/thread/api/lfqueue.fun.h"
+#include "archi/trace/api/trace.def.h"
 #include "archi_base/util/size.def.h"
 
 #include <stdlib.h> // for malloc(), free()
@@ -219,7 +220,10 @@ archi_thread_lfqueue_push(
             atomic_load_explicit(&queue->pop_count[index], memory_order_relaxed);
 
         if (push_count != pop_count) // queue is full
+        {
+            ARCHI_TRACE_EVENT(ARCHI_TRACE__LFQUEUE_PUSH_FULL, "lfqueue push (full)", queue, 0);
             return false;
+        }
 
         archi_thread_lfqueue_count_t revolution_count = total_push_count >> mask_bits;
         if (revolution_count == push_count) // current turn is ours
@@ -272,7 +276,10 @@ archi_thread_lfqueue_pop(
             atomic_load_explicit(&queue->push_count[index], memory_order_relaxed);
 
         if (pop_count == push_count) // queue is empty
+        {
+            ARCHI_TRACE_EVENT(ARCHI_TRACE__LFQUEUE_POP_EMPTY, "lfqueue pop (empty)", queue, 0);
             return false;
+        }
 
         archi_thread_lfqueue_count_t revolution_count = total_pop_count >> mask_bits;
         if (revolution_count == pop_count) // current turn is ours
@@ -295,6 +302,217 @@ archi_thread_lfqueue_pop(
     }
 }
 
+size_t
+archi_thread_lfqueue_push_n(
+        archi_thread_lfqueue_t queue,
+        const void *values,
+        size_t num_values,
+        ARCHI_ERROR_PARAM_DECL)
+{
+    if (queue == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "lock-free queue is NULL");
+        return 0;
+    }
+    else if ((values == NULL) && (num_values != 0))
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "pointer to values is NULL");
+        return 0;
+    }
+
+    unsigned int mask_bits = queue->mask_bits;
+    archi_thread_lfqueue_count_t mask = queue->params.capacity - 1;
+
+    if (num_values > queue->params.capacity)
+        num_values = queue->params.capacity;
+
+    archi_thread_lfqueue_count2_t total_push_count =
+        atomic_load_explicit(&queue->total_push_count, memory_order_relaxed);
+
+    ARCHI_ERROR_RESET();
+
+    if (num_values == 0)
+        return 0;
+
+    for (;;)
+    {
+        // Count consecutive slots that are free in the current turn
+        size_t num_slots = 0;
+        bool stale = false;
+
+        for (; num_slots < num_values; num_slots++)
+        {
+            archi_thread_lfqueue_count2_t slot_total_push_count = total_push_count + num_slots;
+            archi_thread_lfqueue_count_t index = slot_total_push_count & mask;
+
+            archi_thread_lfqueue_count_t push_count =
+                atomic_load_explicit(&queue->push_count[index], memory_order_acquire);
+            archi_thread_lfqueue_count_t pop_count =
+                atomic_load_explicit(&queue->pop_count[index], memory_order_acquire);
+
+            if (push_count != pop_count) // slot is full
+                break;
+
+            archi_thread_lfqueue_count_t revolution_count = slot_total_push_count >> mask_bits;
+            if (revolution_count != push_count) // turn is not ours
+            {
+                stale = (num_slots == 0);
+                break;
+            }
+        }
+
+        if (num_slots == 0)
+        {
+            if (!stale) // queue is full
+            {
+                ARCHI_TRACE_EVENT(ARCHI_TRACE__LFQUEUE_PUSH_FULL, "lfqueue push (full)", queue, 0);
+                return 0;
+            }
+
+            total_push_count = atomic_load_explicit(&queue->total_push_count, memory_order_relaxed);
+            continue;
+        }
+
+        // Try to acquire all the slots at once
+        if (atomic_compare_exchange_weak_explicit(&queue->total_push_count,
+                    &total_push_count, total_push_count + num_slots,
+                    memory_order_relaxed, memory_order_relaxed))
+        {
+            if (queue->buffer != NULL)
+            {
+                // Copy at most two contiguous runs, as the slots may wrap around the buffer end
+                archi_thread_lfqueue_count_t index = total_push_count & mask;
+
+                size_t num_first = queue->params.capacity - index;
+                if (num_first > num_slots)
+                    num_first = num_slots;
+
+                memcpy((char*)queue->buffer + queue->params.elt_size * index,
+                        values, queue->params.elt_size * num_first);
+
+                if (num_first < num_slots)
+                    memcpy(queue->buffer, (const char*)values + queue->params.elt_size * num_first,
+                            queue->params.elt_size * (num_slots - num_first));
+            }
+
+            // Publish the slots in order
+            for (size_t i = 0; i < num_slots; i++)
+            {
+                archi_thread_lfqueue_count2_t slot_total_push_count = total_push_count + i;
+                archi_thread_lfqueue_count_t revolution_count = slot_total_push_count >> mask_bits;
+
+                atomic_store_explicit(&queue->push_count[slot_total_push_count & mask],
+                        revolution_count + 1, memory_order_release);
+            }
+
+            return num_slots;
+        }
+    }
+}
+
+size_t
+archi_thread_lfqueue_pop_n(
+        archi_thread_lfqueue_t queue,
+        void *values,
+        size_t num_values,
+        ARCHI_ERROR_PARAM_DECL)
+{
+    if (queue == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "lock-free queue is NULL");
+        return 0;
+    }
+
+    unsigned int mask_bits = queue->mask_bits;
+    archi_thread_lfqueue_count_t mask = queue->params.capacity - 1;
+
+    if (num_values > queue->params.capacity)
+        num_values = queue->params.capacity;
+
+    archi_thread_lfqueue_count2_t total_pop_count =
+        atomic_load_explicit(&queue->total_pop_count, memory_order_relaxed);
+
+    ARCHI_ERROR_RESET();
+
+    if (num_values == 0)
+        return 0;
+
+    for (;;)
+    {
+        // Count consecutive slots that are full in the current turn
+        size_t num_slots = 0;
+        bool stale = false;
+
+        for (; num_slots < num_values; num_slots++)
+        {
+            archi_thread_lfqueue_count2_t slot_total_pop_count = total_pop_count + num_slots;
+            archi_thread_lfqueue_count_t index = slot_total_pop_count & mask;
+
+            archi_thread_lfqueue_count_t pop_count =
+                atomic_load_explicit(&queue->pop_count[index], memory_order_acquire);
+            archi_thread_lfqueue_count_t push_count =
+                atomic_load_explicit(&queue->push_count[index], memory_order_acquire);
+
+            if (pop_count == push_count) // slot is empty
+                break;
+
+            archi_thread_lfqueue_count_t revolution_count = slot_total_pop_count >> mask_bits;
+            if (revolution_count != pop_count) // turn is not ours
+            {
+                stale = (num_slots == 0);
+                break;
+            }
+        }
+
+        if (num_slots == 0)
+        {
+            if (!stale) // queue is empty
+            {
+                ARCHI_TRACE_EVENT(ARCHI_TRACE__LFQUEUE_POP_EMPTY, "lfqueue pop (empty)", queue, 0);
+                return 0;
+            }
+
+            total_pop_count = atomic_load_explicit(&queue->total_pop_count, memory_order_relaxed);
+            continue;
+        }
+
+        // Try to acquire all the slots at once
+        if (atomic_compare_exchange_weak_explicit(&queue->total_pop_count,
+                    &total_pop_count, total_pop_count + num_slots,
+                    memory_order_relaxed, memory_order_relaxed))
+        {
+            if ((queue->buffer != NULL) && (values != NULL))
+            {
+                // Copy at most two contiguous runs, as the slots may wrap around the buffer end
+                archi_thread_lfqueue_count_t index = total_pop_count & mask;
+
+                size_t num_first = queue->params.capacity - index;
+                if (num_first > num_slots)
+                    num_first = num_slots;
+
+                memcpy(values, (const char*)queue->buffer + queue->params.elt_size * index,
+                        queue->params.elt_size * num_first);
+
+                if (num_first < num_slots)
+                    memcpy((char*)values + queue->params.elt_size * num_first, queue->buffer,
+                            queue->params.elt_size * (num_slots - num_first));
+            }
+
+            // Release the slots in order
+            for (size_t i = 0; i < num_slots; i++)
+            {
+                archi_thread_lfqueue_count2_t slot_total_pop_count = total_pop_count + i;
+                archi_thread_lfqueue_count_t revolution_count = slot_total_pop_count >> mask_bits;
+
+                atomic_store_explicit(&queue->pop_count[slot_total_pop_count & mask],
+                        revolution_count + 1, memory_order_release);
+            }
+
+            return num_slots;
+        }
+    }
+}
+
 size_t
 archi_thread_lfqueue_capacity(
         archi_thread_lfqueue_t queue)
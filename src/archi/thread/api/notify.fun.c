@@ -0,0 +1,112 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Pollable descriptors for notification of thread group work completion.
+ */
+
+#define _POSIX_C_SOURCE 200809L // for pipe(), fcntl()
+
+#include "notify.fun.h"
+
+#include <unistd.h> // for read(), write(), close()
+#include <fcntl.h> // for fcntl()
+#include <stdint.h> // for uint64_t
+
+#ifdef __linux__
+#  include <sys/eventfd.h> // for eventfd()
+#endif
+
+
+bool
+archi_thread_notify_open(
+        struct archi_thread_notify *notify,
+        ARCHI_ERROR_PARAM_DECL)
+{
+#ifdef __linux__
+    int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (fd < 0)
+    {
+        ARCHI_ERROR_SET(ARCHI__ESYSTEM, "couldn't create eventfd descriptor");
+        return false;
+    }
+
+    *notify = (struct archi_thread_notify){.read_fd = fd, .write_fd = fd};
+#else
+    int fd[2];
+    if (pipe(fd) != 0)
+    {
+        ARCHI_ERROR_SET(ARCHI__ESYSTEM, "couldn't create pipe");
+        return false;
+    }
+
+    for (int i = 0; i < 2; i++)
+    {
+        if ((fcntl(fd[i], F_SETFL, fcntl(fd[i], F_GETFL) | O_NONBLOCK) != 0) ||
+                (fcntl(fd[i], F_SETFD, FD_CLOEXEC) != 0))
+        {
+            ARCHI_ERROR_SET(ARCHI__ESYSTEM, "couldn't make pipe non-blocking");
+
+            close(fd[0]);
+            close(fd[1]);
+            return false;
+        }
+    }
+
+    *notify = (struct archi_thread_notify){.read_fd = fd[0], .write_fd = fd[1]};
+#endif
+
+    ARCHI_ERROR_RESET();
+    return true;
+}
+
+void
+archi_thread_notify_close(
+        struct archi_thread_notify *notify)
+{
+    if (notify->write_fd != notify->read_fd)
+        close(notify->write_fd);
+
+    close(notify->read_fd);
+
+    *notify = (struct archi_thread_notify){.read_fd = -1, .write_fd = -1};
+}
+
+void
+archi_thread_notify_signal(
+        const struct archi_thread_notify *notify)
+{
+    // The write can only fail if the descriptor is already readable
+    uint64_t value = 1;
+    ssize_t res = write(notify->write_fd, &value, sizeof(value));
+    (void) res;
+}
+
+void
+archi_thread_notify_clear(
+        const struct archi_thread_notify *notify)
+{
+    // Drain the descriptor until it would block
+    uint64_t value[8];
+    while (read(notify->read_fd, value, sizeof(value)) > 0)
+        ;
+}
+
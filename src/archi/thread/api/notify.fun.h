@@ -0,0 +1,82 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Pollable descriptors for notification of thread group work completion.
+ */
+
+#pragma once
+#ifndef _SRC_ARCHI_THREAD_API_NOTIFY_FUN_H_
+#define _SRC_ARCHI_THREAD_API_NOTIFY_FUN_H_
+
+#include "archi_base/error.typ.h"
+
+#include <stdbool.h>
+
+
+/**
+ * @brief Pollable notification descriptor.
+ *
+ * The read end becomes readable when the descriptor is signalled.
+ * Both ends may be the same descriptor.
+ */
+struct archi_thread_notify {
+    int read_fd;  ///< Descriptor to poll and read from.
+    int write_fd; ///< Descriptor to write to.
+};
+
+/**
+ * @brief Open a non-blocking notification descriptor.
+ *
+ * @return True on success, false on failure.
+ */
+bool
+archi_thread_notify_open(
+        struct archi_thread_notify *notify, ///< [out] Notification descriptor.
+        ARCHI_ERROR_PARAM_DECL ///< [out] Error.
+);
+
+/**
+ * @brief Close a notification descriptor.
+ */
+void
+archi_thread_notify_close(
+        struct archi_thread_notify *notify ///< [in] Notification descriptor.
+);
+
+/**
+ * @brief Make a notification descriptor readable.
+ */
+void
+archi_thread_notify_signal(
+        const struct archi_thread_notify *notify ///< [in] Notification descriptor.
+);
+
+/**
+ * @brief Make a notification descriptor not readable.
+ */
+void
+archi_thread_notify_clear(
+        const struct archi_thread_notify *notify ///< [in] Notification descriptor.
+);
+
+#endif // _SRC_ARCHI_THREAD_API_NOTIFY_FUN_H_
+
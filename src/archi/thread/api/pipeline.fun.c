@@ -0,0 +1,774 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Operations with pipelines of DEG stages.
+ */
+
+#include "archi/thread/api/pipeline.fun.h"
+#include "archi/thread/api/lfqueue.fun.h"
+#include "archi/exec/api/graph.fun.h"
+
+#ifdef __STDC_NO_ATOMICS__
+#  error Atomics are required, but not supported by the compiler.
+#endif
+
+#ifdef __STDC_NO_THREADS__
+#  error Threads are required, but not supported by the compiler.
+#endif
+
+#include <stdlib.h> // for malloc(), free()
+#include <stdatomic.h> // for atomic_* functions and types
+#include <threads.h> // for thrd_*, mtx_*, cnd_* functions and types
+#include <time.h> // for struct timespec, timespec_get()
+#include <stdbool.h>
+#include <stdint.h> // for uint64_t
+
+
+/**
+ * @brief Period of polling a queue that is pushed or popped outside of a pipeline.
+ */
+#define ARCHI_THREAD_PIPELINE_POLL_NS   1000000 // 1 ms
+
+struct archi_thread_pipeline_channel {
+    archi_thread_lfqueue_t queue;
+    bool external; // whether the queue is pushed or popped outside of the pipeline
+
+    atomic_size_t num_events; // number of pushes, pops, and stage state changes
+    atomic_size_t num_sleeping; // number of threads sleeping on the condition variable
+
+    mtx_t mtx;
+    cnd_t cnd;
+};
+
+struct archi_thread_pipeline_worker {
+    archi_thread_pipeline_t pipeline;
+    size_t stage_idx;
+
+    struct archi_thread_pipeline_channel *input; // channel of the input queue
+    struct archi_thread_pipeline_channel *output; // channel of the output queue
+
+    thrd_t thread;
+    atomic_bool finished; // whether the stage has finished in the current run
+};
+
+struct archi_thread_pipeline {
+    archi_thread_pipeline_stage_t *stage;
+    struct archi_thread_pipeline_worker *worker;
+    size_t num_stages;
+    size_t num_threads; // number of created threads
+
+    struct archi_thread_pipeline_channel *channel; // wait channels of queues [num_stages * 2]
+    size_t num_channels; // number of channels in use
+    size_t num_channels_initialized; // number of channels with initialized mutex and condition variable
+
+    uint64_t spin_ns; // time to spin before sleeping
+
+    mtx_t mtx;
+    cnd_t start_cnd; // signalled when the pipeline is started or terminated
+    cnd_t done_cnd; // signalled when all stages are finished
+
+    unsigned long run; // number of pipeline starts
+    bool terminate; // whether threads must exit
+    bool running; // whether the pipeline is running
+    size_t num_running; // number of stages still running
+
+    atomic_bool stop; // whether source stages must finish
+    atomic_bool abort; // whether a stage has failed
+
+    atomic_flag failed;
+    archi_error_t error; // error of the first failed stage
+};
+
+/*****************************************************************************/
+
+static
+uint64_t
+archi_thread_pipeline_time_ns(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static
+void
+archi_thread_pipeline_channel_notify(
+        struct archi_thread_pipeline_channel *channel)
+{
+    atomic_fetch_add_explicit(&channel->num_events, 1, memory_order_seq_cst);
+
+    // Spinning threads see the counter by themselves, sleeping ones need to be woken
+    if (atomic_load_explicit(&channel->num_sleeping, memory_order_seq_cst) != 0)
+    {
+        // Sleepers check the counter under the mutex, so they're either waiting or will see it
+        mtx_lock(&channel->mtx);
+        cnd_broadcast(&channel->cnd);
+        mtx_unlock(&channel->mtx);
+    }
+}
+
+static
+void
+archi_thread_pipeline_channel_notify_all(
+        archi_thread_pipeline_t pipeline)
+{
+    for (size_t i = 0; i < pipeline->num_channels; i++)
+        archi_thread_pipeline_channel_notify(&pipeline->channel[i]);
+}
+
+static
+void
+archi_thread_pipeline_channel_wait(
+        archi_thread_pipeline_t pipeline,
+        struct archi_thread_pipeline_channel *channel,
+        size_t num_events, // value of the event counter before the failed attempt
+        uint64_t *deadline) // end of spinning (0 = not started yet)
+{
+    // Spin first to avoid the cost of sleeping and waking
+    if (pipeline->spin_ns != 0)
+    {
+        if (*deadline == 0)
+            *deadline = archi_thread_pipeline_time_ns() + pipeline->spin_ns;
+
+        while (archi_thread_pipeline_time_ns() < *deadline)
+        {
+            // Check the counter several times between clock readings
+            for (unsigned i = 0; i < 64; i++)
+                if (atomic_load_explicit(&channel->num_events, memory_order_acquire) != num_events)
+                    return;
+
+            // Let the other stages run if the CPU is oversubscribed
+            thrd_yield();
+        }
+    }
+
+    // Fall back to sleeping on the condition variable
+    mtx_lock(&channel->mtx);
+
+    // The counter must be visible before the events are checked, see archi_thread_pipeline_channel_notify()
+    atomic_fetch_add_explicit(&channel->num_sleeping, 1, memory_order_seq_cst);
+
+    if (atomic_load_explicit(&channel->num_events, memory_order_seq_cst) == num_events)
+    {
+        if (!channel->external)
+        {
+            while (atomic_load_explicit(&channel->num_events, memory_order_seq_cst) == num_events)
+                cnd_wait(&channel->cnd, &channel->mtx);
+        }
+        else
+        {
+            // Operations outside of the pipeline don't notify the channel, so poll the queue
+            uint64_t time_ns = archi_thread_pipeline_time_ns() + ARCHI_THREAD_PIPELINE_POLL_NS;
+            struct timespec time_point = {
+                .tv_sec = time_ns / 1000000000u,
+                .tv_nsec = time_ns % 1000000000u,
+            };
+
+            cnd_timedwait(&channel->cnd, &channel->mtx, &time_point);
+        }
+    }
+
+    atomic_fetch_sub_explicit(&channel->num_sleeping, 1, memory_order_relaxed);
+
+    mtx_unlock(&channel->mtx);
+}
+
+static
+struct archi_thread_pipeline_channel*
+archi_thread_pipeline_channel_get(
+        archi_thread_pipeline_t pipeline,
+        archi_thread_lfqueue_t queue)
+{
+    if (queue == NULL)
+        return NULL;
+
+    for (size_t i = 0; i < pipeline->num_channels; i++)
+        if (pipeline->channel[i].queue == queue)
+            return &pipeline->channel[i];
+
+    struct archi_thread_pipeline_channel *channel = &pipeline->channel[pipeline->num_channels++];
+    channel->queue = queue;
+
+    return channel;
+}
+
+static
+void
+archi_thread_pipeline_channel_setup(
+        archi_thread_pipeline_t pipeline)
+{
+    pipeline->num_channels = 0;
+
+    for (size_t i = 0; i < pipeline->num_stages; i++)
+    {
+        pipeline->worker[i].input = archi_thread_pipeline_channel_get(pipeline, pipeline->stage[i].input);
+        pipeline->worker[i].output = archi_thread_pipeline_channel_get(pipeline, pipeline->stage[i].output);
+    }
+
+    // A queue is external if it lacks either a producing or a consuming stage
+    for (size_t i = 0; i < pipeline->num_channels; i++)
+    {
+        struct archi_thread_pipeline_channel *channel = &pipeline->channel[i];
+
+        bool has_producers = false, has_consumers = false;
+        for (size_t j = 0; j < pipeline->num_stages; j++)
+        {
+            if (pipeline->worker[j].output == channel)
+                has_producers = true;
+            if (pipeline->worker[j].input == channel)
+                has_consumers = true;
+        }
+
+        channel->external = !has_producers || !has_consumers;
+    }
+}
+
+static
+void
+archi_thread_pipeline_fail(
+        archi_thread_pipeline_t pipeline,
+        archi_error_t error)
+{
+    if (!atomic_flag_test_and_set_explicit(&pipeline->failed, memory_order_relaxed))
+        pipeline->error = error;
+
+    atomic_store_explicit(&pipeline->abort, true, memory_order_relaxed);
+
+    // Wake waiting stages so that they finish
+    archi_thread_pipeline_channel_notify_all(pipeline);
+}
+
+static
+bool
+archi_thread_pipeline_input_closed(
+        archi_thread_pipeline_t pipeline,
+        archi_thread_lfqueue_t input)
+{
+    bool has_producers = false;
+
+    for (size_t i = 0; i < pipeline->num_stages; i++)
+    {
+        if (pipeline->stage[i].output != input)
+            continue;
+
+        has_producers = true;
+
+        if (!atomic_load_explicit(&pipeline->worker[i].finished, memory_order_acquire))
+            return false;
+    }
+
+    return has_producers || atomic_load_explicit(&pipeline->stop, memory_order_acquire);
+}
+
+static
+void
+archi_thread_pipeline_stage_run(
+        archi_thread_pipeline_t pipeline,
+        archi_thread_pipeline_stage_t stage,
+        struct archi_thread_pipeline_channel *input,
+        struct archi_thread_pipeline_channel *output)
+{
+    archi_error_t error;
+
+    for (;;)
+    {
+        if (atomic_load_explicit(&pipeline->abort, memory_order_relaxed))
+            return;
+
+        // Obtain a work item
+        if (stage.input == NULL)
+        {
+            if (atomic_load_explicit(&pipeline->stop, memory_order_acquire))
+                return;
+        }
+        else
+        {
+            uint64_t deadline = 0;
+
+            for (;;)
+            {
+                // Read the event counter before the attempt, so that no event is missed when waiting
+                size_t num_events = atomic_load_explicit(&input->num_events, memory_order_seq_cst);
+
+                if (archi_thread_lfqueue_pop(stage.input, stage.item, &error))
+                    break;
+                else if (error.code != 0)
+                {
+                    archi_thread_pipeline_fail(pipeline, error);
+                    return;
+                }
+                else if (atomic_load_explicit(&pipeline->abort, memory_order_relaxed))
+                    return;
+
+                if (archi_thread_pipeline_input_closed(pipeline, stage.input))
+                {
+                    // Producers could have pushed the last items before finishing
+                    if (archi_thread_lfqueue_pop(stage.input, stage.item, &error))
+                        break;
+                    else if (error.code != 0)
+                        archi_thread_pipeline_fail(pipeline, error);
+
+                    return;
+                }
+
+                // Input queue is empty: wait
+                archi_thread_pipeline_channel_wait(pipeline, input, num_events, &deadline);
+            }
+
+            // Wake producers waiting for free space
+            archi_thread_pipeline_channel_notify(input);
+        }
+
+        // Process the work item
+        if (stage.entry != NULL)
+        {
+            ARCHI_ERROR_VAR_RESET(&error);
+            archi_dexgraph_execute((archi_dexgraph_frame_t){.node = stage.entry},
+                    ARCHI_DEXGRAPH__NO_INTERRUPT, &error);
+
+            if (error.code != 0)
+            {
+                archi_thread_pipeline_fail(pipeline, error);
+                return;
+            }
+        }
+
+        // Discard the work item produced after the stop request
+        if ((stage.input == NULL) && atomic_load_explicit(&pipeline->stop, memory_order_acquire))
+            return;
+
+        // Pass the work item on
+        if (stage.output != NULL)
+        {
+            uint64_t deadline = 0;
+
+            for (;;)
+            {
+                // Read the event counter before the attempt, so that no event is missed when waiting
+                size_t num_events = atomic_load_explicit(&output->num_events, memory_order_seq_cst);
+
+                if (archi_thread_lfqueue_push(stage.output, stage.item, &error))
+                    break;
+                else if (error.code != 0)
+                {
+                    archi_thread_pipeline_fail(pipeline, error);
+                    return;
+                }
+                else if (atomic_load_explicit(&pipeline->abort, memory_order_relaxed))
+                    return;
+
+                // Nothing may be popping a full queue outside of the pipeline,
+                // so discard the work item instead of blocking the stop request
+                if (output->external && atomic_load_explicit(&pipeline->stop, memory_order_acquire))
+                    break;
+
+                // Output queue is full: wait (backpressure)
+                archi_thread_pipeline_channel_wait(pipeline, output, num_events, &deadline);
+            }
+
+            // Wake consumers waiting for work items
+            archi_thread_pipeline_channel_notify(output);
+        }
+    }
+}
+
+static
+int
+archi_thread_pipeline_thread(
+        void *arg)
+{
+    struct archi_thread_pipeline_worker *worker = arg;
+    archi_thread_pipeline_t pipeline = worker->pipeline;
+
+    unsigned long run = 0;
+
+    for (;;)
+    {
+        archi_thread_pipeline_stage_t stage;
+        struct archi_thread_pipeline_channel *input, *output;
+        {
+            mtx_lock(&pipeline->mtx);
+
+            // Wait for a start or termination
+            while (!pipeline->terminate && (pipeline->run == run))
+                cnd_wait(&pipeline->start_cnd, &pipeline->mtx);
+
+            if (pipeline->terminate)
+            {
+                mtx_unlock(&pipeline->mtx);
+                return 0;
+            }
+
+            run = pipeline->run;
+            stage = pipeline->stage[worker->stage_idx];
+            input = worker->input;
+            output = worker->output;
+
+            mtx_unlock(&pipeline->mtx);
+        }
+
+        archi_thread_pipeline_stage_run(pipeline, stage, input, output);
+
+        atomic_store_explicit(&worker->finished, true, memory_order_release);
+
+        // Wake consumers waiting for the input to close
+        if (output != NULL)
+            archi_thread_pipeline_channel_notify(output);
+
+        {
+            mtx_lock(&pipeline->mtx);
+
+            if (--pipeline->num_running == 0)
+            {
+                pipeline->running = false;
+                cnd_broadcast(&pipeline->done_cnd);
+            }
+
+            mtx_unlock(&pipeline->mtx);
+        }
+    }
+}
+
+/*****************************************************************************/
+
+archi_thread_pipeline_t
+archi_thread_pipeline_create(
+        archi_thread_pipeline_start_params_t params,
+        ARCHI_ERROR_PARAM_DECL)
+{
+    archi_thread_pipeline_t pipeline = malloc(sizeof(*pipeline));
+    if (pipeline == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__EMEMORY, "couldn't allocate pipeline");
+        return NULL;
+    }
+
+    *pipeline = (struct archi_thread_pipeline){
+        .num_stages = params.num_stages,
+        .spin_ns = params.spin_ns,
+        .failed = ATOMIC_FLAG_INIT,
+    };
+
+    if (mtx_init(&pipeline->mtx, mtx_plain) != thrd_success)
+    {
+        ARCHI_ERROR_SET(ARCHI__ESYSTEM, "couldn't initialize mutex");
+        free(pipeline);
+        return NULL;
+    }
+
+    if (cnd_init(&pipeline->start_cnd) != thrd_success)
+    {
+        ARCHI_ERROR_SET(ARCHI__ESYSTEM, "couldn't initialize condition variable");
+        mtx_destroy(&pipeline->mtx);
+        free(pipeline);
+        return NULL;
+    }
+
+    if (cnd_init(&pipeline->done_cnd) != thrd_success)
+    {
+        ARCHI_ERROR_SET(ARCHI__ESYSTEM, "couldn't initialize condition variable");
+        cnd_destroy(&pipeline->start_cnd);
+        mtx_destroy(&pipeline->mtx);
+        free(pipeline);
+        return NULL;
+    }
+
+    ARCHI_ERROR_VAR_RESET(&pipeline->error);
+
+    if (params.num_stages > 0)
+    {
+        pipeline->stage = malloc(sizeof(*pipeline->stage) * params.num_stages);
+        pipeline->worker = malloc(sizeof(*pipeline->worker) * params.num_stages);
+
+        if ((pipeline->stage == NULL) || (pipeline->worker == NULL))
+        {
+            ARCHI_ERROR_SET(ARCHI__EMEMORY, "couldn't allocate arrays of pipeline stages [%zu]",
+                    params.num_stages);
+            goto failure;
+        }
+
+        // Every stage has at most two queues
+        pipeline->channel = malloc(sizeof(*pipeline->channel) * params.num_stages * 2);
+        if (pipeline->channel == NULL)
+        {
+            ARCHI_ERROR_SET(ARCHI__EMEMORY, "couldn't allocate array of queue wait channels [%zu]",
+                    params.num_stages * 2);
+            goto failure;
+        }
+
+        for (; pipeline->num_channels_initialized < params.num_stages * 2;
+                pipeline->num_channels_initialized++)
+        {
+            struct archi_thread_pipeline_channel *channel =
+                &pipeline->channel[pipeline->num_channels_initialized];
+
+            *channel = (struct archi_thread_pipeline_channel){0};
+
+            atomic_init(&channel->num_events, 0);
+            atomic_init(&channel->num_sleeping, 0);
+
+            if (mtx_init(&channel->mtx, mtx_plain) != thrd_success)
+            {
+                ARCHI_ERROR_SET(ARCHI__ESYSTEM, "couldn't initialize mutex");
+                goto failure;
+            }
+
+            if (cnd_init(&channel->cnd) != thrd_success)
+            {
+                ARCHI_ERROR_SET(ARCHI__ESYSTEM, "couldn't initialize condition variable");
+                mtx_destroy(&channel->mtx);
+                goto failure;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < params.num_stages; i++)
+    {
+        pipeline->stage[i] = (archi_thread_pipeline_stage_t){0};
+        pipeline->worker[i] = (struct archi_thread_pipeline_worker){
+            .pipeline = pipeline,
+            .stage_idx = i,
+        };
+
+        atomic_init(&pipeline->worker[i].finished, false);
+    }
+
+    // Create threads
+    for (; pipeline->num_threads < params.num_stages; pipeline->num_threads++)
+    {
+        struct archi_thread_pipeline_worker *worker = &pipeline->worker[pipeline->num_threads];
+
+        int res = thrd_create(&worker->thread, archi_thread_pipeline_thread, worker);
+        if (res != thrd_success)
+        {
+            if (res == thrd_nomem)
+                ARCHI_ERROR_SET(ARCHI__EMEMORY, "couldn't create thread #%zu", pipeline->num_threads);
+            else
+                ARCHI_ERROR_SET(ARCHI__ESYSTEM, "couldn't create thread #%zu", pipeline->num_threads);
+
+            goto failure;
+        }
+    }
+
+    ARCHI_ERROR_RESET();
+    return pipeline;
+
+failure:
+    archi_thread_pipeline_destroy(pipeline);
+    return NULL;
+}
+
+void
+archi_thread_pipeline_destroy(
+        archi_thread_pipeline_t pipeline)
+{
+    if (pipeline == NULL)
+        return;
+
+    // Drain the pipeline and terminate threads
+    archi_thread_pipeline_stop(pipeline);
+    archi_thread_pipeline_wait(pipeline, NULL);
+
+    {
+        mtx_lock(&pipeline->mtx);
+        pipeline->terminate = true;
+        mtx_unlock(&pipeline->mtx);
+    }
+
+    cnd_broadcast(&pipeline->start_cnd);
+
+    for (size_t i = 0; i < pipeline->num_threads; i++)
+        thrd_join(pipeline->worker[i].thread, (int*)NULL);
+
+    for (size_t i = 0; i < pipeline->num_channels_initialized; i++)
+    {
+        cnd_destroy(&pipeline->channel[i].cnd);
+        mtx_destroy(&pipeline->channel[i].mtx);
+    }
+
+    cnd_destroy(&pipeline->done_cnd);
+    cnd_destroy(&pipeline->start_cnd);
+    mtx_destroy(&pipeline->mtx);
+
+    free(pipeline->channel);
+    free(pipeline->worker);
+    free(pipeline->stage);
+    free(pipeline);
+}
+
+void
+archi_thread_pipeline_set_stage(
+        archi_thread_pipeline_t pipeline,
+        size_t index,
+        archi_thread_pipeline_stage_t stage,
+        ARCHI_ERROR_PARAM_DECL)
+{
+    if (pipeline == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "pipeline is NULL");
+        return;
+    }
+    else if (index >= pipeline->num_stages)
+    {
+        ARCHI_ERROR_SET(ARCHI__EINDEX, "stage index %zu is out of bounds [0; %zu)",
+                index, pipeline->num_stages);
+        return;
+    }
+
+    mtx_lock(&pipeline->mtx);
+
+    bool running = pipeline->running;
+    if (!running)
+        pipeline->stage[index] = stage;
+
+    mtx_unlock(&pipeline->mtx);
+
+    if (running)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "pipeline stages cannot be changed while it is running");
+        return;
+    }
+
+    ARCHI_ERROR_RESET();
+}
+
+archi_thread_pipeline_stage_t
+archi_thread_pipeline_get_stage(
+        archi_thread_pipeline_t pipeline,
+        size_t index)
+{
+    if ((pipeline == NULL) || (index >= pipeline->num_stages))
+        return (archi_thread_pipeline_stage_t){0};
+
+    mtx_lock(&pipeline->mtx);
+    archi_thread_pipeline_stage_t stage = pipeline->stage[index];
+    mtx_unlock(&pipeline->mtx);
+
+    return stage;
+}
+
+bool
+archi_thread_pipeline_start(
+        archi_thread_pipeline_t pipeline,
+        ARCHI_ERROR_PARAM_DECL)
+{
+    if (pipeline == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "pipeline is NULL");
+        return false;
+    }
+
+    mtx_lock(&pipeline->mtx);
+
+    if (pipeline->running)
+    {
+        mtx_unlock(&pipeline->mtx);
+
+        ARCHI_ERROR_RESET();
+        return false;
+    }
+
+    // Reset the execution state
+    for (size_t i = 0; i < pipeline->num_stages; i++)
+        atomic_store_explicit(&pipeline->worker[i].finished, false, memory_order_relaxed);
+
+    atomic_store_explicit(&pipeline->stop, false, memory_order_relaxed);
+    atomic_store_explicit(&pipeline->abort, false, memory_order_relaxed);
+    atomic_flag_clear_explicit(&pipeline->failed, memory_order_relaxed);
+    ARCHI_ERROR_VAR_RESET(&pipeline->error);
+
+    // Associate queues with wait channels
+    archi_thread_pipeline_channel_setup(pipeline);
+
+    if (pipeline->num_stages > 0)
+    {
+        pipeline->running = true;
+        pipeline->num_running = pipeline->num_stages;
+        pipeline->run++;
+    }
+
+    mtx_unlock(&pipeline->mtx);
+
+    // Wake stage threads
+    cnd_broadcast(&pipeline->start_cnd);
+
+    ARCHI_ERROR_RESET();
+    return true;
+}
+
+void
+archi_thread_pipeline_stop(
+        archi_thread_pipeline_t pipeline)
+{
+    if (pipeline == NULL)
+        return;
+
+    atomic_store_explicit(&pipeline->stop, true, memory_order_release);
+
+    // Wake stages waiting for input from outside of the pipeline
+    mtx_lock(&pipeline->mtx);
+
+    if (pipeline->running)
+        archi_thread_pipeline_channel_notify_all(pipeline);
+
+    mtx_unlock(&pipeline->mtx);
+}
+
+void
+archi_thread_pipeline_wait(
+        archi_thread_pipeline_t pipeline,
+        ARCHI_ERROR_PARAM_DECL)
+{
+    if (pipeline == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "pipeline is NULL");
+        return;
+    }
+
+    archi_error_t error;
+    {
+        mtx_lock(&pipeline->mtx);
+
+        while (pipeline->running)
+            cnd_wait(&pipeline->done_cnd, &pipeline->mtx);
+
+        error = pipeline->error;
+
+        mtx_unlock(&pipeline->mtx);
+    }
+
+    if (error.code != 0)
+    {
+        ARCHI_ERROR_ASSIGN(error);
+        return;
+    }
+
+    ARCHI_ERROR_RESET();
+}
+
+size_t
+archi_thread_pipeline_num_stages(
+        archi_thread_pipeline_t pipeline)
+{
+    return (pipeline != NULL) ? pipeline->num_stages : 0;
+}
+
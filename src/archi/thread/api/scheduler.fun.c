@@ -0,0 +1,623 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Scheduling of directed execution graph frames.
+ */
+
+#include "archi/thread/api/scheduler.fun.h"
+#include "archi/thread/api/lfqueue.fun.h"
+#include "archi/exec/api/graph.fun.h"
+
+#ifdef __STDC_NO_ATOMICS__
+#  error Atomics are required, but not supported by the compiler.
+#endif
+
+#ifdef __STDC_NO_THREADS__
+#  error Threads are required, but not supported by the compiler.
+#endif
+
+#include <stdlib.h> // for malloc(), aligned_alloc(), free()
+#include <stdatomic.h> // for atomic_* functions and types
+#include <threads.h> // for thrd_*, mtx_*, cnd_* functions and types
+#include <stdalign.h> // for alignas
+#include <stdbool.h>
+
+
+/**
+ * @brief Size of a cache line to separate frequently modified fields with.
+ */
+#define ARCHI_THREAD_SCHEDULER_CACHE_LINE   64
+
+/**
+ * @brief Round a size up to a multiple of the cache line size, as required by aligned_alloc().
+ */
+#define ARCHI_THREAD_SCHEDULER_ALIGNED_SIZE(size) \
+    (((size) + ARCHI_THREAD_SCHEDULER_CACHE_LINE - 1) & ~(size_t)(ARCHI_THREAD_SCHEDULER_CACHE_LINE - 1))
+
+/**
+ * @brief Work-stealing deque of task indices (Chase-Lev).
+ *
+ * The owner pushes and takes at the bottom, thieves steal at the top.
+ * Capacity is never exceeded, as a task is stored in at most one place at a time.
+ */
+struct archi_thread_scheduler_deque {
+    alignas(ARCHI_THREAD_SCHEDULER_CACHE_LINE) atomic_ptrdiff_t top;
+    alignas(ARCHI_THREAD_SCHEDULER_CACHE_LINE) atomic_ptrdiff_t bottom;
+
+    atomic_size_t *buffer;
+    size_t mask;
+};
+
+struct archi_thread_scheduler_worker {
+    archi_thread_scheduler_t scheduler;
+    size_t worker_idx;
+
+    thrd_t thread;
+    struct archi_thread_scheduler_deque deque;
+};
+
+struct archi_thread_scheduler {
+    struct archi_thread_scheduler_worker *worker;
+    size_t num_threads;
+
+    archi_dexgraph_frame_t *task; // frames of tasks
+    size_t max_tasks;
+
+    archi_thread_lfqueue_t injection_queue; // tasks submitted from outside, and yielded tasks
+    archi_thread_lfqueue_t free_slots; // indices of unused task slots
+
+    alignas(ARCHI_THREAD_SCHEDULER_CACHE_LINE) atomic_size_t num_ready; // number of queued tasks
+    alignas(ARCHI_THREAD_SCHEDULER_CACHE_LINE) atomic_size_t num_sleeping; // number of sleeping workers
+    alignas(ARCHI_THREAD_SCHEDULER_CACHE_LINE) atomic_size_t num_tasks; // number of unfinished tasks
+
+    atomic_bool stop;
+
+    mtx_t mtx;
+    cnd_t work_cnd; // signalled when a task is queued
+    cnd_t done_cnd; // signalled when all tasks are finished
+
+    bool failed; // whether a task failed since the previous wait
+    archi_error_t error; // error of the first failed task
+};
+
+static _Thread_local struct archi_thread_scheduler_worker *archi_thread_scheduler_current_worker;
+static _Thread_local bool archi_thread_scheduler_yield_requested;
+
+/*****************************************************************************/
+
+static
+void
+archi_thread_scheduler_deque_push(
+        struct archi_thread_scheduler_deque *deque,
+        size_t task_idx)
+{
+    ptrdiff_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+
+    atomic_store_explicit(&deque->buffer[bottom & deque->mask], task_idx, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+}
+
+static
+bool
+archi_thread_scheduler_deque_take(
+        struct archi_thread_scheduler_deque *deque,
+        size_t *task_idx)
+{
+    ptrdiff_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&deque->bottom, bottom, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    ptrdiff_t top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+
+    bool success = false;
+
+    if (top <= bottom) // non-empty
+    {
+        *task_idx = atomic_load_explicit(&deque->buffer[bottom & deque->mask], memory_order_relaxed);
+        success = true;
+
+        if (top == bottom) // the last element, compete with thieves
+        {
+            if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,
+                        memory_order_seq_cst, memory_order_relaxed))
+                success = false;
+
+            atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+        }
+    }
+    else // empty
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+
+    return success;
+}
+
+static
+bool
+archi_thread_scheduler_deque_steal(
+        struct archi_thread_scheduler_deque *deque,
+        size_t *task_idx)
+{
+    ptrdiff_t top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    ptrdiff_t bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+
+    if (top >= bottom) // empty
+        return false;
+
+    size_t value = atomic_load_explicit(&deque->buffer[top & deque->mask], memory_order_relaxed);
+
+    if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,
+                memory_order_seq_cst, memory_order_relaxed))
+        return false; // lost the race
+
+    *task_idx = value;
+    return true;
+}
+
+/*****************************************************************************/
+
+static
+void
+archi_thread_scheduler_enqueue(
+        archi_thread_scheduler_t scheduler,
+        size_t task_idx,
+        bool local)
+{
+    // The counter is incremented beforehand so that it never underflows
+    atomic_fetch_add_explicit(&scheduler->num_ready, 1, memory_order_seq_cst);
+
+    struct archi_thread_scheduler_worker *worker = archi_thread_scheduler_current_worker;
+
+    if (local && (worker != NULL) && (worker->scheduler == scheduler))
+        archi_thread_scheduler_deque_push(&worker->deque, task_idx);
+    else
+    {
+        // The queue has spare capacity, so a push may fail only transiently
+        while (!archi_thread_lfqueue_push(scheduler->injection_queue, &task_idx, (archi_error_t*)NULL))
+            thrd_yield();
+    }
+
+    // Wake a sleeping worker
+    if (atomic_load_explicit(&scheduler->num_sleeping, memory_order_seq_cst) > 0)
+    {
+        mtx_lock(&scheduler->mtx);
+        cnd_signal(&scheduler->work_cnd);
+        mtx_unlock(&scheduler->mtx);
+    }
+}
+
+static
+bool
+archi_thread_scheduler_find_task(
+        struct archi_thread_scheduler_worker *worker,
+        unsigned long *random_state,
+        size_t *task_idx)
+{
+    archi_thread_scheduler_t scheduler = worker->scheduler;
+
+    // Own deque first
+    if (archi_thread_scheduler_deque_take(&worker->deque, task_idx))
+        return true;
+
+    // Then the injection queue
+    if (archi_thread_lfqueue_pop(scheduler->injection_queue, task_idx, (archi_error_t*)NULL))
+        return true;
+
+    // Then try to steal from random victims
+    for (size_t attempt = 0; attempt < scheduler->num_threads; attempt++)
+    {
+        *random_state = *random_state * 6364136223846793005u + 1442695040888963407u;
+        size_t victim = (*random_state >> 33) % scheduler->num_threads;
+
+        if ((victim != worker->worker_idx) &&
+                archi_thread_scheduler_deque_steal(&scheduler->worker[victim].deque, task_idx))
+            return true;
+    }
+
+    return false;
+}
+
+static
+void
+archi_thread_scheduler_finish_task(
+        archi_thread_scheduler_t scheduler,
+        size_t task_idx,
+        const archi_error_t *error)
+{
+    if (error != NULL)
+    {
+        mtx_lock(&scheduler->mtx);
+
+        if (!scheduler->failed)
+        {
+            scheduler->failed = true;
+            scheduler->error = *error;
+        }
+
+        mtx_unlock(&scheduler->mtx);
+    }
+
+    while (!archi_thread_lfqueue_push(scheduler->free_slots, &task_idx, (archi_error_t*)NULL))
+        thrd_yield();
+
+    if (atomic_fetch_sub_explicit(&scheduler->num_tasks, 1, memory_order_acq_rel) == 1)
+    {
+        mtx_lock(&scheduler->mtx);
+        cnd_broadcast(&scheduler->done_cnd);
+        mtx_unlock(&scheduler->mtx);
+    }
+}
+
+static
+int
+archi_thread_scheduler_worker_thread(
+        void *arg)
+{
+    struct archi_thread_scheduler_worker *worker = arg;
+    archi_thread_scheduler_t scheduler = worker->scheduler;
+
+    archi_thread_scheduler_current_worker = worker;
+
+    unsigned long random_state = worker->worker_idx + 1;
+
+    while (!atomic_load_explicit(&scheduler->stop, memory_order_acquire))
+    {
+        size_t task_idx;
+
+        if (!archi_thread_scheduler_find_task(worker, &random_state, &task_idx))
+        {
+            // Sleep if there are no queued tasks
+            mtx_lock(&scheduler->mtx);
+
+            atomic_fetch_add_explicit(&scheduler->num_sleeping, 1, memory_order_seq_cst);
+
+            while ((atomic_load_explicit(&scheduler->num_ready, memory_order_seq_cst) == 0) &&
+                    !atomic_load_explicit(&scheduler->stop, memory_order_acquire))
+                cnd_wait(&scheduler->work_cnd, &scheduler->mtx);
+
+            atomic_fetch_sub_explicit(&scheduler->num_sleeping, 1, memory_order_relaxed);
+
+            mtx_unlock(&scheduler->mtx);
+            continue;
+        }
+
+        atomic_fetch_sub_explicit(&scheduler->num_ready, 1, memory_order_relaxed);
+
+        // Run the task until it halts, fails, or yields
+        archi_dexgraph_frame_t frame = scheduler->task[task_idx];
+
+        archi_error_t error;
+        archi_thread_scheduler_yield_requested = false;
+
+        do
+        {
+            frame = archi_dexgraph_execute(frame, ARCHI_DEXGRAPH__INTERRUPT_TRANSITION, &error);
+        }
+        while ((error.code == 0) && (frame.node != NULL) && !archi_thread_scheduler_yield_requested);
+
+        if (error.code != 0)
+            archi_thread_scheduler_finish_task(scheduler, task_idx, &error);
+        else if (frame.node == NULL)
+            archi_thread_scheduler_finish_task(scheduler, task_idx, NULL);
+        else
+        {
+            scheduler->task[task_idx] = frame;
+            archi_thread_scheduler_enqueue(scheduler, task_idx, false);
+        }
+    }
+
+    archi_thread_scheduler_current_worker = NULL;
+    return 0;
+}
+
+/*****************************************************************************/
+
+archi_thread_scheduler_t
+archi_thread_scheduler_create(
+        archi_thread_scheduler_start_params_t params,
+        ARCHI_ERROR_PARAM_DECL)
+{
+    if (params.num_threads == 0)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "number of scheduler worker threads is zero");
+        return NULL;
+    }
+    else if (params.max_tasks == 0)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "maximum number of scheduler tasks is zero");
+        return NULL;
+    }
+
+    // Round capacity up to a power of two
+    size_t capacity = 1;
+    while (capacity < params.max_tasks)
+    {
+        capacity <<= 1;
+        if (capacity == 0)
+        {
+            ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "maximum number of scheduler tasks (%zu) is too big",
+                    params.max_tasks);
+            return NULL;
+        }
+    }
+
+    archi_thread_scheduler_t scheduler = aligned_alloc(alignof(struct archi_thread_scheduler),
+            ARCHI_THREAD_SCHEDULER_ALIGNED_SIZE(sizeof(*scheduler)));
+    if (scheduler == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__EMEMORY, "couldn't allocate scheduler");
+        return NULL;
+    }
+
+    *scheduler = (struct archi_thread_scheduler){
+        .max_tasks = params.max_tasks,
+    };
+
+    atomic_init(&scheduler->num_ready, 0);
+    atomic_init(&scheduler->num_sleeping, 0);
+    atomic_init(&scheduler->num_tasks, 0);
+    atomic_init(&scheduler->stop, false);
+
+    // Create synchronization primitives
+    if (mtx_init(&scheduler->mtx, mtx_plain) != thrd_success)
+    {
+        ARCHI_ERROR_SET(ARCHI__ESYSTEM, "couldn't initialize mutex");
+
+        free(scheduler);
+        return NULL;
+    }
+
+    if (cnd_init(&scheduler->work_cnd) != thrd_success)
+    {
+        ARCHI_ERROR_SET(ARCHI__ESYSTEM, "couldn't initialize condition variable");
+
+        mtx_destroy(&scheduler->mtx);
+        free(scheduler);
+        return NULL;
+    }
+
+    if (cnd_init(&scheduler->done_cnd) != thrd_success)
+    {
+        ARCHI_ERROR_SET(ARCHI__ESYSTEM, "couldn't initialize condition variable");
+
+        cnd_destroy(&scheduler->work_cnd);
+        mtx_destroy(&scheduler->mtx);
+        free(scheduler);
+        return NULL;
+    }
+
+    // Allocate tasks and queues
+    scheduler->task = malloc(sizeof(*scheduler->task) * params.max_tasks);
+    if (scheduler->task == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__EMEMORY, "couldn't allocate array of tasks [%zu]", params.max_tasks);
+        goto failure;
+    }
+
+    // Queues have twice the capacity, so that pushes never fail because of in-progress pops
+    scheduler->injection_queue = archi_thread_lfqueue_alloc((archi_thread_lfqueue_alloc_params_t){
+            .capacity = capacity * 2, .elt_size = sizeof(size_t)}, ARCHI_ERROR_PARAM);
+    if (scheduler->injection_queue == NULL)
+        goto failure;
+
+    scheduler->free_slots = archi_thread_lfqueue_alloc((archi_thread_lfqueue_alloc_params_t){
+            .capacity = capacity * 2, .elt_size = sizeof(size_t)}, ARCHI_ERROR_PARAM);
+    if (scheduler->free_slots == NULL)
+        goto failure;
+
+    for (size_t i = 0; i < params.max_tasks; i++)
+        archi_thread_lfqueue_push(scheduler->free_slots, &i, ARCHI_ERROR_PARAM);
+
+    scheduler->worker = aligned_alloc(alignof(struct archi_thread_scheduler_worker),
+            ARCHI_THREAD_SCHEDULER_ALIGNED_SIZE(sizeof(*scheduler->worker) * params.num_threads));
+    if (scheduler->worker == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__EMEMORY, "couldn't allocate array of workers [%zu]", params.num_threads);
+        goto failure;
+    }
+
+    for (size_t i = 0; i < params.num_threads; i++)
+    {
+        struct archi_thread_scheduler_worker *worker = &scheduler->worker[i];
+
+        worker->scheduler = scheduler;
+        worker->worker_idx = i;
+
+        atomic_init(&worker->deque.top, 0);
+        atomic_init(&worker->deque.bottom, 0);
+        worker->deque.mask = capacity - 1;
+
+        worker->deque.buffer = malloc(sizeof(*worker->deque.buffer) * capacity);
+        if (worker->deque.buffer == NULL)
+        {
+            ARCHI_ERROR_SET(ARCHI__EMEMORY, "couldn't allocate deque of worker #%zu", i);
+            goto failure;
+        }
+
+        scheduler->num_threads++;
+    }
+
+    // Create threads
+    for (size_t i = 0; i < params.num_threads; i++)
+    {
+        int res = thrd_create(&scheduler->worker[i].thread,
+                archi_thread_scheduler_worker_thread, &scheduler->worker[i]);
+        if (res != thrd_success)
+        {
+            if (res == thrd_nomem)
+                ARCHI_ERROR_SET(ARCHI__EMEMORY, "couldn't create worker thread #%zu", i);
+            else
+                ARCHI_ERROR_SET(ARCHI__ESYSTEM, "couldn't create worker thread #%zu", i);
+
+            // Stop the created threads
+            atomic_store_explicit(&scheduler->stop, true, memory_order_release);
+
+            mtx_lock(&scheduler->mtx);
+            cnd_broadcast(&scheduler->work_cnd);
+            mtx_unlock(&scheduler->mtx);
+
+            for (size_t j = 0; j < i; j++)
+                thrd_join(scheduler->worker[j].thread, (int*)NULL);
+
+            goto failure;
+        }
+    }
+
+    ARCHI_ERROR_RESET();
+    return scheduler;
+
+failure:
+    for (size_t i = 0; i < scheduler->num_threads; i++)
+        free(scheduler->worker[i].deque.buffer);
+
+    free(scheduler->worker);
+    archi_thread_lfqueue_free(scheduler->free_slots);
+    archi_thread_lfqueue_free(scheduler->injection_queue);
+    free(scheduler->task);
+
+    cnd_destroy(&scheduler->done_cnd);
+    cnd_destroy(&scheduler->work_cnd);
+    mtx_destroy(&scheduler->mtx);
+    free(scheduler);
+
+    return NULL;
+}
+
+void
+archi_thread_scheduler_destroy(
+        archi_thread_scheduler_t scheduler)
+{
+    if (scheduler == NULL)
+        return;
+
+    // Stop worker threads
+    atomic_store_explicit(&scheduler->stop, true, memory_order_release);
+
+    mtx_lock(&scheduler->mtx);
+    cnd_broadcast(&scheduler->work_cnd);
+    mtx_unlock(&scheduler->mtx);
+
+    for (size_t i = 0; i < scheduler->num_threads; i++)
+        thrd_join(scheduler->worker[i].thread, (int*)NULL);
+
+    // Free memory
+    for (size_t i = 0; i < scheduler->num_threads; i++)
+        free(scheduler->worker[i].deque.buffer);
+
+    free(scheduler->worker);
+    archi_thread_lfqueue_free(scheduler->free_slots);
+    archi_thread_lfqueue_free(scheduler->injection_queue);
+    free(scheduler->task);
+
+    cnd_destroy(&scheduler->done_cnd);
+    cnd_destroy(&scheduler->work_cnd);
+    mtx_destroy(&scheduler->mtx);
+    free(scheduler);
+}
+
+bool
+archi_thread_scheduler_submit(
+        archi_thread_scheduler_t scheduler,
+        archi_dexgraph_frame_t frame,
+        ARCHI_ERROR_PARAM_DECL)
+{
+    if (scheduler == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "scheduler is NULL");
+        return false;
+    }
+    else if (frame.node == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "task frame node is NULL");
+        return false;
+    }
+
+    size_t task_idx;
+    if (!archi_thread_lfqueue_pop(scheduler->free_slots, &task_idx, ARCHI_ERROR_PARAM))
+        return false; // no free slots
+
+    scheduler->task[task_idx] = frame;
+    atomic_fetch_add_explicit(&scheduler->num_tasks, 1, memory_order_relaxed);
+
+    archi_thread_scheduler_enqueue(scheduler, task_idx, true);
+
+    ARCHI_ERROR_RESET();
+    return true;
+}
+
+void
+archi_thread_scheduler_yield(void)
+{
+    if (archi_thread_scheduler_current_worker != NULL)
+        archi_thread_scheduler_yield_requested = true;
+}
+
+void
+archi_thread_scheduler_wait(
+        archi_thread_scheduler_t scheduler,
+        ARCHI_ERROR_PARAM_DECL)
+{
+    if (scheduler == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "scheduler is NULL");
+        return;
+    }
+
+    mtx_lock(&scheduler->mtx);
+
+    while (atomic_load_explicit(&scheduler->num_tasks, memory_order_acquire) != 0)
+        cnd_wait(&scheduler->done_cnd, &scheduler->mtx);
+
+    archi_error_t error;
+    ARCHI_ERROR_VAR_RESET(&error);
+
+    if (scheduler->failed)
+    {
+        error = scheduler->error;
+        scheduler->failed = false;
+    }
+
+    mtx_unlock(&scheduler->mtx);
+
+    ARCHI_ERROR_ASSIGN(error);
+}
+
+size_t
+archi_thread_scheduler_num_threads(
+        archi_thread_scheduler_t scheduler)
+{
+    if (scheduler == NULL)
+        return 0;
+
+    return scheduler->num_threads;
+}
+
+size_t
+archi_thread_scheduler_num_tasks(
+        archi_thread_scheduler_t scheduler)
+{
+    if (scheduler == NULL)
+        return 0;
+
+    return atomic_load_explicit(&scheduler->num_tasks, memory_order_relaxed);
+}
+
@@ -24,6 +24,9 @@
  */
 
 #include "archi/thread/api/thread_group.fun.h"
+#include "archi/trace/api/trace.def.h"
+#include "affinity.fun.h"
+#include "notify.fun.h"
 
 #ifdef __STDC_NO_ATOMICS__
 #  error Atomics are required, but not supported by the compiler.
@@ -33,10 +36,15 @@
 #  error Threads are required, but not supported by the compiler.
 #endif
 
-#include <stdlib.h> // for malloc(), free()
+#include <stdlib.h> // for malloc(), aligned_alloc(), free()
+#include <string.h> // for memcpy(), memmove()
 #include <stdatomic.h> // for atomic_* functions and types
 #include <threads.h> // for thrd_* functions and types
+#include <stdalign.h> // for alignas
+#include <stdint.h> // for uint64_t, uintptr_t, SIZE_MAX
+#include <limits.h> // for CHAR_BIT
 #include <stdbool.h>
+#include <time.h> // for struct timespec, timespec_get()
 #include <assert.h>
 
 
@@ -62,6 +70,11 @@
     assert(res == thrd_success);                \
 } while (0)
 
+#  define CND_SIGNAL(condvar) do {              \
+    int res = cnd_signal(&(condvar));           \
+    assert(res == thrd_success);                \
+} while (0)
+
 #  define MTX_UNLOCK(mutex) do {                \
     int res = mtx_unlock(&(mutex));             \
     assert(res == thrd_success);                \
@@ -85,12 +98,44 @@
     cnd_broadcast(&(condvar));          \
 } while (0)
 
+#  define CND_SIGNAL(condvar) do {      \
+    cnd_signal(&(condvar));             \
+} while (0)
+
 #  define MTX_UNLOCK(mutex) do {        \
     mtx_unlock(&(mutex));               \
 } while (0)
 
 #endif
 
+/**
+ * @brief Size of a cache line to separate frequently modified fields with.
+ */
+#define ARCHI_THREAD_GROUP_CACHE_LINE   64
+
+/**
+ * @brief Round a size up to a multiple of the cache line size, as required by aligned_alloc().
+ */
+#define ARCHI_THREAD_GROUP_ALIGNED_SIZE(size) \
+    (((size) + ARCHI_THREAD_GROUP_CACHE_LINE - 1) & ~(size_t)(ARCHI_THREAD_GROUP_CACHE_LINE - 1))
+
+/**
+ * @brief Number of work functions the adaptive scheduling policy remembers item costs of.
+ */
+#define ARCHI_THREAD_GROUP_ADAPTIVE_NUM_ENTRIES 16
+
+/**
+ * @brief Time the adaptive scheduling policy aims a batch to take, in nanoseconds.
+ */
+#define ARCHI_THREAD_GROUP_ADAPTIVE_BATCH_NS    20000
+
+/**
+ * @brief Estimated work time per thread the adaptive scheduling policy needs to wake a thread, in nanoseconds.
+ *
+ * Work of less than this time is done by the dispatching thread itself.
+ */
+#define ARCHI_THREAD_GROUP_ADAPTIVE_THREAD_NS   50000
+
 /*****************************************************************************/
 
 struct archi_thread_group_dispatch {
@@ -98,384 +143,2241 @@ struct archi_thread_group_dispatch {
     archi_thread_group_callback_t callback;
 
     archi_thread_group_dispatch_params_t params;
+
+    size_t ticket; // ticket of the dispatch
+    size_t after; // ticket of the dispatch to complete before starting this one
+    size_t num_participants; // number of threads processing the dispatch
+    size_t adaptive_entry; // index of the adaptive scheduling policy entry of the work function
+
+    bool reduce; // whether the dispatch is a reduction
+    bool phased; // whether the dispatch is multi-phase
+
+    uint64_t enqueue_ns; // time of enqueueing (if statistics are collected)
 };
 
-struct archi_thread_group {
-    thrd_t *threads;
-    size_t num_threads;
+struct archi_thread_group_tiling {
+    archi_thread_group_tile_work_t work;
+    archi_thread_group_tile_order_t order;
+
+    size_t size[3];      // domain size
+    size_t tile_size[3]; // tile size
+    size_t num_tiles[3]; // number of tiles
+    unsigned num_bits[3]; // number of Morton code bits
+};
 
-    struct {
-        bool flag;
-        bool sense;
+struct archi_thread_group_reduce {
+    archi_thread_group_reduction_t reduction;
 
-        cnd_t cnd;
-        mtx_t mtx;
-    } ping, pong;
+    char *accumulator; // per-thread accumulators
+    size_t stride;     // distance between accumulators of neighbouring threads
+    size_t capacity;   // size of the accumulator buffer
+};
 
-    atomic_flag busy; // whether threads are busy
+struct archi_thread_group_phases {
+    archi_thread_group_phase_work_t work;
 
-    atomic_size_t num_work_items_done; // total number of processed work items
-    atomic_size_t num_threads_done;    // number of threads that have finished processing
+    size_t phase; // current phase (modified by the last thread arriving at the barrier)
+    bool stop;    // whether further phases are not started
 
-    struct archi_thread_group_dispatch dispatch; // current work task
+    alignas(ARCHI_THREAD_GROUP_CACHE_LINE) atomic_size_t num_arrived; // number of threads arrived at the barrier
+    atomic_bool sense; // flipped by the last thread arriving at the barrier
 };
 
-/*****************************************************************************/
+struct archi_thread_group_tally {
+    size_t num_work_items; // number of processed work items
+    size_t num_batches;    // number of acquired batches
+};
 
-struct archi_thread_arg {
-    archi_thread_group_t context;
-    size_t thread_idx;
+struct archi_thread_group_counters {
+    alignas(ARCHI_THREAD_GROUP_CACHE_LINE) atomic_uint_least64_t num_work_items;
+    atomic_uint_least64_t num_batches;
+
+    atomic_uint_least64_t busy_ns;
+    atomic_uint_least64_t wait_ns;
+
+    atomic_uint_least64_t num_wakeups;
+    atomic_uint_least64_t wake_latency_ns;
+    atomic_uint_least64_t max_wake_latency_ns;
 };
 
-static
-int
-archi_thread(
-        void *arg)
-{
-    // Copy context and thread index
-    archi_thread_group_t context;
-    size_t thread_idx;
-    {
-        struct archi_thread_arg *thread_arg = arg;
-        assert(thread_arg != NULL);
+typedef void (*archi_thread_group_adaptive_key_t)(void); // user work function of any type
 
-        context = thread_arg->context;
-        thread_idx = thread_arg->thread_idx;
+struct archi_thread_group_adaptive_entry {
+    archi_thread_group_adaptive_key_t function; // work function
+    atomic_uint_least64_t item_ns; // smoothed time of processing a work item
+};
 
-        // Free the temporary argument object
-        free(thread_arg);
-    }
+struct archi_thread_group_signal {
+    alignas(ARCHI_THREAD_GROUP_CACHE_LINE) atomic_size_t count; // spun on by waiting threads
 
-    // Initialize local flags
-    bool ping_sense = false, pong_sense = false;
+    atomic_size_t num_sleeping; // number of threads sleeping on the condition variable
 
-    // Loop until stop signal
-    for (;;)
-    {
-        // Toggle flag sense
-        ping_sense = !ping_sense;
-        pong_sense = !pong_sense;
+    cnd_t cnd;
+    mtx_t mtx;
+};
 
-        struct archi_thread_group_dispatch dispatch;
-        {
-            MTX_LOCK(context->ping.mtx);
+struct archi_thread_group_sleeper {
+    alignas(ARCHI_THREAD_GROUP_CACHE_LINE) atomic_bool sleeping; // whether the thread sleeps waiting for work
 
-            // Wait for a work task or stop signal
-            while (context->ping.flag != ping_sense)
-                CND_WAIT(context->ping.cnd, context->ping.mtx);
+    cnd_t cnd;
+};
 
-            // Store a local copy of the dispatch
-            dispatch = context->dispatch;
+struct archi_thread_group_range {
+    alignas(ARCHI_THREAD_GROUP_CACHE_LINE) atomic_flag lock;
 
-            MTX_UNLOCK(context->ping.mtx);
-        }
+    atomic_size_t begin; // first remaining work item of a thread
+    atomic_size_t end;   // end of remaining work items of a thread
+};
 
-        // Terminate on stop signal
-        if (dispatch.work.function == NULL)
-            return 0;
+struct archi_thread_group_slot {
+    alignas(ARCHI_THREAD_GROUP_CACHE_LINE) atomic_size_t num_work_items_done; // total number of processed work items
+    atomic_size_t num_threads_done; // number of threads that have finished processing
 
-        // Acquire first work item
-        size_t work_item_idx = atomic_fetch_add_explicit(&context->num_work_items_done,
-                dispatch.params.batch_size, memory_order_relaxed);
-        size_t remaining_work_items = dispatch.params.batch_size;
+    atomic_size_t ticket; // ticket of the dispatch in the slot (0 = being replaced)
+    atomic_size_t num_participants; // number of threads processing the dispatch in the slot
 
-        // Loop until no work items left
-        while (work_item_idx < dispatch.params.size)
-        {
-            // Call the work function
-            dispatch.work.function(dispatch.work.data, dispatch.params.offset + work_item_idx, thread_idx);
-            remaining_work_items--;
+    atomic_size_t cancel; // ticket of the latest cancelled dispatch in the slot
+    atomic_size_t num_work_items_processed; // number of actually processed work items
 
-            // Acquire next work item
-            if (remaining_work_items > 0)
-                work_item_idx++;
-            else
-            {
-                work_item_idx = atomic_fetch_add_explicit(&context->num_work_items_done,
-                        dispatch.params.batch_size, memory_order_relaxed);
-                remaining_work_items = dispatch.params.batch_size;
-            }
-        }
+    atomic_uint_least64_t work_time_ns; // total time threads spent processing work items
+    atomic_uint_least64_t first_done_ns; // time the first thread finished processing (if statistics are collected)
 
-        // Check if the current thread is the last
-        if (atomic_fetch_add_explicit(&context->num_threads_done, 1,
-                    memory_order_release) == context->num_threads - 1)
-        {
-            atomic_thread_fence(memory_order_acquire); // synchronize memory writes from other threads
+    struct archi_thread_group_range *range; // per-thread work item ranges for stealing
 
-            // Call the callback function
-            if (dispatch.callback.function != NULL)
-                dispatch.callback.function(dispatch.callback.data,
-                        dispatch.params.offset, dispatch.params.size, thread_idx);
+    struct archi_thread_group_dispatch dispatch; // work task
+    struct archi_thread_group_tiling tiling; // tiled work task
+    struct archi_thread_group_reduce reduce; // reduction task
+    struct archi_thread_group_phases phases; // multi-phase work task
+};
 
-            // Update pong flag
-            {
-                MTX_LOCK(context->pong.mtx);
+struct archi_thread_group_scratch {
+    alignas(ARCHI_THREAD_GROUP_CACHE_LINE) char *base;
 
-                context->pong.flag = pong_sense;
+    size_t size; // size of the arena
+    size_t used; // number of used bytes
+};
 
-                MTX_UNLOCK(context->pong.mtx);
-            }
+struct archi_thread_group {
+    thrd_t *threads;
+    size_t num_threads;
 
-            // Wake the master thread
-            CND_BROADCAST(context->pong.cnd);
+    struct archi_thread_group_scratch *scratch; // per-thread scratch arenas
+    const archi_memory_interface_t *scratch_interface;
+    archi_memory_alloc_info_t scratch_alloc;
+    archi_memory_map_info_t scratch_map;
 
-            // Clear the busyness flag
-            atomic_flag_clear_explicit(&context->busy, memory_order_relaxed);
-        }
-    }
-}
+    struct archi_thread_group_slot *slot; // dispatch queue
+    size_t queue_capacity;
 
-/*****************************************************************************/
+    struct archi_thread_group_range *range; // work item ranges of all slots
 
-archi_thread_group_t
-archi_thread_group_create(
-        archi_thread_group_start_params_t params,
-        ARCHI_ERROR_PARAM_DECL)
-{
-    size_t thread_idx = 0;
+    uint64_t spin_ns; // time to spin before sleeping
 
-    // Initialize threads context
-    archi_thread_group_t context = malloc(sizeof(*context));
-    if (context == NULL)
-    {
-        ARCHI_ERROR_SET(ARCHI__EMEMORY, "couldn't allocate thread group context");
-        goto failure;
-    }
+    struct archi_thread_group_signal ping; // number of enqueued dispatches (slave threads sleep on their own condvars)
+    struct archi_thread_group_signal pong; // number of completed dispatches
 
-    *context = (struct archi_thread_group){
-        .num_threads = params.num_threads,
-        .busy = ATOMIC_FLAG_INIT,
-    };
+    struct archi_thread_group_sleeper *sleeper; // per-thread condition variables to wait for work on
+    size_t num_sleepers;
 
-    if (params.num_threads > 0)
-    {
-        // Create mutexes and condition variables
-        int res;
+    atomic_flag submit_lock; // held by a thread enqueueing a dispatch
 
-        res = cnd_init(&context->ping.cnd);
-        if (res != thrd_success)
-        {
-            if (res == thrd_nomem)
-                ARCHI_ERROR_SET(ARCHI__EMEMORY, "couldn't initialize condition variable");
-            else
-                ARCHI_ERROR_SET(ARCHI__ESYSTEM, "couldn't initialize condition variable");
+    struct archi_thread_group_adaptive_entry adaptive[ARCHI_THREAD_GROUP_ADAPTIVE_NUM_ENTRIES];
+    size_t adaptive_next; // next adaptive scheduling policy entry to replace
 
-            goto failure;
-        }
+    struct archi_thread_group_counters *counters; // per-thread utilization counters (NULL = not collected)
 
-        res = mtx_init(&context->ping.mtx, mtx_plain);
-        if (res != thrd_success)
-        {
-            ARCHI_ERROR_SET(ARCHI__ESYSTEM, "couldn't initialize mutex");
+    atomic_uint_least64_t num_dispatches; // number of completed dispatches (if statistics are collected)
+    atomic_uint_least64_t tail_ns;        // total time between the first and the last thread finishing
+    atomic_uint_least64_t max_tail_ns;    // maximum time between the first and the last thread finishing
 
-            cnd_destroy(&context->ping.cnd);
-            goto failure;
-        }
+    struct archi_thread_notify notify; // completion notification descriptor (read_fd < 0 = not created)
+    atomic_bool notify_pending; // whether the notification descriptor is signalled
+};
 
-        res = cnd_init(&context->pong.cnd);
-        if (res != thrd_success)
-        {
-            if (res == thrd_nomem)
-                ARCHI_ERROR_SET(ARCHI__EMEMORY, "couldn't initialize condition variable");
-            else
-                ARCHI_ERROR_SET(ARCHI__ESYSTEM, "couldn't initialize condition variable");
+/**
+ * @brief Scratch arena of the current thread.
+ */
+static
+thread_local struct archi_thread_group_scratch *archi_thread_group_scratch_current;
 
-            cnd_destroy(&context->ping.cnd);
-            mtx_destroy(&context->ping.mtx);
-            goto failure;
-        }
+/**
+ * @brief Cancellation flag and ticket of the dispatch processed by the current thread.
+ */
+static
+thread_local atomic_size_t *archi_thread_group_cancel_current;
 
-        res = mtx_init(&context->pong.mtx, mtx_plain);
-        if (res != thrd_success)
-        {
-            ARCHI_ERROR_SET(ARCHI__ESYSTEM, "couldn't initialize mutex");
+static
+thread_local size_t archi_thread_group_cancel_ticket;
 
-            cnd_destroy(&context->ping.cnd);
-            mtx_destroy(&context->ping.mtx);
-            cnd_destroy(&context->pong.cnd);
-            goto failure;
-        }
+/*****************************************************************************/
 
-        // Create threads
-        context->threads = malloc(sizeof(*context->threads) * params.num_threads);
-        if (context->threads == NULL)
-        {
-            ARCHI_ERROR_SET(ARCHI__EMEMORY, "couldn't allocate array of threads [%zu]", params.num_threads);
-            goto failure;
-        }
-    }
+static inline
+uint64_t
+archi_thread_group_time_ns(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
 
-    for (; thread_idx < params.num_threads; thread_idx++)
+static
+void
+archi_thread_group_notify(
+        archi_thread_group_t context)
+{
+    // Signal the descriptor only if it isn't signalled already, to save system calls
+    if ((context->notify.read_fd >= 0) &&
+            !atomic_exchange_explicit(&context->notify_pending, true, memory_order_acq_rel))
+        archi_thread_notify_signal(&context->notify);
+}
+
+static inline
+bool
+archi_thread_group_signal_reached(
+        struct archi_thread_group_signal *signal,
+        size_t count,
+        memory_order order)
+{
+    // The counter may wrap around, compare the distance instead of values
+    return atomic_load_explicit(&signal->count, order) - count < SIZE_MAX / 2;
+}
+
+static
+bool
+archi_thread_group_signal_spin(
+        struct archi_thread_group_signal *signal,
+        size_t count,
+        uint64_t spin_ns)
+{
+    if (spin_ns == 0)
+        return archi_thread_group_signal_reached(signal, count, memory_order_acquire);
+
+    uint64_t deadline = archi_thread_group_time_ns() + spin_ns;
+
+    for (;;)
     {
-        struct archi_thread_arg *thread_arg = malloc(sizeof(*thread_arg));
-        if (thread_arg == NULL)
-        {
-            ARCHI_ERROR_SET(ARCHI__EMEMORY, "couldn't allocate thread #%zu entry function argument", thread_idx);
-            goto failure;
-        }
+        // Check the counter several times between clock readings
+        for (unsigned i = 0; i < 64; i++)
+            if (archi_thread_group_signal_reached(signal, count, memory_order_acquire))
+                return true;
 
-        *thread_arg = (struct archi_thread_arg){.context = context, .thread_idx = thread_idx};
+        if (archi_thread_group_time_ns() >= deadline)
+            return false;
 
-        int res = thrd_create(&context->threads[thread_idx], archi_thread, thread_arg);
-        if (res != thrd_success)
+        // Let the signalling thread run if the CPU is oversubscribed
+        thrd_yield();
+    }
+}
+
+static
+void
+archi_thread_group_signal_wait(
+        struct archi_thread_group_signal *signal,
+        size_t count,
+        uint64_t spin_ns,
+        const struct timespec *time_point)
+{
+    // Spin first to avoid the cost of sleeping and waking
+    if (archi_thread_group_signal_spin(signal, count, spin_ns))
+        return;
+
+    // Fall back to sleeping on the condition variable
+    MTX_LOCK(signal->mtx);
+
+    // The counter must be visible before the signal is checked, see archi_thread_group_signal_set()
+    atomic_fetch_add_explicit(&signal->num_sleeping, 1, memory_order_seq_cst);
+
+    while (!archi_thread_group_signal_reached(signal, count, memory_order_seq_cst))
+    {
+        if (time_point == NULL)
+            CND_WAIT(signal->cnd, signal->mtx);
+        else
         {
-            if (res == thrd_nomem)
-                ARCHI_ERROR_SET(ARCHI__EMEMORY, "couldn't create thread #%zu", thread_idx);
-            else
-                ARCHI_ERROR_SET(ARCHI__ESYSTEM, "couldn't create thread #%zu", thread_idx);
+            CND_TIMEDWAIT(signal->cnd, signal->mtx, time_point);
 
-            free(thread_arg);
-            goto failure;
+            if (archi_thread_group_time_ns() >=
+                    (uint64_t)time_point->tv_sec * 1000000000u + (uint64_t)time_point->tv_nsec)
+                break;
         }
     }
 
-    ARCHI_ERROR_RESET();
-    return context;
+    atomic_fetch_sub_explicit(&signal->num_sleeping, 1, memory_order_relaxed);
 
-failure:
-    if (context != NULL)
+    MTX_UNLOCK(signal->mtx);
+}
+
+static
+void
+archi_thread_group_signal_set(
+        struct archi_thread_group_signal *signal,
+        size_t count)
+{
+    atomic_store_explicit(&signal->count, count, memory_order_seq_cst);
+
+    // Spinning threads see the counter by themselves, sleeping ones need to be woken
+    if (atomic_load_explicit(&signal->num_sleeping, memory_order_seq_cst) != 0)
     {
-        context->num_threads = thread_idx; // number of created threads
-        archi_thread_group_destroy(context);
-    }
+        // Sleepers check the counter under the mutex, so they're either waiting or will see it
+        MTX_LOCK(signal->mtx);
+        MTX_UNLOCK(signal->mtx);
 
-    return NULL;
+        CND_BROADCAST(signal->cnd);
+    }
 }
 
+static
 void
-archi_thread_group_destroy(
-        archi_thread_group_t context)
+archi_thread_group_ping_wait(
+        archi_thread_group_t context,
+        size_t ticket,
+        size_t thread_idx)
 {
-    if (context == NULL)
+    // Spin first to avoid the cost of sleeping and waking
+    if (archi_thread_group_signal_spin(&context->ping, ticket, context->spin_ns))
         return;
 
-    // Wait while busy
-    while (atomic_flag_test_and_set_explicit(&context->busy, memory_order_relaxed))
-        archi_thread_group_wait(context);
+    // Fall back to sleeping on the own condition variable, so that only needed threads are woken
+    struct archi_thread_group_sleeper *sleeper = &context->sleeper[thread_idx];
 
-    if (context->num_threads > 0)
+    MTX_LOCK(context->ping.mtx);
+
+    // The flag must be visible before the counter is checked, see archi_thread_group_ping_set()
+    atomic_store_explicit(&sleeper->sleeping, true, memory_order_seq_cst);
+
+    while (!archi_thread_group_signal_reached(&context->ping, ticket, memory_order_seq_cst))
+        CND_WAIT(sleeper->cnd, context->ping.mtx);
+
+    atomic_store_explicit(&sleeper->sleeping, false, memory_order_relaxed);
+
+    MTX_UNLOCK(context->ping.mtx);
+}
+
+static
+void
+archi_thread_group_ping_set(
+        archi_thread_group_t context,
+        size_t ticket,
+        size_t num_threads)
+{
+    atomic_store_explicit(&context->ping.count, ticket, memory_order_seq_cst);
+
+    // Spinning threads see the counter by themselves, sleeping ones need to be woken.
+    // Threads not woken process (or skip) the dispatch when woken for a later one
+    for (size_t i = 0; i < num_threads; i++)
     {
+        if (atomic_load_explicit(&context->sleeper[i].sleeping, memory_order_seq_cst))
         {
+            // Sleepers set the flag under the mutex, so they're either waiting or will see the counter
             MTX_LOCK(context->ping.mtx);
 
-            // Set stop signal
-            context->dispatch = (struct archi_thread_group_dispatch){0};
-
-            // Update ping flag
-            context->ping.flag = !context->ping.sense;
+            for (; i < num_threads; i++)
+                if (atomic_load_explicit(&context->sleeper[i].sleeping, memory_order_relaxed))
+                    CND_SIGNAL(context->sleeper[i].cnd);
 
             MTX_UNLOCK(context->ping.mtx);
+            break;
         }
-
-        // Wake slave threads
-        CND_BROADCAST(context->ping.cnd);
     }
+}
 
-    // Join threads and free memory
-    for (size_t i = 0; i < context->num_threads; i++)
-        thrd_join(context->threads[i], (int*)NULL);
+static
+void
+archi_thread_group_slot_post(
+        archi_thread_group_t context,
+        struct archi_thread_group_slot *slot,
+        const struct archi_thread_group_dispatch *dispatch,
+        size_t ticket)
+{
+    // Threads not participating in the previous dispatch of the slot may still be checking it,
+    // so the ticket is invalidated while the number of participants is changed
+    atomic_store_explicit(&slot->ticket, 0, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&slot->num_participants, dispatch->num_participants, memory_order_relaxed);
 
-    free(context->threads);
+    slot->dispatch = *dispatch;
 
-    // Destroy mutexes, condition variables, and free memory
-    if (context->num_threads > 0)
-    {
-        cnd_destroy(&context->ping.cnd);
-        mtx_destroy(&context->ping.mtx);
-        cnd_destroy(&context->pong.cnd);
-        mtx_destroy(&context->pong.mtx);
-    }
+    atomic_store_explicit(&slot->ticket, ticket, memory_order_release);
 
-    free(context);
+    // Update ping counter and wake participating slave threads
+    archi_thread_group_ping_set(context, ticket, (dispatch->num_participants < context->num_threads) ?
+            dispatch->num_participants : context->num_threads);
 }
 
+static
 bool
-archi_thread_group_dispatch(
-        archi_thread_group_t context,
+archi_thread_group_slot_participates(
+        const struct archi_thread_group_slot *slot,
+        size_t ticket,
+        size_t thread_idx)
+{
+    // A thread not participating in a dispatch may see the slot reused for a later one,
+    // but a participating thread always sees the dispatch, as it can't complete without the thread
+    if (atomic_load_explicit(&slot->ticket, memory_order_acquire) != ticket)
+        return false;
 
-        archi_thread_group_work_t work,
-        archi_thread_group_callback_t callback,
+    size_t num_participants = atomic_load_explicit(&slot->num_participants, memory_order_relaxed);
 
-        archi_thread_group_dispatch_params_t params,
-        ARCHI_ERROR_PARAM_DECL)
-{
-    if (context == NULL)
-    {
-        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "thread group context is NULL");
+    atomic_thread_fence(memory_order_acquire);
+    if (atomic_load_explicit(&slot->ticket, memory_order_relaxed) != ticket)
         return false;
-    }
-    else if (work.function == NULL)
+
+    return thread_idx < num_participants;
+}
+
+static
+void
+archi_thread_group_cancel_set(
+        atomic_size_t *cancel,
+        size_t ticket)
+{
+    size_t current = atomic_load_explicit(cancel, memory_order_relaxed);
+
+    // Don't overwrite cancellation of a later dispatch in the same slot
+    while ((ticket - current - 1 < SIZE_MAX / 2) && !atomic_compare_exchange_weak_explicit(cancel,
+                &current, ticket, memory_order_relaxed, memory_order_relaxed));
+}
+
+static inline
+bool
+archi_thread_group_cancel_check(
+        const atomic_size_t *cancel,
+        size_t ticket)
+{
+    return atomic_load_explicit(cancel, memory_order_relaxed) == ticket;
+}
+
+static inline
+void
+archi_thread_group_counter_max(
+        atomic_uint_least64_t *counter,
+        uint64_t value)
+{
+    uint64_t current = atomic_load_explicit(counter, memory_order_relaxed);
+
+    while ((value > current) && !atomic_compare_exchange_weak_explicit(counter,
+                &current, value, memory_order_relaxed, memory_order_relaxed));
+}
+
+static
+void
+archi_thread_group_adaptive_update(
+        struct archi_thread_group_adaptive_entry *entry,
+        uint64_t work_time_ns,
+        uint64_t num_work_items)
+{
+    if (num_work_items == 0)
+        return;
+
+    uint64_t item_ns = work_time_ns / num_work_items;
+    if (item_ns == 0)
+        item_ns = 1;
+
+    // Exponential smoothing
+    uint64_t prev_item_ns = atomic_load_explicit(&entry->item_ns, memory_order_relaxed);
+    atomic_store_explicit(&entry->item_ns,
+            (prev_item_ns != 0) ? (3 * prev_item_ns + item_ns) / 4 : item_ns,
+            memory_order_relaxed);
+}
+
+/*****************************************************************************/
+
+static
+void
+archi_thread_group_work__shared(
+        struct archi_thread_group_slot *slot,
+        const struct archi_thread_group_dispatch *dispatch,
+        size_t thread_idx,
+        struct archi_thread_group_tally *tally)
+{
+    // Acquire first work item
+    size_t work_item_idx = atomic_fetch_add_explicit(&slot->num_work_items_done,
+            dispatch->params.batch_size, memory_order_relaxed);
+    size_t remaining_work_items = dispatch->params.batch_size;
+
+    if (work_item_idx < dispatch->params.size)
+        tally->num_batches++;
+
+    // Loop until no work items left
+    while (work_item_idx < dispatch->params.size)
+    {
+        // Call the work function
+        dispatch->work.function(dispatch->work.data, dispatch->params.offset + work_item_idx, thread_idx);
+        remaining_work_items--;
+        tally->num_work_items++;
+
+        // Acquire next work item
+        if (remaining_work_items > 0)
+            work_item_idx++;
+        else
+        {
+            if (archi_thread_group_cancel_check(&slot->cancel, dispatch->ticket))
+                break;
+
+            work_item_idx = atomic_fetch_add_explicit(&slot->num_work_items_done,
+                    dispatch->params.batch_size, memory_order_relaxed);
+            remaining_work_items = dispatch->params.batch_size;
+
+            if (work_item_idx < dispatch->params.size)
+                tally->num_batches++;
+        }
+    }
+}
+
+static
+void
+archi_thread_group_work__guided(
+        struct archi_thread_group_slot *slot,
+        const struct archi_thread_group_dispatch *dispatch,
+        size_t thread_idx,
+        struct archi_thread_group_tally *tally)
+{
+    size_t begin = atomic_load_explicit(&slot->num_work_items_done, memory_order_relaxed);
+
+    while (begin < dispatch->params.size)
+    {
+        // Take a share of the remaining work items, but no less than the batch size
+        size_t remaining = dispatch->params.size - begin;
+        size_t chunk_size = 1 + (remaining - 1) / dispatch->num_participants;
+
+        if (chunk_size < dispatch->params.batch_size)
+            chunk_size = dispatch->params.batch_size;
+        if (chunk_size > remaining)
+            chunk_size = remaining;
+
+        if (!atomic_compare_exchange_weak_explicit(&slot->num_work_items_done,
+                    &begin, begin + chunk_size, memory_order_relaxed, memory_order_relaxed))
+            continue;
+
+        tally->num_batches++;
+
+        // Check for cancellation after every batch size of work items, as chunks may be large
+        for (size_t work_item_idx = begin; work_item_idx < begin + chunk_size;)
+        {
+            size_t batch_end = (begin + chunk_size - work_item_idx > dispatch->params.batch_size) ?
+                work_item_idx + dispatch->params.batch_size : begin + chunk_size;
+
+            tally->num_work_items += batch_end - work_item_idx;
+
+            for (; work_item_idx < batch_end; work_item_idx++)
+                dispatch->work.function(dispatch->work.data, dispatch->params.offset + work_item_idx, thread_idx);
+
+            if (archi_thread_group_cancel_check(&slot->cancel, dispatch->ticket))
+                return;
+        }
+
+        begin = atomic_load_explicit(&slot->num_work_items_done, memory_order_relaxed);
+    }
+}
+
+static
+ARCHI_THREAD_GROUP_WORK_FUNC(archi_thread_group_work__tile)
+{
+    const struct archi_thread_group_tiling *tiling = data;
+
+    archi_thread_group_tile_t tile = {0};
+
+    // Compute tile coordinates
+    if (tiling->order == ARCHI_THREAD_GROUP_TILE_ORDER__MORTON)
+    {
+        // De-interleave bits of the Morton code
+        for (unsigned bit = 0; work_item_idx != 0; bit++)
+        {
+            for (size_t d = 0; d < 3; d++)
+            {
+                if (bit < tiling->num_bits[d])
+                {
+                    tile.coord[d] |= (work_item_idx & 1) << bit;
+                    work_item_idx >>= 1;
+                }
+            }
+        }
+
+        // Skip padding
+        for (size_t d = 0; d < 3; d++)
+            if (tile.coord[d] >= tiling->num_tiles[d])
+                return;
+    }
+    else
+    {
+        tile.coord[0] = work_item_idx % tiling->num_tiles[0];
+        work_item_idx /= tiling->num_tiles[0];
+
+        tile.coord[1] = work_item_idx % tiling->num_tiles[1];
+        tile.coord[2] = work_item_idx / tiling->num_tiles[1];
+    }
+
+    // Compute tile bounds
+    for (size_t d = 0; d < 3; d++)
+    {
+        tile.begin[d] = tile.coord[d] * tiling->tile_size[d];
+        tile.end[d] = (tiling->size[d] - tile.begin[d] > tiling->tile_size[d]) ?
+            tile.begin[d] + tiling->tile_size[d] : tiling->size[d];
+    }
+
+    tiling->work.function(tiling->work.data, tile, thread_idx);
+}
+
+static
+ARCHI_THREAD_GROUP_WORK_FUNC(archi_thread_group_work__reduce)
+{
+    const struct archi_thread_group_reduce *reduce = data;
+
+    reduce->reduction.accumulate(reduce->reduction.data,
+            reduce->accumulator + reduce->stride * thread_idx, work_item_idx, thread_idx);
+}
+
+static
+bool
+archi_thread_group_reduce_reserve(
+        struct archi_thread_group_reduce *reduce,
+        size_t value_size,
+        size_t num_accumulators,
+        ARCHI_ERROR_PARAM_DECL)
+{
+    // Pad accumulators to avoid false sharing
+    size_t stride = ARCHI_THREAD_GROUP_ALIGNED_SIZE(value_size);
+
+    if ((stride < value_size) || (stride > SIZE_MAX / num_accumulators))
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "reduction value size (%zu) is too large", value_size);
+        return false;
+    }
+
+    // Reuse the buffer of the previous reduction if it's large enough
+    if (stride * num_accumulators > reduce->capacity)
+    {
+        free(reduce->accumulator);
+
+        reduce->accumulator = aligned_alloc(ARCHI_THREAD_GROUP_CACHE_LINE, stride * num_accumulators);
+        if (reduce->accumulator == NULL)
+        {
+            ARCHI_ERROR_SET(ARCHI__EMEMORY, "couldn't allocate reduction accumulators (%zu bytes)",
+                    stride * num_accumulators);
+
+            reduce->capacity = 0;
+            return false;
+        }
+
+        reduce->capacity = stride * num_accumulators;
+    }
+
+    reduce->stride = stride;
+    return true;
+}
+
+static
+void
+archi_thread_group_reduce_combine(
+        const struct archi_thread_group_reduce *reduce,
+        size_t num_accumulators)
+{
+    // Combine accumulators pairwise, doubling the distance between them on every level of the tree
+    for (size_t step = 1; step < num_accumulators; step *= 2)
+        for (size_t i = 0; i + step < num_accumulators; i += 2 * step)
+            reduce->reduction.combine(reduce->reduction.data, reduce->accumulator + reduce->stride * i,
+                    reduce->accumulator + reduce->stride * (i + step));
+
+    memcpy(reduce->reduction.result, reduce->accumulator, reduce->reduction.value_size);
+}
+
+static
+ARCHI_THREAD_GROUP_WORK_FUNC(archi_thread_group_work__phase)
+{
+    const struct archi_thread_group_phases *phases = data;
+
+    phases->work.function(phases->work.data, phases->phase, work_item_idx, thread_idx);
+}
+
+static inline
+void
+archi_thread_group_range_lock(
+        struct archi_thread_group_range *range)
+{
+    while (atomic_flag_test_and_set_explicit(&range->lock, memory_order_acquire))
+        thrd_yield();
+}
+
+static inline
+void
+archi_thread_group_range_unlock(
+        struct archi_thread_group_range *range)
+{
+    atomic_flag_clear_explicit(&range->lock, memory_order_release);
+}
+
+static
+void
+archi_thread_group_work__steal(
+        struct archi_thread_group_slot *slot,
+        const struct archi_thread_group_dispatch *dispatch,
+        size_t thread_idx,
+        struct archi_thread_group_tally *tally)
+{
+    struct archi_thread_group_range *own = &slot->range[thread_idx];
+
+    for (;;)
+    {
+        size_t begin, end;
+
+        // Take a batch from the own range
+        archi_thread_group_range_lock(own);
+        {
+            begin = atomic_load_explicit(&own->begin, memory_order_relaxed);
+            end = atomic_load_explicit(&own->end, memory_order_relaxed);
+
+            if (end - begin > dispatch->params.batch_size)
+                end = begin + dispatch->params.batch_size;
+
+            atomic_store_explicit(&own->begin, end, memory_order_relaxed);
+        }
+        archi_thread_group_range_unlock(own);
+
+        if (begin < end)
+        {
+            for (size_t work_item_idx = begin; work_item_idx < end; work_item_idx++)
+                dispatch->work.function(dispatch->work.data, dispatch->params.offset + work_item_idx, thread_idx);
+
+            tally->num_work_items += end - begin;
+            tally->num_batches++;
+
+            if (archi_thread_group_cancel_check(&slot->cancel, dispatch->ticket))
+                return;
+
+            continue;
+        }
+
+        // The own range is exhausted: steal the upper half of another thread's range
+        bool stolen = false;
+
+        for (size_t i = 1; (i < dispatch->num_participants) && !stolen; i++)
+        {
+            struct archi_thread_group_range *victim =
+                &slot->range[(thread_idx + i) % dispatch->num_participants];
+
+            // Skip empty ranges without locking them
+            if (atomic_load_explicit(&victim->begin, memory_order_relaxed) >=
+                    atomic_load_explicit(&victim->end, memory_order_relaxed))
+                continue;
+
+            archi_thread_group_range_lock(victim);
+            {
+                begin = atomic_load_explicit(&victim->begin, memory_order_relaxed);
+                end = atomic_load_explicit(&victim->end, memory_order_relaxed);
+
+                if (begin < end)
+                {
+                    begin = end - (end - begin + 1) / 2;
+                    atomic_store_explicit(&victim->end, begin, memory_order_relaxed);
+
+                    stolen = true;
+                }
+            }
+            archi_thread_group_range_unlock(victim);
+        }
+
+        if (!stolen)
+            return;
+
+        archi_thread_group_range_lock(own);
+        {
+            atomic_store_explicit(&own->begin, begin, memory_order_relaxed);
+            atomic_store_explicit(&own->end, end, memory_order_relaxed);
+        }
+        archi_thread_group_range_unlock(own);
+    }
+}
+
+static
+void
+archi_thread_group_range_split(
+        struct archi_thread_group_slot *slot,
+        size_t num_work_items,
+        size_t num_participants)
+{
+    // Split the work item range into contiguous per-thread chunks
+    size_t chunk_size = num_work_items / num_participants;
+    size_t remainder = num_work_items % num_participants;
+
+    for (size_t i = 0; i < num_participants; i++)
+    {
+        size_t begin = chunk_size * i + (i < remainder ? i : remainder);
+        size_t end = begin + chunk_size + (i < remainder ? 1 : 0);
+
+        atomic_store_explicit(&slot->range[i].begin, begin, memory_order_relaxed);
+        atomic_store_explicit(&slot->range[i].end, end, memory_order_relaxed);
+    }
+}
+
+static
+bool
+archi_thread_group_barrier(
+        struct archi_thread_group_slot *slot,
+        const struct archi_thread_group_dispatch *dispatch,
+        bool *sense)
+{
+    struct archi_thread_group_phases *phases = &slot->phases;
+
+    *sense = !*sense;
+
+    if (atomic_fetch_add_explicit(&phases->num_arrived, 1,
+                memory_order_acq_rel) == dispatch->num_participants - 1)
+    {
+        // The last thread prepares the next phase while the others wait.
+        // The decision to stop is made once, so that all threads leave the barrier loop together
+        atomic_store_explicit(&phases->num_arrived, 0, memory_order_relaxed);
+
+        if (archi_thread_group_cancel_check(&slot->cancel, dispatch->ticket))
+            phases->stop = true;
+        else
+        {
+            phases->phase++;
+
+            atomic_store_explicit(&slot->num_work_items_done, 0, memory_order_relaxed);
+            atomic_store_explicit(&slot->num_work_items_processed, 0, memory_order_relaxed);
+
+            if (dispatch->params.schedule == ARCHI_THREAD_GROUP_SCHEDULE__STEAL)
+                archi_thread_group_range_split(slot, dispatch->params.size, dispatch->num_participants);
+        }
+
+        // Release the waiting threads
+        atomic_store_explicit(&phases->sense, *sense, memory_order_release);
+    }
+    else
+    {
+        // Spin until the last thread arrives, letting it run if the CPU is oversubscribed
+        for (unsigned i = 1; atomic_load_explicit(&phases->sense, memory_order_acquire) != *sense; i++)
+            if (i % 64 == 0)
+                thrd_yield();
+    }
+
+    return !phases->stop;
+}
+
+static
+void
+archi_thread_group_process(
+        archi_thread_group_t context,
+        struct archi_thread_group_slot *slot,
+        const struct archi_thread_group_dispatch *dispatch,
+        size_t ticket,
+        size_t thread_idx)
+{
+    // Reset the scratch arena
+    if (context->scratch != NULL)
+        context->scratch[thread_idx].used = 0;
+
+    // Initialize the accumulator of the thread
+    if (dispatch->reduce)
+        memcpy(slot->reduce.accumulator + slot->reduce.stride * thread_idx,
+                slot->reduce.reduction.identity, slot->reduce.reduction.value_size);
+
+    ARCHI_TRACE_EVENT(ARCHI_TRACE__WORK_BEGIN, "work", context, thread_idx);
+
+    bool timed = (dispatch->params.schedule == ARCHI_THREAD_GROUP_SCHEDULE__ADAPTIVE) ||
+        (context->counters != NULL);
+
+    uint64_t start_ns = timed ? archi_thread_group_time_ns() : 0;
+    struct archi_thread_group_tally tally = {0};
+
+    // Let work functions cancel the dispatch
+    atomic_size_t *cancel = archi_thread_group_cancel_current;
+    size_t cancel_ticket = archi_thread_group_cancel_ticket;
+
+    archi_thread_group_cancel_current = &slot->cancel;
+    archi_thread_group_cancel_ticket = ticket;
+
+    bool sense = false; // barrier sense of the thread
+    size_t num_work_items = 0; // number of work items processed in previous phases
+
+    for (;;)
+    {
+        // Process work items (unless the dispatch is cancelled)
+        if (!archi_thread_group_cancel_check(&slot->cancel, ticket))
+        {
+            switch (dispatch->params.schedule)
+            {
+                case ARCHI_THREAD_GROUP_SCHEDULE__STEAL:
+                    archi_thread_group_work__steal(slot, dispatch, thread_idx, &tally);
+                    break;
+
+                case ARCHI_THREAD_GROUP_SCHEDULE__GUIDED:
+                    archi_thread_group_work__guided(slot, dispatch, thread_idx, &tally);
+                    break;
+
+                default:
+                    archi_thread_group_work__shared(slot, dispatch, thread_idx, &tally);
+            }
+        }
+
+        if (!dispatch->phased || (slot->phases.phase + 1 == slot->phases.work.num_phases))
+            break;
+
+        // Wait until all threads finish the phase
+        atomic_fetch_add_explicit(&slot->num_work_items_processed, tally.num_work_items - num_work_items,
+                memory_order_relaxed);
+        num_work_items = tally.num_work_items;
+
+        if (!archi_thread_group_barrier(slot, dispatch, &sense))
+            break;
+    }
+
+    uint64_t end_ns = timed ? archi_thread_group_time_ns() : 0;
+
+    ARCHI_TRACE_EVENT(ARCHI_TRACE__WORK_END, "work", context, thread_idx);
+
+    if (dispatch->params.schedule == ARCHI_THREAD_GROUP_SCHEDULE__ADAPTIVE)
+        atomic_fetch_add_explicit(&slot->work_time_ns, end_ns - start_ns, memory_order_relaxed);
+
+    // Update utilization counters
+    if (context->counters != NULL)
+    {
+        struct archi_thread_group_counters *counters = &context->counters[thread_idx];
+
+        atomic_fetch_add_explicit(&counters->num_work_items, tally.num_work_items, memory_order_relaxed);
+        atomic_fetch_add_explicit(&counters->num_batches, tally.num_batches, memory_order_relaxed);
+        atomic_fetch_add_explicit(&counters->busy_ns, end_ns - start_ns, memory_order_relaxed);
+
+        // Only the first thread to finish stores the time
+        uint64_t first_done_ns = 0;
+        atomic_compare_exchange_strong_explicit(&slot->first_done_ns, &first_done_ns, end_ns,
+                memory_order_relaxed, memory_order_relaxed);
+    }
+
+    atomic_fetch_add_explicit(&slot->num_work_items_processed, tally.num_work_items - num_work_items,
+            memory_order_relaxed);
+
+    // Check if the current thread is the last
+    if (atomic_fetch_add_explicit(&slot->num_threads_done, 1,
+                memory_order_release) == dispatch->num_participants - 1)
+    {
+        atomic_thread_fence(memory_order_acquire); // synchronize memory writes from other threads
+
+        // Threads go through dispatches in order, but a dispatch done by fewer threads
+        // may be finished before the preceding one, so wait for it to complete in order
+        archi_thread_group_signal_wait(&context->pong, ticket - 1, context->spin_ns, NULL);
+
+        size_t num_work_items_processed = atomic_load_explicit(&slot->num_work_items_processed,
+                memory_order_relaxed);
+
+        // Update the measured cost of a work item
+        if (dispatch->params.schedule == ARCHI_THREAD_GROUP_SCHEDULE__ADAPTIVE)
+        {
+            // Work time of a multi-phase dispatch includes all done phases
+            uint64_t num_work_items = (uint64_t)num_work_items_processed *
+                (dispatch->phased ? slot->phases.phase + 1 : 1);
+
+            archi_thread_group_adaptive_update(&context->adaptive[dispatch->adaptive_entry],
+                    atomic_load_explicit(&slot->work_time_ns, memory_order_relaxed), num_work_items);
+        }
+
+        // Update tail time
+        if (context->counters != NULL)
+        {
+            uint64_t first_done_ns = atomic_load_explicit(&slot->first_done_ns, memory_order_relaxed);
+            uint64_t tail_ns = (end_ns > first_done_ns) ? end_ns - first_done_ns : 0;
+
+            atomic_fetch_add_explicit(&context->num_dispatches, 1, memory_order_relaxed);
+            atomic_fetch_add_explicit(&context->tail_ns, tail_ns, memory_order_relaxed);
+            archi_thread_group_counter_max(&context->max_tail_ns, tail_ns);
+        }
+
+        // Combine accumulators of all threads
+        if (dispatch->reduce)
+            archi_thread_group_reduce_combine(&slot->reduce, dispatch->num_participants);
+
+        // Call the callback function
+        if (dispatch->callback.function != NULL)
+            dispatch->callback.function(dispatch->callback.data,
+                    dispatch->params.offset, num_work_items_processed, thread_idx);
+
+        ARCHI_TRACE_EVENT(ARCHI_TRACE__COMPLETE, "complete", context, thread_idx);
+
+        // Update pong counter and wake waiting threads
+        archi_thread_group_signal_set(&context->pong, ticket);
+
+        archi_thread_group_notify(context);
+    }
+
+    archi_thread_group_cancel_current = cancel;
+    archi_thread_group_cancel_ticket = cancel_ticket;
+}
+
+/*****************************************************************************/
+
+struct archi_thread_arg {
+    archi_thread_group_t context;
+    size_t thread_idx;
+    size_t cpu; // CPU to pin the thread to (SIZE_MAX = not pinned)
+
+    // Start-up handshake with the creating thread
+    mtx_t mtx;
+    cnd_t cnd;
+    int status; // 0 = not started yet, 1 = started, -1 = couldn't pin
+};
+
+static
+int
+archi_thread(
+        void *arg)
+{
+    // Copy context and thread index
+    archi_thread_group_t context;
+    size_t thread_idx;
+    {
+        struct archi_thread_arg *thread_arg = arg;
+        assert(thread_arg != NULL);
+
+        context = thread_arg->context;
+        thread_idx = thread_arg->thread_idx;
+
+        // Pin the thread before it touches any memory
+        bool pinned = (thread_arg->cpu == SIZE_MAX) || archi_thread_affinity_pin(thread_arg->cpu);
+
+        // Report the start-up; the argument object must not be accessed afterwards
+        mtx_lock(&thread_arg->mtx);
+        thread_arg->status = pinned ? 1 : -1;
+        cnd_signal(&thread_arg->cnd);
+        mtx_unlock(&thread_arg->mtx);
+
+        if (!pinned)
+            return 1;
+    }
+
+    // Set the scratch arena of the thread
+    if (context->scratch != NULL)
+        archi_thread_group_scratch_current = &context->scratch[thread_idx];
+
+    // Process dispatches in the order of enqueueing
+    struct archi_thread_group_counters *counters =
+        (context->counters != NULL) ? &context->counters[thread_idx] : NULL;
+
+    uint64_t wait_begin_ns = (counters != NULL) ? archi_thread_group_time_ns() : 0;
+
+    for (size_t ticket = 1;; ticket++)
+    {
+        // Wait for a work task or stop signal
+        archi_thread_group_ping_wait(context, ticket, thread_idx);
+
+        uint64_t wake_ns = (counters != NULL) ? archi_thread_group_time_ns() : 0;
+
+        struct archi_thread_group_slot *slot = &context->slot[(ticket - 1) % context->queue_capacity];
+
+        // Skip dispatches done by fewer threads
+        if (!archi_thread_group_slot_participates(slot, ticket, thread_idx))
+            continue;
+
+        // Store a local copy of the dispatch
+        struct archi_thread_group_dispatch dispatch = slot->dispatch;
+
+        // Terminate on stop signal
+        if (dispatch.work.function == NULL)
+            return 0;
+
+        // Wait for the dispatch this one depends on
+        if (dispatch.after != 0)
+            archi_thread_group_signal_wait(&context->pong, dispatch.after, context->spin_ns, NULL);
+
+        // Update waiting time and wake latency
+        if (counters != NULL)
+        {
+            atomic_fetch_add_explicit(&counters->wait_ns,
+                    archi_thread_group_time_ns() - wait_begin_ns, memory_order_relaxed);
+
+            if (dispatch.enqueue_ns > wait_begin_ns) // the thread was waiting for the dispatch
+            {
+                uint64_t latency_ns = (wake_ns > dispatch.enqueue_ns) ? wake_ns - dispatch.enqueue_ns : 0;
+
+                atomic_fetch_add_explicit(&counters->num_wakeups, 1, memory_order_relaxed);
+                atomic_fetch_add_explicit(&counters->wake_latency_ns, latency_ns, memory_order_relaxed);
+                archi_thread_group_counter_max(&counters->max_wake_latency_ns, latency_ns);
+            }
+        }
+
+        archi_thread_group_process(context, slot, &dispatch, ticket, thread_idx);
+
+        if (counters != NULL)
+            wait_begin_ns = archi_thread_group_time_ns();
+    }
+}
+
+/*****************************************************************************/
+
+static
+bool
+archi_thread_group_scratch_create(
+        archi_thread_group_t context,
+        archi_thread_group_start_params_t params,
+        ARCHI_ERROR_PARAM_DECL)
+{
+    if (params.scratch_size == 0)
+        return true;
+
+    // Every thread gets its own arena, the calling thread uses the last one
+    size_t num_arenas = params.num_threads + 1;
+    size_t arena_size = ARCHI_THREAD_GROUP_ALIGNED_SIZE(params.scratch_size);
+
+    if ((arena_size < params.scratch_size) || (arena_size > SIZE_MAX / num_arenas))
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "scratch arena size (%zu) is too large", params.scratch_size);
+        return false;
+    }
+
+    context->scratch = aligned_alloc(alignof(struct archi_thread_group_scratch),
+            sizeof(*context->scratch) * num_arenas);
+    if (context->scratch == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__EMEMORY, "couldn't allocate array of scratch arenas [%zu]", num_arenas);
+        return false;
+    }
+
+    // Allocate memory of all arenas at once.
+    // Pages are not touched here, so they are placed by the first thread to use them
+    char *base;
+
+    if (params.scratch_interface != NULL)
+    {
+        if (params.scratch_interface->alloc_fn == NULL)
+        {
+            ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "scratch arena memory allocation function is NULL");
+            return false;
+        }
+
+        archi_error_t error;
+        ARCHI_ERROR_VAR_UNSET(&error);
+
+        context->scratch_alloc = params.scratch_interface->alloc_fn(arena_size * num_arenas,
+                ARCHI_THREAD_GROUP_CACHE_LINE, params.scratch_alloc_data, &error);
+        if (context->scratch_alloc.allocation.ptr == NULL)
+        {
+            ARCHI_ERROR_ASSIGN(error);
+            return false;
+        }
+
+        context->scratch_interface = params.scratch_interface;
+
+        if (params.scratch_interface->map_fn != NULL)
+        {
+            ARCHI_ERROR_VAR_UNSET(&error);
+
+            context->scratch_map = params.scratch_interface->map_fn(context->scratch_alloc,
+                    0, arena_size * num_arenas, NULL, &error);
+            if (context->scratch_map.mapping.ptr == NULL)
+            {
+                ARCHI_ERROR_ASSIGN(error);
+                return false;
+            }
+
+            base = context->scratch_map.mapping.ptr;
+        }
+        else
+            base = context->scratch_alloc.allocation.ptr;
+    }
+    else
+    {
+        base = aligned_alloc(ARCHI_THREAD_GROUP_CACHE_LINE, arena_size * num_arenas);
+        if (base == NULL)
+        {
+            ARCHI_ERROR_SET(ARCHI__EMEMORY, "couldn't allocate scratch arenas (%zu bytes)",
+                    arena_size * num_arenas);
+            return false;
+        }
+
+        context->scratch_alloc.allocation.ptr = base;
+    }
+
+    for (size_t i = 0; i < num_arenas; i++)
+        context->scratch[i] = (struct archi_thread_group_scratch){
+            .base = base + arena_size * i,
+            .size = arena_size,
+        };
+
+    return true;
+}
+
+static
+void
+archi_thread_group_scratch_destroy(
+        archi_thread_group_t context)
+{
+    if (context->scratch_interface != NULL)
+    {
+        if ((context->scratch_map.mapping.ptr != NULL) && (context->scratch_interface->unmap_fn != NULL))
+            context->scratch_interface->unmap_fn(context->scratch_alloc, context->scratch_map);
+
+        if (context->scratch_interface->free_fn != NULL)
+            context->scratch_interface->free_fn(context->scratch_alloc);
+    }
+    else
+        free(context->scratch_alloc.allocation.ptr);
+
+    free(context->scratch);
+}
+
+archi_thread_group_t
+archi_thread_group_create(
+        archi_thread_group_start_params_t params,
+        ARCHI_ERROR_PARAM_DECL)
+{
+    size_t thread_idx = 0;
+    size_t *thread_cpu = NULL;
+
+    struct archi_thread_arg thread_arg;
+    bool thread_arg_initialized = false;
+
+    // Initialize threads context
+    archi_thread_group_t context = aligned_alloc(alignof(struct archi_thread_group),
+            ARCHI_THREAD_GROUP_ALIGNED_SIZE(sizeof(*context)));
+    if (context == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__EMEMORY, "couldn't allocate thread group context");
+        goto failure;
+    }
+
+    *context = (struct archi_thread_group){
+        .num_threads = params.num_threads,
+        .queue_capacity = (params.queue_capacity != 0) ? params.queue_capacity : 1,
+        .spin_ns = params.spin_ns,
+        .submit_lock = ATOMIC_FLAG_INIT,
+        .notify = {.read_fd = -1, .write_fd = -1},
+    };
+
+    atomic_init(&context->num_dispatches, 0);
+    atomic_init(&context->tail_ns, 0);
+    atomic_init(&context->max_tail_ns, 0);
+    atomic_init(&context->notify_pending, false);
+
+    // Create completion notification descriptor
+    if (params.notify)
+    {
+        if (!archi_thread_notify_open(&context->notify, ARCHI_ERROR_PARAM))
+            goto failure;
+    }
+
+    // Create scratch arenas
+    if (!archi_thread_group_scratch_create(context, params, ARCHI_ERROR_PARAM))
+        goto failure;
+
+    // Create utilization counters (the last ones are of helping threads)
+    if (params.stats)
+    {
+        context->counters = aligned_alloc(alignof(struct archi_thread_group_counters),
+                sizeof(*context->counters) * (params.num_threads + 1));
+        if (context->counters == NULL)
+        {
+            ARCHI_ERROR_SET(ARCHI__EMEMORY, "couldn't allocate array of utilization counters [%zu]",
+                    params.num_threads + 1);
+            goto failure;
+        }
+
+        for (size_t i = 0; i < params.num_threads + 1; i++)
+        {
+            atomic_init(&context->counters[i].num_work_items, 0);
+            atomic_init(&context->counters[i].num_batches, 0);
+            atomic_init(&context->counters[i].busy_ns, 0);
+            atomic_init(&context->counters[i].wait_ns, 0);
+            atomic_init(&context->counters[i].num_wakeups, 0);
+            atomic_init(&context->counters[i].wake_latency_ns, 0);
+            atomic_init(&context->counters[i].max_wake_latency_ns, 0);
+        }
+    }
+
+    if (params.num_threads > 0)
+    {
+        // Create mutexes and condition variables
+        int res;
+
+        res = mtx_init(&context->ping.mtx, mtx_plain);
+        if (res != thrd_success)
+        {
+            ARCHI_ERROR_SET(ARCHI__ESYSTEM, "couldn't initialize mutex");
+            goto failure;
+        }
+
+        res = cnd_init(&context->pong.cnd);
+        if (res != thrd_success)
+        {
+            if (res == thrd_nomem)
+                ARCHI_ERROR_SET(ARCHI__EMEMORY, "couldn't initialize condition variable");
+            else
+                ARCHI_ERROR_SET(ARCHI__ESYSTEM, "couldn't initialize condition variable");
+
+            mtx_destroy(&context->ping.mtx);
+            goto failure;
+        }
+
+        res = mtx_init(&context->pong.mtx, mtx_plain);
+        if (res != thrd_success)
+        {
+            ARCHI_ERROR_SET(ARCHI__ESYSTEM, "couldn't initialize mutex");
+
+            mtx_destroy(&context->ping.mtx);
+            cnd_destroy(&context->pong.cnd);
+            goto failure;
+        }
+
+        // Create per-thread condition variables to wait for work on
+        context->sleeper = aligned_alloc(alignof(struct archi_thread_group_sleeper),
+                sizeof(*context->sleeper) * params.num_threads);
+        if (context->sleeper == NULL)
+        {
+            ARCHI_ERROR_SET(ARCHI__EMEMORY, "couldn't allocate array of condition variables [%zu]",
+                    params.num_threads);
+            goto failure;
+        }
+
+        for (; context->num_sleepers < params.num_threads; context->num_sleepers++)
+        {
+            struct archi_thread_group_sleeper *sleeper = &context->sleeper[context->num_sleepers];
+
+            atomic_init(&sleeper->sleeping, false);
+
+            res = cnd_init(&sleeper->cnd);
+            if (res != thrd_success)
+            {
+                if (res == thrd_nomem)
+                    ARCHI_ERROR_SET(ARCHI__EMEMORY, "couldn't initialize condition variable");
+                else
+                    ARCHI_ERROR_SET(ARCHI__ESYSTEM, "couldn't initialize condition variable");
+
+                goto failure;
+            }
+        }
+
+        // Create threads
+        context->threads = malloc(sizeof(*context->threads) * params.num_threads);
+        if (context->threads == NULL)
+        {
+            ARCHI_ERROR_SET(ARCHI__EMEMORY, "couldn't allocate array of threads [%zu]", params.num_threads);
+            goto failure;
+        }
+
+        // Create the dispatch queue (with work item ranges for the helping thread)
+        if (context->queue_capacity > SIZE_MAX / sizeof(*context->range) / (params.num_threads + 1))
+        {
+            ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "dispatch queue capacity (%zu) is too large",
+                    context->queue_capacity);
+            goto failure;
+        }
+
+        context->range = aligned_alloc(alignof(struct archi_thread_group_range),
+                sizeof(*context->range) * context->queue_capacity * (params.num_threads + 1));
+        if (context->range == NULL)
+        {
+            ARCHI_ERROR_SET(ARCHI__EMEMORY, "couldn't allocate array of work item ranges [%zu]",
+                    context->queue_capacity * (params.num_threads + 1));
+            goto failure;
+        }
+
+        for (size_t i = 0; i < context->queue_capacity * (params.num_threads + 1); i++)
+        {
+            atomic_flag_clear_explicit(&context->range[i].lock, memory_order_relaxed);
+            atomic_init(&context->range[i].begin, 0);
+            atomic_init(&context->range[i].end, 0);
+        }
+
+        context->slot = aligned_alloc(alignof(struct archi_thread_group_slot),
+                sizeof(*context->slot) * context->queue_capacity);
+        if (context->slot == NULL)
+        {
+            ARCHI_ERROR_SET(ARCHI__EMEMORY, "couldn't allocate dispatch queue [%zu]", context->queue_capacity);
+            goto failure;
+        }
+
+        for (size_t i = 0; i < context->queue_capacity; i++)
+        {
+            context->slot[i].reduce = (struct archi_thread_group_reduce){0};
+
+            atomic_init(&context->slot[i].num_work_items_done, 0);
+            atomic_init(&context->slot[i].num_threads_done, 0);
+            atomic_init(&context->slot[i].work_time_ns, 0);
+            atomic_init(&context->slot[i].first_done_ns, 0);
+            atomic_init(&context->slot[i].ticket, 0);
+            atomic_init(&context->slot[i].num_participants, 0);
+            atomic_init(&context->slot[i].cancel, 0);
+            atomic_init(&context->slot[i].num_work_items_processed, 0);
+            atomic_init(&context->slot[i].phases.num_arrived, 0);
+            atomic_init(&context->slot[i].phases.sense, false);
+
+            context->slot[i].range = &context->range[i * (params.num_threads + 1)];
+        }
+
+        // Choose CPUs to pin threads to
+        archi_error_t error;
+        ARCHI_ERROR_VAR_UNSET(&error);
+
+        thread_cpu = archi_thread_affinity_plan(params, &error);
+        if (error.code != 0)
+        {
+            ARCHI_ERROR_ASSIGN(error);
+            goto failure;
+        }
+    }
+
+    if (params.num_threads > 0)
+    {
+        if (mtx_init(&thread_arg.mtx, mtx_plain) != thrd_success)
+        {
+            ARCHI_ERROR_SET(ARCHI__ESYSTEM, "couldn't initialize mutex");
+            goto failure;
+        }
+
+        if (cnd_init(&thread_arg.cnd) != thrd_success)
+        {
+            ARCHI_ERROR_SET(ARCHI__ESYSTEM, "couldn't initialize condition variable");
+
+            mtx_destroy(&thread_arg.mtx);
+            goto failure;
+        }
+
+        thread_arg_initialized = true;
+    }
+
+    for (; thread_idx < params.num_threads; thread_idx++)
+    {
+        thread_arg.context = context;
+        thread_arg.thread_idx = thread_idx;
+        thread_arg.cpu = (thread_cpu != NULL) ? thread_cpu[thread_idx] : SIZE_MAX;
+        thread_arg.status = 0;
+
+        int res = thrd_create(&context->threads[thread_idx], archi_thread, &thread_arg);
+        if (res != thrd_success)
+        {
+            if (res == thrd_nomem)
+                ARCHI_ERROR_SET(ARCHI__EMEMORY, "couldn't create thread #%zu", thread_idx);
+            else
+                ARCHI_ERROR_SET(ARCHI__ESYSTEM, "couldn't create thread #%zu", thread_idx);
+
+            goto failure;
+        }
+
+        // Wait until the thread is started and pinned
+        mtx_lock(&thread_arg.mtx);
+        while (thread_arg.status == 0)
+            cnd_wait(&thread_arg.cnd, &thread_arg.mtx);
+        mtx_unlock(&thread_arg.mtx);
+
+        if (thread_arg.status < 0)
+        {
+            ARCHI_ERROR_SET(ARCHI__ESYSTEM, "couldn't pin thread #%zu to CPU %zu",
+                    thread_idx, thread_cpu[thread_idx]);
+
+            thrd_join(context->threads[thread_idx], NULL);
+            goto failure;
+        }
+    }
+
+    if (thread_arg_initialized)
+    {
+        mtx_destroy(&thread_arg.mtx);
+        cnd_destroy(&thread_arg.cnd);
+    }
+
+    free(thread_cpu);
+
+    ARCHI_ERROR_RESET();
+    return context;
+
+failure:
+    if (thread_arg_initialized)
+    {
+        mtx_destroy(&thread_arg.mtx);
+        cnd_destroy(&thread_arg.cnd);
+    }
+
+    free(thread_cpu);
+
+    if (context != NULL)
+    {
+        context->num_threads = thread_idx; // number of created threads
+        archi_thread_group_destroy(context);
+    }
+
+    return NULL;
+}
+
+void
+archi_thread_group_destroy(
+        archi_thread_group_t context)
+{
+    if (context == NULL)
+        return;
+
+    if (context->num_threads > 0)
+    {
+        // Prevent further enqueueing
+        while (atomic_flag_test_and_set_explicit(&context->submit_lock, memory_order_acquire))
+            thrd_yield();
+
+        // Wait until all dispatches are completed
+        archi_thread_group_wait(context);
+
+        // Set stop signal for all threads
+        size_t ticket = atomic_load_explicit(&context->ping.count, memory_order_relaxed) + 1;
+
+        archi_thread_group_slot_post(context, &context->slot[(ticket - 1) % context->queue_capacity],
+                &(struct archi_thread_group_dispatch){.num_participants = context->num_threads}, ticket);
+    }
+
+    // Join threads and free memory
+    for (size_t i = 0; i < context->num_threads; i++)
+        thrd_join(context->threads[i], (int*)NULL);
+
+    free(context->threads);
+
+    if (context->slot != NULL)
+    {
+        for (size_t i = 0; i < context->queue_capacity; i++)
+            free(context->slot[i].reduce.accumulator);
+
+        free(context->slot);
+    }
+    free(context->range);
+
+    archi_thread_group_scratch_destroy(context);
+    free(context->counters);
+
+    if (context->notify.read_fd >= 0)
+        archi_thread_notify_close(&context->notify);
+
+    // Destroy mutexes, condition variables, and free memory
+    for (size_t i = 0; i < context->num_sleepers; i++)
+        cnd_destroy(&context->sleeper[i].cnd);
+
+    free(context->sleeper);
+
+    if (context->num_threads > 0)
+    {
+        mtx_destroy(&context->ping.mtx);
+        cnd_destroy(&context->pong.cnd);
+        mtx_destroy(&context->pong.mtx);
+    }
+
+    free(context);
+}
+
+static
+bool
+archi_thread_group_schedule_valid(
+        archi_thread_group_schedule_t schedule)
+{
+    switch (schedule)
+    {
+        case ARCHI_THREAD_GROUP_SCHEDULE__SHARED:
+        case ARCHI_THREAD_GROUP_SCHEDULE__STEAL:
+        case ARCHI_THREAD_GROUP_SCHEDULE__GUIDED:
+        case ARCHI_THREAD_GROUP_SCHEDULE__ADAPTIVE:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+static
+archi_thread_group_adaptive_key_t
+archi_thread_group_adaptive_key(
+        archi_thread_group_work_t work,
+        const struct archi_thread_group_tiling *tiling,
+        const archi_thread_group_reduction_t *reduction,
+        const archi_thread_group_phase_work_t *phases)
+{
+    // Work functions are substituted by adapters, so measure costs of the original functions
+    if (tiling != NULL)
+        return (archi_thread_group_adaptive_key_t)tiling->work.function;
+    else if (reduction != NULL)
+        return (archi_thread_group_adaptive_key_t)reduction->accumulate;
+    else if (phases != NULL)
+        return (archi_thread_group_adaptive_key_t)phases->function;
+    else
+        return (archi_thread_group_adaptive_key_t)work.function;
+}
+
+static
+size_t
+archi_thread_group_adaptive_find(
+        archi_thread_group_t context,
+        archi_thread_group_adaptive_key_t function)
+{
+    // Find the work function entry, or replace the oldest one
+    size_t adaptive_entry = 0;
+
+    for (; adaptive_entry < ARCHI_THREAD_GROUP_ADAPTIVE_NUM_ENTRIES; adaptive_entry++)
+        if (context->adaptive[adaptive_entry].function == function)
+            return adaptive_entry;
+
+    adaptive_entry = context->adaptive_next;
+    context->adaptive_next = (adaptive_entry + 1) % ARCHI_THREAD_GROUP_ADAPTIVE_NUM_ENTRIES;
+
+    context->adaptive[adaptive_entry].function = function;
+    atomic_store_explicit(&context->adaptive[adaptive_entry].item_ns, 0, memory_order_relaxed);
+
+    return adaptive_entry;
+}
+
+static
+size_t
+archi_thread_group_adaptive_threads(
+        archi_thread_group_t context,
+        const struct archi_thread_group_adaptive_entry *entry,
+        size_t num_work_items,
+        size_t num_phases)
+{
+    uint64_t item_ns = atomic_load_explicit(&entry->item_ns, memory_order_relaxed);
+
+    // Use all threads if the cost is not measured yet, or the work is too large to estimate
+    if ((item_ns == 0) || (num_work_items > UINT64_MAX / item_ns / num_phases))
+        return context->num_threads;
+
+    // Wake only threads that have enough work to outweigh the cost of waking
+    uint64_t num_threads = item_ns * num_work_items * num_phases / ARCHI_THREAD_GROUP_ADAPTIVE_THREAD_NS;
+
+    return (num_threads < context->num_threads) ? num_threads : context->num_threads;
+}
+
+static
+size_t
+archi_thread_group_start(
+        archi_thread_group_t context,
+
+        archi_thread_group_work_t work,
+        archi_thread_group_callback_t callback,
+
+        archi_thread_group_dispatch_params_t params,
+        const struct archi_thread_group_tiling *tiling,
+        const archi_thread_group_reduction_t *reduction,
+        const archi_thread_group_phase_work_t *phases,
+        size_t after,
+        size_t num_participants,
+        size_t adaptive_entry)
+{
+    ARCHI_TRACE_EVENT(ARCHI_TRACE__DISPATCH, "dispatch", context, params.size);
+
+    size_t ticket = atomic_load_explicit(&context->ping.count, memory_order_relaxed) + 1;
+    struct archi_thread_group_slot *slot = &context->slot[(ticket - 1) % context->queue_capacity];
+
+    // Store the tiling in the slot
+    if (tiling != NULL)
+    {
+        slot->tiling = *tiling;
+        work = (archi_thread_group_work_t){.function = archi_thread_group_work__tile, .data = &slot->tiling};
+    }
+
+    // Store the reduction in the slot (accumulators are reserved beforehand)
+    if (reduction != NULL)
+    {
+        slot->reduce.reduction = *reduction;
+        work = (archi_thread_group_work_t){.function = archi_thread_group_work__reduce, .data = &slot->reduce};
+    }
+
+    // Store the multi-phase work in the slot
+    if (phases != NULL)
+    {
+        slot->phases.work = *phases;
+        slot->phases.phase = 0;
+        slot->phases.stop = false;
+
+        atomic_store_explicit(&slot->phases.num_arrived, 0, memory_order_relaxed);
+        atomic_store_explicit(&slot->phases.sense, false, memory_order_relaxed);
+
+        work = (archi_thread_group_work_t){.function = archi_thread_group_work__phase, .data = &slot->phases};
+    }
+
+    // Calculate batch size if it's not specified
+    switch (params.schedule)
+    {
+        case ARCHI_THREAD_GROUP_SCHEDULE__STEAL:
+            if (params.batch_size == 0)
+                params.batch_size = 1 + (params.size - 1) / (8 * num_participants);
+            break;
+
+        case ARCHI_THREAD_GROUP_SCHEDULE__GUIDED:
+            if (params.batch_size == 0)
+                params.batch_size = 1;
+            break;
+
+        case ARCHI_THREAD_GROUP_SCHEDULE__ADAPTIVE:
+            {
+                size_t max_batch_size = 1 + (params.size - 1) / num_participants;
+                size_t batch_size;
+
+                uint64_t item_ns = atomic_load_explicit(&context->adaptive[adaptive_entry].item_ns,
+                        memory_order_relaxed);
+                if (item_ns != 0) // make a batch take the target time
+                    batch_size = (ARCHI_THREAD_GROUP_ADAPTIVE_BATCH_NS / item_ns < max_batch_size) ?
+                        ARCHI_THREAD_GROUP_ADAPTIVE_BATCH_NS / item_ns : max_batch_size;
+                else // cost is not measured yet
+                    batch_size = 1 + (params.size - 1) / (8 * num_participants);
+
+                if (batch_size < params.batch_size)
+                    batch_size = params.batch_size;
+                if (batch_size == 0)
+                    batch_size = 1;
+
+                params.batch_size = batch_size;
+            }
+            break;
+
+        default:
+            if (params.batch_size == 0)
+                params.batch_size = 1 + (params.size - 1) / num_participants;
+    }
+
+    if (params.schedule == ARCHI_THREAD_GROUP_SCHEDULE__STEAL)
+        archi_thread_group_range_split(slot, params.size, num_participants);
+
+    // Initialize counters
+    atomic_store_explicit(&slot->num_work_items_done, 0, memory_order_relaxed);
+    atomic_store_explicit(&slot->num_threads_done, 0, memory_order_relaxed);
+    atomic_store_explicit(&slot->work_time_ns, 0, memory_order_relaxed);
+    atomic_store_explicit(&slot->first_done_ns, 0, memory_order_relaxed);
+    atomic_store_explicit(&slot->num_work_items_processed, 0, memory_order_relaxed);
+
+    // Assign the work and wake slave threads
+    struct archi_thread_group_dispatch dispatch = {
+        .work = work,
+        .callback = callback,
+        .params = params,
+        .ticket = ticket,
+        .after = after,
+        .num_participants = num_participants,
+        .adaptive_entry = adaptive_entry,
+        .reduce = (reduction != NULL),
+        .phased = (phases != NULL),
+        .enqueue_ns = (context->counters != NULL) ? archi_thread_group_time_ns() : 0,
+    };
+
+    archi_thread_group_slot_post(context, slot, &dispatch, ticket);
+
+    return ticket;
+}
+
+static
+size_t
+archi_thread_group_run(
+        archi_thread_group_t context,
+
+        archi_thread_group_work_t work,
+        archi_thread_group_callback_t callback,
+
+        archi_thread_group_dispatch_params_t params,
+        const struct archi_thread_group_tiling *tiling,
+        const archi_thread_group_reduction_t *reduction,
+        const archi_thread_group_phase_work_t *phases,
+        struct archi_thread_group_adaptive_entry *entry)
+{
+    ARCHI_TRACE_EVENT(ARCHI_TRACE__DISPATCH, "dispatch", context, params.size);
+
+    size_t thread_idx = context->num_threads; // the calling thread works as a helping one
+    size_t ticket;
+
+    // Let work functions cancel the dispatch
+    atomic_size_t local_cancel;
+    atomic_size_t *cancel;
+
+    if (context->num_threads == 0)
+    {
+        ticket = atomic_fetch_add_explicit(&context->ping.count, 1, memory_order_relaxed) + 1;
+
+        atomic_init(&local_cancel, 0);
+        cancel = &local_cancel;
+    }
+    else
+    {
+        // Let slave threads skip the dispatch without waking them
+        ticket = atomic_load_explicit(&context->ping.count, memory_order_relaxed) + 1;
+        struct archi_thread_group_slot *slot = &context->slot[(ticket - 1) % context->queue_capacity];
+
+        archi_thread_group_slot_post(context, slot, &(struct archi_thread_group_dispatch){.ticket = ticket}, ticket);
+
+        cancel = &slot->cancel;
+    }
+
+    if (tiling != NULL)
+        work = (archi_thread_group_work_t){.function = archi_thread_group_work__tile, .data = (void*)tiling};
+
+    // Accumulate directly into the result, as there is only one thread
+    struct archi_thread_group_reduce reduce;
+
+    if (reduction != NULL)
+    {
+        reduce = (struct archi_thread_group_reduce){
+            .reduction = *reduction,
+            .accumulator = reduction->result,
+        };
+
+        memmove(reduction->result, reduction->identity, reduction->value_size);
+        work = (archi_thread_group_work_t){.function = archi_thread_group_work__reduce, .data = &reduce};
+    }
+
+    struct archi_thread_group_phases phased;
+    if (phases != NULL)
+    {
+        phased = (struct archi_thread_group_phases){.work = *phases};
+        work = (archi_thread_group_work_t){.function = archi_thread_group_work__phase, .data = &phased};
+    }
+
+    // Use the scratch arena of the calling thread
+    struct archi_thread_group_scratch *scratch = archi_thread_group_scratch_current;
+    if (context->scratch != NULL)
+    {
+        archi_thread_group_scratch_current = &context->scratch[thread_idx];
+        context->scratch[thread_idx].used = 0;
+    }
+
+    ARCHI_TRACE_EVENT(ARCHI_TRACE__WORK_BEGIN, "work", context, thread_idx);
+
+    bool timed = (entry != NULL) || (context->counters != NULL);
+    uint64_t start_ns = timed ? archi_thread_group_time_ns() : 0;
+
+    atomic_size_t *prev_cancel = archi_thread_group_cancel_current;
+    size_t prev_cancel_ticket = archi_thread_group_cancel_ticket;
+
+    archi_thread_group_cancel_current = cancel;
+    archi_thread_group_cancel_ticket = ticket;
+
+    size_t num_work_items_processed = 0; // in the last phase
+    size_t num_work_items = 0; // in all phases
+
+    for (size_t phase = 0;; phase++)
+    {
+        if (phases != NULL)
+            phased.phase = phase;
+
+        for (num_work_items_processed = 0; (num_work_items_processed < params.size) &&
+                !archi_thread_group_cancel_check(cancel, ticket); num_work_items_processed++)
+            work.function(work.data, params.offset + num_work_items_processed, thread_idx);
+
+        num_work_items += num_work_items_processed;
+
+        if ((phases == NULL) || (phase + 1 == phases->num_phases) ||
+                archi_thread_group_cancel_check(cancel, ticket))
+            break;
+    }
+
+    uint64_t end_ns = timed ? archi_thread_group_time_ns() : 0;
+
+    ARCHI_TRACE_EVENT(ARCHI_TRACE__WORK_END, "work", context, thread_idx);
+
+    // Update the measured cost of a work item
+    if (entry != NULL)
+        archi_thread_group_adaptive_update(entry, end_ns - start_ns, num_work_items);
+
+    // Update utilization counters
+    if (context->counters != NULL)
+    {
+        atomic_fetch_add_explicit(&context->counters[thread_idx].num_work_items, num_work_items,
+                memory_order_relaxed);
+        atomic_fetch_add_explicit(&context->counters[thread_idx].num_batches, 1, memory_order_relaxed);
+        atomic_fetch_add_explicit(&context->counters[thread_idx].busy_ns, end_ns - start_ns,
+                memory_order_relaxed);
+
+        atomic_fetch_add_explicit(&context->num_dispatches, 1, memory_order_relaxed);
+    }
+
+    if (callback.function != NULL)
+        callback.function(callback.data, params.offset, num_work_items_processed, thread_idx);
+
+    ARCHI_TRACE_EVENT(ARCHI_TRACE__COMPLETE, "complete", context, thread_idx);
+
+    archi_thread_group_cancel_current = prev_cancel;
+    archi_thread_group_cancel_ticket = prev_cancel_ticket;
+
+    archi_thread_group_scratch_current = scratch;
+
+    // Update pong counter and wake waiting threads
+    if (context->num_threads == 0)
+        atomic_fetch_add_explicit(&context->pong.count, 1, memory_order_relaxed);
+    else
+        archi_thread_group_signal_set(&context->pong, ticket);
+
+    archi_thread_group_notify(context);
+
+    return ticket;
+}
+
+static
+size_t
+archi_thread_group_submit(
+        archi_thread_group_t context,
+
+        archi_thread_group_work_t work,
+        archi_thread_group_callback_t callback,
+
+        archi_thread_group_dispatch_params_t params,
+        const struct archi_thread_group_tiling *tiling,
+        const archi_thread_group_reduction_t *reduction,
+        const archi_thread_group_phase_work_t *phases,
+        size_t after,
+        bool if_idle,
+        bool help,
+        ARCHI_ERROR_PARAM_DECL)
+{
+    ARCHI_ERROR_RESET();
+
+    // Do all the work in this thread if there are no slave threads
+    if (context->num_threads == 0)
+        return archi_thread_group_run(context, work, callback, params, tiling, reduction, phases, NULL);
+
+    // Fail if another thread is enqueueing
+    if (atomic_flag_test_and_set_explicit(&context->submit_lock, memory_order_acquire))
+        return 0;
+
+    size_t num_enqueued = atomic_load_explicit(&context->ping.count, memory_order_relaxed);
+    size_t num_completed = atomic_load_explicit(&context->pong.count, memory_order_acquire);
+
+    // Fail if slave threads are busy or the queue is full
+    size_t ticket = 0;
+
+    if (if_idle ? (num_enqueued == num_completed) :
+            (num_enqueued - num_completed < context->queue_capacity))
+    {
+        size_t num_participants = context->num_threads + (help ? 1 : 0);
+        size_t adaptive_entry = 0;
+
+        // Choose the number of threads by the measured cost of work
+        if (params.schedule == ARCHI_THREAD_GROUP_SCHEDULE__ADAPTIVE)
+        {
+            adaptive_entry = archi_thread_group_adaptive_find(context,
+                    archi_thread_group_adaptive_key(work, tiling, reduction, phases));
+
+            if (!help)
+                num_participants = archi_thread_group_adaptive_threads(context,
+                        &context->adaptive[adaptive_entry], params.size,
+                        (phases != NULL) ? phases->num_phases : 1);
+        }
+
+        if ((num_participants == 0) && (num_enqueued == num_completed))
+        {
+            // Do small work in this thread, holding the lock so that dispatches complete in order
+            ticket = archi_thread_group_run(context, work, callback, params, tiling, reduction, phases,
+                    &context->adaptive[adaptive_entry]);
+        }
+        else
+        {
+            if (num_participants == 0) // preceding dispatches must complete first
+                num_participants = 1;
+
+            // Slot of the new dispatch is free, so its accumulators can be reallocated
+            if ((reduction == NULL) || archi_thread_group_reduce_reserve(
+                        &context->slot[num_enqueued % context->queue_capacity].reduce,
+                        reduction->value_size, context->num_threads + (help ? 1 : 0), ARCHI_ERROR_PARAM))
+                ticket = archi_thread_group_start(context, work, callback, params,
+                        tiling, reduction, phases, after, num_participants, adaptive_entry);
+        }
+    }
+
+    atomic_flag_clear_explicit(&context->submit_lock, memory_order_release);
+
+    return ticket;
+}
+
+static
+bool
+archi_thread_group_check(
+        archi_thread_group_t context,
+        archi_thread_group_work_t work,
+        archi_thread_group_dispatch_params_t params,
+        ARCHI_ERROR_PARAM_DECL)
+{
+    if (context == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "thread group context is NULL");
+        return false;
+    }
+    else if (work.function == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "thread group work function is NULL");
+        return false;
+    }
+    else if (params.offset + params.size < params.offset)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "thread group work offset+size overflows size_t");
+        return false;
+    }
+    else if (!archi_thread_group_schedule_valid(params.schedule))
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "unknown thread group scheduling policy (%i)", (int)params.schedule);
+        return false;
+    }
+
+    return true;
+}
+
+bool
+archi_thread_group_dispatch(
+        archi_thread_group_t context,
+
+        archi_thread_group_work_t work,
+        archi_thread_group_callback_t callback,
+
+        archi_thread_group_dispatch_params_t params,
+        ARCHI_ERROR_PARAM_DECL)
+{
+    if (!archi_thread_group_check(context, work, params, ARCHI_ERROR_PARAM))
+        return false;
+
+    // Check if there is nothing to do
+    if (params.size == 0)
     {
-        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "thread group work function is NULL");
+        ARCHI_ERROR_RESET();
+        return true;
+    }
+
+    size_t ticket = archi_thread_group_submit(context, work, callback, params,
+            NULL, NULL, NULL, 0, true, false, ARCHI_ERROR_PARAM);
+
+    return ticket != 0;
+}
+
+bool
+archi_thread_group_dispatch_help(
+        archi_thread_group_t context,
+
+        archi_thread_group_work_t work,
+        archi_thread_group_callback_t callback,
+
+        archi_thread_group_dispatch_params_t params,
+        ARCHI_ERROR_PARAM_DECL)
+{
+    if (!archi_thread_group_check(context, work, params, ARCHI_ERROR_PARAM))
         return false;
+
+    // Check if there is nothing to do
+    if (params.size == 0)
+    {
+        ARCHI_ERROR_RESET();
+        return true;
     }
-    else if (params.offset + params.size < params.offset)
+
+    size_t ticket = archi_thread_group_submit(context, work, callback, params,
+            NULL, NULL, NULL, 0, true, true, ARCHI_ERROR_PARAM);
+
+    if ((ticket != 0) && (context->num_threads > 0))
     {
-        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "thread group work offset+size overflows size_t");
+        struct archi_thread_group_slot *slot = &context->slot[(ticket - 1) % context->queue_capacity];
+        struct archi_thread_group_dispatch dispatch = slot->dispatch;
+
+        // Process work items along with slave threads
+        struct archi_thread_group_scratch *scratch = archi_thread_group_scratch_current;
+        if (context->scratch != NULL)
+            archi_thread_group_scratch_current = &context->scratch[context->num_threads];
+
+        archi_thread_group_process(context, slot, &dispatch, ticket, context->num_threads);
+
+        archi_thread_group_scratch_current = scratch;
+
+        // Wait for the remaining threads
+        archi_thread_group_wait_ticket(context, ticket, NULL);
+    }
+
+    return ticket != 0;
+}
+
+size_t
+archi_thread_group_enqueue(
+        archi_thread_group_t context,
+
+        archi_thread_group_work_t work,
+        archi_thread_group_callback_t callback,
+
+        archi_thread_group_dispatch_params_t params,
+        size_t after,
+        ARCHI_ERROR_PARAM_DECL)
+{
+    if (!archi_thread_group_check(context, work, params, ARCHI_ERROR_PARAM))
+        return 0;
+
+    // Tickets only grow, so a valid dependency can't become invalid
+    if (after > atomic_load_explicit(&context->ping.count, memory_order_relaxed))
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "thread group dispatch dependency (%zu) is not enqueued yet", after);
+        return 0;
+    }
+
+    return archi_thread_group_submit(context, work, callback, params,
+            NULL, NULL, NULL, after, false, false, ARCHI_ERROR_PARAM);
+}
+
+bool
+archi_thread_group_dispatch_tiled(
+        archi_thread_group_t context,
+
+        archi_thread_group_tile_work_t work,
+        archi_thread_group_callback_t callback,
+
+        archi_thread_group_tiled_dispatch_params_t params,
+        ARCHI_ERROR_PARAM_DECL)
+{
+    if (context == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "thread group context is NULL");
+        return false;
+    }
+    else if (work.function == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "thread group tile work function is NULL");
+        return false;
+    }
+    else if ((params.order != ARCHI_THREAD_GROUP_TILE_ORDER__ROW_MAJOR) &&
+            (params.order != ARCHI_THREAD_GROUP_TILE_ORDER__MORTON))
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "unknown thread group tile order (%i)", (int)params.order);
+        return false;
+    }
+    else if (!archi_thread_group_schedule_valid(params.schedule))
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "unknown thread group scheduling policy (%i)", (int)params.schedule);
         return false;
     }
 
     // Check if there is nothing to do
-    if (params.size == 0)
+    if ((params.size[0] == 0) || (params.size[1] == 0) || (params.size[2] == 0))
     {
         ARCHI_ERROR_RESET();
         return true;
     }
 
-    if (context->num_threads > 0)
+    // Split the domain into tiles
+    struct archi_thread_group_tiling tiling = {
+        .work = work,
+        .order = params.order,
+    };
+
+    size_t num_work_items = 1;
+    unsigned total_bits = 0;
+
+    for (size_t d = 0; d < 3; d++)
     {
-        // Fail if slave threads are busy
-        if (atomic_flag_test_and_set_explicit(&context->busy, memory_order_relaxed))
+        tiling.size[d] = params.size[d];
+        tiling.tile_size[d] = ((params.tile_size[d] != 0) && (params.tile_size[d] < tiling.size[d])) ?
+            params.tile_size[d] : tiling.size[d];
+        tiling.num_tiles[d] = 1 + (tiling.size[d] - 1) / tiling.tile_size[d];
+
+        if (params.order == ARCHI_THREAD_GROUP_TILE_ORDER__MORTON)
         {
-            ARCHI_ERROR_RESET();
-            return false;
+            while (((size_t)1 << tiling.num_bits[d]) < tiling.num_tiles[d])
+                tiling.num_bits[d]++;
+
+            total_bits += tiling.num_bits[d];
+        }
+        else
+        {
+            if (num_work_items > SIZE_MAX / tiling.num_tiles[d])
+            {
+                ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "number of tiles overflows size_t");
+                return false;
+            }
+
+            num_work_items *= tiling.num_tiles[d];
         }
+    }
 
+    if (params.order == ARCHI_THREAD_GROUP_TILE_ORDER__MORTON)
+    {
+        if (total_bits >= sizeof(size_t) * CHAR_BIT)
         {
-            MTX_LOCK(context->ping.mtx);
-            MTX_LOCK(context->pong.mtx);
+            ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "number of tiles overflows size_t");
+            return false;
+        }
 
-            // Calculate batch size if it's not specified
-            if (params.batch_size == 0)
-                params.batch_size = 1 + (params.size - 1) / context->num_threads;
+        num_work_items = (size_t)1 << total_bits;
+    }
 
-            // Assign the work
-            context->dispatch = (struct archi_thread_group_dispatch){
-                .work = work,
-                .callback = callback,
-                .params = params,
-            };
+    archi_thread_group_dispatch_params_t dispatch_params = {
+        .size = num_work_items,
+        .batch_size = params.batch_size,
+        .schedule = params.schedule,
+    };
 
-            // Initialize counters
-            atomic_store_explicit(&context->num_work_items_done, 0, memory_order_relaxed);
-            atomic_store_explicit(&context->num_threads_done, 0, memory_order_relaxed);
+    size_t ticket = archi_thread_group_submit(context, (archi_thread_group_work_t){0},
+            callback, dispatch_params, &tiling, NULL, NULL, 0, true, false, ARCHI_ERROR_PARAM);
 
-            // Toggle flag sense
-            context->ping.sense = !context->ping.sense;
-            context->pong.sense = !context->pong.sense;
+    return ticket != 0;
+}
 
-            // Update ping flag
-            context->ping.flag = context->ping.sense;
+bool
+archi_thread_group_dispatch_reduce(
+        archi_thread_group_t context,
 
-            MTX_UNLOCK(context->pong.mtx);
-            MTX_UNLOCK(context->ping.mtx);
-        }
+        archi_thread_group_reduction_t reduction,
+        archi_thread_group_callback_t callback,
 
-        // Wake slave threads
-        CND_BROADCAST(context->ping.cnd);
+        archi_thread_group_dispatch_params_t params,
+        ARCHI_ERROR_PARAM_DECL)
+{
+    if (reduction.accumulate == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "thread group reduction accumulation function is NULL");
+        return false;
+    }
+    else if (reduction.combine == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "thread group reduction combination function is NULL");
+        return false;
+    }
+    else if (reduction.value_size == 0)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "thread group reduction value size is zero");
+        return false;
+    }
+    else if ((reduction.identity == NULL) || (reduction.result == NULL))
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "thread group reduction identity value or result location is NULL");
+        return false;
     }
-    else // do all the work in this thread
+
+    // The work function is substituted by an adapter, check the remaining parameters
+    if (!archi_thread_group_check(context, (archi_thread_group_work_t){
+                .function = archi_thread_group_work__reduce}, params, ARCHI_ERROR_PARAM))
+        return false;
+
+    // Check if there is nothing to do
+    if (params.size == 0)
     {
-        for (size_t work_item_idx = 0; work_item_idx < params.size; work_item_idx++)
-            work.function(work.data, params.offset + work_item_idx, 0);
+        memmove(reduction.result, reduction.identity, reduction.value_size);
 
-        if (callback.function != NULL)
-            callback.function(callback.data, params.offset, params.size, 0);
+        ARCHI_ERROR_RESET();
+        return true;
     }
 
-    ARCHI_ERROR_RESET();
-    return true;
+    size_t ticket = archi_thread_group_submit(context, (archi_thread_group_work_t){0},
+            callback, params, NULL, &reduction, NULL, 0, true, false, ARCHI_ERROR_PARAM);
+
+    return ticket != 0;
+}
+
+bool
+archi_thread_group_dispatch_phased(
+        archi_thread_group_t context,
+
+        archi_thread_group_phase_work_t work,
+        archi_thread_group_callback_t callback,
+
+        archi_thread_group_dispatch_params_t params,
+        ARCHI_ERROR_PARAM_DECL)
+{
+    if (work.function == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "thread group multi-phase work function is NULL");
+        return false;
+    }
+
+    // The work function is substituted by an adapter, check the remaining parameters
+    if (!archi_thread_group_check(context, (archi_thread_group_work_t){
+                .function = archi_thread_group_work__phase}, params, ARCHI_ERROR_PARAM))
+        return false;
+
+    // Check if there is nothing to do
+    if ((params.size == 0) || (work.num_phases == 0))
+    {
+        ARCHI_ERROR_RESET();
+        return true;
+    }
+
+    size_t ticket = archi_thread_group_submit(context, (archi_thread_group_work_t){0},
+            callback, params, NULL, NULL, &work, 0, true, false, ARCHI_ERROR_PARAM);
+
+    return ticket != 0;
 }
 
 void
@@ -485,15 +2387,11 @@ archi_thread_group_wait(
     if (context == NULL)
         return;
 
-    {
-        MTX_LOCK(context->pong.mtx);
-
-        bool pong_sense = context->pong.sense;
-        while (context->pong.flag != pong_sense)
-            CND_WAIT(context->pong.cnd, context->pong.mtx);
+    if (context->num_threads == 0)
+        return;
 
-        MTX_UNLOCK(context->pong.mtx);
-    }
+    size_t num_enqueued = atomic_load_explicit(&context->ping.count, memory_order_acquire);
+    archi_thread_group_signal_wait(&context->pong, num_enqueued, context->spin_ns, NULL);
 }
 
 void
@@ -510,15 +2408,213 @@ archi_thread_group_wait_until(
         return;
     }
 
+    if (context->num_threads == 0)
+        return;
+
+    size_t num_enqueued = atomic_load_explicit(&context->ping.count, memory_order_acquire);
+    archi_thread_group_signal_wait(&context->pong, num_enqueued, context->spin_ns, time_point);
+}
+
+void
+archi_thread_group_wait_ticket(
+        archi_thread_group_t context,
+        size_t ticket,
+        const struct timespec *time_point)
+{
+    if (context == NULL)
+        return;
+
+    if ((context->num_threads == 0) || (ticket == 0))
+        return;
+
+    archi_thread_group_signal_wait(&context->pong, ticket, context->spin_ns, time_point);
+}
+
+void
+archi_thread_group_cancel(
+        archi_thread_group_t context,
+        size_t ticket)
+{
+    if (context == NULL)
+        return;
+
+    if (context->num_threads == 0)
+        return;
+
+    size_t num_enqueued = atomic_load_explicit(&context->ping.count, memory_order_acquire);
+    size_t num_completed = atomic_load_explicit(&context->pong.count, memory_order_acquire);
+
+    if (ticket == 0)
+    {
+        // Cancel all incomplete dispatches
+        for (ticket = num_completed + 1; ticket - 1 != num_enqueued; ticket++)
+            archi_thread_group_cancel_set(&context->slot[(ticket - 1) % context->queue_capacity].cancel, ticket);
+    }
+    else if ((ticket - num_completed - 1) < (num_enqueued - num_completed)) // the dispatch is incomplete
+        archi_thread_group_cancel_set(&context->slot[(ticket - 1) % context->queue_capacity].cancel, ticket);
+}
+
+void
+archi_thread_group_cancel_current_dispatch(void)
+{
+    if (archi_thread_group_cancel_current != NULL)
+        archi_thread_group_cancel_set(archi_thread_group_cancel_current, archi_thread_group_cancel_ticket);
+}
+
+bool
+archi_thread_group_current_dispatch_cancelled(void)
+{
+    if (archi_thread_group_cancel_current == NULL)
+        return false;
+
+    return archi_thread_group_cancel_check(archi_thread_group_cancel_current, archi_thread_group_cancel_ticket);
+}
+
+void*
+archi_thread_group_scratch_alloc(
+        size_t num_bytes,
+        size_t alignment)
+{
+    struct archi_thread_group_scratch *scratch = archi_thread_group_scratch_current;
+    if (scratch == NULL)
+        return NULL;
+
+    if (alignment == 0)
+        alignment = 1;
+    else if ((alignment & (alignment - 1)) != 0)
+        return NULL;
+
+    // Pad the current position to the alignment
+    size_t padding = -(uintptr_t)(scratch->base + scratch->used) & (alignment - 1);
+
+    if ((padding > scratch->size - scratch->used) ||
+            (num_bytes > scratch->size - scratch->used - padding))
+        return NULL;
+
+    void *ptr = scratch->base + scratch->used + padding;
+    scratch->used += padding + num_bytes;
+
+    return ptr;
+}
+
+size_t
+archi_thread_group_scratch_mark(void)
+{
+    struct archi_thread_group_scratch *scratch = archi_thread_group_scratch_current;
+    if (scratch == NULL)
+        return 0;
+
+    return scratch->used;
+}
+
+void
+archi_thread_group_scratch_rewind(
+        size_t mark)
+{
+    struct archi_thread_group_scratch *scratch = archi_thread_group_scratch_current;
+    if (scratch == NULL)
+        return;
+
+    if (mark < scratch->used)
+        scratch->used = mark;
+}
+
+bool
+archi_thread_group_stats(
+        archi_thread_group_t context,
+        archi_thread_group_stats_t *stats)
+{
+    if ((context == NULL) || (context->counters == NULL) || (stats == NULL))
+        return false;
+
+    *stats = (archi_thread_group_stats_t){
+        .num_dispatches = atomic_load_explicit(&context->num_dispatches, memory_order_relaxed),
+        .tail_ns = atomic_load_explicit(&context->tail_ns, memory_order_relaxed),
+        .max_tail_ns = atomic_load_explicit(&context->max_tail_ns, memory_order_relaxed),
+    };
+
+    return true;
+}
+
+bool
+archi_thread_group_thread_stats(
+        archi_thread_group_t context,
+        size_t thread_idx,
+        archi_thread_group_thread_stats_t *stats)
+{
+    if ((context == NULL) || (context->counters == NULL) || (stats == NULL))
+        return false;
+    else if (thread_idx > context->num_threads)
+        return false;
+
+    struct archi_thread_group_counters *counters = &context->counters[thread_idx];
+
+    *stats = (archi_thread_group_thread_stats_t){
+        .num_work_items = atomic_load_explicit(&counters->num_work_items, memory_order_relaxed),
+        .num_batches = atomic_load_explicit(&counters->num_batches, memory_order_relaxed),
+        .busy_ns = atomic_load_explicit(&counters->busy_ns, memory_order_relaxed),
+        .wait_ns = atomic_load_explicit(&counters->wait_ns, memory_order_relaxed),
+        .num_wakeups = atomic_load_explicit(&counters->num_wakeups, memory_order_relaxed),
+        .wake_latency_ns = atomic_load_explicit(&counters->wake_latency_ns, memory_order_relaxed),
+        .max_wake_latency_ns = atomic_load_explicit(&counters->max_wake_latency_ns, memory_order_relaxed),
+    };
+
+    return true;
+}
+
+void
+archi_thread_group_stats_reset(
+        archi_thread_group_t context)
+{
+    if ((context == NULL) || (context->counters == NULL))
+        return;
+
+    atomic_store_explicit(&context->num_dispatches, 0, memory_order_relaxed);
+    atomic_store_explicit(&context->tail_ns, 0, memory_order_relaxed);
+    atomic_store_explicit(&context->max_tail_ns, 0, memory_order_relaxed);
+
+    for (size_t i = 0; i < context->num_threads + 1; i++)
     {
-        MTX_LOCK(context->pong.mtx);
+        struct archi_thread_group_counters *counters = &context->counters[i];
+
+        atomic_store_explicit(&counters->num_work_items, 0, memory_order_relaxed);
+        atomic_store_explicit(&counters->num_batches, 0, memory_order_relaxed);
+        atomic_store_explicit(&counters->busy_ns, 0, memory_order_relaxed);
+        atomic_store_explicit(&counters->wait_ns, 0, memory_order_relaxed);
+        atomic_store_explicit(&counters->num_wakeups, 0, memory_order_relaxed);
+        atomic_store_explicit(&counters->wake_latency_ns, 0, memory_order_relaxed);
+        atomic_store_explicit(&counters->max_wake_latency_ns, 0, memory_order_relaxed);
+    }
+}
+
+int
+archi_thread_group_notify_fd(
+        archi_thread_group_t context)
+{
+    if (context == NULL)
+        return -1;
+
+    return context->notify.read_fd;
+}
 
-        bool pong_sense = context->pong.sense;
-        while (context->pong.flag != pong_sense)
-            CND_TIMEDWAIT(context->pong.cnd, context->pong.mtx, time_point);
+size_t
+archi_thread_group_notify_clear(
+        archi_thread_group_t context)
+{
+    if (context == NULL)
+        return 0;
 
-        MTX_UNLOCK(context->pong.mtx);
+    // Drain the descriptor before resetting the flag: a completion that happens in between
+    // doesn't signal the descriptor again, but it is included in the returned counter,
+    // as the flag exchange synchronizes with the completion that has set the flag
+    if ((context->notify.read_fd >= 0) &&
+            atomic_load_explicit(&context->notify_pending, memory_order_acquire))
+    {
+        archi_thread_notify_clear(&context->notify);
+        atomic_exchange_explicit(&context->notify_pending, false, memory_order_acq_rel);
     }
+
+    return atomic_load_explicit(&context->pong.count, memory_order_acquire);
 }
 
 size_t
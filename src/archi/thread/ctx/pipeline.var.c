@@ -0,0 +1,350 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Context interface for pipelines of DEG stages.
+ */
+
+#include "archi/thread/ctx/pipeline.var.h"
+#include "archi/thread/api/pipeline.fun.h"
+#include "archi/thread/api/tag.def.h"
+#include "archi/exec/api/tag.def.h"
+#include "archi/context/api/interface.def.h"
+#include "archi_base/pointer.fun.h"
+#include "archi_base/pointer.def.h"
+#include "archi_base/util/plist.fun.h"
+#include "archi_base/util/check.fun.h"
+#include "archi_base/util/string.fun.h"
+
+#include <stdlib.h> // for malloc(), free()
+#include <stdalign.h>
+
+
+struct archi_context_data__thread_pipeline_stage {
+    archi_rcpointer_t ref_entry;
+    archi_rcpointer_t ref_input;
+    archi_rcpointer_t ref_output;
+    archi_rcpointer_t ref_item;
+};
+
+struct archi_context_data__thread_pipeline {
+    archi_rcpointer_t pipeline;
+
+    // References
+    struct archi_context_data__thread_pipeline_stage *ref_stage;
+};
+
+static
+ARCHI_CONTEXT_INIT_FUNC(archi_context_init__thread_pipeline)
+{
+    // Parse parameters
+    archi_thread_pipeline_start_params_t pipeline_params = {0};
+    {
+        archi_plist_param_t parsed[] = {
+            {.name = "params",
+                .check = {archi_value_check__attr, (archi_pointer_attr_t[]){ARCHI_POINTER_ATTR__PDATA(1, archi_thread_pipeline_start_params_t)}},
+                .assign = {archi_plist_assign__value, &pipeline_params, sizeof(pipeline_params), NULL}},
+            {.name = "num_stages",
+                .check = {archi_value_check__attr, (archi_pointer_attr_t[]){ARCHI_POINTER_ATTR__PDATA(1, size_t)}},
+                .assign = {archi_plist_assign__value, &pipeline_params.num_stages, sizeof(pipeline_params.num_stages), NULL}},
+            {.name = "spin_ns",
+                .check = {archi_value_check__attr, (archi_pointer_attr_t[]){ARCHI_POINTER_ATTR__PDATA(1, uint64_t)}},
+                .assign = {archi_plist_assign__value, &pipeline_params.spin_ns, sizeof(pipeline_params.spin_ns), NULL}},
+            {0},
+        };
+
+        if (!archi_plist_parse(&params->n, true, parsed, false, ARCHI_ERROR_PARAM))
+            return NULL;
+    }
+
+    // Construct the context
+    struct archi_context_data__thread_pipeline *context_data = malloc(sizeof(*context_data));
+    if (context_data == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__EMEMORY, "couldn't allocate context data");
+        return NULL;
+    }
+
+    *context_data = (struct archi_context_data__thread_pipeline){
+        .pipeline = {
+            .attr = ARCHI_POINTER_TYPE__DATA_WRITABLE |
+                archi_pointer_attr__cdata(ARCHI_POINTER_DATA_TAG__THREAD_PIPELINE),
+        },
+    };
+
+    // Initialize references
+    if (pipeline_params.num_stages != 0)
+    {
+        context_data->ref_stage = malloc(sizeof(*context_data->ref_stage) * pipeline_params.num_stages);
+        if (context_data->ref_stage == NULL)
+        {
+            ARCHI_ERROR_SET(ARCHI__EMEMORY, "couldn't allocate array of references to stage entities (length = %zu)",
+                    pipeline_params.num_stages);
+            free(context_data);
+            return NULL;
+        }
+
+        for (size_t i = 0; i < pipeline_params.num_stages; i++)
+            context_data->ref_stage[i] = (struct archi_context_data__thread_pipeline_stage){0};
+    }
+
+    context_data->pipeline.ptr = archi_thread_pipeline_create(pipeline_params, ARCHI_ERROR_PARAM);
+    if (context_data->pipeline.ptr == NULL)
+    {
+        free(context_data->ref_stage);
+        free(context_data);
+        return NULL;
+    }
+
+    ARCHI_ERROR_RESET();
+    return (archi_rcpointer_t*)context_data;
+}
+
+static
+ARCHI_CONTEXT_FINAL_FUNC(archi_context_final__thread_pipeline)
+{
+    struct archi_context_data__thread_pipeline *context_data =
+        (struct archi_context_data__thread_pipeline*)context;
+
+    size_t num_stages = archi_thread_pipeline_num_stages(context_data->pipeline.ptr);
+
+    // Threads must be stopped before the referenced entities are released
+    archi_thread_pipeline_destroy(context_data->pipeline.ptr);
+
+    for (size_t i = 0; i < num_stages; i++)
+    {
+        archi_rcpointer_disown(context_data->ref_stage[i].ref_entry);
+        archi_rcpointer_disown(context_data->ref_stage[i].ref_input);
+        archi_rcpointer_disown(context_data->ref_stage[i].ref_output);
+        archi_rcpointer_disown(context_data->ref_stage[i].ref_item);
+    }
+
+    free(context_data->ref_stage);
+    free(context_data);
+}
+
+static
+archi_rcpointer_t*
+archi_context_pipeline_stage_ref(
+        struct archi_context_data__thread_pipeline *context_data,
+        archi_context_slot_t slot,
+        ARCHI_ERROR_PARAM_DECL)
+{
+    if (slot.num_indices != 1)
+    {
+        ARCHI_ERROR_SET(ARCHI__EINDEX, "number of slot indices isn't 1");
+        return NULL;
+    }
+
+    size_t num_stages = archi_thread_pipeline_num_stages(context_data->pipeline.ptr);
+
+    archi_context_slot_index_t index = slot.index[0];
+    if ((index < 0) || ((size_t)index >= num_stages))
+    {
+        ARCHI_ERROR_SET(ARCHI__EINDEX, "index %lli is out of bounds [0; %zu)",
+                index, num_stages);
+        return NULL;
+    }
+
+    struct archi_context_data__thread_pipeline_stage *ref_stage = &context_data->ref_stage[index];
+
+    if (ARCHI_STRING_COMPARE("stage.entry", ==, slot.name))
+        return &ref_stage->ref_entry;
+    else if (ARCHI_STRING_COMPARE("stage.input", ==, slot.name))
+        return &ref_stage->ref_input;
+    else if (ARCHI_STRING_COMPARE("stage.output", ==, slot.name))
+        return &ref_stage->ref_output;
+    else
+        return &ref_stage->ref_item;
+}
+
+static
+ARCHI_CONTEXT_EVAL_FUNC(archi_context_eval__thread_pipeline)
+{
+    struct archi_context_data__thread_pipeline *context_data =
+        (struct archi_context_data__thread_pipeline*)context;
+
+    if (!call)
+    {
+        if (ARCHI_STRING_COMPARE("num_stages", ==, slot.name))
+        {
+            if (slot.num_indices != 0)
+            {
+                ARCHI_ERROR_SET(ARCHI__EINDEX, "number of slot indices isn't 0");
+                return;
+            }
+
+            size_t num_stages = archi_thread_pipeline_num_stages(context_data->pipeline.ptr);
+
+            archi_rcpointer_t value = {
+                .ptr = &num_stages,
+                .attr = ARCHI_POINTER_TYPE__DATA_ON_STACK |
+                    ARCHI_POINTER_ATTR__PDATA(1, size_t),
+            };
+
+            ARCHI_CONTEXT_YIELD(value);
+        }
+        else if (ARCHI_STRING_COMPARE("stage.entry", ==, slot.name) ||
+                ARCHI_STRING_COMPARE("stage.input", ==, slot.name) ||
+                ARCHI_STRING_COMPARE("stage.output", ==, slot.name) ||
+                ARCHI_STRING_COMPARE("stage.item", ==, slot.name))
+        {
+            archi_rcpointer_t *ref = archi_context_pipeline_stage_ref(context_data, slot, ARCHI_ERROR_PARAM);
+            if (ref == NULL)
+                return;
+
+            ARCHI_CONTEXT_YIELD(*ref);
+        }
+        else
+            ARCHI_ERROR_SET(ARCHI__EKEY, "unknown slot '%s' encountered", slot.name);
+    }
+    else
+    {
+        if (slot.num_indices != 0)
+        {
+            ARCHI_ERROR_SET(ARCHI__EINDEX, "number of slot indices isn't 0");
+            return;
+        }
+        else if (params != NULL)
+        {
+            ARCHI_ERROR_SET(ARCHI__EKEY, "no parameters are accepted");
+            return;
+        }
+
+        if (ARCHI_STRING_COMPARE("start", ==, slot.name))
+        {
+            archi_error_t error;
+            ARCHI_ERROR_VAR_UNSET(&error);
+
+            if (!archi_thread_pipeline_start(context_data->pipeline.ptr, &error) && (error.code == 0))
+            {
+                ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "pipeline is already running");
+                return;
+            }
+
+            ARCHI_ERROR_ASSIGN(error);
+        }
+        else if (ARCHI_STRING_COMPARE("stop", ==, slot.name))
+        {
+            archi_thread_pipeline_stop(context_data->pipeline.ptr);
+
+            ARCHI_ERROR_RESET();
+        }
+        else if (ARCHI_STRING_COMPARE("wait", ==, slot.name))
+            archi_thread_pipeline_wait(context_data->pipeline.ptr, ARCHI_ERROR_PARAM);
+        else
+            ARCHI_ERROR_SET(ARCHI__EKEY, "unknown slot '%s' encountered", slot.name);
+    }
+}
+
+static
+ARCHI_CONTEXT_SET_FUNC(archi_context_set__thread_pipeline)
+{
+    if (unset)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "slot unsetting is not supported");
+        return;
+    }
+
+    struct archi_context_data__thread_pipeline *context_data =
+        (struct archi_context_data__thread_pipeline*)context;
+
+    // Check the assigned value
+    if (ARCHI_STRING_COMPARE("stage.entry", ==, slot.name))
+    {
+        if (!archi_pointer_attr_compatible(value.attr,
+                    archi_pointer_attr__cdata(ARCHI_POINTER_DATA_TAG__DEXGRAPH_NODE)))
+        {
+            ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "assigned value is not a DEG node");
+            return;
+        }
+    }
+    else if (ARCHI_STRING_COMPARE("stage.input", ==, slot.name) ||
+            ARCHI_STRING_COMPARE("stage.output", ==, slot.name))
+    {
+        if (!archi_pointer_attr_compatible(value.attr,
+                    archi_pointer_attr__cdata(ARCHI_POINTER_DATA_TAG__THREAD_LFQUEUE)))
+        {
+            ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "assigned value is not a lock-free queue");
+            return;
+        }
+    }
+    else if (ARCHI_STRING_COMPARE("stage.item", ==, slot.name))
+    {
+        if (ARCHI_POINTER_TO_FUNCTION(value.attr))
+        {
+            ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "assigned value is not data");
+            return;
+        }
+    }
+    else
+    {
+        ARCHI_ERROR_SET(ARCHI__EKEY, "unknown slot '%s' encountered", slot.name);
+        return;
+    }
+
+    archi_rcpointer_t *ref = archi_context_pipeline_stage_ref(context_data, slot, ARCHI_ERROR_PARAM);
+    if (ref == NULL)
+        return;
+
+    // Update the stage
+    archi_thread_pipeline_stage_t stage =
+        archi_thread_pipeline_get_stage(context_data->pipeline.ptr, slot.index[0]);
+
+    if (ref == &context_data->ref_stage[slot.index[0]].ref_entry)
+        stage.entry = value.ptr;
+    else if (ref == &context_data->ref_stage[slot.index[0]].ref_input)
+        stage.input = value.ptr;
+    else if (ref == &context_data->ref_stage[slot.index[0]].ref_output)
+        stage.output = value.ptr;
+    else
+        stage.item = value.ptr;
+
+    value = archi_rcpointer_own(value, ARCHI_ERROR_PARAM);
+    if (!value.attr)
+        return;
+
+    archi_error_t error;
+    ARCHI_ERROR_VAR_UNSET(&error);
+
+    archi_thread_pipeline_set_stage(context_data->pipeline.ptr, slot.index[0], stage, &error);
+    if (error.code != 0)
+    {
+        archi_rcpointer_disown(value);
+
+        ARCHI_ERROR_ASSIGN(error);
+        return;
+    }
+
+    archi_rcpointer_disown(*ref);
+    *ref = value;
+
+    ARCHI_ERROR_RESET();
+}
+
+const archi_context_interface_t
+archi_context_interface__thread_pipeline = {
+    .init_fn = archi_context_init__thread_pipeline,
+    .final_fn = archi_context_final__thread_pipeline,
+    .eval_fn = archi_context_eval__thread_pipeline,
+    .set_fn = archi_context_set__thread_pipeline,
+};
+
@@ -0,0 +1,205 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+/**
+ * @file
+ * @brief Context interface for schedulers.
+ */
+
+#include "archi/thread/ctx/scheduler.var.h"
+#include "archi/thread/api/scheduler.fun.h"
+#include "archi/thread/api/tag.def.h"
+#include "archi/exec/api/tag.def.h"
+#include "archi/context/api/interface.def.h"
+#include "archi_base/pointer.fun.h"
+#include "archi_base/pointer.def.h"
+#include "archi_base/util/plist.fun.h"
+#include "archi_base/util/check.fun.h"
+#include "archi_base/util/string.fun.h"
+
+#include <stdlib.h> // for malloc(), free()
+#include <stdalign.h>
+
+
+static
+ARCHI_CONTEXT_INIT_FUNC(archi_context_init__thread_scheduler)
+{
+    // Parse parameters
+    archi_thread_scheduler_start_params_t scheduler_params = {0};
+    {
+        archi_plist_param_t parsed[] = {
+            {.name = "params",
+                .check = {archi_value_check__attr, (archi_pointer_attr_t[]){ARCHI_POINTER_ATTR__PDATA(1, archi_thread_scheduler_start_params_t)}},
+                .assign = {archi_plist_assign__value, &scheduler_params, sizeof(scheduler_params), NULL}},
+            {.name = "num_threads",
+                .check = {archi_value_check__attr, (archi_pointer_attr_t[]){ARCHI_POINTER_ATTR__PDATA(1, size_t)}},
+                .assign = {archi_plist_assign__value, &scheduler_params.num_threads, sizeof(scheduler_params.num_threads), NULL}},
+            {.name = "max_tasks",
+                .check = {archi_value_check__attr, (archi_pointer_attr_t[]){ARCHI_POINTER_ATTR__PDATA(1, size_t)}},
+                .assign = {archi_plist_assign__value, &scheduler_params.max_tasks, sizeof(scheduler_params.max_tasks), NULL}},
+            {0},
+        };
+
+        if (!archi_plist_parse(&params->n, true, parsed, false, ARCHI_ERROR_PARAM))
+            return NULL;
+    }
+
+    // Construct the context
+    archi_rcpointer_t *context_data = malloc(sizeof(*context_data));
+    if (context_data == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__EMEMORY, "couldn't allocate context data");
+        return NULL;
+    }
+
+    archi_thread_scheduler_t scheduler = archi_thread_scheduler_create(scheduler_params, ARCHI_ERROR_PARAM);
+    if (scheduler == NULL)
+    {
+        free(context_data);
+        return NULL;
+    }
+
+    *context_data = (archi_rcpointer_t){
+        .ptr = scheduler,
+        .attr = ARCHI_POINTER_TYPE__DATA_WRITABLE |
+            archi_pointer_attr__cdata(ARCHI_POINTER_DATA_TAG__THREAD_SCHEDULER),
+    };
+
+    ARCHI_ERROR_RESET();
+    return context_data;
+}
+
+static
+ARCHI_CONTEXT_FINAL_FUNC(archi_context_final__thread_scheduler)
+{
+    archi_thread_scheduler_destroy(context->ptr);
+    free(context);
+}
+
+static
+ARCHI_CONTEXT_EVAL_FUNC(archi_context_eval__thread_scheduler)
+{
+    if (!call)
+    {
+        if (ARCHI_STRING_COMPARE("num_threads", ==, slot.name))
+        {
+            if (slot.num_indices != 0)
+            {
+                ARCHI_ERROR_SET(ARCHI__EINDEX, "number of slot indices isn't 0");
+                return;
+            }
+
+            size_t num_threads = archi_thread_scheduler_num_threads(context->ptr);
+
+            archi_rcpointer_t value = {
+                .ptr = &num_threads,
+                .attr = ARCHI_POINTER_TYPE__DATA_ON_STACK |
+                    ARCHI_POINTER_ATTR__PDATA(1, size_t),
+            };
+
+            ARCHI_CONTEXT_YIELD(value);
+        }
+        else if (ARCHI_STRING_COMPARE("num_tasks", ==, slot.name))
+        {
+            if (slot.num_indices != 0)
+            {
+                ARCHI_ERROR_SET(ARCHI__EINDEX, "number of slot indices isn't 0");
+                return;
+            }
+
+            size_t num_tasks = archi_thread_scheduler_num_tasks(context->ptr);
+
+            archi_rcpointer_t value = {
+                .ptr = &num_tasks,
+                .attr = ARCHI_POINTER_TYPE__DATA_ON_STACK |
+                    ARCHI_POINTER_ATTR__PDATA(1, size_t),
+            };
+
+            ARCHI_CONTEXT_YIELD(value);
+        }
+        else
+            ARCHI_ERROR_SET(ARCHI__EKEY, "unknown slot '%s' encountered", slot.name);
+    }
+    else
+    {
+        if (ARCHI_STRING_COMPARE("submit", ==, slot.name))
+        {
+            if (slot.num_indices != 0)
+            {
+                ARCHI_ERROR_SET(ARCHI__EINDEX, "number of slot indices isn't 0");
+                return;
+            }
+
+            // Parse parameters
+            archi_dexgraph_frame_t frame = {0};
+            {
+                archi_plist_param_t parsed[] = {
+                    {.name = "node",
+                        .check = {archi_value_check__attr, (archi_pointer_attr_t[]){archi_pointer_attr__cdata(ARCHI_POINTER_DATA_TAG__DEXGRAPH_NODE)}},
+                        .assign = {archi_plist_assign__dptr, &frame.node, sizeof(frame.node), NULL}},
+                    {.name = "index",
+                        .check = {archi_value_check__attr, (archi_pointer_attr_t[]){ARCHI_POINTER_ATTR__PDATA(1, size_t)}},
+                        .assign = {archi_plist_assign__value, &frame.index, sizeof(frame.index), NULL}},
+                    {0},
+                };
+
+                if (!archi_plist_parse(&params->n, true, parsed, false, ARCHI_ERROR_PARAM))
+                    return;
+            }
+
+            // Submit the task
+            archi_error_t error;
+            ARCHI_ERROR_VAR_UNSET(&error);
+
+            if (!archi_thread_scheduler_submit(context->ptr, frame, &error) && (error.code == 0))
+            {
+                ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "maximum number of scheduler tasks is reached");
+                return;
+            }
+
+            ARCHI_ERROR_ASSIGN(error);
+        }
+        else if (ARCHI_STRING_COMPARE("wait", ==, slot.name))
+        {
+            if (slot.num_indices != 0)
+            {
+                ARCHI_ERROR_SET(ARCHI__EINDEX, "number of slot indices isn't 0");
+                return;
+            }
+
+            if (params != NULL)
+            {
+                ARCHI_ERROR_SET(ARCHI__EKEY, "no parameters are accepted");
+                return;
+            }
+
+            archi_thread_scheduler_wait(context->ptr, ARCHI_ERROR_PARAM);
+        }
+        else
+            ARCHI_ERROR_SET(ARCHI__EKEY, "unknown slot '%s' encountered", slot.name);
+    }
+}
+
+const archi_context_interface_t
+archi_context_interface__thread_scheduler = {
+    .init_fn = archi_context_init__thread_scheduler,
+    .final_fn = archi_context_final__thread_scheduler,
+    .eval_fn = archi_context_eval__thread_scheduler,
+};
+
@@ -26,6 +26,7 @@
 #include "archi/thread/ctx/thread_group.var.h"
 #include "archi/thread/api/thread_group.fun.h"
 #include "archi/thread/api/tag.def.h"
+#include "archi/memory/api/tag.def.h"
 #include "archi/context/api/interface.def.h"
 #include "archi_base/pointer.fun.h"
 #include "archi_base/pointer.def.h"
@@ -37,11 +38,21 @@
 #include <stdalign.h>
 
 
+struct archi_context_data__thread_group {
+    archi_rcpointer_t thread_group;
+
+    // References
+    archi_rcpointer_t ref_scratch_interface;
+    archi_rcpointer_t ref_scratch_alloc_data;
+};
+
 static
 ARCHI_CONTEXT_INIT_FUNC(archi_context_init__thread_group)
 {
     // Parse parameters
     archi_thread_group_start_params_t thread_group_params = {0};
+    archi_rcpointer_t cpus = {0}, numa_nodes = {0};
+    archi_rcpointer_t scratch_interface = {0}, scratch_alloc_data = {0};
     {
         archi_plist_param_t parsed[] = {
             {.name = "params",
@@ -50,6 +61,36 @@ ARCHI_CONTEXT_INIT_FUNC(archi_context_init__thread_group)
             {.name = "num_threads",
                 .check = {archi_value_check__attr, (archi_pointer_attr_t[]){ARCHI_POINTER_ATTR__PDATA(1, size_t)}},
                 .assign = {archi_plist_assign__value, &thread_group_params.num_threads, sizeof(thread_group_params.num_threads), NULL}},
+            {.name = "queue_capacity",
+                .check = {archi_value_check__attr, (archi_pointer_attr_t[]){ARCHI_POINTER_ATTR__PDATA(1, size_t)}},
+                .assign = {archi_plist_assign__value, &thread_group_params.queue_capacity, sizeof(thread_group_params.queue_capacity), NULL}},
+            {.name = "spin_ns",
+                .check = {archi_value_check__attr, (archi_pointer_attr_t[]){ARCHI_POINTER_ATTR__PDATA(1, uint64_t)}},
+                .assign = {archi_plist_assign__value, &thread_group_params.spin_ns, sizeof(thread_group_params.spin_ns), NULL}},
+            {.name = "affinity",
+                .check = {archi_value_check__attr, (archi_pointer_attr_t[]){ARCHI_POINTER_ATTR__PDATA(1, archi_thread_group_affinity_t)}},
+                .assign = {archi_plist_assign__value, &thread_group_params.affinity, sizeof(thread_group_params.affinity), NULL}},
+            {.name = "cpus",
+                .check = {archi_value_check__attr, (archi_pointer_attr_t[]){ARCHI_POINTER_ATTR__PDATA(1, size_t)}},
+                .assign = {archi_plist_assign__rcpointer, &cpus, sizeof(cpus), NULL}},
+            {.name = "numa_nodes",
+                .check = {archi_value_check__attr, (archi_pointer_attr_t[]){ARCHI_POINTER_ATTR__PDATA(1, size_t)}},
+                .assign = {archi_plist_assign__rcpointer, &numa_nodes, sizeof(numa_nodes), NULL}},
+            {.name = "scratch_size",
+                .check = {archi_value_check__attr, (archi_pointer_attr_t[]){ARCHI_POINTER_ATTR__PDATA(1, size_t)}},
+                .assign = {archi_plist_assign__value, &thread_group_params.scratch_size, sizeof(thread_group_params.scratch_size), NULL}},
+            {.name = "scratch_interface",
+                .check = {archi_value_check__attr, (archi_pointer_attr_t[]){archi_pointer_attr__cdata(ARCHI_POINTER_DATA_TAG__MEMORY_INTERFACE)}},
+                .assign = {archi_plist_assign__rcpointer, &scratch_interface, sizeof(scratch_interface), NULL}},
+            {.name = "scratch_alloc_data",
+                .check = {archi_value_check__attr, (archi_pointer_attr_t[]){archi_pointer_attr__cdata(0)}},
+                .assign = {archi_plist_assign__rcpointer, &scratch_alloc_data, sizeof(scratch_alloc_data), NULL}},
+            {.name = "stats",
+                .check = {archi_value_check__attr, (archi_pointer_attr_t[]){ARCHI_POINTER_ATTR__PDATA(1, char)}},
+                .assign = {archi_plist_assign__bool, &thread_group_params.stats, sizeof(thread_group_params.stats), NULL}},
+            {.name = "notify",
+                .check = {archi_value_check__attr, (archi_pointer_attr_t[]){ARCHI_POINTER_ATTR__PDATA(1, char)}},
+                .assign = {archi_plist_assign__bool, &thread_group_params.notify, sizeof(thread_group_params.notify), NULL}},
             {0},
         };
 
@@ -57,69 +98,230 @@ ARCHI_CONTEXT_INIT_FUNC(archi_context_init__thread_group)
             return NULL;
     }
 
+    if (cpus.ptr != NULL)
+    {
+        thread_group_params.cpu = cpus.cptr;
+        archi_pointer_attr_unpk__pdata(cpus.attr, &thread_group_params.num_cpus, NULL, NULL, NULL);
+    }
+
+    if (numa_nodes.ptr != NULL)
+    {
+        thread_group_params.numa_node = numa_nodes.cptr;
+        archi_pointer_attr_unpk__pdata(numa_nodes.attr, &thread_group_params.num_numa_nodes, NULL, NULL, NULL);
+    }
+
     // Construct the context
-    archi_rcpointer_t *context_data = malloc(sizeof(*context_data));
+    struct archi_context_data__thread_group *context_data = malloc(sizeof(*context_data));
     if (context_data == NULL)
     {
         ARCHI_ERROR_SET(ARCHI__EMEMORY, "couldn't allocate context data");
         return NULL;
     }
 
-    archi_thread_group_t thread_group = archi_thread_group_create(thread_group_params, ARCHI_ERROR_PARAM);
-    if (thread_group == NULL)
+    *context_data = (struct archi_context_data__thread_group){
+        .thread_group = {
+            .attr = ARCHI_POINTER_TYPE__DATA_WRITABLE |
+                archi_pointer_attr__cdata(ARCHI_POINTER_DATA_TAG__THREAD_GROUP),
+        },
+    };
+
+    // Keep the scratch arena memory interface alive while the thread group exists
+    if (scratch_interface.attr)
+    {
+        context_data->ref_scratch_interface = archi_rcpointer_own(scratch_interface, ARCHI_ERROR_PARAM);
+        if (!context_data->ref_scratch_interface.attr)
+        {
+            free(context_data);
+            return NULL;
+        }
+
+        thread_group_params.scratch_interface = context_data->ref_scratch_interface.cptr;
+    }
+
+    if (scratch_alloc_data.attr)
+    {
+        context_data->ref_scratch_alloc_data = archi_rcpointer_own(scratch_alloc_data, ARCHI_ERROR_PARAM);
+        if (!context_data->ref_scratch_alloc_data.attr)
+        {
+            archi_rcpointer_disown(context_data->ref_scratch_interface);
+            free(context_data);
+            return NULL;
+        }
+
+        thread_group_params.scratch_alloc_data = context_data->ref_scratch_alloc_data.ptr;
+    }
+
+    context_data->thread_group.ptr = archi_thread_group_create(thread_group_params, ARCHI_ERROR_PARAM);
+    if (context_data->thread_group.ptr == NULL)
     {
+        archi_rcpointer_disown(context_data->ref_scratch_interface);
+        archi_rcpointer_disown(context_data->ref_scratch_alloc_data);
         free(context_data);
         return NULL;
     }
 
-    *context_data = (archi_rcpointer_t){
-        .ptr = thread_group,
-        .attr = ARCHI_POINTER_TYPE__DATA_WRITABLE |
-            archi_pointer_attr__cdata(ARCHI_POINTER_DATA_TAG__THREAD_GROUP),
-    };
-
     ARCHI_ERROR_RESET();
-    return context_data;
+    return (archi_rcpointer_t*)context_data;
 }
 
 static
 ARCHI_CONTEXT_FINAL_FUNC(archi_context_final__thread_group)
 {
-    archi_thread_group_destroy(context->ptr);
-    free(context);
+    struct archi_context_data__thread_group *context_data =
+        (struct archi_context_data__thread_group*)context;
+
+    archi_thread_group_destroy(context_data->thread_group.ptr);
+
+    archi_rcpointer_disown(context_data->ref_scratch_interface);
+    archi_rcpointer_disown(context_data->ref_scratch_alloc_data);
+
+    free(context_data);
 }
 
 static
 ARCHI_CONTEXT_EVAL_FUNC(archi_context_eval__thread_group)
 {
-    (void) params;
-
-    if (call)
+    if (!call)
     {
-        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "no calls are supported");
-        return;
-    }
+        if (ARCHI_STRING_COMPARE("num_threads", ==, slot.name))
+        {
+            if (slot.num_indices != 0)
+            {
+                ARCHI_ERROR_SET(ARCHI__EINDEX, "number of slot indices isn't 0");
+                return;
+            }
 
-    if (ARCHI_STRING_COMPARE("num_threads", ==, slot.name))
-    {
-        if (slot.num_indices != 0)
+            size_t num_threads = archi_thread_group_num_threads(context->ptr);
+
+            archi_rcpointer_t value = {
+                .ptr = &num_threads,
+                .attr = ARCHI_POINTER_TYPE__DATA_ON_STACK |
+                    ARCHI_POINTER_ATTR__PDATA(1, size_t),
+            };
+
+            ARCHI_CONTEXT_YIELD(value);
+        }
+        else if (ARCHI_STRING_COMPARE("stats", ==, slot.name))
         {
-            ARCHI_ERROR_SET(ARCHI__EINDEX, "number of slot indices isn't 0");
-            return;
+            if (slot.num_indices != 0)
+            {
+                ARCHI_ERROR_SET(ARCHI__EINDEX, "number of slot indices isn't 0");
+                return;
+            }
+
+            archi_thread_group_stats_t stats;
+            if (!archi_thread_group_stats(context->ptr, &stats))
+            {
+                ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "thread group statistics are not collected");
+                return;
+            }
+
+            archi_rcpointer_t value = {
+                .ptr = &stats,
+                .attr = ARCHI_POINTER_TYPE__DATA_ON_STACK |
+                    ARCHI_POINTER_ATTR__PDATA(1, archi_thread_group_stats_t),
+            };
+
+            ARCHI_CONTEXT_YIELD(value);
         }
+        else if (ARCHI_STRING_COMPARE("thread_stats", ==, slot.name))
+        {
+            if (slot.num_indices != 1)
+            {
+                ARCHI_ERROR_SET(ARCHI__EINDEX, "number of slot indices isn't 1");
+                return;
+            }
 
-        size_t num_threads = archi_thread_group_num_threads(context->ptr);
+            size_t num_threads = archi_thread_group_num_threads(context->ptr);
 
-        archi_rcpointer_t value = {
-            .ptr = &num_threads,
-            .attr = ARCHI_POINTER_TYPE__DATA_ON_STACK |
-                ARCHI_POINTER_ATTR__PDATA(1, size_t),
-        };
+            archi_context_slot_index_t index = slot.index[0];
+            if ((index < 0) || ((size_t)index > num_threads))
+            {
+                ARCHI_ERROR_SET(ARCHI__EINDEX, "index %lli is out of bounds [0; %zu]",
+                        index, num_threads);
+                return;
+            }
+
+            archi_thread_group_thread_stats_t stats;
+            if (!archi_thread_group_thread_stats(context->ptr, index, &stats))
+            {
+                ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "thread group statistics are not collected");
+                return;
+            }
+
+            archi_rcpointer_t value = {
+                .ptr = &stats,
+                .attr = ARCHI_POINTER_TYPE__DATA_ON_STACK |
+                    ARCHI_POINTER_ATTR__PDATA(1, archi_thread_group_thread_stats_t),
+            };
 
-        ARCHI_CONTEXT_YIELD(value);
+            ARCHI_CONTEXT_YIELD(value);
+        }
+        else if (ARCHI_STRING_COMPARE("notify_fd", ==, slot.name))
+        {
+            if (slot.num_indices != 0)
+            {
+                ARCHI_ERROR_SET(ARCHI__EINDEX, "number of slot indices isn't 0");
+                return;
+            }
+
+            int notify_fd = archi_thread_group_notify_fd(context->ptr);
+            if (notify_fd < 0)
+            {
+                ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "thread group completion notification descriptor is not created");
+                return;
+            }
+
+            archi_rcpointer_t value = {
+                .ptr = &notify_fd,
+                .attr = ARCHI_POINTER_TYPE__DATA_ON_STACK |
+                    ARCHI_POINTER_ATTR__PDATA(1, int),
+            };
+
+            ARCHI_CONTEXT_YIELD(value);
+        }
+        else
+            ARCHI_ERROR_SET(ARCHI__EKEY, "unknown slot '%s' encountered", slot.name);
     }
     else
-        ARCHI_ERROR_SET(ARCHI__EKEY, "unknown slot '%s' encountered", slot.name);
+    {
+        if (ARCHI_STRING_COMPARE("reset_stats", ==, slot.name))
+        {
+            if (slot.num_indices != 0)
+            {
+                ARCHI_ERROR_SET(ARCHI__EINDEX, "number of slot indices isn't 0");
+                return;
+            }
+            else if (params != NULL)
+            {
+                ARCHI_ERROR_SET(ARCHI__EKEY, "no parameters are accepted");
+                return;
+            }
+
+            archi_thread_group_stats_reset(context->ptr);
+
+            ARCHI_ERROR_RESET();
+        }
+        else if (ARCHI_STRING_COMPARE("clear_notify", ==, slot.name))
+        {
+            if (slot.num_indices != 0)
+            {
+                ARCHI_ERROR_SET(ARCHI__EINDEX, "number of slot indices isn't 0");
+                return;
+            }
+            else if (params != NULL)
+            {
+                ARCHI_ERROR_SET(ARCHI__EKEY, "no parameters are accepted");
+                return;
+            }
+
+            archi_thread_group_notify_clear(context->ptr);
+
+            ARCHI_ERROR_RESET();
+        }
+        else
+            ARCHI_ERROR_SET(ARCHI__EKEY, "unknown slot '%s' encountered", slot.name);
+    }
 }
 
 const archi_context_interface_t
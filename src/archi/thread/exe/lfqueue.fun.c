@@ -0,0 +1,74 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief DEG operation functions for lock-free queue operations.
+ */
+
+#include "archi/thread/exe/lfqueue.fun.h"
+#include "archi/thread/exe/lfqueue.typ.h"
+#include "archi/thread/api/lfqueue.fun.h"
+
+
+ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__thread_lfqueue_push_n)
+{
+    const archi_dexgraph_op_data__thread_lfqueue_push_n_t *push_data = data;
+
+    if (push_data == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "lock-free queue push operation parameters is NULL");
+        return;
+    }
+
+    archi_error_t error;
+    ARCHI_ERROR_VAR_UNSET(&error);
+
+    size_t num_pushed = archi_thread_lfqueue_push_n(push_data->queue,
+            push_data->values, push_data->num_values, &error);
+
+    if ((error.code == 0) && (push_data->num_pushed != NULL))
+        *push_data->num_pushed = num_pushed;
+
+    ARCHI_ERROR_ASSIGN(error);
+}
+
+ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__thread_lfqueue_pop_n)
+{
+    const archi_dexgraph_op_data__thread_lfqueue_pop_n_t *pop_data = data;
+
+    if (pop_data == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "lock-free queue pop operation parameters is NULL");
+        return;
+    }
+
+    archi_error_t error;
+    ARCHI_ERROR_VAR_UNSET(&error);
+
+    size_t num_popped = archi_thread_lfqueue_pop_n(pop_data->queue,
+            pop_data->values, pop_data->num_values, &error);
+
+    if ((error.code == 0) && (pop_data->num_popped != NULL))
+        *pop_data->num_popped = num_popped;
+
+    ARCHI_ERROR_ASSIGN(error);
+}
+
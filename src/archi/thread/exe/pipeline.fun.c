@@ -0,0 +1,83 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief DEG operation functions for pipeline operations.
+ */
+
+#include "archi/thread/exe/pipeline.fun.h"
+#include "archi/thread/api/pipeline.fun.h"
+
+
+ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__thread_pipeline_start)
+{
+    if (data == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "pipeline is NULL");
+        return;
+    }
+
+    archi_error_t error;
+
+    for (;;)
+    {
+        // Make an attempt
+        ARCHI_ERROR_VAR_UNSET(&error);
+        bool success = archi_thread_pipeline_start(data, &error);
+
+        if (success || (error.code != 0))
+            break;
+
+        // Running: wait and retry
+        ARCHI_ERROR_VAR_UNSET(&error);
+        archi_thread_pipeline_wait(data, &error);
+
+        if (error.code != 0)
+            break;
+    }
+
+    ARCHI_ERROR_ASSIGN(error);
+}
+
+ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__thread_pipeline_stop)
+{
+    if (data == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "pipeline is NULL");
+        return;
+    }
+
+    archi_thread_pipeline_stop(data);
+
+    ARCHI_ERROR_RESET();
+}
+
+ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__thread_pipeline_wait)
+{
+    if (data == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "pipeline is NULL");
+        return;
+    }
+
+    archi_thread_pipeline_wait(data, ARCHI_ERROR_PARAM);
+}
+
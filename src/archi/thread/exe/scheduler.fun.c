@@ -0,0 +1,75 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+/**
+ * @file
+ * @brief DEG operation functions for scheduler operations.
+ */
+
+#include "archi/thread/exe/scheduler.fun.h"
+#include "archi/thread/exe/scheduler.typ.h"
+#include "archi/thread/api/scheduler.fun.h"
+
+
+ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__thread_scheduler_submit)
+{
+    const archi_dexgraph_op_data__thread_scheduler_submit_t *submit_data = data;
+
+    if (submit_data == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "scheduler submit operation parameters is NULL");
+        return;
+    }
+
+    archi_error_t error;
+    ARCHI_ERROR_VAR_UNSET(&error);
+
+    bool success = archi_thread_scheduler_submit(submit_data->scheduler,
+            (archi_dexgraph_frame_t){.node = submit_data->node, .index = submit_data->index}, &error);
+
+    if (!success && (error.code == 0))
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "maximum number of scheduler tasks (%zu) is reached",
+                archi_thread_scheduler_num_tasks(submit_data->scheduler));
+        return;
+    }
+
+    ARCHI_ERROR_ASSIGN(error);
+}
+
+ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__thread_scheduler_wait)
+{
+    if (data == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "scheduler is NULL");
+        return;
+    }
+
+    archi_thread_scheduler_wait(data, ARCHI_ERROR_PARAM);
+}
+
+ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__thread_scheduler_yield)
+{
+    (void) data;
+
+    archi_thread_scheduler_yield();
+
+    ARCHI_ERROR_RESET();
+}
+
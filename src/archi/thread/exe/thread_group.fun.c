@@ -26,7 +26,123 @@
 #include "archi/thread/exe/thread_group.fun.h"
 #include "archi/thread/exe/thread_group.typ.h"
 #include "archi/thread/api/thread_group.fun.h"
+#include "archi/exec/api/graph.fun.h"
+#include "archi/exec/api/dataflow.fun.h"
 
+#include <stdatomic.h>
+
+
+/**
+ * @brief Attempt to submit work to a thread group.
+ *
+ * @return Non-zero (ticket or true) if work has been submitted, 0 if the thread group is busy.
+ */
+typedef size_t (*archi_thread_group_submit_attempt_func_t)(
+        const void *data,
+        ARCHI_ERROR_PARAM_DECL);
+
+static
+size_t
+archi_thread_group_submit_retry(
+        archi_thread_group_t thread_group,
+        archi_thread_group_submit_attempt_func_t attempt,
+        const void *data,
+        ARCHI_ERROR_PARAM_DECL)
+{
+    archi_error_t error;
+    size_t result;
+
+    for (;;)
+    {
+        // Make an attempt
+        ARCHI_ERROR_VAR_UNSET(&error);
+        result = attempt(data, &error);
+
+        if ((result != 0) || (error.code != 0))
+            break;
+
+        // Busy: wait and retry
+        archi_thread_group_wait(thread_group);
+    }
+
+    ARCHI_ERROR_ASSIGN(error);
+    return result;
+}
+
+static
+size_t
+archi_thread_group_attempt__dispatch(
+        const void *data,
+        ARCHI_ERROR_PARAM_DECL)
+{
+    const archi_dexgraph_op_data__thread_group_dispatch_t *dispatch_data = data;
+
+    return archi_thread_group_dispatch(dispatch_data->thread_group,
+            dispatch_data->work, dispatch_data->callback, dispatch_data->param, ARCHI_ERROR_PARAM);
+}
+
+static
+size_t
+archi_thread_group_attempt__dispatch_help(
+        const void *data,
+        ARCHI_ERROR_PARAM_DECL)
+{
+    const archi_dexgraph_op_data__thread_group_dispatch_t *dispatch_data = data;
+
+    return archi_thread_group_dispatch_help(dispatch_data->thread_group,
+            dispatch_data->work, dispatch_data->callback, dispatch_data->param, ARCHI_ERROR_PARAM);
+}
+
+static
+size_t
+archi_thread_group_attempt__dispatch_tiled(
+        const void *data,
+        ARCHI_ERROR_PARAM_DECL)
+{
+    const archi_dexgraph_op_data__thread_group_dispatch_tiled_t *dispatch_data = data;
+
+    return archi_thread_group_dispatch_tiled(dispatch_data->thread_group,
+            dispatch_data->work, dispatch_data->callback, dispatch_data->param, ARCHI_ERROR_PARAM);
+}
+
+static
+size_t
+archi_thread_group_attempt__dispatch_reduce(
+        const void *data,
+        ARCHI_ERROR_PARAM_DECL)
+{
+    const archi_dexgraph_op_data__thread_group_dispatch_reduce_t *dispatch_data = data;
+
+    return archi_thread_group_dispatch_reduce(dispatch_data->thread_group,
+            dispatch_data->reduction, dispatch_data->callback, dispatch_data->param, ARCHI_ERROR_PARAM);
+}
+
+static
+size_t
+archi_thread_group_attempt__dispatch_phased(
+        const void *data,
+        ARCHI_ERROR_PARAM_DECL)
+{
+    const archi_dexgraph_op_data__thread_group_dispatch_phased_t *dispatch_data = data;
+
+    return archi_thread_group_dispatch_phased(dispatch_data->thread_group,
+            dispatch_data->work, dispatch_data->callback, dispatch_data->param, ARCHI_ERROR_PARAM);
+}
+
+static
+size_t
+archi_thread_group_attempt__enqueue(
+        const void *data,
+        ARCHI_ERROR_PARAM_DECL)
+{
+    const archi_dexgraph_op_data__thread_group_enqueue_t *enqueue_data = data;
+
+    return archi_thread_group_enqueue(enqueue_data->thread_group,
+            enqueue_data->work, enqueue_data->callback, enqueue_data->param,
+            (enqueue_data->after != NULL) ? *enqueue_data->after : 0, ARCHI_ERROR_PARAM);
+}
+
+/*****************************************************************************/
 
 ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__thread_group_dispatch)
 {
@@ -39,22 +155,88 @@ ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__thread_group_dispatch)
     }
 
     // Dispatch the work to the thread group
-    archi_error_t error;
+    archi_thread_group_submit_retry(dispatch_data->thread_group,
+            archi_thread_group_attempt__dispatch, dispatch_data, ARCHI_ERROR_PARAM);
+}
 
-    for (;;)
+ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__thread_group_dispatch_help)
+{
+    const archi_dexgraph_op_data__thread_group_dispatch_t *dispatch_data = data;
+
+    if (dispatch_data == NULL)
     {
-        // Make an attempt
-        ARCHI_ERROR_VAR_UNSET(&error);
-        bool success = archi_thread_group_dispatch(dispatch_data->thread_group,
-                dispatch_data->work, dispatch_data->callback, dispatch_data->param, &error);
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "thread group dispatch operation parameters is NULL");
+        return;
+    }
 
-        if (success || (error.code != 0))
-            break;
+    // Dispatch the work to the thread group and help it
+    archi_thread_group_submit_retry(dispatch_data->thread_group,
+            archi_thread_group_attempt__dispatch_help, dispatch_data, ARCHI_ERROR_PARAM);
+}
 
-        // Busy: wait and retry
-        archi_thread_group_wait(dispatch_data->thread_group);
+ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__thread_group_dispatch_tiled)
+{
+    const archi_dexgraph_op_data__thread_group_dispatch_tiled_t *dispatch_data = data;
+
+    if (dispatch_data == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "thread group tiled dispatch operation parameters is NULL");
+        return;
+    }
+
+    // Dispatch the work to the thread group
+    archi_thread_group_submit_retry(dispatch_data->thread_group,
+            archi_thread_group_attempt__dispatch_tiled, dispatch_data, ARCHI_ERROR_PARAM);
+}
+
+ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__thread_group_dispatch_reduce)
+{
+    const archi_dexgraph_op_data__thread_group_dispatch_reduce_t *dispatch_data = data;
+
+    if (dispatch_data == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "thread group reduction dispatch operation parameters is NULL");
+        return;
+    }
+
+    // Dispatch the reduction to the thread group
+    archi_thread_group_submit_retry(dispatch_data->thread_group,
+            archi_thread_group_attempt__dispatch_reduce, dispatch_data, ARCHI_ERROR_PARAM);
+}
+
+ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__thread_group_dispatch_phased)
+{
+    const archi_dexgraph_op_data__thread_group_dispatch_phased_t *dispatch_data = data;
+
+    if (dispatch_data == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "thread group multi-phase dispatch operation parameters is NULL");
+        return;
+    }
+
+    // Dispatch the work to the thread group
+    archi_thread_group_submit_retry(dispatch_data->thread_group,
+            archi_thread_group_attempt__dispatch_phased, dispatch_data, ARCHI_ERROR_PARAM);
+}
+
+ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__thread_group_enqueue)
+{
+    const archi_dexgraph_op_data__thread_group_enqueue_t *enqueue_data = data;
+
+    if (enqueue_data == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "thread group enqueue operation parameters is NULL");
+        return;
     }
 
+    // Enqueue the work to the thread group (wait and retry if the queue is full)
+    archi_error_t error;
+    size_t ticket = archi_thread_group_submit_retry(enqueue_data->thread_group,
+            archi_thread_group_attempt__enqueue, enqueue_data, &error);
+
+    if ((ticket != 0) && (enqueue_data->ticket != NULL))
+        *enqueue_data->ticket = ticket;
+
     ARCHI_ERROR_ASSIGN(error);
 }
 
@@ -71,3 +253,193 @@ ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__thread_group_wait)
     ARCHI_ERROR_RESET();
 }
 
+ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__thread_group_cancel)
+{
+    const archi_dexgraph_op_data__thread_group_cancel_t *cancel_data = data;
+
+    if (cancel_data == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "thread group cancellation operation parameters is NULL");
+        return;
+    }
+    else if (cancel_data->thread_group == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "thread group context is NULL");
+        return;
+    }
+
+    archi_thread_group_cancel(cancel_data->thread_group,
+            (cancel_data->ticket != NULL) ? *cancel_data->ticket : 0);
+
+    ARCHI_ERROR_RESET();
+}
+
+ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__thread_group_wait_ticket)
+{
+    const archi_dexgraph_op_data__thread_group_wait_ticket_t *wait_data = data;
+
+    if (wait_data == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "thread group ticket wait operation parameters is NULL");
+        return;
+    }
+    else if (wait_data->thread_group == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "thread group context is NULL");
+        return;
+    }
+    else if (wait_data->ticket == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "thread group work task ticket is NULL");
+        return;
+    }
+
+    archi_thread_group_wait_ticket(wait_data->thread_group, *wait_data->ticket, NULL);
+
+    ARCHI_ERROR_RESET();
+}
+
+struct archi_thread_group_fork_join_state {
+    const archi_dexgraph_node_array_t *branches;
+    archi_error_t *branch_error;
+
+    atomic_flag failed;
+    archi_error_t first_error;
+};
+
+static
+ARCHI_THREAD_GROUP_WORK_FUNC(archi_thread_group_work__fork_join)
+{
+    (void) thread_idx;
+
+    struct archi_thread_group_fork_join_state *state = data;
+
+    archi_dexgraph_frame_t frame = {.node = state->branches->node[work_item_idx]};
+
+    archi_error_t error;
+    ARCHI_ERROR_VAR_RESET(&error);
+
+    if (frame.node != NULL)
+        archi_dexgraph_execute(frame, ARCHI_DEXGRAPH__NO_INTERRUPT, &error);
+
+    if (state->branch_error != NULL)
+        state->branch_error[work_item_idx] = error;
+    else if ((error.code != 0) && !atomic_flag_test_and_set_explicit(&state->failed, memory_order_relaxed))
+        state->first_error = error;
+}
+
+ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__thread_group_fork_join)
+{
+    const archi_dexgraph_op_data__thread_group_fork_join_t *fork_join_data = data;
+
+    if (fork_join_data == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "thread group fork-join operation parameters is NULL");
+        return;
+    }
+    else if (fork_join_data->branches == NULL)
+    {
+        ARCHI_ERROR_RESET();
+        return;
+    }
+
+    struct archi_thread_group_fork_join_state state = {
+        .branches = fork_join_data->branches,
+        .branch_error = fork_join_data->branch_error,
+        .failed = ATOMIC_FLAG_INIT,
+    };
+
+    ARCHI_ERROR_VAR_RESET(&state.first_error);
+
+    // Fork: enqueue a work item per branch
+    archi_dexgraph_op_data__thread_group_enqueue_t enqueue_data = {
+        .thread_group = fork_join_data->thread_group,
+        .work = {.function = archi_thread_group_work__fork_join, .data = &state},
+        .param = {.size = state.branches->num_nodes, .batch_size = 1},
+    };
+
+    archi_error_t error;
+    size_t ticket = archi_thread_group_submit_retry(fork_join_data->thread_group,
+            archi_thread_group_attempt__enqueue, &enqueue_data, &error);
+
+    if (error.code != 0)
+    {
+        ARCHI_ERROR_ASSIGN(error);
+        return;
+    }
+
+    // Join: wait for the branches to finish, but not for unrelated enqueued work
+    archi_thread_group_wait_ticket(fork_join_data->thread_group, ticket, NULL);
+
+    if (state.branch_error != NULL)
+    {
+        for (size_t i = 0; i < state.branches->num_nodes; i++)
+        {
+            if (state.branch_error[i].code != 0)
+            {
+                ARCHI_ERROR_ASSIGN(state.branch_error[i]);
+                return;
+            }
+        }
+    }
+    else if (state.first_error.code != 0)
+    {
+        ARCHI_ERROR_ASSIGN(state.first_error);
+        return;
+    }
+
+    ARCHI_ERROR_RESET();
+}
+
+static
+ARCHI_THREAD_GROUP_WORK_FUNC(archi_thread_group_work__dataflow)
+{
+    (void) work_item_idx;
+    (void) thread_idx;
+
+    archi_dexgraph_dataflow_work(data);
+}
+
+ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__thread_group_dataflow)
+{
+    const archi_dexgraph_op_data__thread_group_dataflow_t *dataflow_data = data;
+
+    if (dataflow_data == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "thread group dataflow operation parameters is NULL");
+        return;
+    }
+    else if (dataflow_data->dataflow == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "dataflow graph is NULL");
+        return;
+    }
+
+    archi_dexgraph_dataflow_begin(dataflow_data->dataflow);
+
+    // Dispatch a worker per thread (a single worker if the group has no threads)
+    size_t num_workers = archi_thread_group_num_threads(dataflow_data->thread_group);
+    if (num_workers == 0)
+        num_workers = 1;
+
+    archi_dexgraph_op_data__thread_group_enqueue_t enqueue_data = {
+        .thread_group = dataflow_data->thread_group,
+        .work = {.function = archi_thread_group_work__dataflow, .data = dataflow_data->dataflow},
+        .param = {.size = num_workers, .batch_size = 1},
+    };
+
+    archi_error_t error;
+    size_t ticket = archi_thread_group_submit_retry(dataflow_data->thread_group,
+            archi_thread_group_attempt__enqueue, &enqueue_data, &error);
+
+    if (error.code != 0)
+    {
+        ARCHI_ERROR_ASSIGN(error);
+        return;
+    }
+
+    // Wait for all workers to finish
+    archi_thread_group_wait_ticket(dataflow_data->thread_group, ticket, NULL);
+
+    archi_dexgraph_dataflow_end(dataflow_data->dataflow, ARCHI_ERROR_PARAM);
+}
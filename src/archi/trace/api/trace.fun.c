@@ -0,0 +1,395 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Execution tracing.
+ */
+
+#include "archi/trace/api/trace.fun.h"
+#include "archi/trace/api/trace.var.h"
+
+#ifdef __STDC_NO_ATOMICS__
+#  error Atomics are required, but not supported by the compiler.
+#endif
+
+#ifdef __STDC_NO_THREADS__
+#  error Threads are required, but not supported by the compiler.
+#endif
+
+#include <stdlib.h> // for malloc(), free()
+#include <stdio.h> // for FILE, fopen(), fclose(), fprintf(), fputc()
+#include <stdatomic.h> // for atomic_* functions and types
+#include <threads.h> // for mtx_*, tss_*, call_once()
+#include <time.h> // for struct timespec, timespec_get()
+
+
+struct archi_trace_buffer {
+    struct archi_trace_buffer *next; ///< Next buffer in the list.
+    unsigned long id; ///< Buffer identifier used as thread identifier.
+
+    atomic_bool retired; ///< Whether the owning thread has exited.
+
+    atomic_size_t head; ///< Number of recorded events (written by the owner thread only).
+    size_t tail; ///< Number of consumed events (written by flushing thread only).
+
+    size_t mask; ///< Capacity minus one.
+    archi_trace_event_t event[]; ///< Ring buffer of events.
+};
+
+static once_flag archi_trace_once = ONCE_FLAG_INIT;
+static bool archi_trace_initialized; // whether the mutex and the key are initialized
+
+static mtx_t archi_trace_mutex; // protects the list of buffers
+static tss_t archi_trace_key; // for buffer retirement on thread exit
+
+static struct archi_trace_buffer *archi_trace_buffers;
+static unsigned long archi_trace_num_buffers;
+
+static atomic_size_t archi_trace_capacity = ARCHI_TRACE_DEFAULT_CAPACITY;
+static atomic_uint_fast64_t archi_trace_start_time;
+
+static _Thread_local struct archi_trace_buffer *archi_trace_local_buffer;
+
+static
+uint64_t
+archi_trace_time_ns(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static
+void
+archi_trace_retire_buffer(
+        void *buffer)
+{
+    atomic_store_explicit(&((struct archi_trace_buffer*)buffer)->retired, true, memory_order_release);
+}
+
+static
+void
+archi_trace_initialize(void)
+{
+    if (mtx_init(&archi_trace_mutex, mtx_plain) != thrd_success)
+        return;
+
+    if (tss_create(&archi_trace_key, archi_trace_retire_buffer) != thrd_success)
+    {
+        mtx_destroy(&archi_trace_mutex);
+        return;
+    }
+
+    archi_trace_initialized = true;
+}
+
+static
+struct archi_trace_buffer*
+archi_trace_register_buffer(void)
+{
+    call_once(&archi_trace_once, archi_trace_initialize);
+    if (!archi_trace_initialized)
+        return NULL;
+
+    size_t capacity = atomic_load_explicit(&archi_trace_capacity, memory_order_relaxed);
+
+    struct archi_trace_buffer *buffer = malloc(sizeof(*buffer) + sizeof(*buffer->event) * capacity);
+    if (buffer == NULL)
+        return NULL;
+
+    buffer->tail = 0;
+    buffer->mask = capacity - 1;
+    atomic_init(&buffer->retired, false);
+    atomic_init(&buffer->head, 0);
+
+    if (tss_set(archi_trace_key, buffer) != thrd_success)
+    {
+        free(buffer);
+        return NULL;
+    }
+
+    mtx_lock(&archi_trace_mutex);
+
+    buffer->id = archi_trace_num_buffers++;
+    buffer->next = archi_trace_buffers;
+    archi_trace_buffers = buffer;
+
+    mtx_unlock(&archi_trace_mutex);
+
+    archi_trace_local_buffer = buffer;
+    return buffer;
+}
+
+bool
+archi_trace_start(
+        archi_trace_start_params_t params,
+        ARCHI_ERROR_PARAM_DECL)
+{
+#ifdef ARCHI_FEATURE_TRACE
+    if (params.capacity == 0)
+        params.capacity = ARCHI_TRACE_DEFAULT_CAPACITY;
+    else if ((params.capacity & (params.capacity - 1)) != 0)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "trace buffer capacity (%zu) is not a power of two",
+                params.capacity);
+        return false;
+    }
+
+    call_once(&archi_trace_once, archi_trace_initialize);
+    if (!archi_trace_initialized)
+    {
+        ARCHI_ERROR_SET(ARCHI__ESYSTEM, "couldn't initialize tracing synchronization primitives");
+        return false;
+    }
+
+    atomic_store_explicit(&archi_trace_capacity, params.capacity, memory_order_relaxed);
+
+    // Keep the time origin of the first start, so that flushed timelines stay consistent
+    uint_fast64_t start_time = 0;
+    atomic_compare_exchange_strong_explicit(&archi_trace_start_time, &start_time,
+            archi_trace_time_ns(), memory_order_relaxed, memory_order_relaxed);
+
+    atomic_store_explicit(&archi_trace_active, true, memory_order_release);
+
+    ARCHI_ERROR_RESET();
+    return true;
+#else
+    (void) params;
+
+    ARCHI_ERROR_SET(ARCHI__ENOTIMPL, "tracing is disabled at build time");
+    return false;
+#endif
+}
+
+void
+archi_trace_stop(void)
+{
+    atomic_store_explicit(&archi_trace_active, false, memory_order_release);
+}
+
+void
+archi_trace_record(
+        archi_trace_event_type_t type,
+        const char *name,
+        const void *object,
+        uint32_t arg)
+{
+    struct archi_trace_buffer *buffer = archi_trace_local_buffer;
+    if (buffer == NULL)
+    {
+        buffer = archi_trace_register_buffer();
+        if (buffer == NULL)
+            return;
+    }
+
+    size_t head = atomic_load_explicit(&buffer->head, memory_order_relaxed);
+
+    // Order the overwriting of the slot after the previous head update,
+    // so that a concurrent flush that reads the new data also sees the head advanced
+    atomic_thread_fence(memory_order_release);
+
+    archi_trace_event_t *event = &buffer->event[head & buffer->mask];
+
+    event->time_ns = archi_trace_time_ns();
+    event->object = object;
+    event->type = type;
+    event->arg = arg;
+
+    // Copy the name, as the string may not outlive the event
+    size_t length = 0;
+    if (name != NULL)
+    {
+        for (; (length < ARCHI_TRACE_EVENT_NAME_SIZE - 1) && (name[length] != '\0'); length++)
+            event->name[length] = name[length];
+    }
+    event->name[length] = '\0';
+
+    atomic_store_explicit(&buffer->head, head + 1, memory_order_release);
+}
+
+/*****************************************************************************/
+
+static
+void
+archi_trace_write_escaped(
+        FILE *file,
+        const char *string)
+{
+    for (; *string != '\0'; string++)
+    {
+        unsigned char c = *string;
+
+        if ((c == '"') || (c == '\\'))
+            fprintf(file, "\\%c", c);
+        else if (c < 0x20)
+            fprintf(file, "\\u%04x", c);
+        else
+            fputc(c, file);
+    }
+}
+
+static
+void
+archi_trace_write_event(
+        FILE *file,
+        const archi_trace_event_t *event,
+        unsigned long tid,
+        uint64_t start_time)
+{
+    const char *category, *phase;
+
+    switch (event->type)
+    {
+        case ARCHI_TRACE__NODE_ENTER:
+            category = "node"; phase = "B"; break;
+        case ARCHI_TRACE__NODE_LEAVE:
+            category = "node"; phase = "E"; break;
+        case ARCHI_TRACE__OPERATION_BEGIN:
+            category = "operation"; phase = "B"; break;
+        case ARCHI_TRACE__OPERATION_END:
+            category = "operation"; phase = "E"; break;
+        case ARCHI_TRACE__DISPATCH:
+            category = "thread_group"; phase = "i"; break;
+        case ARCHI_TRACE__WORK_BEGIN:
+            category = "thread_group"; phase = "B"; break;
+        case ARCHI_TRACE__WORK_END:
+            category = "thread_group"; phase = "E"; break;
+        case ARCHI_TRACE__COMPLETE:
+            category = "thread_group"; phase = "i"; break;
+        case ARCHI_TRACE__LFQUEUE_PUSH_FULL:
+        case ARCHI_TRACE__LFQUEUE_POP_EMPTY:
+            category = "lfqueue"; phase = "i"; break;
+        default:
+            return;
+    }
+
+    uint64_t time_ns = (event->time_ns > start_time) ? event->time_ns - start_time : 0;
+
+    fprintf(file, ",\n{\"name\":\"");
+    archi_trace_write_escaped(file, event->name);
+
+    // Operations are named after their node and sequence index
+    if ((event->type == ARCHI_TRACE__OPERATION_BEGIN) || (event->type == ARCHI_TRACE__OPERATION_END))
+        fprintf(file, "[%lu]", (unsigned long)event->arg);
+
+    fputc('"', file);
+
+    fprintf(file, ",\"cat\":\"%s\",\"ph\":\"%s\",\"ts\":%llu.%03u,\"pid\":1,\"tid\":%lu",
+            category, phase, (unsigned long long)(time_ns / 1000), (unsigned)(time_ns % 1000), tid);
+
+    if (phase[0] == 'i')
+        fprintf(file, ",\"s\":\"t\"");
+
+    fprintf(file, ",\"args\":{\"object\":\"%p\",\"arg\":%lu}}", event->object, (unsigned long)event->arg);
+}
+
+bool
+archi_trace_flush(
+        const char *pathname,
+        ARCHI_ERROR_PARAM_DECL)
+{
+    if (pathname == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "trace output file path is NULL");
+        return false;
+    }
+
+    call_once(&archi_trace_once, archi_trace_initialize);
+    if (!archi_trace_initialized)
+    {
+        ARCHI_ERROR_SET(ARCHI__ESYSTEM, "couldn't initialize tracing synchronization primitives");
+        return false;
+    }
+
+    FILE *file = fopen(pathname, "w");
+    if (file == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ESYSTEM, "couldn't open trace output file '%s'", pathname);
+        return false;
+    }
+
+    uint64_t start_time = atomic_load_explicit(&archi_trace_start_time, memory_order_relaxed);
+
+    fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    fprintf(file, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"archipelago\"}}");
+
+    mtx_lock(&archi_trace_mutex);
+
+    struct archi_trace_buffer **link = &archi_trace_buffers;
+    while (*link != NULL)
+    {
+        struct archi_trace_buffer *buffer = *link;
+
+        // Check retirement before reading the head, so that no events are lost
+        bool retired = atomic_load_explicit(&buffer->retired, memory_order_acquire);
+
+        fprintf(file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%lu,"
+                "\"args\":{\"name\":\"thread #%lu\"}}", buffer->id, buffer->id);
+
+        size_t capacity = buffer->mask + 1;
+        size_t head = atomic_load_explicit(&buffer->head, memory_order_acquire);
+        size_t tail = buffer->tail;
+
+        if (head - tail > capacity)
+            tail = head - capacity;
+
+        for (size_t i = tail; i < head; i++)
+        {
+            archi_trace_event_t event = buffer->event[i & buffer->mask];
+
+            // Order the copying before reloading the head (pairs with the fence in archi_trace_record())
+            atomic_thread_fence(memory_order_acquire);
+
+            // Skip the event if it could have been overwritten while being read:
+            // the writer of event (i + capacity) overwrites the slot before advancing the head past it.
+            // Buffers of exited threads are not written anymore
+            size_t current_head = atomic_load_explicit(&buffer->head, memory_order_relaxed);
+            if (!retired && (current_head - i >= capacity))
+                continue;
+
+            archi_trace_write_event(file, &event, buffer->id, start_time);
+        }
+
+        buffer->tail = head;
+
+        if (retired)
+        {
+            *link = buffer->next;
+            free(buffer);
+        }
+        else
+            link = &buffer->next;
+    }
+
+    mtx_unlock(&archi_trace_mutex);
+
+    fprintf(file, "\n]}\n");
+
+    if (fclose(file) != 0)
+    {
+        ARCHI_ERROR_SET(ARCHI__ESYSTEM, "couldn't write trace output file '%s'", pathname);
+        return false;
+    }
+
+    ARCHI_ERROR_RESET();
+    return true;
+}
+
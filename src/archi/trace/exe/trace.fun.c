@@ -0,0 +1,59 @@
+/*****************************************************************************
+ * Copyright (C) 2023-2026 by Ivan Podmazov                                  *
+ *                                                                           *
+ * This file is part of Archipelago.                                         *
+ *                                                                           *
+ *   Archipelago is free software: you can redistribute it and/or modify it  *
+ *   under the terms of the GNU Lesser General Public License as published   *
+ *   by the Free Software Foundation, either version 3 of the License, or    *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   Archipelago is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU Lesser General Public License for more details.                     *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with Archipelago. If not, see                             *
+ *   <http://www.gnu.org/licenses/>.                                         *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief DEG operation functions for execution tracing.
+ */
+
+#include "archi/trace/exe/trace.fun.h"
+#include "archi/trace/api/trace.fun.h"
+
+
+ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__trace_start)
+{
+    archi_trace_start_params_t params = {0};
+
+    if (data != NULL)
+        params = *(const archi_trace_start_params_t*)data;
+
+    archi_trace_start(params, ARCHI_ERROR_PARAM);
+}
+
+ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__trace_stop)
+{
+    (void) data;
+
+    archi_trace_stop();
+
+    ARCHI_ERROR_RESET();
+}
+
+ARCHI_DEXGRAPH_OPERATION_FUNC(archi_dexgraph_op__trace_flush)
+{
+    if (data == NULL)
+    {
+        ARCHI_ERROR_SET(ARCHI__ECONSTRAINT, "trace output file path is NULL");
+        return;
+    }
+
+    archi_trace_flush(data, ARCHI_ERROR_PARAM);
+}
+
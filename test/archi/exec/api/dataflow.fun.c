@@ -0,0 +1,217 @@
+#include "test.h"
+
+#include "archi/exec/api/dataflow.fun.h"
+#include "archi/exec/api/node.fun.h"
+
+#include <stdatomic.h>
+#include <threads.h>
+#include <time.h>
+
+
+#define NUM_OPERATIONS  8
+#define NUM_WORKERS     4
+
+struct op_data {
+    atomic_size_t *counter;
+    size_t stamp;
+    bool slow;
+};
+
+static
+ARCHI_DEXGRAPH_OPERATION_FUNC(stamp_op)
+{
+    struct op_data *op = data;
+
+    if (op->slow)
+        thrd_sleep(&(struct timespec){.tv_nsec = 2000000}, NULL);
+
+    op->stamp = atomic_fetch_add(op->counter, 1) + 1;
+
+    ARCHI_ERROR_RESET();
+}
+
+static
+ARCHI_DEXGRAPH_OPERATION_FUNC(failing_op)
+{
+    (void) data;
+
+    ARCHI_ERROR_SET(ARCHI__EFAILURE, "operation failed");
+}
+
+static
+int
+worker(
+        void *arg)
+{
+    archi_dexgraph_dataflow_work(arg);
+    return 0;
+}
+
+static
+archi_dexgraph_node_t*
+make_node(
+        struct op_data op[],
+        atomic_size_t *counter,
+        bool slow)
+{
+    archi_dexgraph_node_t *node = archi_dexgraph_node_alloc("dataflow", NUM_OPERATIONS);
+    if (node == NULL)
+        return NULL;
+
+    for (size_t i = 0; i < NUM_OPERATIONS; i++)
+    {
+        op[i] = (struct op_data){.counter = counter, .slow = slow};
+        node->sequence[i] = (archi_dexgraph_operation_t){.function = stamp_op, .data = &op[i]};
+    }
+
+    return node;
+}
+
+TEST(archi_dexgraph_dataflow_create)
+{
+    archi_error_t error;
+
+    atomic_size_t counter = 0;
+    struct op_data op[NUM_OPERATIONS];
+    archi_dexgraph_node_t *node = make_node(op, &counter, false);
+    ASSERT_NE(node, NULL, void*, "%p");
+
+    archi_dexgraph_dataflow_t dataflow;
+
+    // Cycle
+    dataflow = archi_dexgraph_dataflow_create(node, (archi_dexgraph_dataflow_dependency_t[]){
+            {.operation = 1, .dependency = 0},
+            {.operation = 2, .dependency = 1},
+            {.operation = 0, .dependency = 2}}, 3, &error);
+    ASSERT_EQ(dataflow, NULL, void*, "%p");
+    ASSERT_EQ(error.code, ARCHI__ECONSTRAINT, archi_error_code_t, "%i");
+
+    // Self-dependency
+    dataflow = archi_dexgraph_dataflow_create(node, (archi_dexgraph_dataflow_dependency_t[]){
+            {.operation = 3, .dependency = 3}}, 1, &error);
+    ASSERT_EQ(dataflow, NULL, void*, "%p");
+    ASSERT_EQ(error.code, ARCHI__ECONSTRAINT, archi_error_code_t, "%i");
+
+    // Operation out of bounds
+    dataflow = archi_dexgraph_dataflow_create(node, (archi_dexgraph_dataflow_dependency_t[]){
+            {.operation = NUM_OPERATIONS, .dependency = 0}}, 1, &error);
+    ASSERT_EQ(dataflow, NULL, void*, "%p");
+    ASSERT_EQ(error.code, ARCHI__EINDEX, archi_error_code_t, "%i");
+
+    // Acyclic graph
+    dataflow = archi_dexgraph_dataflow_create(node, (archi_dexgraph_dataflow_dependency_t[]){
+            {.operation = 1, .dependency = 0},
+            {.operation = 2, .dependency = 0}}, 2, &error);
+    ASSERT_NE(dataflow, NULL, void*, "%p");
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+    ASSERT_EQ(archi_dexgraph_dataflow_num_operations(dataflow), NUM_OPERATIONS, size_t, "%zu");
+    ASSERT_EQ(archi_dexgraph_dataflow_num_dependencies(dataflow), 2, size_t, "%zu");
+
+    archi_dexgraph_dataflow_destroy(dataflow);
+    archi_dexgraph_node_free(node);
+}
+
+// Diamonds: 0 -> {1, 2} -> 3 -> {4, 5, 6} -> 7
+static const archi_dexgraph_dataflow_dependency_t dependencies[] = {
+    {.operation = 1, .dependency = 0},
+    {.operation = 2, .dependency = 0},
+    {.operation = 3, .dependency = 1},
+    {.operation = 3, .dependency = 2},
+    {.operation = 4, .dependency = 3},
+    {.operation = 5, .dependency = 3},
+    {.operation = 6, .dependency = 3},
+    {.operation = 7, .dependency = 4},
+    {.operation = 7, .dependency = 5},
+    {.operation = 7, .dependency = 6},
+};
+
+#define NUM_DEPENDENCIES    (sizeof(dependencies) / sizeof(dependencies[0]))
+
+TEST(archi_dexgraph_dataflow_execute)
+{
+    archi_error_t error;
+
+    atomic_size_t counter = 0;
+    struct op_data op[NUM_OPERATIONS];
+    archi_dexgraph_node_t *node = make_node(op, &counter, false);
+    ASSERT_NE(node, NULL, void*, "%p");
+
+    archi_dexgraph_dataflow_t dataflow = archi_dexgraph_dataflow_create(node,
+            dependencies, NUM_DEPENDENCIES, &error);
+    ASSERT_NE(dataflow, NULL, void*, "%p");
+
+    for (int run = 0; run < 2; run++)
+    {
+        atomic_store(&counter, 0);
+
+        archi_dexgraph_dataflow_execute(dataflow, &error);
+        ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+        ASSERT_EQ(atomic_load(&counter), NUM_OPERATIONS, size_t, "%zu");
+
+        for (size_t i = 0; i < NUM_DEPENDENCIES; i++)
+            ASSERT_LT(op[dependencies[i].dependency].stamp, op[dependencies[i].operation].stamp, size_t, "%zu");
+    }
+
+    // Failure stops the execution
+    node->sequence[3].function = failing_op;
+    archi_dexgraph_dataflow_destroy(dataflow);
+
+    dataflow = archi_dexgraph_dataflow_create(node, dependencies, NUM_DEPENDENCIES, &error);
+    ASSERT_NE(dataflow, NULL, void*, "%p");
+
+    atomic_store(&counter, 0);
+
+    archi_dexgraph_dataflow_execute(dataflow, &error);
+    ASSERT_EQ(error.code, ARCHI__EFAILURE, archi_error_code_t, "%i");
+    ASSERT_EQ(atomic_load(&counter), 3, size_t, "%zu");
+
+    archi_dexgraph_dataflow_destroy(dataflow);
+    archi_dexgraph_node_free(node);
+}
+
+TEST(archi_dexgraph_dataflow_work)
+{
+    archi_error_t error;
+
+    atomic_size_t counter = 0;
+    struct op_data op[NUM_OPERATIONS];
+    archi_dexgraph_node_t *node = make_node(op, &counter, true);
+    ASSERT_NE(node, NULL, void*, "%p");
+
+    archi_dexgraph_dataflow_t dataflow = archi_dexgraph_dataflow_create(node,
+            dependencies, NUM_DEPENDENCIES, &error);
+    ASSERT_NE(dataflow, NULL, void*, "%p");
+
+    clock_t cpu_begin = clock();
+    struct timespec wall_begin, wall_end;
+    timespec_get(&wall_begin, TIME_UTC);
+
+    archi_dexgraph_dataflow_begin(dataflow);
+
+    thrd_t thread[NUM_WORKERS];
+    for (int i = 0; i < NUM_WORKERS; i++)
+        ASSERT_EQ(thrd_create(&thread[i], worker, dataflow), thrd_success, int, "%i");
+
+    for (int i = 0; i < NUM_WORKERS; i++)
+        thrd_join(thread[i], NULL);
+
+    archi_dexgraph_dataflow_end(dataflow, &error);
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+
+    timespec_get(&wall_end, TIME_UTC);
+    clock_t cpu_end = clock();
+
+    ASSERT_EQ(atomic_load(&counter), NUM_OPERATIONS, size_t, "%zu");
+
+    for (size_t i = 0; i < NUM_DEPENDENCIES; i++)
+        ASSERT_LT(op[dependencies[i].dependency].stamp, op[dependencies[i].operation].stamp, size_t, "%zu");
+
+    // Workers without ready operations sleep instead of spinning
+    double cpu_time = (double)(cpu_end - cpu_begin) / CLOCKS_PER_SEC;
+    double wall_time = (double)(wall_end.tv_sec - wall_begin.tv_sec) +
+        (double)(wall_end.tv_nsec - wall_begin.tv_nsec) / 1e9;
+    ASSERT_LT(cpu_time, wall_time / 2, double, "%f");
+
+    archi_dexgraph_dataflow_destroy(dataflow);
+    archi_dexgraph_node_free(node);
+}
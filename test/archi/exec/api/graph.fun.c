@@ -0,0 +1,185 @@
+#include "test.h"
+
+#include "archi/exec/api/graph.fun.h"
+#include "archi/exec/api/node.fun.h"
+
+#include <string.h>
+#include <threads.h>
+#include <time.h>
+
+
+struct log {
+    char text[32];
+    size_t length;
+};
+
+struct log_data {
+    struct log *log;
+    char symbol;
+};
+
+static
+ARCHI_DEXGRAPH_OPERATION_FUNC(log_op)
+{
+    struct log_data *log = data;
+
+    if (log->log->length < sizeof(log->log->text) - 1)
+        log->log->text[log->log->length++] = log->symbol;
+
+    ARCHI_ERROR_RESET();
+}
+
+TEST(archi_dexgraph_execute_budgeted__operations)
+{
+    archi_error_t error;
+
+    // A: a, _, b, c -> B: d, e -> halt
+    struct log log = {0};
+    struct log_data symbol[5];
+    for (int i = 0; i < 5; i++)
+        symbol[i] = (struct log_data){.log = &log, .symbol = 'a' + i};
+
+    archi_dexgraph_node_t *a = archi_dexgraph_node_alloc("A", 4);
+    archi_dexgraph_node_t *b = archi_dexgraph_node_alloc("B", 2);
+    archi_dexgraph_node_array_t *branch = archi_dexgraph_node_array_alloc(1);
+    ASSERT_NE(a, NULL, void*, "%p");
+    ASSERT_NE(b, NULL, void*, "%p");
+    ASSERT_NE(branch, NULL, void*, "%p");
+
+    a->sequence[0] = (archi_dexgraph_operation_t){.function = log_op, .data = &symbol[0]};
+    a->sequence[2] = (archi_dexgraph_operation_t){.function = log_op, .data = &symbol[1]};
+    a->sequence[3] = (archi_dexgraph_operation_t){.function = log_op, .data = &symbol[2]};
+    b->sequence[0] = (archi_dexgraph_operation_t){.function = log_op, .data = &symbol[3]};
+    b->sequence[1] = (archi_dexgraph_operation_t){.function = log_op, .data = &symbol[4]};
+
+    branch->node[0] = b;
+    a->branch = branch;
+
+    archi_dexgraph_branch_index_t halt = ARCHI_DEXGRAPH_HALT;
+    b->transition = (archi_dexgraph_transition_t){.data = &halt};
+
+    // Budget is required
+    archi_dexgraph_frame_t frame = archi_dexgraph_execute_budgeted(
+            (archi_dexgraph_frame_t){.node = a}, ARCHI_DEXGRAPH__NO_INTERRUPT, NULL, &error);
+    ASSERT_EQ(error.code, ARCHI__ECONSTRAINT, archi_error_code_t, "%i");
+
+    // Empty operation slots are not counted
+    archi_dexgraph_budget_t budget = {.max_operations = 2};
+
+    frame = archi_dexgraph_execute_budgeted(
+            (archi_dexgraph_frame_t){.node = a}, ARCHI_DEXGRAPH__NO_INTERRUPT, &budget, &error);
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+    ASSERT_EQ(budget.num_operations, 2, size_t, "%zu");
+    ASSERT_EQ(frame.node, a, void*, "%p");
+    ASSERT_EQ(frame.index, 3, size_t, "%zu");
+    ASSERT_EQ(strcmp(log.text, "ab"), 0, int, "%i");
+
+    // Execution resumes exactly where it stopped, across the node transition
+    frame = archi_dexgraph_execute_budgeted(frame, ARCHI_DEXGRAPH__NO_INTERRUPT, &budget, &error);
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+    ASSERT_EQ(budget.num_operations, 2, size_t, "%zu");
+    ASSERT_EQ(frame.node, b, void*, "%p");
+    ASSERT_EQ(frame.index, 1, size_t, "%zu");
+    ASSERT_EQ(strcmp(log.text, "abcd"), 0, int, "%i");
+
+    frame = archi_dexgraph_execute_budgeted(frame, ARCHI_DEXGRAPH__NO_INTERRUPT, &budget, &error);
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+    ASSERT_EQ(budget.num_operations, 1, size_t, "%zu");
+    ASSERT_EQ(frame.node, NULL, void*, "%p");
+    ASSERT_EQ(strcmp(log.text, "abcde"), 0, int, "%i");
+
+    // Unlimited budget runs the graph to the end
+    log = (struct log){0};
+    budget = (archi_dexgraph_budget_t){0};
+
+    frame = archi_dexgraph_execute_budgeted(
+            (archi_dexgraph_frame_t){.node = a}, ARCHI_DEXGRAPH__NO_INTERRUPT, &budget, &error);
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+    ASSERT_EQ(budget.num_operations, 5, size_t, "%zu");
+    ASSERT_EQ(frame.node, NULL, void*, "%p");
+    ASSERT_EQ(strcmp(log.text, "abcde"), 0, int, "%i");
+
+    archi_dexgraph_node_free(a);
+    archi_dexgraph_node_free(b);
+    archi_dexgraph_node_array_free(branch);
+}
+
+static
+ARCHI_DEXGRAPH_OPERATION_FUNC(sleep_op)
+{
+    (void) data;
+
+    thrd_sleep(&(struct timespec){.tv_nsec = 1000000}, NULL);
+
+    ARCHI_ERROR_RESET();
+}
+
+static
+uint64_t
+time_ns(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+TEST(archi_dexgraph_execute_budgeted__deadline)
+{
+    archi_error_t error;
+
+    archi_dexgraph_node_array_t *branch = archi_dexgraph_node_array_alloc(1);
+    ASSERT_NE(branch, NULL, void*, "%p");
+
+    // A node without operations branching to itself (e.g. polling a flag)
+    archi_dexgraph_node_t *poll = archi_dexgraph_node_alloc("poll", 0);
+    ASSERT_NE(poll, NULL, void*, "%p");
+
+    branch->node[0] = poll;
+    poll->branch = branch;
+
+    archi_dexgraph_budget_t budget = {.time_limit_ns = 1000000};
+
+    uint64_t start = time_ns();
+    archi_dexgraph_frame_t frame = archi_dexgraph_execute_budgeted(
+            (archi_dexgraph_frame_t){.node = poll}, ARCHI_DEXGRAPH__NO_INTERRUPT, &budget, &error);
+    uint64_t elapsed = time_ns() - start;
+
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+    ASSERT_EQ(budget.num_operations, 0, size_t, "%zu");
+    ASSERT_EQ(frame.node, poll, void*, "%p");
+    ASSERT_EQ(frame.index, 0, size_t, "%zu");
+    ASSERT_TRUE(elapsed >= 1000000);
+    ASSERT_TRUE(elapsed < 1000000000);
+
+    archi_dexgraph_node_free(poll);
+
+    // A looping node with slow operations is interrupted mid-node
+    archi_dexgraph_node_t *work = archi_dexgraph_node_alloc("work", 3);
+    ASSERT_NE(work, NULL, void*, "%p");
+
+    for (int i = 0; i < 3; i++)
+        work->sequence[i] = (archi_dexgraph_operation_t){.function = sleep_op};
+
+    branch->node[0] = work;
+    work->branch = branch;
+
+    budget = (archi_dexgraph_budget_t){.time_limit_ns = 10000000, .check_period = 1};
+
+    start = time_ns();
+    frame = archi_dexgraph_execute_budgeted(
+            (archi_dexgraph_frame_t){.node = work}, ARCHI_DEXGRAPH__NO_INTERRUPT, &budget, &error);
+    elapsed = time_ns() - start;
+
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+    ASSERT_EQ(frame.node, work, void*, "%p");
+    ASSERT_TRUE(budget.num_operations >= 1);
+    ASSERT_TRUE(budget.num_operations <= 10);
+    ASSERT_TRUE(elapsed >= 10000000);
+    ASSERT_TRUE(elapsed < 1000000000);
+
+    // The interruption point follows the count (end of the node, or the next node's frame)
+    ASSERT_EQ(frame.index % 3, budget.num_operations % 3, size_t, "%zu");
+
+    archi_dexgraph_node_free(work);
+    archi_dexgraph_node_array_free(branch);
+}
@@ -0,0 +1,134 @@
+#include "test.h"
+
+#include "archi/exec/api/profile.fun.h"
+#include "archi/exec/api/graph.fun.h"
+#include "archi/exec/api/node.fun.h"
+
+#include <inttypes.h>
+
+
+TEST(archi_dexgraph_profile_record)
+{
+    archi_dexgraph_profile_t profile = archi_dexgraph_profile_alloc();
+    ASSERT_NE(profile, NULL, void*, "%p");
+    ASSERT_EQ(archi_dexgraph_profile_num_entries(profile), 0, size_t, "%zu");
+
+    // Nodes are only used as keys
+    char node[2];
+    const struct archi_dexgraph_node *node_a = (const void*)&node[0], *node_b = (const void*)&node[1];
+
+    ASSERT_TRUE(archi_dexgraph_profile_record(profile, node_a, 1, 30));
+    ASSERT_TRUE(archi_dexgraph_profile_record(profile, node_b, 0, 5));
+    ASSERT_TRUE(archi_dexgraph_profile_record(profile, node_a, 1, 10));
+    ASSERT_TRUE(archi_dexgraph_profile_record(profile, node_a, 0, 7));
+    ASSERT_TRUE(archi_dexgraph_profile_record(profile, node_a, 1, 20));
+
+    // Calls of the same operation are accumulated, entries are ordered by first recording
+    ASSERT_EQ(archi_dexgraph_profile_num_entries(profile), 3, size_t, "%zu");
+
+    const archi_dexgraph_profile_entry_t *entry = archi_dexgraph_profile_entries(profile);
+    ASSERT_NE(entry, NULL, const void*, "%p");
+
+    ASSERT_EQ(entry[0].node, node_a, const void*, "%p");
+    ASSERT_EQ(entry[0].index, 1, size_t, "%zu");
+    ASSERT_EQ(entry[0].num_calls, 3, uint64_t, "%" PRIu64);
+    ASSERT_EQ(entry[0].total_ns, 60, uint64_t, "%" PRIu64);
+    ASSERT_EQ(entry[0].min_ns, 10, uint64_t, "%" PRIu64);
+    ASSERT_EQ(entry[0].max_ns, 30, uint64_t, "%" PRIu64);
+
+    ASSERT_EQ(entry[1].node, node_b, const void*, "%p");
+    ASSERT_EQ(entry[1].index, 0, size_t, "%zu");
+    ASSERT_EQ(entry[1].num_calls, 1, uint64_t, "%" PRIu64);
+
+    ASSERT_EQ(entry[2].node, node_a, const void*, "%p");
+    ASSERT_EQ(entry[2].index, 0, size_t, "%zu");
+    ASSERT_EQ(entry[2].total_ns, 7, uint64_t, "%" PRIu64);
+
+    // Many entries survive growth of the profile
+    for (size_t i = 0; i < 1000; i++)
+        ASSERT_TRUE(archi_dexgraph_profile_record(profile, node_b, i + 1, i));
+
+    for (size_t i = 0; i < 1000; i++)
+        ASSERT_TRUE(archi_dexgraph_profile_record(profile, node_b, i + 1, i));
+
+    ASSERT_EQ(archi_dexgraph_profile_num_entries(profile), 1003, size_t, "%zu");
+
+    entry = archi_dexgraph_profile_entries(profile);
+    for (size_t i = 0; i < 1000; i++)
+    {
+        ASSERT_EQ(entry[3 + i].index, i + 1, size_t, "%zu");
+        ASSERT_EQ(entry[3 + i].num_calls, 2, uint64_t, "%" PRIu64);
+        ASSERT_EQ(entry[3 + i].total_ns, 2 * i, uint64_t, "%" PRIu64);
+    }
+
+    archi_dexgraph_profile_reset(profile);
+    ASSERT_EQ(archi_dexgraph_profile_num_entries(profile), 0, size_t, "%zu");
+
+    archi_dexgraph_profile_free(profile);
+}
+
+static
+ARCHI_DEXGRAPH_OPERATION_FUNC(nop)
+{
+    (void) data;
+
+    ARCHI_ERROR_RESET();
+}
+
+TEST(archi_dexgraph_execute_profiled)
+{
+    archi_error_t error;
+
+    archi_dexgraph_node_t *node = archi_dexgraph_node_alloc("node", 3);
+    ASSERT_NE(node, NULL, void*, "%p");
+
+    archi_dexgraph_node_array_t *branch = archi_dexgraph_node_array_alloc(1);
+    ASSERT_NE(branch, NULL, void*, "%p");
+
+    // Loop over the node 4 times
+    archi_dexgraph_transition_loop_t loop = {.num_iterations = 4};
+
+    node->sequence[0] = (archi_dexgraph_operation_t){.function = nop};
+    node->sequence[2] = (archi_dexgraph_operation_t){.function = nop};
+    node->transition = (archi_dexgraph_transition_t){.kind = ARCHI_DEXGRAPH_TRANSITION__LOOP, .data = &loop};
+    branch->node[0] = node;
+    node->branch = branch;
+
+    archi_dexgraph_profile_t profile = archi_dexgraph_profile_alloc();
+    ASSERT_NE(profile, NULL, void*, "%p");
+
+    archi_dexgraph_execute_profiled((archi_dexgraph_frame_t){.node = node},
+            ARCHI_DEXGRAPH__NO_INTERRUPT, NULL, &error);
+    ASSERT_NE(error.code, 0, archi_error_code_t, "%i");
+
+    archi_dexgraph_frame_t frame = archi_dexgraph_execute_profiled((archi_dexgraph_frame_t){.node = node},
+            ARCHI_DEXGRAPH__NO_INTERRUPT, profile, &error);
+
+#ifdef ARCHI_FEATURE_DEXGRAPH_PROFILE
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+    ASSERT_EQ(frame.node, NULL, const void*, "%p");
+
+    // Null operations are not recorded, the transition is recorded at the sequence length
+    ASSERT_EQ(archi_dexgraph_profile_num_entries(profile), 3, size_t, "%zu");
+
+    const archi_dexgraph_profile_entry_t *entry = archi_dexgraph_profile_entries(profile);
+    size_t index[] = {0, 2, 3};
+
+    for (size_t i = 0; i < 3; i++)
+    {
+        ASSERT_EQ(entry[i].node, node, const void*, "%p");
+        ASSERT_EQ(entry[i].index, index[i], size_t, "%zu");
+        ASSERT_EQ(entry[i].num_calls, 4, uint64_t, "%" PRIu64);
+        ASSERT_LE(entry[i].min_ns, entry[i].max_ns, uint64_t, "%" PRIu64);
+        ASSERT_LE(entry[i].max_ns, entry[i].total_ns, uint64_t, "%" PRIu64);
+    }
+#else
+    ASSERT_EQ(error.code, ARCHI__ENOTIMPL, archi_error_code_t, "%i");
+    ASSERT_EQ(frame.node, node, const void*, "%p");
+    ASSERT_EQ(archi_dexgraph_profile_num_entries(profile), 0, size_t, "%zu");
+#endif
+
+    archi_dexgraph_profile_free(profile);
+    archi_dexgraph_node_array_free(branch);
+    archi_dexgraph_node_free(node);
+}
@@ -0,0 +1,566 @@
+#include "test.h"
+
+#include "archi/exec/api/program.fun.h"
+#include "archi/exec/api/graph.fun.h"
+#include "archi/exec/api/node.fun.h"
+
+#include <stdatomic.h>
+#include <string.h>
+
+
+struct graph_state {
+    char log[64];
+    size_t log_length;
+
+    size_t value; // switch value
+    archi_dexgraph_transition_loop_t loop;
+    bool fail;
+};
+
+struct log_data {
+    struct graph_state *state;
+    char symbol;
+};
+
+static
+ARCHI_DEXGRAPH_OPERATION_FUNC(log_op)
+{
+    struct log_data *log = data;
+
+    if (log->state->log_length < sizeof(log->state->log) - 1)
+        log->state->log[log->state->log_length++] = log->symbol;
+
+    ARCHI_ERROR_RESET();
+}
+
+static
+ARCHI_DEXGRAPH_OPERATION_FUNC(increment_op)
+{
+    struct graph_state *state = data;
+
+    state->value++;
+
+    if (state->fail && (state->value == 2))
+    {
+        ARCHI_ERROR_SET(ARCHI__EFAILURE, "operation failed");
+        return;
+    }
+
+    ARCHI_ERROR_RESET();
+}
+
+struct graph {
+    struct graph_state state;
+    struct log_data log[5];
+
+    archi_dexgraph_branch_index_t table[3];
+    archi_dexgraph_transition_switch_t sw;
+    archi_dexgraph_branch_index_t branch_back, branch_none;
+
+    archi_dexgraph_node_t *node[4];
+    archi_dexgraph_node_array_t *branch[3];
+};
+
+/*
+ * A: a, _, b; loop 3 times, then B
+ * B: c; switch on value {0 -> C, 1 -> C, 2 -> D}
+ * C: d, ++value; back to B
+ * D: e; halt via non-existent branch
+ */
+static
+bool
+make_graph(
+        struct graph *graph)
+{
+    *graph = (struct graph){
+        .state = {.loop = {.num_iterations = 3}},
+        .table = {0, 0, 1},
+        .branch_back = 0,
+        .branch_none = 5,
+    };
+
+    graph->sw = (archi_dexgraph_transition_switch_t){
+        .value = &graph->state.value,
+        .table = graph->table,
+        .table_size = 3,
+        .default_branch = ARCHI_DEXGRAPH_HALT,
+    };
+
+    for (int i = 0; i < 5; i++)
+        graph->log[i] = (struct log_data){.state = &graph->state, .symbol = 'a' + i};
+
+    graph->node[0] = archi_dexgraph_node_alloc("A", 3);
+    graph->node[1] = archi_dexgraph_node_alloc("B", 1);
+    graph->node[2] = archi_dexgraph_node_alloc("C", 2);
+    graph->node[3] = archi_dexgraph_node_alloc("D", 1);
+
+    for (int i = 0; i < 3; i++)
+        graph->branch[i] = archi_dexgraph_node_array_alloc(2);
+
+    for (int i = 0; i < 4; i++)
+        if (graph->node[i] == NULL)
+            return false;
+
+    for (int i = 0; i < 3; i++)
+        if (graph->branch[i] == NULL)
+            return false;
+
+    archi_dexgraph_node_t *a = graph->node[0], *b = graph->node[1], *c = graph->node[2], *d = graph->node[3];
+
+    a->sequence[0] = (archi_dexgraph_operation_t){.function = log_op, .data = &graph->log[0]};
+    a->sequence[2] = (archi_dexgraph_operation_t){.function = log_op, .data = &graph->log[1]};
+    a->transition = (archi_dexgraph_transition_t){
+        .kind = ARCHI_DEXGRAPH_TRANSITION__LOOP, .data = &graph->state.loop};
+    graph->branch[0]->node[0] = a;
+    graph->branch[0]->node[1] = b;
+    a->branch = graph->branch[0];
+
+    b->sequence[0] = (archi_dexgraph_operation_t){.function = log_op, .data = &graph->log[2]};
+    b->transition = (archi_dexgraph_transition_t){
+        .kind = ARCHI_DEXGRAPH_TRANSITION__SWITCH, .data = &graph->sw};
+    graph->branch[1]->node[0] = c;
+    graph->branch[1]->node[1] = d;
+    b->branch = graph->branch[1];
+
+    c->sequence[0] = (archi_dexgraph_operation_t){.function = log_op, .data = &graph->log[3]};
+    c->sequence[1] = (archi_dexgraph_operation_t){.function = increment_op, .data = &graph->state};
+    c->transition = (archi_dexgraph_transition_t){.data = &graph->branch_back};
+    graph->branch[2]->node[0] = b;
+    graph->branch[2]->node[1] = NULL;
+    c->branch = graph->branch[2];
+
+    d->sequence[0] = (archi_dexgraph_operation_t){.function = log_op, .data = &graph->log[4]};
+    d->transition = (archi_dexgraph_transition_t){.data = &graph->branch_none};
+    d->branch = graph->branch[2];
+
+    return true;
+}
+
+static
+void
+free_graph(
+        struct graph *graph)
+{
+    for (int i = 0; i < 4; i++)
+        archi_dexgraph_node_free(graph->node[i]);
+
+    for (int i = 0; i < 3; i++)
+        archi_dexgraph_node_array_free(graph->branch[i]);
+}
+
+static
+void
+reset_state(
+        struct graph *graph)
+{
+    graph->state.log_length = 0;
+    memset(graph->state.log, 0, sizeof(graph->state.log));
+    graph->state.value = 0;
+    graph->state.loop.iteration = 0;
+}
+
+TEST(archi_dexgraph_program_compile)
+{
+    archi_error_t error;
+
+    struct graph graph;
+    ASSERT_TRUE(make_graph(&graph));
+
+    archi_dexgraph_program_t program = archi_dexgraph_program_compile(NULL, &error);
+    ASSERT_EQ(program, NULL, void*, "%p");
+    ASSERT_NE(error.code, 0, archi_error_code_t, "%i");
+
+    program = archi_dexgraph_program_compile(graph.node[0], &error);
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+    ASSERT_NE(program, NULL, void*, "%p");
+
+    // Null operations are skipped, every node gets a transition instruction
+    ASSERT_EQ(archi_dexgraph_program_num_nodes(program), 4, size_t, "%zu");
+    ASSERT_EQ(archi_dexgraph_program_length(program), 2 + 1 + 2 + 1 + 4, size_t, "%zu");
+
+    // The entry node is the first
+    ASSERT_EQ(archi_dexgraph_program_position(program,
+                (archi_dexgraph_frame_t){.node = graph.node[0]}), 0, size_t, "%zu");
+
+    // Null operation is resolved to the next one
+    archi_dexgraph_program_position_t position = archi_dexgraph_program_position(program,
+            (archi_dexgraph_frame_t){.node = graph.node[0], .index = 1});
+    archi_dexgraph_frame_t frame = archi_dexgraph_program_frame(program, position);
+    ASSERT_EQ(frame.node, graph.node[0], const void*, "%p");
+    ASSERT_EQ(frame.index, 2, size_t, "%zu");
+
+    // Positions and frames convert back and forth
+    for (int i = 0; i < 4; i++)
+    {
+        position = archi_dexgraph_program_position(program, (archi_dexgraph_frame_t){.node = graph.node[i]});
+        ASSERT_NE(position, ARCHI_DEXGRAPH_PROGRAM_END, size_t, "%zu");
+
+        frame = archi_dexgraph_program_frame(program, position);
+        ASSERT_EQ(frame.node, graph.node[i], const void*, "%p");
+        ASSERT_EQ(frame.index, 0, size_t, "%zu");
+    }
+
+    frame = archi_dexgraph_program_frame(program, ARCHI_DEXGRAPH_PROGRAM_END);
+    ASSERT_EQ(frame.node, NULL, const void*, "%p");
+
+    archi_dexgraph_program_free(program);
+    free_graph(&graph);
+}
+
+TEST(archi_dexgraph_program_execute)
+{
+    archi_error_t error;
+
+    struct graph graph;
+    ASSERT_TRUE(make_graph(&graph));
+
+    archi_dexgraph_program_t program = archi_dexgraph_program_compile(graph.node[0], &error);
+    ASSERT_NE(program, NULL, void*, "%p");
+
+    // Interpreted graph
+    reset_state(&graph);
+
+    archi_dexgraph_frame_t frame = archi_dexgraph_execute(
+            (archi_dexgraph_frame_t){.node = graph.node[0]}, ARCHI_DEXGRAPH__NO_INTERRUPT, &error);
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+    ASSERT_EQ(frame.node, NULL, const void*, "%p");
+
+    char expected[sizeof(graph.state.log)];
+    memcpy(expected, graph.state.log, sizeof(expected));
+    ASSERT_EQ(strcmp(expected, "abababcdcdce"), 0, int, "%i");
+
+    // Compiled program
+    reset_state(&graph);
+
+    archi_dexgraph_program_position_t position = archi_dexgraph_program_execute(program, 0,
+            ARCHI_DEXGRAPH__NO_INTERRUPT, &error);
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+    ASSERT_EQ(position, ARCHI_DEXGRAPH_PROGRAM_END, size_t, "%zu");
+    ASSERT_EQ(strcmp(graph.state.log, expected), 0, int, "%i");
+
+    // Compiled program interrupted at every operation and transition, resumed by the position
+    for (int mode = ARCHI_DEXGRAPH__INTERRUPT_TRANSITION; mode <= ARCHI_DEXGRAPH__INTERRUPT_OPERATION; mode++)
+    {
+        reset_state(&graph);
+
+        position = 0;
+        size_t num_interrupts = 0;
+
+        do
+        {
+            position = archi_dexgraph_program_execute(program, position, mode, &error);
+            ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+            num_interrupts++;
+        }
+        while (position != ARCHI_DEXGRAPH_PROGRAM_END);
+
+        ASSERT_EQ(strcmp(graph.state.log, expected), 0, int, "%i");
+        ASSERT_GT(num_interrupts, 1, size_t, "%zu");
+    }
+
+    archi_dexgraph_program_free(program);
+    free_graph(&graph);
+}
+
+TEST(archi_dexgraph_program_execute__error)
+{
+    archi_error_t error;
+
+    struct graph graph;
+    ASSERT_TRUE(make_graph(&graph));
+    graph.state.fail = true;
+
+    archi_dexgraph_program_t program = archi_dexgraph_program_compile(graph.node[0], &error);
+    ASSERT_NE(program, NULL, void*, "%p");
+
+    reset_state(&graph);
+
+    archi_dexgraph_frame_t frame = archi_dexgraph_execute(
+            (archi_dexgraph_frame_t){.node = graph.node[0]}, ARCHI_DEXGRAPH__NO_INTERRUPT, &error);
+    ASSERT_EQ(error.code, ARCHI__EFAILURE, archi_error_code_t, "%i");
+
+    char expected[sizeof(graph.state.log)];
+    memcpy(expected, graph.state.log, sizeof(expected));
+
+    reset_state(&graph);
+
+    // The program stops at the same operation with the same error
+    archi_dexgraph_program_position_t position = archi_dexgraph_program_execute(program, 0,
+            ARCHI_DEXGRAPH__NO_INTERRUPT, &error);
+    ASSERT_EQ(error.code, ARCHI__EFAILURE, archi_error_code_t, "%i");
+    ASSERT_EQ(strcmp(graph.state.log, expected), 0, int, "%i");
+
+    archi_dexgraph_frame_t program_frame = archi_dexgraph_program_frame(program, position);
+    ASSERT_EQ(program_frame.node, frame.node, const void*, "%p");
+    ASSERT_EQ(program_frame.index, frame.index, size_t, "%zu");
+
+    archi_dexgraph_program_free(program);
+    free_graph(&graph);
+}
+
+struct flag_state {
+    char log[64];
+    size_t log_length;
+
+    size_t counter;
+    atomic_bool flag, signal;
+
+    size_t value; // switch value
+    archi_dexgraph_branch_index_t table[2];
+    archi_dexgraph_transition_switch_t sw;
+};
+
+struct flag_log_data {
+    struct flag_state *state;
+    char symbol;
+};
+
+static
+ARCHI_DEXGRAPH_OPERATION_FUNC(flag_log_op)
+{
+    struct flag_log_data *log = data;
+
+    if (log->state->log_length < sizeof(log->state->log) - 1)
+        log->state->log[log->state->log_length++] = log->symbol;
+
+    ARCHI_ERROR_RESET();
+}
+
+static
+ARCHI_DEXGRAPH_OPERATION_FUNC(raise_flag_op)
+{
+    struct flag_state *state = data;
+
+    // Raise the flag on every third call
+    if (++state->counter % 3 == 0)
+        atomic_store(&state->flag, true);
+
+    ARCHI_ERROR_RESET();
+}
+
+struct flag_graph {
+    struct flag_state state;
+    struct flag_log_data log[5];
+
+    archi_dexgraph_node_t *node[5];
+    archi_dexgraph_node_array_t *branch[4];
+};
+
+/*
+ * X: x, raise flag every third time; atomic flag {0 -> X, 1 -> Y}
+ * Y: y; signal flag on the same (cleared) flag {0 -> Z, 1 -> halt}
+ * Z: z; signal flag on a raised signal {0 -> halt, 1 -> W}
+ * W: w; switch on value {0 -> halt, 1 -> halt, default -> V}
+ * V: v; signal flag on a raised signal again {0 -> halt, 1 -> halt}
+ */
+static
+bool
+make_flag_graph(
+        struct flag_graph *graph)
+{
+    *graph = (struct flag_graph){
+        .state = {.table = {ARCHI_DEXGRAPH_HALT, ARCHI_DEXGRAPH_HALT}},
+    };
+
+    graph->state.sw = (archi_dexgraph_transition_switch_t){
+        .value = &graph->state.value,
+        .table = graph->state.table,
+        .table_size = 2,
+        .default_branch = 0,
+    };
+
+    for (int i = 0; i < 5; i++)
+        graph->log[i] = (struct flag_log_data){.state = &graph->state, .symbol = "xyzwv"[i]};
+
+    graph->node[0] = archi_dexgraph_node_alloc("X", 2);
+    graph->node[1] = archi_dexgraph_node_alloc("Y", 1);
+    graph->node[2] = archi_dexgraph_node_alloc("Z", 1);
+    graph->node[3] = archi_dexgraph_node_alloc("W", 1);
+    graph->node[4] = archi_dexgraph_node_alloc("V", 1);
+
+    for (int i = 0; i < 4; i++)
+        graph->branch[i] = archi_dexgraph_node_array_alloc(2);
+
+    for (int i = 0; i < 5; i++)
+        if (graph->node[i] == NULL)
+            return false;
+
+    for (int i = 0; i < 4; i++)
+        if (graph->branch[i] == NULL)
+            return false;
+
+    archi_dexgraph_node_t *x = graph->node[0], *y = graph->node[1], *z = graph->node[2],
+                          *w = graph->node[3], *v = graph->node[4];
+
+    x->sequence[0] = (archi_dexgraph_operation_t){.function = flag_log_op, .data = &graph->log[0]};
+    x->sequence[1] = (archi_dexgraph_operation_t){.function = raise_flag_op, .data = &graph->state};
+    x->transition = (archi_dexgraph_transition_t){
+        .kind = ARCHI_DEXGRAPH_TRANSITION__ATOMIC_FLAG, .data = &graph->state.flag};
+    graph->branch[0]->node[0] = x;
+    graph->branch[0]->node[1] = y;
+    x->branch = graph->branch[0];
+
+    y->sequence[0] = (archi_dexgraph_operation_t){.function = flag_log_op, .data = &graph->log[1]};
+    y->transition = (archi_dexgraph_transition_t){
+        .kind = ARCHI_DEXGRAPH_TRANSITION__SIGNAL_FLAG, .data = &graph->state.flag};
+    graph->branch[1]->node[0] = z;
+    y->branch = graph->branch[1];
+
+    z->sequence[0] = (archi_dexgraph_operation_t){.function = flag_log_op, .data = &graph->log[2]};
+    z->transition = (archi_dexgraph_transition_t){
+        .kind = ARCHI_DEXGRAPH_TRANSITION__SIGNAL_FLAG, .data = &graph->state.signal};
+    graph->branch[2]->node[1] = w;
+    z->branch = graph->branch[2];
+
+    w->sequence[0] = (archi_dexgraph_operation_t){.function = flag_log_op, .data = &graph->log[3]};
+    w->transition = (archi_dexgraph_transition_t){
+        .kind = ARCHI_DEXGRAPH_TRANSITION__SWITCH, .data = &graph->state.sw};
+    graph->branch[3]->node[0] = v;
+    w->branch = graph->branch[3];
+
+    v->sequence[0] = (archi_dexgraph_operation_t){.function = flag_log_op, .data = &graph->log[4]};
+    v->transition = (archi_dexgraph_transition_t){
+        .kind = ARCHI_DEXGRAPH_TRANSITION__SIGNAL_FLAG, .data = &graph->state.signal};
+
+    return true;
+}
+
+static
+void
+free_flag_graph(
+        struct flag_graph *graph)
+{
+    for (int i = 0; i < 5; i++)
+        archi_dexgraph_node_free(graph->node[i]);
+
+    for (int i = 0; i < 4; i++)
+        archi_dexgraph_node_array_free(graph->branch[i]);
+}
+
+static
+void
+reset_flag_state(
+        struct flag_graph *graph,
+        size_t value)
+{
+    graph->state.log_length = 0;
+    memset(graph->state.log, 0, sizeof(graph->state.log));
+    graph->state.counter = 0;
+    atomic_store(&graph->state.flag, false);
+    atomic_store(&graph->state.signal, true);
+    graph->state.value = value;
+}
+
+TEST(archi_dexgraph_program_execute__flags)
+{
+    archi_error_t error;
+
+    struct flag_graph graph;
+    ASSERT_TRUE(make_flag_graph(&graph));
+
+    archi_dexgraph_program_t program = archi_dexgraph_program_compile(graph.node[0], &error);
+    ASSERT_NE(program, NULL, void*, "%p");
+
+    // Switch value out of the table selects the default branch,
+    // switch value in the table selects halting
+    static const struct {
+        size_t value;
+        const char *log;
+    } run[] = {{2, "xxxyzwv"}, {100, "xxxyzwv"}, {1, "xxxyzw"}};
+
+    for (size_t r = 0; r < sizeof(run) / sizeof(run[0]); r++)
+    {
+        // Interpreted graph
+        reset_flag_state(&graph, run[r].value);
+
+        archi_dexgraph_frame_t frame = archi_dexgraph_execute(
+                (archi_dexgraph_frame_t){.node = graph.node[0]}, ARCHI_DEXGRAPH__NO_INTERRUPT, &error);
+        ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+        ASSERT_EQ(frame.node, NULL, const void*, "%p");
+        ASSERT_EQ(strcmp(graph.state.log, run[r].log), 0, int, "%i");
+
+        // Atomic flag is cleared, signal flag is not
+        ASSERT_FALSE(atomic_load(&graph.state.flag));
+        ASSERT_TRUE(atomic_load(&graph.state.signal));
+
+        // Compiled program
+        reset_flag_state(&graph, run[r].value);
+
+        archi_dexgraph_program_position_t position = archi_dexgraph_program_execute(program, 0,
+                ARCHI_DEXGRAPH__NO_INTERRUPT, &error);
+        ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+        ASSERT_EQ(position, ARCHI_DEXGRAPH_PROGRAM_END, size_t, "%zu");
+        ASSERT_EQ(strcmp(graph.state.log, run[r].log), 0, int, "%i");
+
+        ASSERT_FALSE(atomic_load(&graph.state.flag));
+        ASSERT_TRUE(atomic_load(&graph.state.signal));
+    }
+
+    // Signal flag is tested without clearing: lowered signal halts at Z
+    reset_flag_state(&graph, 2);
+    atomic_store(&graph.state.signal, false);
+
+    archi_dexgraph_execute((archi_dexgraph_frame_t){.node = graph.node[0]},
+            ARCHI_DEXGRAPH__NO_INTERRUPT, &error);
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+    ASSERT_EQ(strcmp(graph.state.log, "xxxyz"), 0, int, "%i");
+
+    reset_flag_state(&graph, 2);
+    atomic_store(&graph.state.signal, false);
+
+    archi_dexgraph_program_execute(program, 0, ARCHI_DEXGRAPH__NO_INTERRUPT, &error);
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+    ASSERT_EQ(strcmp(graph.state.log, "xxxyz"), 0, int, "%i");
+
+    archi_dexgraph_program_free(program);
+    free_flag_graph(&graph);
+}
+
+TEST(archi_dexgraph_program_execute__invalid_transition)
+{
+    archi_error_t error;
+
+    struct flag_graph graph;
+    ASSERT_TRUE(make_flag_graph(&graph));
+
+    // Transition of W has unknown kind, transition of V has null data
+    for (int v = 0; v < 2; v++)
+    {
+        if (v == 0)
+            graph.node[3]->transition.kind = (archi_dexgraph_transition_kind_t)100;
+        else
+        {
+            graph.node[3]->transition.kind = ARCHI_DEXGRAPH_TRANSITION__SWITCH;
+            graph.node[4]->transition.data = NULL;
+        }
+
+        archi_dexgraph_program_t program = archi_dexgraph_program_compile(graph.node[0], &error);
+        ASSERT_NE(program, NULL, void*, "%p");
+
+        // Interpreted graph
+        reset_flag_state(&graph, 2);
+
+        archi_dexgraph_frame_t frame = archi_dexgraph_execute(
+                (archi_dexgraph_frame_t){.node = graph.node[0]}, ARCHI_DEXGRAPH__NO_INTERRUPT, &error);
+        ASSERT_EQ(error.code, ARCHI__ECONSTRAINT, archi_error_code_t, "%i");
+        ASSERT_EQ(frame.node, graph.node[3 + v], const void*, "%p");
+        ASSERT_EQ(frame.index, 1, size_t, "%zu");
+        ASSERT_EQ(strcmp(graph.state.log, v == 0 ? "xxxyzw" : "xxxyzwv"), 0, int, "%i");
+
+        // Compiled program fails at the same transition with the same error
+        reset_flag_state(&graph, 2);
+
+        archi_dexgraph_program_position_t position = archi_dexgraph_program_execute(program, 0,
+                ARCHI_DEXGRAPH__NO_INTERRUPT, &error);
+        ASSERT_EQ(error.code, ARCHI__ECONSTRAINT, archi_error_code_t, "%i");
+        ASSERT_EQ(strcmp(graph.state.log, v == 0 ? "xxxyzw" : "xxxyzwv"), 0, int, "%i");
+
+        archi_dexgraph_frame_t program_frame = archi_dexgraph_program_frame(program, position);
+        ASSERT_EQ(program_frame.node, frame.node, const void*, "%p");
+        ASSERT_EQ(program_frame.index, frame.index, size_t, "%zu");
+
+        archi_dexgraph_program_free(program);
+    }
+
+    free_flag_graph(&graph);
+}
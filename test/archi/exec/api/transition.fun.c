@@ -0,0 +1,125 @@
+#include "test.h"
+
+#include "archi/exec/api/transition.fun.h"
+
+#include <stdatomic.h>
+#include <stdint.h>
+
+
+TEST(archi_dexgraph_transition_builtin__loop)
+{
+    archi_error_t error;
+
+    archi_dexgraph_transition_loop_t loop = {.num_iterations = 3};
+    archi_dexgraph_transition_t transition = {.kind = ARCHI_DEXGRAPH_TRANSITION__LOOP, .data = &loop};
+
+    for (int pass = 0; pass < 2; pass++)
+    {
+        ASSERT_EQ(archi_dexgraph_transition_builtin(transition, &error), 0, size_t, "%zu");
+        ASSERT_EQ(archi_dexgraph_transition_builtin(transition, &error), 0, size_t, "%zu");
+        ASSERT_EQ(archi_dexgraph_transition_builtin(transition, &error), 1, size_t, "%zu");
+        ASSERT_EQ(loop.iteration, 0, size_t, "%zu");
+    }
+
+    loop.num_iterations = 0;
+
+    ARCHI_ERROR_VAR_RESET(&error);
+    ASSERT_EQ(archi_dexgraph_transition_builtin(transition, &error), ARCHI_DEXGRAPH_HALT, size_t, "%zu");
+    ASSERT_EQ(error.code, ARCHI__ECONSTRAINT, archi_error_code_t, "%i");
+}
+
+TEST(archi_dexgraph_transition_builtin__flags)
+{
+    archi_error_t error;
+    atomic_bool flag = false;
+
+    archi_dexgraph_transition_t signal = {.kind = ARCHI_DEXGRAPH_TRANSITION__SIGNAL_FLAG, .data = &flag};
+    archi_dexgraph_transition_t atomic = {.kind = ARCHI_DEXGRAPH_TRANSITION__ATOMIC_FLAG, .data = &flag};
+
+    // Error is left untouched on success
+    ARCHI_ERROR_VAR_SET(&error, ARCHI__EFAILURE, "untouched");
+
+    ASSERT_EQ(archi_dexgraph_transition_builtin(signal, &error), 0, size_t, "%zu");
+    ASSERT_EQ(archi_dexgraph_transition_builtin(atomic, &error), 0, size_t, "%zu");
+
+    // Signal flag is not cleared
+    atomic_store(&flag, true);
+
+    ASSERT_EQ(archi_dexgraph_transition_builtin(signal, &error), 1, size_t, "%zu");
+    ASSERT_EQ(archi_dexgraph_transition_builtin(signal, &error), 1, size_t, "%zu");
+    ASSERT_TRUE(atomic_load(&flag));
+
+    // Atomic flag is cleared
+    ASSERT_EQ(archi_dexgraph_transition_builtin(atomic, &error), 1, size_t, "%zu");
+    ASSERT_FALSE(atomic_load(&flag));
+    ASSERT_EQ(archi_dexgraph_transition_builtin(atomic, &error), 0, size_t, "%zu");
+    ASSERT_EQ(archi_dexgraph_transition_builtin(signal, &error), 0, size_t, "%zu");
+
+    ASSERT_EQ(error.code, ARCHI__EFAILURE, archi_error_code_t, "%i");
+}
+
+TEST(archi_dexgraph_transition_builtin__switch)
+{
+    archi_error_t error;
+
+    size_t value = 0;
+    archi_dexgraph_branch_index_t table[] = {2, ARCHI_DEXGRAPH_HALT, 0};
+
+    archi_dexgraph_transition_switch_t sw = {
+        .value = &value, .table = table, .table_size = 3, .default_branch = 5};
+    archi_dexgraph_transition_t transition = {.kind = ARCHI_DEXGRAPH_TRANSITION__SWITCH, .data = &sw};
+
+    ARCHI_ERROR_VAR_RESET(&error);
+
+    ASSERT_EQ(archi_dexgraph_transition_builtin(transition, &error), 2, size_t, "%zu");
+
+    value = 1;
+    ASSERT_EQ(archi_dexgraph_transition_builtin(transition, &error), ARCHI_DEXGRAPH_HALT, size_t, "%zu");
+
+    value = 2;
+    ASSERT_EQ(archi_dexgraph_transition_builtin(transition, &error), 0, size_t, "%zu");
+
+    // Values out of the table bounds select the default branch
+    value = 3;
+    ASSERT_EQ(archi_dexgraph_transition_builtin(transition, &error), 5, size_t, "%zu");
+
+    value = SIZE_MAX;
+    ASSERT_EQ(archi_dexgraph_transition_builtin(transition, &error), 5, size_t, "%zu");
+
+    sw.table_size = 0;
+    value = 0;
+    ASSERT_EQ(archi_dexgraph_transition_builtin(transition, &error), 5, size_t, "%zu");
+
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+
+    // Null value
+    sw.value = NULL;
+    ASSERT_EQ(archi_dexgraph_transition_builtin(transition, &error), ARCHI_DEXGRAPH_HALT, size_t, "%zu");
+    ASSERT_EQ(error.code, ARCHI__ECONSTRAINT, archi_error_code_t, "%i");
+}
+
+TEST(archi_dexgraph_transition_builtin__errors)
+{
+    archi_error_t error;
+    atomic_bool flag = true;
+
+    // Unknown kind
+    ARCHI_ERROR_VAR_RESET(&error);
+    ASSERT_EQ(archi_dexgraph_transition_builtin((archi_dexgraph_transition_t){
+                .kind = (archi_dexgraph_transition_kind_t)100, .data = &flag}, &error),
+            ARCHI_DEXGRAPH_HALT, size_t, "%zu");
+    ASSERT_EQ(error.code, ARCHI__ECONSTRAINT, archi_error_code_t, "%i");
+
+    // Null data
+    static const archi_dexgraph_transition_kind_t kind[] = {
+        ARCHI_DEXGRAPH_TRANSITION__LOOP, ARCHI_DEXGRAPH_TRANSITION__SIGNAL_FLAG,
+        ARCHI_DEXGRAPH_TRANSITION__SWITCH, ARCHI_DEXGRAPH_TRANSITION__ATOMIC_FLAG};
+
+    for (size_t i = 0; i < sizeof(kind) / sizeof(kind[0]); i++)
+    {
+        ARCHI_ERROR_VAR_RESET(&error);
+        ASSERT_EQ(archi_dexgraph_transition_builtin((archi_dexgraph_transition_t){.kind = kind[i]}, &error),
+                ARCHI_DEXGRAPH_HALT, size_t, "%zu");
+        ASSERT_EQ(error.code, ARCHI__ECONSTRAINT, archi_error_code_t, "%i");
+    }
+}
@@ -0,0 +1,427 @@
+#define _GNU_SOURCE // for sched_getaffinity(), CPU_* macros
+
+#include "test.h"
+
+#include "../../../../src/archi/thread/api/affinity.fun.h"
+#include "archi/thread/api/thread_group.fun.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdatomic.h>
+#include <threads.h>
+
+#ifdef __linux__
+#  include <sched.h>
+#  include <unistd.h>
+
+
+#define MAX_CPUS 64
+
+/**
+ * @brief Get CPUs available to the process, in ascending order.
+ */
+static
+size_t
+allowed_cpus(
+        size_t cpu[MAX_CPUS])
+{
+    cpu_set_t allowed;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+        return 0;
+
+    size_t num_cpus = 0;
+    for (size_t c = 0; (c < CPU_SETSIZE) && (num_cpus < MAX_CPUS); c++)
+        if (CPU_ISSET(c, &allowed))
+            cpu[num_cpus++] = c;
+
+    return num_cpus;
+}
+
+/**
+ * @brief Get NUMA node of a CPU (0 if there is no NUMA information).
+ */
+static
+size_t
+cpu_node(
+        size_t cpu)
+{
+    for (size_t node = 0; node < 1024; node++)
+    {
+        char path[96];
+        snprintf(path, sizeof(path), "/sys/devices/system/node/node%zu/cpu%zu", node, cpu);
+
+        if (access(path, F_OK) == 0)
+            return node;
+    }
+
+    return 0;
+}
+
+static
+bool
+cpu_in_list(
+        size_t cpu,
+        const size_t *list,
+        size_t list_size)
+{
+    for (size_t i = 0; i < list_size; i++)
+        if (list[i] == cpu)
+            return true;
+
+    return false;
+}
+
+TEST(archi_thread_affinity_plan__compact)
+{
+    archi_error_t error;
+
+    size_t cpu[MAX_CPUS];
+    size_t num_cpus = allowed_cpus(cpu);
+    ASSERT_NE(num_cpus, 0, size_t, "%zu");
+
+    size_t num_threads = 2 * num_cpus + 1;
+
+    size_t *plan = archi_thread_affinity_plan((archi_thread_group_start_params_t){
+            .num_threads = num_threads, .affinity = ARCHI_THREAD_GROUP_AFFINITY__COMPACT}, &error);
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+    ASSERT_NE(plan, NULL, void*, "%p");
+
+    // Every available CPU is taken once, ordered by NUMA nodes, then by CPU indices
+    for (size_t i = 0; i < num_cpus; i++)
+    {
+        ASSERT_TRUE(cpu_in_list(plan[i], cpu, num_cpus));
+
+        for (size_t j = 0; j < i; j++)
+        {
+            ASSERT_NE(plan[j], plan[i], size_t, "%zu");
+            ASSERT_TRUE((cpu_node(plan[j]) < cpu_node(plan[i])) ||
+                    ((cpu_node(plan[j]) == cpu_node(plan[i])) && (plan[j] < plan[i])));
+        }
+    }
+
+    // Extra threads reuse CPUs in the same order
+    for (size_t i = num_cpus; i < num_threads; i++)
+        ASSERT_EQ(plan[i], plan[i % num_cpus], size_t, "%zu");
+
+    free(plan);
+}
+
+TEST(archi_thread_affinity_plan__scatter)
+{
+    archi_error_t error;
+
+    size_t cpu[MAX_CPUS];
+    size_t num_cpus = allowed_cpus(cpu);
+    ASSERT_NE(num_cpus, 0, size_t, "%zu");
+
+    size_t num_threads = 2 * num_cpus + 1;
+
+    size_t *plan = archi_thread_affinity_plan((archi_thread_group_start_params_t){
+            .num_threads = num_threads, .affinity = ARCHI_THREAD_GROUP_AFFINITY__SCATTER}, &error);
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+    ASSERT_NE(plan, NULL, void*, "%p");
+
+    for (size_t i = 0; i < num_cpus; i++)
+    {
+        ASSERT_TRUE(cpu_in_list(plan[i], cpu, num_cpus));
+
+        for (size_t j = 0; j < i; j++)
+            ASSERT_NE(plan[j], plan[i], size_t, "%zu");
+    }
+
+    // Nodes are taken in turn, CPUs of a node are taken in ascending order
+    size_t num_nodes = 0;
+    for (size_t i = 0; i < num_cpus; i++)
+    {
+        bool new_node = true;
+        for (size_t j = 0; j < i; j++)
+            if (cpu_node(cpu[j]) == cpu_node(cpu[i]))
+                new_node = false;
+
+        if (new_node)
+            num_nodes++;
+    }
+
+    for (size_t i = 0; i < num_cpus; i++)
+    {
+        for (size_t j = 0; j < i; j++)
+        {
+            if (i < num_nodes)
+                ASSERT_NE(cpu_node(plan[j]), cpu_node(plan[i]), size_t, "%zu");
+
+            if (cpu_node(plan[j]) == cpu_node(plan[i]))
+                ASSERT_LT(plan[j], plan[i], size_t, "%zu");
+        }
+    }
+
+    for (size_t i = num_cpus; i < num_threads; i++)
+        ASSERT_EQ(plan[i], plan[i % num_cpus], size_t, "%zu");
+
+    free(plan);
+}
+
+TEST(archi_thread_affinity_plan__cpu_list)
+{
+    archi_error_t error;
+
+    size_t cpu[MAX_CPUS];
+    size_t num_cpus = allowed_cpus(cpu);
+    ASSERT_NE(num_cpus, 0, size_t, "%zu");
+
+    // Order of the list doesn't matter
+    size_t list[] = {cpu[num_cpus - 1], cpu[0]};
+    size_t list_size = (num_cpus > 1) ? 2 : 1;
+
+    archi_thread_group_affinity_t policy[] = {
+        ARCHI_THREAD_GROUP_AFFINITY__COMPACT, ARCHI_THREAD_GROUP_AFFINITY__SCATTER};
+
+    for (size_t p = 0; p < sizeof(policy) / sizeof(policy[0]); p++)
+    {
+        size_t *plan = archi_thread_affinity_plan((archi_thread_group_start_params_t){
+                .num_threads = 5, .affinity = policy[p], .cpu = list, .num_cpus = list_size}, &error);
+        ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+        ASSERT_NE(plan, NULL, void*, "%p");
+
+        for (size_t i = 0; i < 5; i++)
+            ASSERT_TRUE(cpu_in_list(plan[i], list, list_size));
+
+        if (list_size > 1)
+        {
+            ASSERT_NE(plan[0], plan[1], size_t, "%zu");
+            ASSERT_EQ(plan[2], plan[0], size_t, "%zu");
+        }
+
+        free(plan);
+    }
+}
+
+TEST(archi_thread_affinity_plan__numa_node)
+{
+    archi_error_t error;
+
+    size_t cpu[MAX_CPUS];
+    size_t num_cpus = allowed_cpus(cpu);
+    ASSERT_NE(num_cpus, 0, size_t, "%zu");
+
+    // Take CPUs of the node of the last available CPU only
+    size_t node = cpu_node(cpu[num_cpus - 1]);
+
+    size_t num_node_cpus = 0;
+    for (size_t i = 0; i < num_cpus; i++)
+        if (cpu_node(cpu[i]) == node)
+            num_node_cpus++;
+
+    size_t *plan = archi_thread_affinity_plan((archi_thread_group_start_params_t){
+            .num_threads = num_cpus, .affinity = ARCHI_THREAD_GROUP_AFFINITY__COMPACT,
+            .numa_node = &node, .num_numa_nodes = 1}, &error);
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+    ASSERT_NE(plan, NULL, void*, "%p");
+
+    for (size_t i = 0; i < num_cpus; i++)
+    {
+        ASSERT_EQ(cpu_node(plan[i]), node, size_t, "%zu");
+        ASSERT_EQ(plan[i], plan[i % num_node_cpus], size_t, "%zu");
+    }
+
+    free(plan);
+
+    // CPU list and NUMA node list are combined
+    size_t list[] = {cpu[0], cpu[num_cpus - 1]};
+
+    plan = archi_thread_affinity_plan((archi_thread_group_start_params_t){
+            .num_threads = 2, .affinity = ARCHI_THREAD_GROUP_AFFINITY__COMPACT,
+            .cpu = list, .num_cpus = 2, .numa_node = &node, .num_numa_nodes = 1}, &error);
+
+    if (cpu_node(cpu[0]) == node)
+    {
+        ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+        ASSERT_NE(plan, NULL, void*, "%p");
+
+        ASSERT_EQ(plan[0], cpu[0], size_t, "%zu");
+        ASSERT_EQ(plan[1], (num_cpus > 1) ? cpu[num_cpus - 1] : cpu[0], size_t, "%zu");
+    }
+    else
+    {
+        ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+        ASSERT_NE(plan, NULL, void*, "%p");
+
+        ASSERT_EQ(plan[0], cpu[num_cpus - 1], size_t, "%zu");
+        ASSERT_EQ(plan[1], cpu[num_cpus - 1], size_t, "%zu");
+    }
+
+    free(plan);
+
+    // No CPUs left after filtering
+    if (cpu_node(cpu[0]) != node)
+    {
+        plan = archi_thread_affinity_plan((archi_thread_group_start_params_t){
+                .num_threads = 2, .affinity = ARCHI_THREAD_GROUP_AFFINITY__COMPACT,
+                .cpu = cpu, .num_cpus = 1, .numa_node = &node, .num_numa_nodes = 1}, &error);
+        ASSERT_EQ(error.code, ARCHI__ECONSTRAINT, archi_error_code_t, "%i");
+        ASSERT_EQ(plan, NULL, void*, "%p");
+    }
+}
+
+TEST(archi_thread_affinity_plan__errors)
+{
+    archi_error_t error;
+    size_t *plan;
+
+    // No pinning
+    plan = archi_thread_affinity_plan((archi_thread_group_start_params_t){
+            .num_threads = 4, .affinity = ARCHI_THREAD_GROUP_AFFINITY__NONE}, &error);
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+    ASSERT_EQ(plan, NULL, void*, "%p");
+
+    plan = archi_thread_affinity_plan((archi_thread_group_start_params_t){
+            .num_threads = 0, .affinity = ARCHI_THREAD_GROUP_AFFINITY__COMPACT}, &error);
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+    ASSERT_EQ(plan, NULL, void*, "%p");
+
+    // Unknown policy
+    plan = archi_thread_affinity_plan((archi_thread_group_start_params_t){
+            .num_threads = 4, .affinity = (archi_thread_group_affinity_t)100}, &error);
+    ASSERT_EQ(error.code, ARCHI__ECONSTRAINT, archi_error_code_t, "%i");
+    ASSERT_EQ(plan, NULL, void*, "%p");
+
+    // Null lists of non-zero length
+    plan = archi_thread_affinity_plan((archi_thread_group_start_params_t){
+            .num_threads = 4, .affinity = ARCHI_THREAD_GROUP_AFFINITY__COMPACT,
+            .num_cpus = 1}, &error);
+    ASSERT_EQ(error.code, ARCHI__ECONSTRAINT, archi_error_code_t, "%i");
+    ASSERT_EQ(plan, NULL, void*, "%p");
+
+    plan = archi_thread_affinity_plan((archi_thread_group_start_params_t){
+            .num_threads = 4, .affinity = ARCHI_THREAD_GROUP_AFFINITY__COMPACT,
+            .num_numa_nodes = 1}, &error);
+    ASSERT_EQ(error.code, ARCHI__ECONSTRAINT, archi_error_code_t, "%i");
+    ASSERT_EQ(plan, NULL, void*, "%p");
+
+    // Invalid CPUs
+    size_t invalid_cpu[] = {CPU_SETSIZE, SIZE_MAX};
+
+    for (size_t i = 0; i < sizeof(invalid_cpu) / sizeof(invalid_cpu[0]); i++)
+    {
+        plan = archi_thread_affinity_plan((archi_thread_group_start_params_t){
+                .num_threads = 4, .affinity = ARCHI_THREAD_GROUP_AFFINITY__SCATTER,
+                .cpu = &invalid_cpu[i], .num_cpus = 1}, &error);
+        ASSERT_EQ(error.code, ARCHI__ECONSTRAINT, archi_error_code_t, "%i");
+        ASSERT_EQ(plan, NULL, void*, "%p");
+    }
+
+    // CPU not available to the process
+    cpu_set_t allowed;
+    ASSERT_EQ(sched_getaffinity(0, sizeof(allowed), &allowed), 0, int, "%i");
+
+    for (size_t c = 0; c < CPU_SETSIZE; c++)
+    {
+        if (CPU_ISSET(c, &allowed))
+            continue;
+
+        plan = archi_thread_affinity_plan((archi_thread_group_start_params_t){
+                .num_threads = 4, .affinity = ARCHI_THREAD_GROUP_AFFINITY__COMPACT,
+                .cpu = &c, .num_cpus = 1}, &error);
+        ASSERT_EQ(error.code, ARCHI__ECONSTRAINT, archi_error_code_t, "%i");
+        ASSERT_EQ(plan, NULL, void*, "%p");
+        break;
+    }
+
+    // Invalid NUMA nodes
+    size_t invalid_node[] = {1023, 1024, SIZE_MAX};
+
+    for (size_t i = 0; i < sizeof(invalid_node) / sizeof(invalid_node[0]); i++)
+    {
+        plan = archi_thread_affinity_plan((archi_thread_group_start_params_t){
+                .num_threads = 4, .affinity = ARCHI_THREAD_GROUP_AFFINITY__COMPACT,
+                .numa_node = &invalid_node[i], .num_numa_nodes = 1}, &error);
+        ASSERT_EQ(error.code, ARCHI__ECONSTRAINT, archi_error_code_t, "%i");
+        ASSERT_EQ(plan, NULL, void*, "%p");
+    }
+
+    // Thread group creation fails with the same error
+    archi_thread_group_t group = archi_thread_group_create((archi_thread_group_start_params_t){
+            .num_threads = 2, .affinity = ARCHI_THREAD_GROUP_AFFINITY__COMPACT,
+            .numa_node = &invalid_node[1], .num_numa_nodes = 1}, &error);
+    ASSERT_EQ(error.code, ARCHI__ECONSTRAINT, archi_error_code_t, "%i");
+    ASSERT_EQ(group, NULL, void*, "%p");
+}
+
+struct pinned_cpu_data {
+    size_t cpu[4];
+    atomic_size_t num_pinned;
+    atomic_size_t num_arrived;
+};
+
+static
+ARCHI_THREAD_GROUP_WORK_FUNC(pinned_cpu_work)
+{
+    (void) work_item_idx;
+
+    struct pinned_cpu_data *pinned = data;
+
+    // Hold every thread until all threads have taken a work item
+    atomic_fetch_add(&pinned->num_arrived, 1);
+    while (atomic_load(&pinned->num_arrived) < 4)
+        thrd_yield();
+
+    cpu_set_t mask;
+    if (sched_getaffinity(0, sizeof(mask), &mask) != 0)
+        return;
+
+    if (CPU_COUNT(&mask) != 1)
+        return;
+
+    for (size_t c = 0; c < CPU_SETSIZE; c++)
+    {
+        if (CPU_ISSET(c, &mask))
+        {
+            pinned->cpu[thread_idx] = c;
+            break;
+        }
+    }
+
+    atomic_fetch_add(&pinned->num_pinned, 1);
+}
+
+TEST(archi_thread_affinity__thread_group_compact)
+{
+    archi_error_t error;
+
+    size_t cpu[MAX_CPUS];
+    size_t num_cpus = allowed_cpus(cpu);
+    ASSERT_NE(num_cpus, 0, size_t, "%zu");
+
+    size_t *plan = archi_thread_affinity_plan((archi_thread_group_start_params_t){
+            .num_threads = 4, .affinity = ARCHI_THREAD_GROUP_AFFINITY__COMPACT}, &error);
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+    ASSERT_NE(plan, NULL, void*, "%p");
+
+    archi_thread_group_t group = archi_thread_group_create((archi_thread_group_start_params_t){
+            .num_threads = 4, .affinity = ARCHI_THREAD_GROUP_AFFINITY__COMPACT}, &error);
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+    ASSERT_NE(group, NULL, void*, "%p");
+
+    // Every thread processes one work item and reports the CPU it is pinned to
+    struct pinned_cpu_data pinned = {0};
+
+    ASSERT_TRUE(archi_thread_group_dispatch(group,
+                (archi_thread_group_work_t){.function = pinned_cpu_work, .data = &pinned},
+                (archi_thread_group_callback_t){0},
+                (archi_thread_group_dispatch_params_t){.size = 4, .batch_size = 1},
+                &error));
+    archi_thread_group_wait(group);
+
+    ASSERT_EQ(atomic_load(&pinned.num_pinned), 4, size_t, "%zu");
+
+    for (size_t i = 0; i < 4; i++)
+        ASSERT_EQ(pinned.cpu[i], plan[i], size_t, "%zu");
+
+    archi_thread_group_destroy(group);
+    free(plan);
+
+    // The calling thread is not pinned
+    size_t cpu_after[MAX_CPUS];
+    ASSERT_EQ(allowed_cpus(cpu_after), num_cpus, size_t, "%zu");
+}
+
+#endif // __linux__
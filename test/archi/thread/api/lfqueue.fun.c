@@ -0,0 +1,199 @@
+#include "test.h"
+
+#include "archi/thread/api/lfqueue.fun.h"
+
+#include <stdatomic.h>
+#include <threads.h>
+
+
+TEST(archi_thread_lfqueue_push_n)
+{
+    archi_error_t error;
+
+    archi_thread_lfqueue_t queue = archi_thread_lfqueue_alloc((archi_thread_lfqueue_alloc_params_t){
+            .capacity = 8, .elt_size = sizeof(int)}, &error);
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+    ASSERT_NE(queue, NULL, void*, "%p");
+
+    int in[16], out[16];
+    for (int i = 0; i < 16; i++)
+        in[i] = i;
+
+    ASSERT_EQ(archi_thread_lfqueue_push_n(queue, NULL, 1, &error), 0, size_t, "%zu");
+    ASSERT_NE(error.code, 0, archi_error_code_t, "%i");
+
+    ASSERT_EQ(archi_thread_lfqueue_push_n(queue, in, 0, &error), 0, size_t, "%zu");
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+    ASSERT_EQ(archi_thread_lfqueue_pop_n(queue, out, 4, &error), 0, size_t, "%zu");
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+
+    // Move the head and the tail close to the buffer end
+    ASSERT_EQ(archi_thread_lfqueue_push_n(queue, in, 5, &error), 5, size_t, "%zu");
+    ASSERT_EQ(archi_thread_lfqueue_pop_n(queue, out, 3, &error), 3, size_t, "%zu");
+    for (int i = 0; i < 3; i++)
+        ASSERT_EQ(out[i], i, int, "%i");
+
+    // Only free slots are filled, wrapping around the buffer end
+    ASSERT_EQ(archi_thread_lfqueue_push_n(queue, in + 5, 8, &error), 6, size_t, "%zu");
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+
+    // The queue is full
+    ASSERT_EQ(archi_thread_lfqueue_push_n(queue, in, 1, &error), 0, size_t, "%zu");
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+    ASSERT_FALSE(archi_thread_lfqueue_push(queue, in, &error));
+
+    // Only available values are popped, wrapping around the buffer end, in order
+    ASSERT_EQ(archi_thread_lfqueue_pop_n(queue, out, 16, &error), 8, size_t, "%zu");
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+    for (int i = 0; i < 8; i++)
+        ASSERT_EQ(out[i], i + 3, int, "%i");
+
+    ASSERT_EQ(archi_thread_lfqueue_pop_n(queue, out, 1, &error), 0, size_t, "%zu");
+    ASSERT_FALSE(archi_thread_lfqueue_pop(queue, out, &error));
+
+    archi_thread_lfqueue_free(queue);
+}
+
+TEST(archi_thread_lfqueue_push_n__revolutions)
+{
+    archi_error_t error;
+
+    archi_thread_lfqueue_t queue = archi_thread_lfqueue_alloc((archi_thread_lfqueue_alloc_params_t){
+            .capacity = 4, .elt_size = sizeof(unsigned)}, &error);
+    ASSERT_NE(queue, NULL, void*, "%p");
+
+    // Mix batch and single operations of varying sizes over many revolutions,
+    // so that revolution counters wrap around, comparing with a reference model
+    unsigned next_push = 0, next_pop = 0;
+    unsigned values[8];
+
+    for (unsigned iter = 0; iter < 300000; iter++)
+    {
+        size_t num_push = iter % 6, num_pop = (iter / 3) % 7;
+        size_t length = next_push - next_pop;
+
+        for (size_t i = 0; i < num_push; i++)
+            values[i] = next_push + i;
+
+        size_t expected = (num_push < 4 - length) ? num_push : 4 - length;
+        size_t pushed;
+
+        if ((num_push == 1) && (iter % 2 == 0))
+            pushed = archi_thread_lfqueue_push(queue, values, &error) ? 1 : 0;
+        else
+            pushed = archi_thread_lfqueue_push_n(queue, values, num_push, &error);
+
+        ASSERT_EQ(pushed, expected, size_t, "%zu");
+        next_push += pushed;
+        length += pushed;
+
+        expected = (num_pop < length) ? num_pop : length;
+        size_t popped;
+
+        if ((num_pop == 1) && (iter % 2 == 1))
+            popped = archi_thread_lfqueue_pop(queue, values, &error) ? 1 : 0;
+        else if (iter % 5 == 0)
+        {
+            // Values are discarded
+            popped = archi_thread_lfqueue_pop_n(queue, NULL, num_pop, &error);
+            next_pop += popped;
+            ASSERT_EQ(popped, expected, size_t, "%zu");
+            continue;
+        }
+        else
+            popped = archi_thread_lfqueue_pop_n(queue, values, num_pop, &error);
+
+        ASSERT_EQ(popped, expected, size_t, "%zu");
+
+        for (size_t i = 0; i < popped; i++)
+            ASSERT_EQ(values[i], next_pop + i, unsigned, "%u");
+
+        next_pop += popped;
+    }
+
+    archi_thread_lfqueue_free(queue);
+}
+
+#define NUM_PRODUCERS   2
+#define NUM_PER_THREAD  20000
+
+struct producer {
+    archi_thread_lfqueue_t queue;
+    unsigned id;
+};
+
+static
+int
+producer_thread(
+        void *arg)
+{
+    struct producer *producer = arg;
+
+    unsigned values[5];
+    unsigned next = 0;
+
+    while (next < NUM_PER_THREAD)
+    {
+        size_t num = 1 + next % 5;
+        if (num > NUM_PER_THREAD - next)
+            num = NUM_PER_THREAD - next;
+
+        for (size_t i = 0; i < num; i++)
+            values[i] = producer->id * NUM_PER_THREAD + next + i;
+
+        size_t pushed = archi_thread_lfqueue_push_n(producer->queue, values, num, NULL);
+        if (pushed == 0)
+            thrd_yield();
+
+        next += pushed;
+    }
+
+    return 0;
+}
+
+TEST(archi_thread_lfqueue_push_n__concurrent)
+{
+    archi_error_t error;
+
+    archi_thread_lfqueue_t queue = archi_thread_lfqueue_alloc((archi_thread_lfqueue_alloc_params_t){
+            .capacity = 16, .elt_size = sizeof(unsigned)}, &error);
+    ASSERT_NE(queue, NULL, void*, "%p");
+
+    struct producer producer[NUM_PRODUCERS];
+    thrd_t thread[NUM_PRODUCERS];
+
+    for (unsigned i = 0; i < NUM_PRODUCERS; i++)
+    {
+        producer[i] = (struct producer){.queue = queue, .id = i};
+        ASSERT_EQ(thrd_create(&thread[i], producer_thread, &producer[i]), thrd_success, int, "%i");
+    }
+
+    // Values of every producer come out in order, none is lost or duplicated
+    unsigned next[NUM_PRODUCERS] = {0};
+    unsigned values[7];
+    size_t num_popped = 0;
+
+    while (num_popped < NUM_PRODUCERS * NUM_PER_THREAD)
+    {
+        size_t popped = archi_thread_lfqueue_pop_n(queue, values, 1 + num_popped % 7, &error);
+        if (popped == 0)
+            thrd_yield();
+
+        for (size_t i = 0; i < popped; i++)
+        {
+            unsigned id = values[i] / NUM_PER_THREAD;
+            ASSERT_LT(id, NUM_PRODUCERS, unsigned, "%u");
+            ASSERT_EQ(values[i] % NUM_PER_THREAD, next[id], unsigned, "%u");
+            next[id]++;
+        }
+
+        num_popped += popped;
+    }
+
+    for (unsigned i = 0; i < NUM_PRODUCERS; i++)
+        thrd_join(thread[i], NULL);
+
+    ASSERT_EQ(archi_thread_lfqueue_pop_n(queue, values, 1, &error), 0, size_t, "%zu");
+
+    archi_thread_lfqueue_free(queue);
+}
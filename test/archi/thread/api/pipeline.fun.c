@@ -0,0 +1,209 @@
+#include "test.h"
+
+#include "archi/thread/api/pipeline.fun.h"
+#include "archi/thread/api/lfqueue.fun.h"
+#include "archi/exec/api/node.fun.h"
+
+#include <threads.h>
+#include <time.h>
+
+
+#define NUM_ITEMS   64
+
+struct source_data {
+    archi_thread_pipeline_t pipeline;
+    int counter;
+    int *item;
+};
+
+static
+ARCHI_DEXGRAPH_OPERATION_FUNC(source_op)
+{
+    struct source_data *source = data;
+
+    *source->item = ++source->counter;
+
+    // The item produced during the stop request is discarded
+    if (source->counter > NUM_ITEMS)
+        archi_thread_pipeline_stop(source->pipeline);
+
+    ARCHI_ERROR_RESET();
+}
+
+static
+ARCHI_DEXGRAPH_OPERATION_FUNC(double_op)
+{
+    *(int*)data *= 2;
+
+    ARCHI_ERROR_RESET();
+}
+
+struct sink_data {
+    int *item;
+    long sum;
+    int num_items;
+};
+
+static
+ARCHI_DEXGRAPH_OPERATION_FUNC(sink_op)
+{
+    struct sink_data *sink = data;
+
+    sink->sum += *sink->item;
+    sink->num_items++;
+
+    // Slow consumer: other stages wait on full or empty queues
+    thrd_sleep(&(struct timespec){.tv_nsec = 1000000}, NULL);
+
+    ARCHI_ERROR_RESET();
+}
+
+static
+archi_dexgraph_node_t*
+make_node(
+        archi_dexgraph_operation_func_t function,
+        void *data)
+{
+    archi_dexgraph_node_t *node = archi_dexgraph_node_alloc("stage", 1);
+    if (node != NULL)
+        node->sequence[0] = (archi_dexgraph_operation_t){.function = function, .data = data};
+
+    return node;
+}
+
+TEST(archi_thread_pipeline)
+{
+    archi_error_t error;
+
+    archi_thread_lfqueue_t queue[2];
+    for (int i = 0; i < 2; i++)
+    {
+        queue[i] = archi_thread_lfqueue_alloc((archi_thread_lfqueue_alloc_params_t){
+                .capacity = 2, .elt_size = sizeof(int)}, &error);
+        ASSERT_NE(queue[i], NULL, void*, "%p");
+    }
+
+    archi_thread_pipeline_t pipeline = archi_thread_pipeline_create(
+            (archi_thread_pipeline_start_params_t){.num_stages = 3}, &error);
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+    ASSERT_NE(pipeline, NULL, void*, "%p");
+    ASSERT_EQ(archi_thread_pipeline_num_stages(pipeline), 3, size_t, "%zu");
+
+    int item[3];
+    struct source_data source = {.pipeline = pipeline, .item = &item[0]};
+    struct sink_data sink = {.item = &item[2]};
+
+    archi_dexgraph_node_t *node[3] = {
+        make_node(source_op, &source),
+        make_node(double_op, &item[1]),
+        make_node(sink_op, &sink),
+    };
+
+    archi_thread_pipeline_set_stage(pipeline, 0, (archi_thread_pipeline_stage_t){
+            .entry = node[0], .output = queue[0], .item = &item[0]}, &error);
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+    archi_thread_pipeline_set_stage(pipeline, 1, (archi_thread_pipeline_stage_t){
+            .entry = node[1], .input = queue[0], .output = queue[1], .item = &item[1]}, &error);
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+    archi_thread_pipeline_set_stage(pipeline, 2, (archi_thread_pipeline_stage_t){
+            .entry = node[2], .input = queue[1], .item = &item[2]}, &error);
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+
+    archi_thread_pipeline_set_stage(pipeline, 3, (archi_thread_pipeline_stage_t){0}, &error);
+    ASSERT_NE(error.code, 0, archi_error_code_t, "%i");
+
+    clock_t cpu_begin = clock();
+    struct timespec wall_begin, wall_end;
+    timespec_get(&wall_begin, TIME_UTC);
+
+    ASSERT_TRUE(archi_thread_pipeline_start(pipeline, &error));
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+
+    archi_thread_pipeline_wait(pipeline, &error);
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+
+    timespec_get(&wall_end, TIME_UTC);
+    clock_t cpu_end = clock();
+
+    // All items pass through the pipeline in order and are not lost
+    ASSERT_EQ(sink.num_items, NUM_ITEMS, int, "%i");
+    ASSERT_EQ(sink.sum, (long)NUM_ITEMS * (NUM_ITEMS + 1), long, "%li");
+
+    // Waiting stages sleep instead of spinning: the pipeline mostly waits for the slow sink
+    double cpu_time = (double)(cpu_end - cpu_begin) / CLOCKS_PER_SEC;
+    double wall_time = (double)(wall_end.tv_sec - wall_begin.tv_sec) +
+        (double)(wall_end.tv_nsec - wall_begin.tv_nsec) / 1e9;
+    ASSERT_LT(cpu_time, wall_time / 2, double, "%f");
+
+    // The pipeline can be restarted
+    source.counter = 0;
+    sink.sum = 0;
+    sink.num_items = 0;
+
+    ASSERT_TRUE(archi_thread_pipeline_start(pipeline, &error));
+    archi_thread_pipeline_wait(pipeline, &error);
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+    ASSERT_EQ(sink.num_items, NUM_ITEMS, int, "%i");
+
+    archi_thread_pipeline_destroy(pipeline);
+
+    for (int i = 0; i < 3; i++)
+        archi_dexgraph_node_free(node[i]);
+
+    for (int i = 0; i < 2; i++)
+        archi_thread_lfqueue_free(queue[i]);
+}
+
+static
+ARCHI_DEXGRAPH_OPERATION_FUNC(count_op)
+{
+    ++*(int*)data;
+
+    ARCHI_ERROR_RESET();
+}
+
+TEST(archi_thread_pipeline_stop_external_output)
+{
+    archi_error_t error;
+
+    // Nothing pops the queue, so the source stage blocks when it is full
+    archi_thread_lfqueue_t queue = archi_thread_lfqueue_alloc((archi_thread_lfqueue_alloc_params_t){
+            .capacity = 2, .elt_size = sizeof(int)}, &error);
+    ASSERT_NE(queue, NULL, void*, "%p");
+
+    archi_thread_pipeline_t pipeline = archi_thread_pipeline_create(
+            (archi_thread_pipeline_start_params_t){.num_stages = 1}, &error);
+    ASSERT_NE(pipeline, NULL, void*, "%p");
+
+    int item = 0;
+    archi_dexgraph_node_t *node = make_node(count_op, &item);
+
+    archi_thread_pipeline_set_stage(pipeline, 0, (archi_thread_pipeline_stage_t){
+            .entry = node, .output = queue, .item = &item}, &error);
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+
+    ASSERT_TRUE(archi_thread_pipeline_start(pipeline, &error));
+    thrd_sleep(&(struct timespec){.tv_nsec = 50000000}, NULL);
+
+    // The blocked stage discards its work item and finishes
+    archi_thread_pipeline_stop(pipeline);
+    archi_thread_pipeline_wait(pipeline, &error);
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+
+    int value;
+    for (int i = 1; i <= 2; i++)
+    {
+        ASSERT_TRUE(archi_thread_lfqueue_pop(queue, &value, &error));
+        ASSERT_EQ(value, i, int, "%i");
+    }
+    ASSERT_FALSE(archi_thread_lfqueue_pop(queue, &value, &error));
+
+    // Destruction of a blocked pipeline doesn't hang either
+    ASSERT_TRUE(archi_thread_pipeline_start(pipeline, &error));
+    thrd_sleep(&(struct timespec){.tv_nsec = 50000000}, NULL);
+
+    archi_thread_pipeline_destroy(pipeline);
+
+    archi_dexgraph_node_free(node);
+    archi_thread_lfqueue_free(queue);
+}
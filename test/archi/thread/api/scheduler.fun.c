@@ -0,0 +1,184 @@
+#include "test.h"
+
+#include "archi/thread/api/scheduler.fun.h"
+#include "archi/exec/api/node.fun.h"
+
+#include <string.h>
+#include <stdatomic.h>
+#include <threads.h>
+
+
+#define NUM_ITERATIONS  5
+
+struct task {
+    archi_dexgraph_node_t *node;
+    archi_dexgraph_node_array_t *branch;
+    archi_dexgraph_transition_loop_t loop;
+
+    char id;
+    char *log;
+    size_t *log_length;
+    atomic_bool *gate;
+
+    size_t num_iterations_done;
+    bool fail;
+};
+
+static
+ARCHI_DEXGRAPH_OPERATION_FUNC(task_op)
+{
+    struct task *task = data;
+
+    if (task->fail)
+    {
+        ARCHI_ERROR_SET(ARCHI__EFAILURE, "task failed");
+        return;
+    }
+
+    // Hold the worker until the other tasks are submitted
+    if (task->gate != NULL)
+        while (!atomic_load(task->gate))
+            thrd_yield();
+
+    task->num_iterations_done++;
+
+    if (task->log != NULL)
+        task->log[(*task->log_length)++] = task->id;
+
+    // Let other tasks run at the next transition
+    archi_thread_scheduler_yield();
+
+    ARCHI_ERROR_RESET();
+}
+
+static
+bool
+make_task(
+        struct task *task,
+        char id,
+        char *log,
+        size_t *log_length)
+{
+    *task = (struct task){
+        .loop = {.num_iterations = NUM_ITERATIONS},
+        .id = id,
+        .log = log,
+        .log_length = log_length,
+    };
+
+    task->node = archi_dexgraph_node_alloc("task", 1);
+    task->branch = archi_dexgraph_node_array_alloc(1);
+
+    if ((task->node == NULL) || (task->branch == NULL))
+        return false;
+
+    // Loop over the node, halting via the non-existent branch #1
+    task->node->sequence[0] = (archi_dexgraph_operation_t){.function = task_op, .data = task};
+    task->node->transition = (archi_dexgraph_transition_t){
+        .kind = ARCHI_DEXGRAPH_TRANSITION__LOOP, .data = &task->loop};
+    task->branch->node[0] = task->node;
+    task->node->branch = task->branch;
+
+    return true;
+}
+
+static
+void
+free_task(
+        struct task *task)
+{
+    archi_dexgraph_node_free(task->node);
+    archi_dexgraph_node_array_free(task->branch);
+}
+
+TEST(archi_thread_scheduler_yield)
+{
+    archi_error_t error;
+
+    // Calls outside of worker threads are ignored
+    archi_thread_scheduler_yield();
+
+    archi_thread_scheduler_t scheduler = archi_thread_scheduler_create(
+            (archi_thread_scheduler_start_params_t){.num_threads = 1, .max_tasks = 4}, &error);
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+    ASSERT_NE(scheduler, NULL, void*, "%p");
+    ASSERT_EQ(archi_thread_scheduler_num_threads(scheduler), 1, size_t, "%zu");
+
+    char log[2 * NUM_ITERATIONS + 1] = {0};
+    size_t log_length = 0;
+
+    struct task task[2];
+    ASSERT_TRUE(make_task(&task[0], 'A', log, &log_length));
+    ASSERT_TRUE(make_task(&task[1], 'B', log, &log_length));
+
+    atomic_bool gate = false;
+    task[0].gate = &gate;
+
+    ASSERT_TRUE(archi_thread_scheduler_submit(scheduler,
+                (archi_dexgraph_frame_t){.node = task[0].node}, &error));
+    ASSERT_TRUE(archi_thread_scheduler_submit(scheduler,
+                (archi_dexgraph_frame_t){.node = task[1].node}, &error));
+
+    atomic_store(&gate, true);
+
+    archi_thread_scheduler_wait(scheduler, &error);
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+    ASSERT_EQ(archi_thread_scheduler_num_tasks(scheduler), 0, size_t, "%zu");
+
+    // A yielded task is resumed where it stopped, after the other task has run
+    ASSERT_EQ(task[0].num_iterations_done, NUM_ITERATIONS, size_t, "%zu");
+    ASSERT_EQ(task[1].num_iterations_done, NUM_ITERATIONS, size_t, "%zu");
+    ASSERT_EQ(strcmp(log, "ABABABABAB"), 0, int, "%i");
+
+    archi_thread_scheduler_destroy(scheduler);
+
+    free_task(&task[0]);
+    free_task(&task[1]);
+}
+
+#define NUM_TASKS   16
+
+TEST(archi_thread_scheduler_wait)
+{
+    archi_error_t error;
+
+    archi_thread_scheduler_t scheduler = archi_thread_scheduler_create(
+            (archi_thread_scheduler_start_params_t){.num_threads = 3, .max_tasks = NUM_TASKS}, &error);
+    ASSERT_NE(scheduler, NULL, void*, "%p");
+
+    struct task task[NUM_TASKS];
+    for (int i = 0; i < NUM_TASKS; i++)
+        ASSERT_TRUE(make_task(&task[i], 'a' + i, NULL, NULL));
+
+    for (int run = 0; run < 2; run++)
+    {
+        for (int i = 0; i < NUM_TASKS; i++)
+        {
+            task[i].num_iterations_done = 0;
+            task[i].fail = (run == 1) && (i == 5);
+
+            ASSERT_TRUE(archi_thread_scheduler_submit(scheduler,
+                        (archi_dexgraph_frame_t){.node = task[i].node}, &error));
+        }
+
+        archi_thread_scheduler_wait(scheduler, &error);
+        ASSERT_EQ(archi_thread_scheduler_num_tasks(scheduler), 0, size_t, "%zu");
+
+        if (run == 0)
+            ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+        else // the failure is reported and the failed task is removed
+            ASSERT_EQ(error.code, ARCHI__EFAILURE, archi_error_code_t, "%i");
+
+        for (int i = 0; i < NUM_TASKS; i++)
+            ASSERT_EQ(task[i].num_iterations_done, task[i].fail ? 0 : NUM_ITERATIONS, size_t, "%zu");
+    }
+
+    // The error is reported once
+    archi_thread_scheduler_wait(scheduler, &error);
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+
+    archi_thread_scheduler_destroy(scheduler);
+
+    for (int i = 0; i < NUM_TASKS; i++)
+        free_task(&task[i]);
+}
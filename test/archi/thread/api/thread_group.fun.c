@@ -0,0 +1,1448 @@
+#include "test.h"
+
+#include "archi/thread/api/thread_group.fun.h"
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <poll.h>
+#include <threads.h>
+#include <time.h>
+
+
+#define NUM_ITEMS   1000
+
+static
+ARCHI_THREAD_GROUP_WORK_FUNC(gate_work)
+{
+    (void) work_item_idx;
+    (void) thread_idx;
+
+    while (!atomic_load((atomic_bool*)data))
+        thrd_yield();
+}
+
+struct fill_data {
+    int *dest;
+    atomic_bool *gate;
+};
+
+static
+ARCHI_THREAD_GROUP_WORK_FUNC(fill_work)
+{
+    struct fill_data *fill = data;
+
+    // Hold the first work item to let other threads run ahead
+    if ((work_item_idx == 0) && (fill->gate != NULL))
+        gate_work(fill->gate, work_item_idx, thread_idx);
+
+    fill->dest[work_item_idx] = (int)work_item_idx + 1;
+}
+
+struct copy_data {
+    const int *src;
+    int *dest;
+};
+
+static
+ARCHI_THREAD_GROUP_WORK_FUNC(double_work)
+{
+    (void) thread_idx;
+
+    struct copy_data *copy = data;
+    copy->dest[work_item_idx] = 2 * copy->src[work_item_idx];
+}
+
+struct completion_log {
+    atomic_size_t length;
+    size_t ticket[8];
+};
+
+struct completion {
+    struct completion_log *log;
+    size_t ticket;
+};
+
+static
+ARCHI_THREAD_GROUP_CALLBACK_FUNC(log_completion)
+{
+    (void) work_offset;
+    (void) work_size;
+    (void) thread_idx;
+
+    struct completion *completion = data;
+    completion->log->ticket[atomic_fetch_add(&completion->log->length, 1)] = completion->ticket;
+}
+
+TEST(archi_thread_group_enqueue)
+{
+    archi_error_t error;
+
+    archi_thread_group_t group = archi_thread_group_create(
+            (archi_thread_group_start_params_t){.num_threads = 4, .queue_capacity = 4}, &error);
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+    ASSERT_NE(group, NULL, void*, "%p");
+
+    static int a[NUM_ITEMS], b[NUM_ITEMS], c[NUM_ITEMS];
+    struct copy_data ab = {.src = a, .dest = b}, bc = {.src = b, .dest = c};
+
+    struct completion_log log = {0};
+    struct completion completion[4];
+    for (size_t i = 0; i < 4; i++)
+        completion[i] = (struct completion){.log = &log, .ticket = i + 1};
+
+    archi_thread_group_dispatch_params_t params = {.size = NUM_ITEMS, .batch_size = 16};
+
+    // The first task holds all threads until the queue is filled
+    atomic_bool gate = false, fill_gate = false;
+    struct fill_data fill_a = {.dest = a, .gate = &fill_gate};
+
+    size_t ticket = archi_thread_group_enqueue(group,
+            (archi_thread_group_work_t){.function = gate_work, .data = &gate},
+            (archi_thread_group_callback_t){.function = log_completion, .data = &completion[0]},
+            (archi_thread_group_dispatch_params_t){.size = 4, .batch_size = 1}, 0, &error);
+    ASSERT_EQ(ticket, 1, size_t, "%zu");
+
+    ticket = archi_thread_group_enqueue(group,
+            (archi_thread_group_work_t){.function = fill_work, .data = &fill_a},
+            (archi_thread_group_callback_t){.function = log_completion, .data = &completion[1]},
+            params, 0, &error);
+    ASSERT_EQ(ticket, 2, size_t, "%zu");
+
+    // Each task reads the output of the previous one
+    ticket = archi_thread_group_enqueue(group,
+            (archi_thread_group_work_t){.function = double_work, .data = &ab},
+            (archi_thread_group_callback_t){.function = log_completion, .data = &completion[2]},
+            params, 2, &error);
+    ASSERT_EQ(ticket, 3, size_t, "%zu");
+
+    ticket = archi_thread_group_enqueue(group,
+            (archi_thread_group_work_t){.function = double_work, .data = &bc},
+            (archi_thread_group_callback_t){.function = log_completion, .data = &completion[3]},
+            params, 3, &error);
+    ASSERT_EQ(ticket, 4, size_t, "%zu");
+
+    // The queue is full
+    ticket = archi_thread_group_enqueue(group,
+            (archi_thread_group_work_t){.function = fill_work, .data = &fill_a},
+            (archi_thread_group_callback_t){0}, params, 0, &error);
+    ASSERT_EQ(ticket, 0, size_t, "%zu");
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+
+    // A dependency must be enqueued already
+    ticket = archi_thread_group_enqueue(group,
+            (archi_thread_group_work_t){.function = fill_work, .data = &fill_a},
+            (archi_thread_group_callback_t){0}, params, 5, &error);
+    ASSERT_EQ(ticket, 0, size_t, "%zu");
+    ASSERT_EQ(error.code, ARCHI__ECONSTRAINT, archi_error_code_t, "%i");
+
+    ASSERT_EQ(atomic_load(&log.length), 0, size_t, "%zu");
+    atomic_store(&gate, true);
+
+    // Dependent tasks don't start while the first work item is held
+    archi_thread_group_wait_ticket(group, 1, NULL);
+    thrd_sleep(&(struct timespec){.tv_nsec = 10000000}, NULL);
+
+    ASSERT_EQ(atomic_load(&log.length), 1, size_t, "%zu");
+    atomic_store(&fill_gate, true);
+
+    archi_thread_group_wait_ticket(group, 2, NULL);
+    ASSERT_TRUE(atomic_load(&log.length) >= 2);
+
+    archi_thread_group_wait(group);
+
+    // Tasks complete in order
+    ASSERT_EQ(atomic_load(&log.length), 4, size_t, "%zu");
+    for (size_t i = 0; i < 4; i++)
+        ASSERT_EQ(log.ticket[i], i + 1, size_t, "%zu");
+
+    for (int i = 0; i < NUM_ITEMS; i++)
+        ASSERT_EQ(c[i], 4 * (i + 1), int, "%i");
+
+    archi_thread_group_destroy(group);
+}
+
+TEST(archi_thread_group_enqueue_no_threads)
+{
+    archi_error_t error;
+
+    archi_thread_group_t group = archi_thread_group_create(
+            (archi_thread_group_start_params_t){.num_threads = 0}, &error);
+    ASSERT_NE(group, NULL, void*, "%p");
+
+    static int a[NUM_ITEMS];
+    struct fill_data fill_a = {.dest = a};
+
+    // Work is done in the calling thread immediately
+    size_t ticket = archi_thread_group_enqueue(group,
+            (archi_thread_group_work_t){.function = fill_work, .data = &fill_a},
+            (archi_thread_group_callback_t){0},
+            (archi_thread_group_dispatch_params_t){.size = NUM_ITEMS}, 0, &error);
+    ASSERT_NE(ticket, 0, size_t, "%zu");
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+
+    for (int i = 0; i < NUM_ITEMS; i++)
+        ASSERT_EQ(a[i], i + 1, int, "%i");
+
+    archi_thread_group_destroy(group);
+}
+
+struct stats {
+    unsigned long long sum;
+    size_t max;
+    size_t count;
+};
+
+static
+ARCHI_THREAD_GROUP_REDUCE_FUNC(stats_accumulate)
+{
+    (void) data;
+    (void) thread_idx;
+
+    struct stats *acc = accumulator;
+
+    acc->sum += work_item_idx;
+    if (work_item_idx > acc->max)
+        acc->max = work_item_idx;
+    acc->count++;
+}
+
+static
+ARCHI_THREAD_GROUP_COMBINE_FUNC(stats_combine)
+{
+    (void) data;
+
+    struct stats *acc = accumulator;
+    const struct stats *other = value;
+
+    acc->sum += other->sum;
+    if (other->max > acc->max)
+        acc->max = other->max;
+    acc->count += other->count;
+}
+
+struct reduce_check {
+    const struct stats *result;
+    struct stats seen;
+    size_t work_size;
+};
+
+static
+ARCHI_THREAD_GROUP_CALLBACK_FUNC(reduce_done)
+{
+    (void) work_offset;
+    (void) thread_idx;
+
+    // The result is written before the callback is called
+    struct reduce_check *check = data;
+    check->seen = *check->result;
+    check->work_size = work_size;
+}
+
+TEST(archi_thread_group_dispatch_reduce)
+{
+    archi_error_t error;
+
+    const struct stats identity = {.max = 0};
+
+    for (size_t num_threads = 0; num_threads <= 4; num_threads += 4)
+    {
+        archi_thread_group_t group = archi_thread_group_create(
+                (archi_thread_group_start_params_t){.num_threads = num_threads}, &error);
+        ASSERT_NE(group, NULL, void*, "%p");
+
+        for (int schedule = ARCHI_THREAD_GROUP_SCHEDULE__SHARED;
+                schedule <= ARCHI_THREAD_GROUP_SCHEDULE__ADAPTIVE; schedule++)
+        {
+            // Repeated dispatches reuse the accumulators
+            for (int repeat = 0; repeat < 3; repeat++)
+            {
+                struct stats result = {.sum = 1, .max = 1, .count = 1};
+                struct reduce_check check = {.result = &result};
+
+                ASSERT_TRUE(archi_thread_group_dispatch_reduce(group,
+                            (archi_thread_group_reduction_t){
+                                .accumulate = stats_accumulate, .combine = stats_combine,
+                                .identity = &identity, .value_size = sizeof(struct stats),
+                                .result = &result},
+                            (archi_thread_group_callback_t){.function = reduce_done, .data = &check},
+                            (archi_thread_group_dispatch_params_t){.offset = 10, .size = NUM_ITEMS,
+                                .batch_size = 7, .schedule = schedule}, &error));
+                ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+
+                archi_thread_group_wait(group);
+
+                // Sum of [10; 10 + NUM_ITEMS)
+                ASSERT_EQ(result.sum, (unsigned long long)NUM_ITEMS * (2 * 10 + NUM_ITEMS - 1) / 2,
+                        unsigned long long, "%llu");
+                ASSERT_EQ(result.max, 10 + NUM_ITEMS - 1, size_t, "%zu");
+                ASSERT_EQ(result.count, NUM_ITEMS, size_t, "%zu");
+
+                ASSERT_EQ(check.seen.sum, result.sum, unsigned long long, "%llu");
+                ASSERT_EQ(check.work_size, NUM_ITEMS, size_t, "%zu");
+            }
+        }
+
+        // Empty reduction yields the identity value
+        struct stats result = {.sum = 1, .max = 1, .count = 1};
+
+        ASSERT_TRUE(archi_thread_group_dispatch_reduce(group,
+                    (archi_thread_group_reduction_t){
+                        .accumulate = stats_accumulate, .combine = stats_combine,
+                        .identity = &identity, .value_size = sizeof(struct stats),
+                        .result = &result},
+                    (archi_thread_group_callback_t){0},
+                    (archi_thread_group_dispatch_params_t){.size = 0}, &error));
+        ASSERT_EQ(result.sum, 0, unsigned long long, "%llu");
+        ASSERT_EQ(result.count, 0, size_t, "%zu");
+
+        // Combination function is required
+        ASSERT_FALSE(archi_thread_group_dispatch_reduce(group,
+                    (archi_thread_group_reduction_t){
+                        .accumulate = stats_accumulate,
+                        .identity = &identity, .value_size = sizeof(struct stats),
+                        .result = &result},
+                    (archi_thread_group_callback_t){0},
+                    (archi_thread_group_dispatch_params_t){.size = NUM_ITEMS}, &error));
+        ASSERT_EQ(error.code, ARCHI__ECONSTRAINT, archi_error_code_t, "%i");
+
+        archi_thread_group_destroy(group);
+    }
+}
+
+struct cancel_data {
+    atomic_size_t num_processed;
+    size_t cancel_at; // work item to cancel the dispatch at
+};
+
+static
+ARCHI_THREAD_GROUP_WORK_FUNC(cancel_work)
+{
+    (void) thread_idx;
+
+    struct cancel_data *cancel = data;
+    atomic_fetch_add(&cancel->num_processed, 1);
+
+    if (work_item_idx == cancel->cancel_at)
+        archi_thread_group_cancel_current_dispatch();
+}
+
+static
+ARCHI_THREAD_GROUP_WORK_FUNC(wait_cancelled_work)
+{
+    (void) data;
+    (void) work_item_idx;
+    (void) thread_idx;
+
+    while (!archi_thread_group_current_dispatch_cancelled())
+        thrd_yield();
+}
+
+static
+ARCHI_THREAD_GROUP_CALLBACK_FUNC(store_work_size)
+{
+    (void) work_offset;
+    (void) thread_idx;
+
+    *(size_t*)data = work_size;
+}
+
+TEST(archi_thread_group_cancel)
+{
+    archi_error_t error;
+
+    // Calls outside of work functions do nothing
+    archi_thread_group_cancel_current_dispatch();
+    ASSERT_FALSE(archi_thread_group_current_dispatch_cancelled());
+
+    for (size_t num_threads = 0; num_threads <= 4; num_threads += 4)
+    {
+        archi_thread_group_t group = archi_thread_group_create(
+                (archi_thread_group_start_params_t){.num_threads = num_threads, .queue_capacity = 4}, &error);
+        ASSERT_NE(group, NULL, void*, "%p");
+
+        // Cancellation from a work function stops processing between batches
+        for (int schedule = ARCHI_THREAD_GROUP_SCHEDULE__SHARED;
+                schedule <= ARCHI_THREAD_GROUP_SCHEDULE__ADAPTIVE; schedule++)
+        {
+            struct cancel_data cancel = {.cancel_at = 100};
+            size_t work_size = SIZE_MAX;
+
+            ASSERT_TRUE(archi_thread_group_dispatch(group,
+                        (archi_thread_group_work_t){.function = cancel_work, .data = &cancel},
+                        (archi_thread_group_callback_t){.function = store_work_size, .data = &work_size},
+                        (archi_thread_group_dispatch_params_t){.size = NUM_ITEMS, .batch_size = 1,
+                            .schedule = schedule}, &error));
+            archi_thread_group_wait(group);
+
+            ASSERT_TRUE(atomic_load(&cancel.num_processed) > 100);
+            ASSERT_TRUE(atomic_load(&cancel.num_processed) < NUM_ITEMS);
+            ASSERT_EQ(work_size, atomic_load(&cancel.num_processed), size_t, "%zu");
+        }
+
+        archi_thread_group_destroy(group);
+    }
+
+    archi_thread_group_t group = archi_thread_group_create(
+            (archi_thread_group_start_params_t){.num_threads = 4, .queue_capacity = 4}, &error);
+    ASSERT_NE(group, NULL, void*, "%p");
+
+    // Cancellation of a queued task by ticket
+    size_t work_size[3] = {SIZE_MAX, SIZE_MAX, SIZE_MAX};
+    struct cancel_data cancel = {.cancel_at = SIZE_MAX};
+
+    size_t ticket = archi_thread_group_enqueue(group,
+            (archi_thread_group_work_t){.function = wait_cancelled_work},
+            (archi_thread_group_callback_t){.function = store_work_size, .data = &work_size[0]},
+            (archi_thread_group_dispatch_params_t){.size = NUM_ITEMS, .batch_size = 1}, 0, &error);
+    ASSERT_EQ(ticket, 1, size_t, "%zu");
+
+    ticket = archi_thread_group_enqueue(group,
+            (archi_thread_group_work_t){.function = cancel_work, .data = &cancel},
+            (archi_thread_group_callback_t){.function = store_work_size, .data = &work_size[1]},
+            (archi_thread_group_dispatch_params_t){.size = NUM_ITEMS}, 0, &error);
+    ASSERT_EQ(ticket, 2, size_t, "%zu");
+
+    ticket = archi_thread_group_enqueue(group,
+            (archi_thread_group_work_t){.function = cancel_work, .data = &cancel},
+            (archi_thread_group_callback_t){.function = store_work_size, .data = &work_size[2]},
+            (archi_thread_group_dispatch_params_t){.size = NUM_ITEMS}, 0, &error);
+    ASSERT_EQ(ticket, 3, size_t, "%zu");
+
+    // Threads are held by the first task, so the second one is cancelled before it is started
+    archi_thread_group_cancel(group, 2);
+
+    // Cancellation is observed by long-running work items
+    archi_thread_group_cancel(group, 1);
+    archi_thread_group_wait(group);
+
+    ASSERT_TRUE(work_size[0] <= 4);
+    ASSERT_EQ(work_size[1], 0, size_t, "%zu");
+
+    // The third task is not affected
+    ASSERT_EQ(work_size[2], NUM_ITEMS, size_t, "%zu");
+    ASSERT_EQ(atomic_load(&cancel.num_processed), NUM_ITEMS, size_t, "%zu");
+
+    // Cancellation of a completed task doesn't affect later tasks in the same slot
+    for (size_t i = 0; i < 4; i++)
+    {
+        atomic_store(&cancel.num_processed, 0);
+        work_size[0] = SIZE_MAX;
+
+        archi_thread_group_cancel(group, 0);
+        archi_thread_group_cancel(group, 3);
+
+        ASSERT_TRUE(archi_thread_group_dispatch(group,
+                    (archi_thread_group_work_t){.function = cancel_work, .data = &cancel},
+                    (archi_thread_group_callback_t){.function = store_work_size, .data = &work_size[0]},
+                    (archi_thread_group_dispatch_params_t){.size = NUM_ITEMS}, &error));
+        archi_thread_group_wait(group);
+
+        ASSERT_EQ(work_size[0], NUM_ITEMS, size_t, "%zu");
+    }
+
+    archi_thread_group_destroy(group);
+}
+
+static
+bool
+notify_readable(
+        int fd,
+        int timeout_ms)
+{
+    struct pollfd pfd = {.fd = fd, .events = POLLIN};
+    return (poll(&pfd, 1, timeout_ms) == 1) && (pfd.revents & POLLIN);
+}
+
+static
+ARCHI_THREAD_GROUP_WORK_FUNC(nop_work)
+{
+    (void) data;
+    (void) work_item_idx;
+    (void) thread_idx;
+}
+
+#define NUM_NOTIFIED_TASKS  2000
+
+TEST(archi_thread_group_notify)
+{
+    archi_error_t error;
+
+    // The descriptor is created only on request
+    archi_thread_group_t group = archi_thread_group_create(
+            (archi_thread_group_start_params_t){.num_threads = 2}, &error);
+    ASSERT_NE(group, NULL, void*, "%p");
+    ASSERT_EQ(archi_thread_group_notify_fd(group), -1, int, "%i");
+    archi_thread_group_destroy(group);
+
+    group = archi_thread_group_create(
+            (archi_thread_group_start_params_t){.num_threads = 2, .queue_capacity = 8, .notify = true}, &error);
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+    ASSERT_NE(group, NULL, void*, "%p");
+
+    int fd = archi_thread_group_notify_fd(group);
+    ASSERT_TRUE(fd >= 0);
+    ASSERT_FALSE(notify_readable(fd, 0));
+
+    // Clearing a descriptor that isn't readable does nothing
+    ASSERT_EQ(archi_thread_group_notify_clear(group), 0, size_t, "%zu");
+    ASSERT_FALSE(notify_readable(fd, 0));
+
+    archi_thread_group_work_t work = {.function = nop_work};
+    archi_thread_group_dispatch_params_t params = {.size = 16};
+
+    // The descriptor stays readable until cleared, however many tasks complete
+    ASSERT_TRUE(archi_thread_group_dispatch(group, work, (archi_thread_group_callback_t){0}, params, &error));
+    archi_thread_group_wait(group);
+
+    // The descriptor is signalled after the counter is updated, so it may lag behind waiting
+    ASSERT_TRUE(notify_readable(fd, 1000));
+    ASSERT_TRUE(notify_readable(fd, 0));
+
+    ASSERT_NE(archi_thread_group_enqueue(group, work, (archi_thread_group_callback_t){0}, params, 0, &error), 0, size_t, "%zu");
+    ASSERT_NE(archi_thread_group_enqueue(group, work, (archi_thread_group_callback_t){0}, params, 0, &error), 0, size_t, "%zu");
+    archi_thread_group_wait(group);
+
+    ASSERT_TRUE(notify_readable(fd, 1000));
+    ASSERT_EQ(archi_thread_group_notify_clear(group), 3, size_t, "%zu");
+
+    // Completions interleaved with clearing are never missed:
+    // a completion is either counted by the clear, or leaves the descriptor readable
+    size_t num_submitted = 3, num_seen = 3;
+
+    while (num_seen < 3 + NUM_NOTIFIED_TASKS)
+    {
+        // Keep the queue busy while clearing
+        while ((num_submitted < 3 + NUM_NOTIFIED_TASKS) && (archi_thread_group_enqueue(group, work,
+                        (archi_thread_group_callback_t){0}, params, 0, &error) != 0))
+            num_submitted++;
+
+        ASSERT_TRUE(notify_readable(fd, 1000));
+
+        size_t num_completed = archi_thread_group_notify_clear(group);
+        ASSERT_TRUE(num_completed >= num_seen);
+        ASSERT_TRUE(num_completed <= num_submitted);
+
+        num_seen = num_completed;
+    }
+
+    archi_thread_group_wait(group);
+    ASSERT_EQ(archi_thread_group_notify_clear(group), 3 + NUM_NOTIFIED_TASKS, size_t, "%zu");
+
+    archi_thread_group_destroy(group);
+}
+
+#define NUM_PHASES  6
+
+struct phased_data {
+    unsigned buffer[2][NUM_ITEMS];
+    atomic_size_t num_done[NUM_PHASES];
+    atomic_bool overlap; // whether a phase was started before the previous one is done
+    size_t cancel_phase;
+};
+
+static
+ARCHI_THREAD_GROUP_PHASE_WORK_FUNC(phased_work)
+{
+    (void) thread_idx;
+
+    struct phased_data *phased = data;
+
+    if ((phase > 0) && (atomic_load(&phased->num_done[phase - 1]) != NUM_ITEMS))
+        atomic_store(&phased->overlap, true);
+
+    // Every item depends on its neighbour from the previous phase
+    const unsigned *in = phased->buffer[phase % 2];
+    unsigned *out = phased->buffer[(phase + 1) % 2];
+
+    out[work_item_idx] = 3 * in[work_item_idx] + in[(work_item_idx + 1) % NUM_ITEMS];
+
+    atomic_fetch_add(&phased->num_done[phase], 1);
+
+    if (phase == phased->cancel_phase)
+        archi_thread_group_cancel_current_dispatch();
+}
+
+TEST(archi_thread_group_dispatch_phased)
+{
+    archi_error_t error;
+
+    static struct phased_data phased, expected;
+
+    // Compute the expected result serially
+    for (size_t i = 0; i < NUM_ITEMS; i++)
+        expected.buffer[0][i] = (unsigned)i;
+
+    for (size_t phase = 0; phase < NUM_PHASES; phase++)
+        for (size_t i = 0; i < NUM_ITEMS; i++)
+            expected.buffer[(phase + 1) % 2][i] = 3 * expected.buffer[phase % 2][i] +
+                expected.buffer[phase % 2][(i + 1) % NUM_ITEMS];
+
+    for (size_t num_threads = 0; num_threads <= 4; num_threads += 4)
+    {
+        archi_thread_group_t group = archi_thread_group_create(
+                (archi_thread_group_start_params_t){.num_threads = num_threads}, &error);
+        ASSERT_NE(group, NULL, void*, "%p");
+
+        for (int schedule = ARCHI_THREAD_GROUP_SCHEDULE__SHARED;
+                schedule <= ARCHI_THREAD_GROUP_SCHEDULE__ADAPTIVE; schedule++)
+        {
+            for (size_t cancel_phase = 2; cancel_phase <= NUM_PHASES; cancel_phase += NUM_PHASES - 2)
+            {
+                for (size_t i = 0; i < NUM_ITEMS; i++)
+                    phased.buffer[0][i] = (unsigned)i;
+                for (size_t phase = 0; phase < NUM_PHASES; phase++)
+                    atomic_store(&phased.num_done[phase], 0);
+                atomic_store(&phased.overlap, false);
+                phased.cancel_phase = cancel_phase;
+
+                size_t work_size = SIZE_MAX;
+
+                ASSERT_TRUE(archi_thread_group_dispatch_phased(group,
+                            (archi_thread_group_phase_work_t){.function = phased_work, .data = &phased,
+                                .num_phases = NUM_PHASES},
+                            (archi_thread_group_callback_t){.function = store_work_size, .data = &work_size},
+                            (archi_thread_group_dispatch_params_t){.size = NUM_ITEMS, .batch_size = 3,
+                                .schedule = schedule}, &error));
+                ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+
+                archi_thread_group_wait(group);
+
+                // Phases don't overlap
+                ASSERT_FALSE(atomic_load(&phased.overlap));
+
+                if (cancel_phase < NUM_PHASES)
+                {
+                    // No further phases are started after cancellation
+                    ASSERT_EQ(atomic_load(&phased.num_done[cancel_phase - 1]), NUM_ITEMS, size_t, "%zu");
+                    ASSERT_TRUE(atomic_load(&phased.num_done[cancel_phase]) < NUM_ITEMS);
+                    ASSERT_EQ(atomic_load(&phased.num_done[cancel_phase + 1]), 0, size_t, "%zu");
+                    ASSERT_EQ(work_size, atomic_load(&phased.num_done[cancel_phase]), size_t, "%zu");
+                }
+                else
+                {
+                    ASSERT_EQ(work_size, NUM_ITEMS, size_t, "%zu");
+
+                    for (size_t i = 0; i < NUM_ITEMS; i++)
+                        ASSERT_EQ(phased.buffer[NUM_PHASES % 2][i], expected.buffer[NUM_PHASES % 2][i],
+                                unsigned, "%u");
+                }
+            }
+        }
+
+        archi_thread_group_destroy(group);
+    }
+}
+
+struct adaptive_data {
+    atomic_uint count[NUM_ITEMS];
+    atomic_bool inline_thread; // whether the dispatching thread has done a work item
+    atomic_bool group_thread;  // whether a thread of the group has done a work item
+    size_t num_threads;
+    uint64_t item_ns;
+};
+
+static
+ARCHI_THREAD_GROUP_WORK_FUNC(adaptive_work)
+{
+    struct adaptive_data *adaptive = data;
+
+    if (adaptive->item_ns != 0)
+    {
+        struct timespec start, now;
+        timespec_get(&start, TIME_UTC);
+
+        do
+            timespec_get(&now, TIME_UTC);
+        while ((uint64_t)(now.tv_sec - start.tv_sec) * 1000000000u + (uint64_t)now.tv_nsec -
+                (uint64_t)start.tv_nsec < adaptive->item_ns);
+    }
+
+    atomic_fetch_add(&adaptive->count[work_item_idx], 1);
+
+    if (thread_idx == adaptive->num_threads)
+        atomic_store(&adaptive->inline_thread, true);
+    else
+        atomic_store(&adaptive->group_thread, true);
+}
+
+// Costs are measured per work function
+static
+ARCHI_THREAD_GROUP_WORK_FUNC(costly_work)
+{
+    adaptive_work(data, work_item_idx, thread_idx);
+}
+
+static
+void
+adaptive_reset(
+        struct adaptive_data *adaptive)
+{
+    for (size_t i = 0; i < NUM_ITEMS; i++)
+        atomic_store(&adaptive->count[i], 0);
+
+    atomic_store(&adaptive->inline_thread, false);
+    atomic_store(&adaptive->group_thread, false);
+}
+
+static
+bool
+adaptive_done_once(
+        struct adaptive_data *adaptive,
+        size_t size)
+{
+    for (size_t i = 0; i < NUM_ITEMS; i++)
+        if (atomic_load(&adaptive->count[i]) != (i < size))
+            return false;
+
+    return true;
+}
+
+TEST(archi_thread_group_adaptive)
+{
+    archi_error_t error;
+
+    archi_thread_group_t group = archi_thread_group_create(
+            (archi_thread_group_start_params_t){.num_threads = 4, .queue_capacity = 2}, &error);
+    ASSERT_NE(group, NULL, void*, "%p");
+
+    static struct adaptive_data cheap = {.num_threads = 4}, costly = {.num_threads = 4, .item_ns = 200000};
+
+    archi_thread_group_dispatch_params_t params = {.schedule = ARCHI_THREAD_GROUP_SCHEDULE__ADAPTIVE};
+
+    // Unmeasured work is done by the group
+    adaptive_reset(&cheap);
+    params.size = 16;
+
+    ASSERT_TRUE(archi_thread_group_dispatch(group,
+                (archi_thread_group_work_t){.function = adaptive_work, .data = &cheap},
+                (archi_thread_group_callback_t){0}, params, &error));
+    archi_thread_group_wait(group);
+
+    ASSERT_TRUE(adaptive_done_once(&cheap, params.size));
+    ASSERT_FALSE(atomic_load(&cheap.inline_thread));
+
+    // Small measured work is done in the dispatching thread of an idle group
+    bool done_inline = false;
+
+    for (int attempt = 0; (attempt < 100) && !done_inline; attempt++)
+    {
+        adaptive_reset(&cheap);
+
+        ASSERT_TRUE(archi_thread_group_dispatch(group,
+                    (archi_thread_group_work_t){.function = adaptive_work, .data = &cheap},
+                    (archi_thread_group_callback_t){0}, params, &error));
+
+        if (atomic_load(&cheap.inline_thread))
+        {
+            // The work is done before the function returns
+            ASSERT_TRUE(adaptive_done_once(&cheap, params.size));
+            ASSERT_FALSE(atomic_load(&cheap.group_thread));
+
+            done_inline = true;
+        }
+
+        archi_thread_group_wait(group);
+        ASSERT_TRUE(adaptive_done_once(&cheap, params.size));
+    }
+
+    ASSERT_TRUE(done_inline);
+
+    // Small work queued behind a busy group is still done by the group, in order
+    atomic_bool gate = false;
+    adaptive_reset(&cheap);
+
+    ASSERT_NE(archi_thread_group_enqueue(group,
+                (archi_thread_group_work_t){.function = gate_work, .data = &gate},
+                (archi_thread_group_callback_t){0},
+                (archi_thread_group_dispatch_params_t){.size = 1}, 0, &error), 0, size_t, "%zu");
+    ASSERT_NE(archi_thread_group_enqueue(group,
+                (archi_thread_group_work_t){.function = adaptive_work, .data = &cheap},
+                (archi_thread_group_callback_t){0}, params, 1, &error), 0, size_t, "%zu");
+
+    ASSERT_FALSE(atomic_load(&cheap.inline_thread));
+    atomic_store(&gate, true);
+
+    archi_thread_group_wait(group);
+    ASSERT_TRUE(adaptive_done_once(&cheap, params.size));
+    ASSERT_FALSE(atomic_load(&cheap.inline_thread));
+
+    // Large work is done by the group, and every item is done once whatever the batch size
+    params.size = 64;
+
+    for (int i = 0; i < 3; i++)
+    {
+        adaptive_reset(&costly);
+
+        ASSERT_TRUE(archi_thread_group_dispatch(group,
+                    (archi_thread_group_work_t){.function = costly_work, .data = &costly},
+                    (archi_thread_group_callback_t){0}, params, &error));
+        archi_thread_group_wait(group);
+
+        ASSERT_TRUE(adaptive_done_once(&costly, params.size));
+        ASSERT_FALSE(atomic_load(&costly.inline_thread));
+    }
+
+    // Helping threads take part in adaptive dispatches
+    params.size = NUM_ITEMS;
+    adaptive_reset(&cheap);
+
+    ASSERT_TRUE(archi_thread_group_dispatch_help(group,
+                (archi_thread_group_work_t){.function = adaptive_work, .data = &cheap},
+                (archi_thread_group_callback_t){0}, params, &error));
+    ASSERT_TRUE(adaptive_done_once(&cheap, params.size));
+
+    archi_thread_group_destroy(group);
+}
+
+struct tiled_data {
+    size_t size[3];
+    size_t tile_size[3];
+
+    atomic_uint count[128];
+    atomic_size_t num_tiles;
+    atomic_bool bad_tile; // whether a tile has wrong bounds
+};
+
+static
+ARCHI_THREAD_GROUP_TILE_WORK_FUNC(tiled_work)
+{
+    (void) thread_idx;
+
+    struct tiled_data *tiled = data;
+    atomic_fetch_add(&tiled->num_tiles, 1);
+
+    for (size_t d = 0; d < 3; d++)
+    {
+        // Tiles are aligned to the tile grid, edge tiles are clamped to the domain
+        if ((tile.begin[d] != tile.coord[d] * tiled->tile_size[d]) ||
+                (tile.begin[d] >= tile.end[d]) || (tile.end[d] > tiled->size[d]) ||
+                (tile.end[d] - tile.begin[d] > tiled->tile_size[d]) ||
+                ((tile.end[d] - tile.begin[d] < tiled->tile_size[d]) && (tile.end[d] != tiled->size[d])))
+            atomic_store(&tiled->bad_tile, true);
+    }
+
+    for (size_t z = tile.begin[2]; z < tile.end[2]; z++)
+        for (size_t y = tile.begin[1]; y < tile.end[1]; y++)
+            for (size_t x = tile.begin[0]; x < tile.end[0]; x++)
+                atomic_fetch_add(&tiled->count[(z * tiled->size[1] + y) * tiled->size[0] + x], 1);
+}
+
+TEST(archi_thread_group_dispatch_tiled)
+{
+    archi_error_t error;
+
+    static const struct {
+        size_t size[3];
+        size_t tile_size[3];
+        size_t num_tiles;
+    } domain[] = {
+        {{100, 1, 1}, {7, 0, 0}, 15},  // 1D with a partial edge tile
+        {{13, 9, 1}, {4, 4, 0}, 12},   // 2D with partial edge tiles
+        {{7, 5, 3}, {3, 2, 2}, 18},    // 3D with partial edge tiles
+        {{8, 8, 2}, {0, 0, 0}, 1},     // whole domain in one tile
+        {{5, 4, 3}, {1, 1, 1}, 60},    // single element tiles
+    };
+
+    static struct tiled_data tiled;
+
+    for (size_t num_threads = 0; num_threads <= 4; num_threads += 4)
+    {
+        archi_thread_group_t group = archi_thread_group_create(
+                (archi_thread_group_start_params_t){.num_threads = num_threads}, &error);
+        ASSERT_NE(group, NULL, void*, "%p");
+
+        for (int order = ARCHI_THREAD_GROUP_TILE_ORDER__ROW_MAJOR;
+                order <= ARCHI_THREAD_GROUP_TILE_ORDER__MORTON; order++)
+        {
+            for (size_t i = 0; i < sizeof(domain) / sizeof(domain[0]); i++)
+            {
+                tiled = (struct tiled_data){0};
+
+                for (size_t d = 0; d < 3; d++)
+                {
+                    tiled.size[d] = domain[i].size[d];
+                    tiled.tile_size[d] = (domain[i].tile_size[d] != 0) ?
+                        domain[i].tile_size[d] : domain[i].size[d];
+                }
+
+                size_t work_size = SIZE_MAX;
+
+                archi_thread_group_tiled_dispatch_params_t params = {
+                    .order = order, .batch_size = 2};
+                for (size_t d = 0; d < 3; d++)
+                {
+                    params.size[d] = domain[i].size[d];
+                    params.tile_size[d] = domain[i].tile_size[d];
+                }
+
+                ASSERT_TRUE(archi_thread_group_dispatch_tiled(group,
+                            (archi_thread_group_tile_work_t){.function = tiled_work, .data = &tiled},
+                            (archi_thread_group_callback_t){.function = store_work_size, .data = &work_size},
+                            params, &error));
+                ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+
+                archi_thread_group_wait(group);
+
+                // Every element is processed exactly once
+                size_t num_elements = domain[i].size[0] * domain[i].size[1] * domain[i].size[2];
+                for (size_t e = 0; e < num_elements; e++)
+                    ASSERT_EQ(atomic_load(&tiled.count[e]), 1, unsigned, "%u");
+
+                ASSERT_FALSE(atomic_load(&tiled.bad_tile));
+                ASSERT_EQ(atomic_load(&tiled.num_tiles), domain[i].num_tiles, size_t, "%zu");
+
+                // Morton order pads the tile grid to powers of two
+                if (order == ARCHI_THREAD_GROUP_TILE_ORDER__ROW_MAJOR)
+                    ASSERT_EQ(work_size, domain[i].num_tiles, size_t, "%zu");
+                else
+                    ASSERT_TRUE(work_size >= domain[i].num_tiles);
+            }
+
+            // Empty domain means no work
+            for (size_t d = 0; d < 3; d++)
+            {
+                tiled = (struct tiled_data){0};
+                size_t work_size = SIZE_MAX;
+
+                archi_thread_group_tiled_dispatch_params_t params = {
+                    .order = order, .size = {4, 4, 4}};
+                params.size[d] = 0;
+
+                ASSERT_TRUE(archi_thread_group_dispatch_tiled(group,
+                            (archi_thread_group_tile_work_t){.function = tiled_work, .data = &tiled},
+                            (archi_thread_group_callback_t){.function = store_work_size, .data = &work_size},
+                            params, &error));
+                ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+
+                archi_thread_group_wait(group);
+
+                ASSERT_EQ(atomic_load(&tiled.num_tiles), 0, size_t, "%zu");
+                ASSERT_EQ(work_size, SIZE_MAX, size_t, "%zu");
+            }
+        }
+
+        archi_thread_group_destroy(group);
+    }
+}
+
+static
+ARCHI_THREAD_GROUP_WORK_FUNC(count_work)
+{
+    (void) work_item_idx;
+    (void) thread_idx;
+
+    atomic_fetch_add((atomic_size_t*)data, 1);
+}
+
+TEST(archi_thread_group_spin)
+{
+    archi_error_t error;
+
+    // Long spinning: threads catch back-to-back work without sleeping
+    // Short spinning: threads fall back to sleeping between sparse work tasks
+    static const uint64_t spin_ns[] = {50000000, 10000};
+
+    for (size_t s = 0; s < sizeof(spin_ns) / sizeof(spin_ns[0]); s++)
+    {
+        archi_thread_group_t group = archi_thread_group_create(
+                (archi_thread_group_start_params_t){.num_threads = 3, .queue_capacity = 4,
+                    .spin_ns = spin_ns[s]}, &error);
+        ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+        ASSERT_NE(group, NULL, void*, "%p");
+
+        atomic_size_t counter = 0;
+        archi_thread_group_work_t work = {.function = count_work, .data = &counter};
+        archi_thread_group_dispatch_params_t params = {.size = 64, .batch_size = 4};
+
+        size_t expected = 0;
+
+        for (int i = 0; i < 20; i++)
+        {
+            ASSERT_TRUE(archi_thread_group_dispatch(group, work, (archi_thread_group_callback_t){0},
+                        params, &error));
+            archi_thread_group_wait(group);
+
+            expected += params.size;
+            ASSERT_EQ(atomic_load(&counter), expected, size_t, "%zu");
+
+            ASSERT_NE(archi_thread_group_enqueue(group, work, (archi_thread_group_callback_t){0},
+                        params, 0, &error), 0, size_t, "%zu");
+            ASSERT_NE(archi_thread_group_enqueue(group, work, (archi_thread_group_callback_t){0},
+                        params, 0, &error), 0, size_t, "%zu");
+            archi_thread_group_wait(group);
+
+            expected += 2 * params.size;
+            ASSERT_EQ(atomic_load(&counter), expected, size_t, "%zu");
+
+            // Let the threads go past spinning every few tasks
+            if (i % 5 == 4)
+                thrd_sleep(&(struct timespec){.tv_nsec = 5000000}, NULL);
+        }
+
+        // Waiting for held work times out while spinning or sleeping
+        atomic_bool gate = false;
+
+        size_t ticket = archi_thread_group_enqueue(group,
+                (archi_thread_group_work_t){.function = gate_work, .data = &gate},
+                (archi_thread_group_callback_t){0}, (archi_thread_group_dispatch_params_t){.size = 1},
+                0, &error);
+        ASSERT_NE(ticket, 0, size_t, "%zu");
+
+        struct timespec time_point;
+        timespec_get(&time_point, TIME_UTC);
+        time_point.tv_nsec += 1000000;
+        if (time_point.tv_nsec >= 1000000000)
+        {
+            time_point.tv_sec++;
+            time_point.tv_nsec -= 1000000000;
+        }
+
+        archi_thread_group_wait_ticket(group, ticket, &time_point);
+        ASSERT_FALSE(atomic_load(&gate));
+
+        atomic_store(&gate, true);
+        archi_thread_group_wait_ticket(group, ticket, NULL);
+
+        // Idle threads stop spinning and sleep
+        if (spin_ns[s] < 1000000)
+        {
+            clock_t cpu_begin = clock();
+            thrd_sleep(&(struct timespec){.tv_nsec = 100000000}, NULL);
+            clock_t cpu_end = clock();
+
+            ASSERT_LT((double)(cpu_end - cpu_begin) / CLOCKS_PER_SEC, 0.05, double, "%f");
+        }
+
+        archi_thread_group_destroy(group);
+    }
+}
+
+#define SCRATCH_SIZE    256
+#define SCRATCH_THREADS 3
+
+struct scratch_data {
+    atomic_size_t num_arrived;
+    size_t num_participants;
+
+    char *base[SCRATCH_THREADS + 1];
+    atomic_size_t num_failures;
+};
+
+static
+ARCHI_THREAD_GROUP_WORK_FUNC(scratch_align_work)
+{
+    (void) work_item_idx;
+    (void) thread_idx;
+
+    atomic_size_t *num_failures = data;
+
+    size_t mark = archi_thread_group_scratch_mark();
+
+    static const size_t alignment[] = {0, 1, 2, 8, 16, 64, 128};
+    for (size_t i = 0; i < sizeof(alignment) / sizeof(alignment[0]); i++)
+    {
+        char *ptr = archi_thread_group_scratch_alloc(3, alignment[i]);
+        if ((ptr == NULL) || ((alignment[i] != 0) && ((uintptr_t)ptr % alignment[i] != 0)))
+            atomic_fetch_add(num_failures, 1);
+    }
+
+    // Incorrect alignment
+    if (archi_thread_group_scratch_alloc(1, 3) != NULL)
+        atomic_fetch_add(num_failures, 1);
+
+    // Not enough free space
+    if (archi_thread_group_scratch_alloc(SCRATCH_SIZE, 1) != NULL)
+        atomic_fetch_add(num_failures, 1);
+
+    // Rewinding releases memory for reuse
+    archi_thread_group_scratch_rewind(mark);
+    if (archi_thread_group_scratch_mark() != mark)
+        atomic_fetch_add(num_failures, 1);
+
+    char *ptr = archi_thread_group_scratch_alloc(SCRATCH_SIZE - mark, 1);
+    if (ptr == NULL)
+        atomic_fetch_add(num_failures, 1);
+
+    archi_thread_group_scratch_rewind(mark);
+}
+
+static
+ARCHI_THREAD_GROUP_WORK_FUNC(scratch_isolation_work)
+{
+    (void) work_item_idx;
+
+    struct scratch_data *scratch = data;
+
+    // Hold every participant until all of them have taken a work item
+    atomic_fetch_add(&scratch->num_arrived, 1);
+    while (atomic_load(&scratch->num_arrived) < scratch->num_participants)
+        thrd_yield();
+
+    char *ptr = archi_thread_group_scratch_alloc(SCRATCH_SIZE, 1);
+    if (ptr == NULL)
+    {
+        atomic_fetch_add(&scratch->num_failures, 1);
+        return;
+    }
+
+    scratch->base[thread_idx] = ptr;
+
+    for (size_t i = 0; i < SCRATCH_SIZE; i++)
+        ptr[i] = (char)thread_idx;
+
+    // Let other threads write to their arenas
+    atomic_fetch_add(&scratch->num_arrived, 1);
+    while (atomic_load(&scratch->num_arrived) < 2 * scratch->num_participants)
+        thrd_yield();
+
+    for (size_t i = 0; i < SCRATCH_SIZE; i++)
+        if (ptr[i] != (char)thread_idx)
+        {
+            atomic_fetch_add(&scratch->num_failures, 1);
+            break;
+        }
+}
+
+static
+ARCHI_THREAD_GROUP_WORK_FUNC(scratch_reset_work)
+{
+    (void) work_item_idx;
+    (void) thread_idx;
+
+    // Memory is not released: it must be reclaimed by the next work task
+    if (archi_thread_group_scratch_alloc(SCRATCH_SIZE / 2, 1) == NULL)
+        atomic_fetch_add((atomic_size_t*)data, 1);
+}
+
+TEST(archi_thread_group_scratch)
+{
+    archi_error_t error;
+
+    // No scratch arena outside of thread groups
+    ASSERT_EQ(archi_thread_group_scratch_alloc(1, 1), NULL, void*, "%p");
+    ASSERT_EQ(archi_thread_group_scratch_mark(), 0, size_t, "%zu");
+
+    for (size_t num_threads = 0; num_threads <= SCRATCH_THREADS; num_threads += SCRATCH_THREADS)
+    {
+        archi_thread_group_t group = archi_thread_group_create(
+                (archi_thread_group_start_params_t){.num_threads = num_threads, .queue_capacity = 2,
+                    .scratch_size = SCRATCH_SIZE}, &error);
+        ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+        ASSERT_NE(group, NULL, void*, "%p");
+
+        // Alignment
+        atomic_size_t num_failures = 0;
+
+        ASSERT_TRUE(archi_thread_group_dispatch(group,
+                    (archi_thread_group_work_t){.function = scratch_align_work, .data = &num_failures},
+                    (archi_thread_group_callback_t){0},
+                    (archi_thread_group_dispatch_params_t){.size = 100, .batch_size = 1}, &error));
+        archi_thread_group_wait(group);
+
+        ASSERT_EQ(atomic_load(&num_failures), 0, size_t, "%zu");
+
+        // Per-thread isolation, including the helping thread
+        struct scratch_data scratch = {.num_participants = num_threads + 1};
+
+        ASSERT_TRUE(archi_thread_group_dispatch_help(group,
+                    (archi_thread_group_work_t){.function = scratch_isolation_work, .data = &scratch},
+                    (archi_thread_group_callback_t){0},
+                    (archi_thread_group_dispatch_params_t){.size = num_threads + 1, .batch_size = 1},
+                    &error));
+
+        ASSERT_EQ(atomic_load(&scratch.num_failures), 0, size_t, "%zu");
+
+        for (size_t i = 0; i <= num_threads; i++)
+        {
+            ASSERT_NE(scratch.base[i], NULL, void*, "%p");
+
+            for (size_t j = 0; j < i; j++)
+                ASSERT_TRUE((scratch.base[i] >= scratch.base[j] + SCRATCH_SIZE) ||
+                        (scratch.base[j] >= scratch.base[i] + SCRATCH_SIZE));
+        }
+
+        // The helping thread got its arena back
+        ASSERT_EQ(archi_thread_group_scratch_alloc(1, 1), NULL, void*, "%p");
+
+        // Reset between work tasks
+        for (int i = 0; i < 10; i++)
+        {
+            ASSERT_TRUE(archi_thread_group_dispatch(group,
+                        (archi_thread_group_work_t){.function = scratch_reset_work, .data = &num_failures},
+                        (archi_thread_group_callback_t){0},
+                        (archi_thread_group_dispatch_params_t){.size = 2, .batch_size = 1}, &error));
+            archi_thread_group_wait(group);
+
+            ASSERT_NE(archi_thread_group_enqueue(group,
+                        (archi_thread_group_work_t){.function = scratch_reset_work, .data = &num_failures},
+                        (archi_thread_group_callback_t){0},
+                        (archi_thread_group_dispatch_params_t){.size = 2, .batch_size = 1}, 0, &error),
+                    0, size_t, "%zu");
+            archi_thread_group_wait(group);
+        }
+
+        ASSERT_EQ(atomic_load(&num_failures), 0, size_t, "%zu");
+
+        archi_thread_group_destroy(group);
+    }
+}
+
+struct scratch_interface_data {
+    size_t num_allocs, num_frees, num_maps, num_unmaps;
+    size_t num_bytes, alignment;
+    char *mapping;
+};
+
+static
+ARCHI_MEMORY_ALLOC_FUNC(scratch_interface_alloc)
+{
+    struct scratch_interface_data *interface_data = alloc_data;
+
+    interface_data->num_allocs++;
+    interface_data->num_bytes = num_bytes;
+    interface_data->alignment = alignment;
+
+    ARCHI_ERROR_RESET();
+    return (archi_memory_alloc_info_t){.allocation = {
+        .ptr = aligned_alloc(alignment, num_bytes), .writable = true}, .metadata = interface_data};
+}
+
+static
+ARCHI_MEMORY_FREE_FUNC(scratch_interface_free)
+{
+    struct scratch_interface_data *interface_data = alloc_info.metadata;
+
+    interface_data->num_frees++;
+    free(alloc_info.allocation.ptr);
+}
+
+static
+ARCHI_MEMORY_MAP_FUNC(scratch_interface_map)
+{
+    (void) num_bytes;
+    (void) map_data;
+
+    struct scratch_interface_data *interface_data = alloc_info.metadata;
+
+    interface_data->num_maps++;
+    interface_data->mapping = (char*)alloc_info.allocation.ptr + offset;
+
+    ARCHI_ERROR_RESET();
+    return (archi_memory_map_info_t){.mapping = {.ptr = interface_data->mapping, .writable = true}};
+}
+
+static
+ARCHI_MEMORY_UNMAP_FUNC(scratch_interface_unmap)
+{
+    (void) map_info;
+
+    struct scratch_interface_data *interface_data = alloc_info.metadata;
+
+    interface_data->num_unmaps++;
+}
+
+TEST(archi_thread_group_scratch_interface)
+{
+    archi_error_t error;
+
+    const archi_memory_interface_t interface = {
+        .alloc_fn = scratch_interface_alloc,
+        .free_fn = scratch_interface_free,
+        .map_fn = scratch_interface_map,
+        .unmap_fn = scratch_interface_unmap,
+    };
+
+    struct scratch_interface_data interface_data = {0};
+
+    archi_thread_group_t group = archi_thread_group_create(
+            (archi_thread_group_start_params_t){.num_threads = SCRATCH_THREADS, .queue_capacity = 2,
+                .scratch_size = SCRATCH_SIZE, .scratch_interface = &interface,
+                .scratch_alloc_data = &interface_data}, &error);
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+    ASSERT_NE(group, NULL, void*, "%p");
+
+    // All arenas are allocated and mapped at once
+    ASSERT_EQ(interface_data.num_allocs, 1, size_t, "%zu");
+    ASSERT_EQ(interface_data.num_maps, 1, size_t, "%zu");
+    ASSERT_TRUE(interface_data.num_bytes >= (SCRATCH_THREADS + 1) * SCRATCH_SIZE);
+    ASSERT_NE(interface_data.alignment, 0, size_t, "%zu");
+
+    struct scratch_data scratch = {.num_participants = SCRATCH_THREADS + 1};
+
+    ASSERT_TRUE(archi_thread_group_dispatch_help(group,
+                (archi_thread_group_work_t){.function = scratch_isolation_work, .data = &scratch},
+                (archi_thread_group_callback_t){0},
+                (archi_thread_group_dispatch_params_t){.size = SCRATCH_THREADS + 1, .batch_size = 1},
+                &error));
+
+    ASSERT_EQ(atomic_load(&scratch.num_failures), 0, size_t, "%zu");
+
+    // Arenas are placed in the mapped memory
+    for (size_t i = 0; i <= SCRATCH_THREADS; i++)
+    {
+        ASSERT_TRUE(scratch.base[i] >= interface_data.mapping);
+        ASSERT_TRUE(scratch.base[i] + SCRATCH_SIZE <= interface_data.mapping + interface_data.num_bytes);
+    }
+
+    archi_thread_group_destroy(group);
+
+    ASSERT_EQ(interface_data.num_unmaps, 1, size_t, "%zu");
+    ASSERT_EQ(interface_data.num_frees, 1, size_t, "%zu");
+
+    // Allocation function is required
+    const archi_memory_interface_t no_alloc_interface = {.free_fn = scratch_interface_free};
+
+    group = archi_thread_group_create(
+            (archi_thread_group_start_params_t){.num_threads = SCRATCH_THREADS,
+                .scratch_size = SCRATCH_SIZE, .scratch_interface = &no_alloc_interface}, &error);
+    ASSERT_EQ(error.code, ARCHI__ECONSTRAINT, archi_error_code_t, "%i");
+    ASSERT_EQ(group, NULL, void*, "%p");
+}
+
+#define STATS_THREADS   3
+
+static
+bool
+sum_thread_stats(
+        archi_thread_group_t group,
+        archi_thread_group_thread_stats_t *sum)
+{
+    *sum = (archi_thread_group_thread_stats_t){0};
+
+    for (size_t i = 0; i <= archi_thread_group_num_threads(group); i++)
+    {
+        archi_thread_group_thread_stats_t stats;
+        if (!archi_thread_group_thread_stats(group, i, &stats))
+            return false;
+
+        sum->num_work_items += stats.num_work_items;
+        sum->num_batches += stats.num_batches;
+        sum->busy_ns += stats.busy_ns;
+        sum->wait_ns += stats.wait_ns;
+        sum->num_wakeups += stats.num_wakeups;
+        sum->wake_latency_ns += stats.wake_latency_ns;
+
+        if (stats.max_wake_latency_ns > sum->max_wake_latency_ns)
+            sum->max_wake_latency_ns = stats.max_wake_latency_ns;
+    }
+
+    return true;
+}
+
+TEST(archi_thread_group_stats)
+{
+    archi_error_t error;
+
+    for (size_t num_threads = 0; num_threads <= STATS_THREADS; num_threads += STATS_THREADS)
+    {
+        // Statistics are not collected unless requested
+        archi_thread_group_t group = archi_thread_group_create(
+                (archi_thread_group_start_params_t){.num_threads = num_threads}, &error);
+        ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+        ASSERT_NE(group, NULL, void*, "%p");
+
+        archi_thread_group_stats_t stats;
+        archi_thread_group_thread_stats_t thread_stats;
+
+        ASSERT_FALSE(archi_thread_group_stats(group, &stats));
+        ASSERT_FALSE(archi_thread_group_thread_stats(group, 0, &thread_stats));
+
+        archi_thread_group_stats_reset(group);
+        archi_thread_group_destroy(group);
+
+        group = archi_thread_group_create(
+                (archi_thread_group_start_params_t){.num_threads = num_threads, .queue_capacity = 2,
+                    .stats = true}, &error);
+        ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+        ASSERT_NE(group, NULL, void*, "%p");
+
+        // Counters start at zero
+        ASSERT_TRUE(archi_thread_group_stats(group, &stats));
+        ASSERT_EQ(stats.num_dispatches, 0, uint64_t, "%" PRIu64);
+
+        ASSERT_TRUE(sum_thread_stats(group, &thread_stats));
+        ASSERT_EQ(thread_stats.num_work_items, 0, uint64_t, "%" PRIu64);
+        ASSERT_EQ(thread_stats.num_batches, 0, uint64_t, "%" PRIu64);
+
+        // Helping thread has an index equal to the number of threads
+        ASSERT_TRUE(archi_thread_group_thread_stats(group, num_threads, &thread_stats));
+        ASSERT_FALSE(archi_thread_group_thread_stats(group, num_threads + 1, &thread_stats));
+
+        atomic_size_t counter = 0;
+        archi_thread_group_work_t work = {.function = count_work, .data = &counter};
+
+        // Per-thread counters sum to the dispatched size
+        ASSERT_TRUE(archi_thread_group_dispatch(group, work, (archi_thread_group_callback_t){0},
+                    (archi_thread_group_dispatch_params_t){.size = NUM_ITEMS, .batch_size = 1}, &error));
+        archi_thread_group_wait(group);
+
+        ASSERT_TRUE(sum_thread_stats(group, &thread_stats));
+        if (num_threads > 0)
+        {
+            ASSERT_EQ(thread_stats.num_work_items, NUM_ITEMS, uint64_t, "%" PRIu64);
+            ASSERT_EQ(thread_stats.num_batches, NUM_ITEMS, uint64_t, "%" PRIu64);
+        }
+        else // work is done by the calling thread at once
+        {
+            ASSERT_EQ(thread_stats.num_work_items, NUM_ITEMS, uint64_t, "%" PRIu64);
+            ASSERT_EQ(thread_stats.num_batches, 1, uint64_t, "%" PRIu64);
+        }
+
+        ASSERT_TRUE(archi_thread_group_dispatch_help(group, work, (archi_thread_group_callback_t){0},
+                    (archi_thread_group_dispatch_params_t){.size = NUM_ITEMS, .batch_size = 10}, &error));
+
+        ASSERT_NE(archi_thread_group_enqueue(group, work, (archi_thread_group_callback_t){0},
+                    (archi_thread_group_dispatch_params_t){.size = NUM_ITEMS, .batch_size = 100}, 0, &error),
+                0, size_t, "%zu");
+        archi_thread_group_wait(group);
+
+        ASSERT_EQ(atomic_load(&counter), 3 * NUM_ITEMS, size_t, "%zu");
+
+        ASSERT_TRUE(sum_thread_stats(group, &thread_stats));
+        ASSERT_EQ(thread_stats.num_work_items, 3 * NUM_ITEMS, uint64_t, "%" PRIu64);
+        if (num_threads > 0)
+            ASSERT_EQ(thread_stats.num_batches, NUM_ITEMS + NUM_ITEMS / 10 + NUM_ITEMS / 100,
+                    uint64_t, "%" PRIu64);
+        else
+            ASSERT_EQ(thread_stats.num_batches, 3, uint64_t, "%" PRIu64);
+
+        ASSERT_TRUE(archi_thread_group_stats(group, &stats));
+        ASSERT_EQ(stats.num_dispatches, 3, uint64_t, "%" PRIu64);
+        ASSERT_TRUE(stats.max_tail_ns <= stats.tail_ns);
+
+        // Reset zeroes all counters
+        archi_thread_group_stats_reset(group);
+
+        ASSERT_TRUE(archi_thread_group_stats(group, &stats));
+        ASSERT_EQ(stats.num_dispatches, 0, uint64_t, "%" PRIu64);
+        ASSERT_EQ(stats.tail_ns, 0, uint64_t, "%" PRIu64);
+        ASSERT_EQ(stats.max_tail_ns, 0, uint64_t, "%" PRIu64);
+
+        for (size_t i = 0; i <= num_threads; i++)
+        {
+            ASSERT_TRUE(archi_thread_group_thread_stats(group, i, &thread_stats));
+            ASSERT_EQ(thread_stats.num_work_items, 0, uint64_t, "%" PRIu64);
+            ASSERT_EQ(thread_stats.num_batches, 0, uint64_t, "%" PRIu64);
+            ASSERT_EQ(thread_stats.busy_ns, 0, uint64_t, "%" PRIu64);
+            ASSERT_EQ(thread_stats.wait_ns, 0, uint64_t, "%" PRIu64);
+            ASSERT_EQ(thread_stats.num_wakeups, 0, uint64_t, "%" PRIu64);
+            ASSERT_EQ(thread_stats.wake_latency_ns, 0, uint64_t, "%" PRIu64);
+            ASSERT_EQ(thread_stats.max_wake_latency_ns, 0, uint64_t, "%" PRIu64);
+        }
+
+        // Counting resumes after reset
+        ASSERT_TRUE(archi_thread_group_dispatch(group, work, (archi_thread_group_callback_t){0},
+                    (archi_thread_group_dispatch_params_t){.size = NUM_ITEMS / 2, .batch_size = 1}, &error));
+        archi_thread_group_wait(group);
+
+        ASSERT_TRUE(sum_thread_stats(group, &thread_stats));
+        ASSERT_EQ(thread_stats.num_work_items, NUM_ITEMS / 2, uint64_t, "%" PRIu64);
+
+        ASSERT_TRUE(archi_thread_group_stats(group, &stats));
+        ASSERT_EQ(stats.num_dispatches, 1, uint64_t, "%" PRIu64);
+
+        archi_thread_group_destroy(group);
+    }
+}
@@ -0,0 +1,186 @@
+#include "test.h"
+
+#include "archi/thread/ctx/thread_group.var.h"
+#include "archi/thread/api/thread_group.fun.h"
+#include "archi/context/api/interface.fun.h"
+#include "archi/context/api/tag.def.h"
+#include "archi_base/pointer.def.h"
+#include "archi_base/pointer.fun.h"
+
+#include <stdatomic.h>
+#include <inttypes.h>
+
+
+#define NUM_THREADS 3
+#define NUM_ITEMS   1000
+
+static
+ARCHI_THREAD_GROUP_WORK_FUNC(count_work)
+{
+    (void) work_item_idx;
+    (void) thread_idx;
+
+    atomic_fetch_add((atomic_size_t*)data, 1);
+}
+
+struct slot_value {
+    archi_pointer_attr_t attr;
+
+    archi_thread_group_stats_t stats;
+    archi_thread_group_thread_stats_t thread_stats;
+};
+
+static
+ARCHI_CONTEXT_CALLBACK_FUNC(copy_value)
+{
+    // The value is on the stack of the getter, so it is copied here
+    struct slot_value *copy = data;
+    copy->attr = value.attr;
+
+    if (archi_pointer_attr_compatible(value.attr,
+                ARCHI_POINTER_ATTR__PDATA(1, archi_thread_group_stats_t)))
+        copy->stats = *(const archi_thread_group_stats_t*)value.cptr;
+    else if (archi_pointer_attr_compatible(value.attr,
+                ARCHI_POINTER_ATTR__PDATA(1, archi_thread_group_thread_stats_t)))
+        copy->thread_stats = *(const archi_thread_group_thread_stats_t*)value.cptr;
+
+    ARCHI_ERROR_RESET();
+}
+
+static
+archi_context_t
+thread_group_context(
+        bool stats,
+        ARCHI_ERROR_PARAM_DECL)
+{
+    size_t num_threads = NUM_THREADS;
+    char stats_flag = stats;
+
+    archi_krcvlist_t params[] = {
+        {.next = &params[1], .key = "num_threads", .value = {.ptr = &num_threads,
+            .attr = ARCHI_POINTER_TYPE__DATA_WRITABLE | ARCHI_POINTER_ATTR__PDATA(1, size_t)}},
+        {.key = "stats", .value = {.ptr = &stats_flag,
+            .attr = ARCHI_POINTER_TYPE__DATA_WRITABLE | ARCHI_POINTER_ATTR__PDATA(1, char)}},
+    };
+
+    archi_rcpointer_t interface = {
+        .cptr = &archi_context_interface__thread_group,
+        .attr = ARCHI_POINTER_TYPE__DATA_READONLY |
+            archi_pointer_attr__cdata(ARCHI_POINTER_DATA_TAG__CONTEXT_INTERFACE),
+    };
+
+    return archi_context_initialize(interface, params, ARCHI_ERROR_PARAM);
+}
+
+TEST(archi_context_interface__thread_group__stats)
+{
+    archi_error_t error;
+
+    archi_context_t context = thread_group_context(true, &error);
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+    ASSERT_NE(context, NULL, void*, "%p");
+
+    archi_thread_group_t group = archi_context_data(context).ptr;
+    ASSERT_NE(group, NULL, void*, "%p");
+
+    atomic_size_t counter = 0;
+    ASSERT_TRUE(archi_thread_group_dispatch(group,
+                (archi_thread_group_work_t){.function = count_work, .data = &counter},
+                (archi_thread_group_callback_t){0},
+                (archi_thread_group_dispatch_params_t){.size = NUM_ITEMS, .batch_size = 1}, &error));
+    archi_thread_group_wait(group);
+
+    struct slot_value value;
+    archi_context_callback_t callback = {.function = copy_value, .data = &value};
+
+    // Group statistics
+    archi_context_get(context, (archi_context_slot_t){.name = "stats"}, callback, &error);
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+    ASSERT_TRUE(archi_pointer_attr_compatible(value.attr,
+                ARCHI_POINTER_ATTR__PDATA(1, archi_thread_group_stats_t)));
+    ASSERT_EQ(value.stats.num_dispatches, 1, uint64_t, "%" PRIu64);
+
+    // Per-thread statistics sum to the dispatched size
+    uint64_t num_work_items = 0, num_batches = 0;
+
+    for (archi_context_slot_index_t index = 0; index <= NUM_THREADS; index++)
+    {
+        archi_context_get(context, (archi_context_slot_t){.name = "thread_stats",
+                .index = &index, .num_indices = 1}, callback, &error);
+        ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+        ASSERT_TRUE(archi_pointer_attr_compatible(value.attr,
+                    ARCHI_POINTER_ATTR__PDATA(1, archi_thread_group_thread_stats_t)));
+
+        num_work_items += value.thread_stats.num_work_items;
+        num_batches += value.thread_stats.num_batches;
+    }
+
+    ASSERT_EQ(num_work_items, NUM_ITEMS, uint64_t, "%" PRIu64);
+    ASSERT_EQ(num_batches, NUM_ITEMS, uint64_t, "%" PRIu64);
+
+    // Thread index out of bounds
+    archi_context_slot_index_t index = NUM_THREADS + 1;
+    archi_context_get(context, (archi_context_slot_t){.name = "thread_stats",
+            .index = &index, .num_indices = 1}, callback, &error);
+    ASSERT_EQ(error.code, ARCHI__EINDEX, archi_error_code_t, "%i");
+
+    index = -1;
+    archi_context_get(context, (archi_context_slot_t){.name = "thread_stats",
+            .index = &index, .num_indices = 1}, callback, &error);
+    ASSERT_EQ(error.code, ARCHI__EINDEX, archi_error_code_t, "%i");
+
+    archi_context_get(context, (archi_context_slot_t){.name = "thread_stats"}, callback, &error);
+    ASSERT_EQ(error.code, ARCHI__EINDEX, archi_error_code_t, "%i");
+
+    // Reset zeroes the counters
+    archi_context_call(context, (archi_context_slot_t){.name = "reset_stats"}, NULL,
+            (archi_context_callback_t){0}, &error);
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+
+    archi_context_get(context, (archi_context_slot_t){.name = "stats"}, callback, &error);
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+    ASSERT_EQ(value.stats.num_dispatches, 0, uint64_t, "%" PRIu64);
+    ASSERT_EQ(value.stats.tail_ns, 0, uint64_t, "%" PRIu64);
+    ASSERT_EQ(value.stats.max_tail_ns, 0, uint64_t, "%" PRIu64);
+
+    for (archi_context_slot_index_t index = 0; index <= NUM_THREADS; index++)
+    {
+        archi_context_get(context, (archi_context_slot_t){.name = "thread_stats",
+                .index = &index, .num_indices = 1}, callback, &error);
+        ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+
+        ASSERT_EQ(value.thread_stats.num_work_items, 0, uint64_t, "%" PRIu64);
+        ASSERT_EQ(value.thread_stats.num_batches, 0, uint64_t, "%" PRIu64);
+        ASSERT_EQ(value.thread_stats.busy_ns, 0, uint64_t, "%" PRIu64);
+        ASSERT_EQ(value.thread_stats.num_wakeups, 0, uint64_t, "%" PRIu64);
+    }
+
+    archi_context_finalize(context);
+}
+
+TEST(archi_context_interface__thread_group__no_stats)
+{
+    archi_error_t error;
+
+    archi_context_t context = thread_group_context(false, &error);
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+    ASSERT_NE(context, NULL, void*, "%p");
+
+    struct slot_value value;
+    archi_context_callback_t callback = {.function = copy_value, .data = &value};
+
+    archi_context_get(context, (archi_context_slot_t){.name = "stats"}, callback, &error);
+    ASSERT_EQ(error.code, ARCHI__ECONSTRAINT, archi_error_code_t, "%i");
+
+    archi_context_slot_index_t index = 0;
+    archi_context_get(context, (archi_context_slot_t){.name = "thread_stats",
+            .index = &index, .num_indices = 1}, callback, &error);
+    ASSERT_EQ(error.code, ARCHI__ECONSTRAINT, archi_error_code_t, "%i");
+
+    // Resetting statistics that are not collected is allowed
+    archi_context_call(context, (archi_context_slot_t){.name = "reset_stats"}, NULL,
+            (archi_context_callback_t){0}, &error);
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+
+    archi_context_finalize(context);
+}
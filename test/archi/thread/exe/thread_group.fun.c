@@ -0,0 +1,410 @@
+#include "test.h"
+
+#include "archi/thread/exe/thread_group.fun.h"
+#include "archi/thread/exe/thread_group.typ.h"
+#include "archi/thread/api/thread_group.fun.h"
+#include "archi/exec/api/node.fun.h"
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <threads.h>
+#include <time.h>
+
+
+#define NUM_BRANCHES    5
+
+struct branch_data {
+    atomic_int num_runs;
+    archi_error_code_t code; // error code to fail with (0 = succeed)
+};
+
+static
+ARCHI_DEXGRAPH_OPERATION_FUNC(branch_op)
+{
+    struct branch_data *branch = data;
+
+    atomic_fetch_add(&branch->num_runs, 1);
+
+    if (branch->code != 0)
+    {
+        ARCHI_ERROR_SET(branch->code, "branch failed");
+        return;
+    }
+
+    ARCHI_ERROR_RESET();
+}
+
+struct branches {
+    struct branch_data data[NUM_BRANCHES];
+    archi_dexgraph_node_t *node[NUM_BRANCHES];
+    archi_dexgraph_node_array_t *array;
+};
+
+static
+bool
+make_branches(
+        struct branches *branches)
+{
+    *branches = (struct branches){0};
+
+    branches->array = archi_dexgraph_node_array_alloc(NUM_BRANCHES);
+    if (branches->array == NULL)
+        return false;
+
+    // Branch #2 is null
+    for (size_t i = 0; i < NUM_BRANCHES; i++)
+    {
+        if (i == 2)
+            continue;
+
+        branches->node[i] = archi_dexgraph_node_alloc("branch", 1);
+        if (branches->node[i] == NULL)
+            return false;
+
+        branches->node[i]->sequence[0] = (archi_dexgraph_operation_t){
+            .function = branch_op, .data = &branches->data[i]};
+        branches->array->node[i] = branches->node[i];
+    }
+
+    return true;
+}
+
+static
+void
+reset_branches(
+        struct branches *branches,
+        archi_error_code_t code1,
+        archi_error_code_t code3)
+{
+    for (size_t i = 0; i < NUM_BRANCHES; i++)
+        atomic_store(&branches->data[i].num_runs, 0);
+
+    branches->data[1].code = code1;
+    branches->data[3].code = code3;
+}
+
+static
+void
+free_branches(
+        struct branches *branches)
+{
+    for (size_t i = 0; i < NUM_BRANCHES; i++)
+        archi_dexgraph_node_free(branches->node[i]);
+
+    archi_dexgraph_node_array_free(branches->array);
+}
+
+static
+bool
+all_branches_run_once(
+        struct branches *branches)
+{
+    for (size_t i = 0; i < NUM_BRANCHES; i++)
+        if (atomic_load(&branches->data[i].num_runs) != ((i != 2) ? 1 : 0))
+            return false;
+
+    return true;
+}
+
+TEST(archi_dexgraph_op__thread_group_fork_join)
+{
+    archi_error_t error;
+
+    struct branches branches;
+    ASSERT_TRUE(make_branches(&branches));
+
+    for (size_t num_threads = 0; num_threads <= 3; num_threads += 3)
+    {
+        archi_thread_group_t group = archi_thread_group_create(
+                (archi_thread_group_start_params_t){.num_threads = num_threads}, &error);
+        ASSERT_NE(group, NULL, void*, "%p");
+
+        archi_error_t branch_error[NUM_BRANCHES];
+        archi_dexgraph_op_data__thread_group_fork_join_t fork_join = {
+            .thread_group = group, .branches = branches.array};
+
+        // All branches succeed
+        reset_branches(&branches, 0, 0);
+
+        ARCHI_ERROR_VAR_UNSET(&error);
+        archi_dexgraph_op__thread_group_fork_join(&fork_join, &error);
+        ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+        ASSERT_TRUE(all_branches_run_once(&branches));
+
+        // A failed branch doesn't stop the others
+        reset_branches(&branches, 0, 7);
+
+        ARCHI_ERROR_VAR_UNSET(&error);
+        archi_dexgraph_op__thread_group_fork_join(&fork_join, &error);
+        ASSERT_EQ(error.code, 7, archi_error_code_t, "%i");
+        ASSERT_TRUE(all_branches_run_once(&branches));
+
+        // Without the error array, the error of one of the failed branches is reported
+        reset_branches(&branches, 5, 7);
+
+        ARCHI_ERROR_VAR_UNSET(&error);
+        archi_dexgraph_op__thread_group_fork_join(&fork_join, &error);
+        ASSERT_TRUE((error.code == 5) || (error.code == 7));
+        ASSERT_TRUE(all_branches_run_once(&branches));
+
+        // With the error array, errors of all branches are stored,
+        // and the error of the failed branch with the lowest index is reported
+        fork_join.branch_error = branch_error;
+        reset_branches(&branches, 5, 7);
+
+        ARCHI_ERROR_VAR_UNSET(&error);
+        archi_dexgraph_op__thread_group_fork_join(&fork_join, &error);
+        ASSERT_EQ(error.code, 5, archi_error_code_t, "%i");
+        ASSERT_TRUE(all_branches_run_once(&branches));
+
+        for (size_t i = 0; i < NUM_BRANCHES; i++)
+            ASSERT_EQ(branch_error[i].code, (i == 1) ? 5 : (i == 3) ? 7 : 0, archi_error_code_t, "%i");
+
+        reset_branches(&branches, 0, 0);
+
+        ARCHI_ERROR_VAR_UNSET(&error);
+        archi_dexgraph_op__thread_group_fork_join(&fork_join, &error);
+        ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+
+        for (size_t i = 0; i < NUM_BRANCHES; i++)
+            ASSERT_EQ(branch_error[i].code, 0, archi_error_code_t, "%i");
+
+        archi_thread_group_destroy(group);
+    }
+
+    free_branches(&branches);
+}
+
+struct unrelated_work {
+    archi_thread_group_t group;
+
+    atomic_bool fork_started; // whether the branch has started
+    atomic_bool enqueued;     // whether the unrelated work is enqueued
+    atomic_bool release;      // whether the unrelated work may finish
+    atomic_bool timed_out;    // whether the unrelated work has been held for too long
+};
+
+static
+ARCHI_THREAD_GROUP_WORK_FUNC(held_work)
+{
+    (void) work_item_idx;
+    (void) thread_idx;
+
+    struct unrelated_work *unrelated = data;
+
+    struct timespec start, now;
+    timespec_get(&start, TIME_UTC);
+
+    while (!atomic_load(&unrelated->release))
+    {
+        timespec_get(&now, TIME_UTC);
+        if (now.tv_sec - start.tv_sec >= 2)
+        {
+            atomic_store(&unrelated->timed_out, true);
+            break;
+        }
+
+        thrd_yield();
+    }
+}
+
+static
+int
+enqueue_unrelated_thread(
+        void *arg)
+{
+    struct unrelated_work *unrelated = arg;
+
+    while (!atomic_load(&unrelated->fork_started))
+        thrd_yield();
+
+    // Enqueueing fails while another thread is enqueueing, so retry
+    archi_error_t error;
+    while (archi_thread_group_enqueue(unrelated->group,
+                (archi_thread_group_work_t){.function = held_work, .data = unrelated},
+                (archi_thread_group_callback_t){0},
+                (archi_thread_group_dispatch_params_t){.size = 1}, 0, &error) == 0)
+        thrd_yield();
+
+    atomic_store(&unrelated->enqueued, true);
+    return 0;
+}
+
+static
+ARCHI_DEXGRAPH_OPERATION_FUNC(unrelated_branch_op)
+{
+    struct unrelated_work *unrelated = data;
+
+    // Let another thread enqueue work while the branch is running
+    atomic_store(&unrelated->fork_started, true);
+
+    while (!atomic_load(&unrelated->enqueued))
+        thrd_yield();
+
+    ARCHI_ERROR_RESET();
+}
+
+TEST(archi_dexgraph_op__thread_group_fork_join__unrelated_work)
+{
+    archi_error_t error;
+
+    archi_thread_group_t group = archi_thread_group_create(
+            (archi_thread_group_start_params_t){.num_threads = 2, .queue_capacity = 4}, &error);
+    ASSERT_NE(group, NULL, void*, "%p");
+
+    struct unrelated_work unrelated = {.group = group};
+
+    archi_dexgraph_node_t *node = archi_dexgraph_node_alloc("branch", 1);
+    archi_dexgraph_node_array_t *array = archi_dexgraph_node_array_alloc(1);
+    ASSERT_NE(node, NULL, void*, "%p");
+    ASSERT_NE(array, NULL, void*, "%p");
+
+    node->sequence[0] = (archi_dexgraph_operation_t){.function = unrelated_branch_op, .data = &unrelated};
+    array->node[0] = node;
+
+    thrd_t thread;
+    ASSERT_EQ(thrd_create(&thread, enqueue_unrelated_thread, &unrelated), thrd_success, int, "%i");
+
+    archi_dexgraph_op_data__thread_group_fork_join_t fork_join = {
+        .thread_group = group, .branches = array};
+
+    // The join waits only for the branches, not for work enqueued after them
+    ARCHI_ERROR_VAR_UNSET(&error);
+    archi_dexgraph_op__thread_group_fork_join(&fork_join, &error);
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+
+    atomic_store(&unrelated.release, true);
+
+    thrd_join(thread, NULL);
+    archi_thread_group_wait(group);
+
+    ASSERT_FALSE(atomic_load(&unrelated.timed_out));
+
+    archi_thread_group_destroy(group);
+
+    archi_dexgraph_node_free(node);
+    archi_dexgraph_node_array_free(array);
+}
+
+#define NUM_ITEMS   1000
+
+static
+ARCHI_THREAD_GROUP_WORK_FUNC(wait_cancelled_work)
+{
+    (void) data;
+    (void) work_item_idx;
+    (void) thread_idx;
+
+    while (!archi_thread_group_current_dispatch_cancelled())
+        thrd_yield();
+}
+
+static
+ARCHI_THREAD_GROUP_WORK_FUNC(count_work)
+{
+    (void) work_item_idx;
+    (void) thread_idx;
+
+    atomic_fetch_add((atomic_size_t*)data, 1);
+}
+
+static
+ARCHI_THREAD_GROUP_CALLBACK_FUNC(store_work_size)
+{
+    (void) work_offset;
+    (void) thread_idx;
+
+    *(size_t*)data = work_size;
+}
+
+TEST(archi_dexgraph_op__thread_group_cancel)
+{
+    archi_error_t error;
+
+    // Operation data and thread group are required
+    ARCHI_ERROR_VAR_UNSET(&error);
+    archi_dexgraph_op__thread_group_cancel(NULL, &error);
+    ASSERT_EQ(error.code, ARCHI__ECONSTRAINT, archi_error_code_t, "%i");
+
+    archi_dexgraph_op_data__thread_group_cancel_t cancel = {0};
+
+    ARCHI_ERROR_VAR_UNSET(&error);
+    archi_dexgraph_op__thread_group_cancel(&cancel, &error);
+    ASSERT_EQ(error.code, ARCHI__ECONSTRAINT, archi_error_code_t, "%i");
+
+    archi_thread_group_t group = archi_thread_group_create(
+            (archi_thread_group_start_params_t){.num_threads = 4, .queue_capacity = 4}, &error);
+    ASSERT_NE(group, NULL, void*, "%p");
+
+    cancel.thread_group = group;
+
+    size_t work_size[3] = {SIZE_MAX, SIZE_MAX, SIZE_MAX};
+    atomic_size_t num_processed = 0;
+
+    // Threads are held by the first task until it is cancelled
+    size_t ticket[3];
+    ticket[0] = archi_thread_group_enqueue(group,
+            (archi_thread_group_work_t){.function = wait_cancelled_work},
+            (archi_thread_group_callback_t){.function = store_work_size, .data = &work_size[0]},
+            (archi_thread_group_dispatch_params_t){.size = NUM_ITEMS, .batch_size = 1}, 0, &error);
+    ASSERT_NE(ticket[0], 0, size_t, "%zu");
+
+    for (size_t i = 1; i < 3; i++)
+    {
+        ticket[i] = archi_thread_group_enqueue(group,
+                (archi_thread_group_work_t){.function = count_work, .data = &num_processed},
+                (archi_thread_group_callback_t){.function = store_work_size, .data = &work_size[i]},
+                (archi_thread_group_dispatch_params_t){.size = NUM_ITEMS}, 0, &error);
+        ASSERT_NE(ticket[i], 0, size_t, "%zu");
+    }
+
+    // Only the task with the provided ticket is cancelled
+    cancel.ticket = &ticket[2];
+
+    ARCHI_ERROR_VAR_UNSET(&error);
+    archi_dexgraph_op__thread_group_cancel(&cancel, &error);
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+
+    cancel.ticket = &ticket[0];
+
+    ARCHI_ERROR_VAR_UNSET(&error);
+    archi_dexgraph_op__thread_group_cancel(&cancel, &error);
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+
+    archi_thread_group_wait(group);
+
+    ASSERT_TRUE(work_size[0] <= 4);
+    ASSERT_EQ(work_size[1], NUM_ITEMS, size_t, "%zu");
+    ASSERT_EQ(work_size[2], 0, size_t, "%zu");
+    ASSERT_EQ(atomic_load(&num_processed), NUM_ITEMS, size_t, "%zu");
+
+    // Without the ticket, all incomplete tasks are cancelled
+    work_size[0] = work_size[1] = SIZE_MAX;
+    atomic_store(&num_processed, 0);
+
+    ticket[0] = archi_thread_group_enqueue(group,
+            (archi_thread_group_work_t){.function = wait_cancelled_work},
+            (archi_thread_group_callback_t){.function = store_work_size, .data = &work_size[0]},
+            (archi_thread_group_dispatch_params_t){.size = NUM_ITEMS, .batch_size = 1}, 0, &error);
+    ASSERT_NE(ticket[0], 0, size_t, "%zu");
+
+    ticket[1] = archi_thread_group_enqueue(group,
+            (archi_thread_group_work_t){.function = count_work, .data = &num_processed},
+            (archi_thread_group_callback_t){.function = store_work_size, .data = &work_size[1]},
+            (archi_thread_group_dispatch_params_t){.size = NUM_ITEMS}, 0, &error);
+    ASSERT_NE(ticket[1], 0, size_t, "%zu");
+
+    cancel.ticket = NULL;
+
+    ARCHI_ERROR_VAR_UNSET(&error);
+    archi_dexgraph_op__thread_group_cancel(&cancel, &error);
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+
+    archi_thread_group_wait(group);
+
+    ASSERT_TRUE(work_size[0] <= 4);
+    ASSERT_EQ(work_size[1], 0, size_t, "%zu");
+    ASSERT_EQ(atomic_load(&num_processed), 0, size_t, "%zu");
+
+    archi_thread_group_destroy(group);
+}
@@ -0,0 +1,140 @@
+#include "test.h"
+
+#include "archi/trace/api/trace.fun.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <threads.h>
+
+
+#define TRACE_FILE  "archi-test-trace.json"
+
+#define CAPACITY    8
+#define NUM_EVENTS  20
+
+static
+int
+record_thread(
+        void *arg)
+{
+    (void) arg;
+
+    char name[16];
+
+    for (int i = 0; i < NUM_EVENTS; i++)
+    {
+        snprintf(name, sizeof(name), "event #%i", i);
+        archi_trace_record(ARCHI_TRACE__DISPATCH, name, NULL, i);
+
+        // The name is copied, so the buffer can be reused
+        memset(name, 0, sizeof(name));
+    }
+
+    // Long names are truncated
+    archi_trace_record(ARCHI_TRACE__DISPATCH,
+            "long event name 0123456789abcdefghijklmnopqrstuvwxyz", NULL, 0);
+
+    return 0;
+}
+
+static
+char*
+read_file(
+        const char *pathname)
+{
+    FILE *file = fopen(pathname, "r");
+    if (file == NULL)
+        return NULL;
+
+    static char contents[1 << 16];
+    size_t length = fread(contents, 1, sizeof(contents) - 1, file);
+    contents[length] = '\0';
+
+    fclose(file);
+    return contents;
+}
+
+TEST(archi_trace_flush)
+{
+    archi_error_t error;
+
+    ASSERT_FALSE(archi_trace_start((archi_trace_start_params_t){.capacity = 3}, &error));
+    ASSERT_NE(error.code, 0, archi_error_code_t, "%i");
+
+#ifdef ARCHI_FEATURE_TRACE
+    ASSERT_TRUE(archi_trace_start((archi_trace_start_params_t){.capacity = CAPACITY}, &error));
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+
+    // Record events in a new thread, so that its buffer has the set capacity
+    thrd_t thread;
+    ASSERT_EQ(thrd_create(&thread, record_thread, NULL), thrd_success, int, "%i");
+    thrd_join(thread, NULL);
+
+    archi_trace_stop();
+
+    ASSERT_TRUE(archi_trace_flush(TRACE_FILE, &error));
+    ASSERT_EQ(error.code, 0, archi_error_code_t, "%i");
+
+    char *contents = read_file(TRACE_FILE);
+    ASSERT_NE(contents, NULL, void*, "%p");
+
+    ASSERT_EQ(strncmp(contents, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 39), 0, int, "%i");
+    ASSERT_NE(strstr(contents, "]}"), NULL, void*, "%p");
+
+    // The oldest events are overwritten, the last ones are kept in order
+    const char *prev = contents;
+    char name[32];
+
+    for (int i = 0; i < NUM_EVENTS; i++)
+    {
+        snprintf(name, sizeof(name), "\"name\":\"event #%i\"", i);
+        const char *event = strstr(contents, name);
+
+        if (i < NUM_EVENTS + 1 - CAPACITY)
+            ASSERT_EQ(event, NULL, const void*, "%p");
+        else
+        {
+            ASSERT_NE(event, NULL, const void*, "%p");
+            ASSERT_GT(event, prev, const void*, "%p");
+            prev = event;
+        }
+    }
+
+    ASSERT_NE(strstr(contents, "\"name\":\"long event name 0123456789abcdefghijklm\","), NULL, void*, "%p");
+
+    // Flushed events are discarded
+    ASSERT_TRUE(archi_trace_flush(TRACE_FILE, &error));
+
+    contents = read_file(TRACE_FILE);
+    ASSERT_NE(contents, NULL, void*, "%p");
+    ASSERT_EQ(strstr(contents, "event #"), NULL, void*, "%p");
+
+    // The slot next to be written of a live thread buffer is not flushed,
+    // as it could be being overwritten
+    ASSERT_TRUE(archi_trace_start((archi_trace_start_params_t){.capacity = CAPACITY}, &error));
+
+    for (int i = 0; i < NUM_EVENTS; i++)
+        archi_trace_record(ARCHI_TRACE__DISPATCH, "live event", NULL, i);
+
+    archi_trace_stop();
+
+    ASSERT_TRUE(archi_trace_flush(TRACE_FILE, &error));
+
+    contents = read_file(TRACE_FILE);
+    ASSERT_NE(contents, NULL, void*, "%p");
+
+    int num_live_events = 0;
+    for (const char *event = contents; (event = strstr(event, "\"name\":\"live event\"")) != NULL; event++)
+        num_live_events++;
+
+    ASSERT_EQ(num_live_events, CAPACITY - 1, int, "%i");
+
+    remove(TRACE_FILE);
+#else
+    (void) record_thread;
+    (void) read_file;
+
+    ASSERT_FALSE(archi_trace_start((archi_trace_start_params_t){0}, &error));
+    ASSERT_EQ(error.code, ARCHI__ENOTIMPL, archi_error_code_t, "%i");
+#endif
+}